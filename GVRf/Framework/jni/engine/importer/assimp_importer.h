@@ -42,7 +42,8 @@ public:
     }
 
     unsigned int getNumberOfMeshes() {
-        return assimp_importer_->GetScene()->mNumMeshes;
+        const aiScene* scene = assimp_importer_->GetScene();
+        return scene != 0 ? scene->mNumMeshes : 0;
     }
 
     Mesh* getMesh(int index);
@@ -20,22 +20,54 @@
 
 #include "importer.h"
 
+#include "engine/importer/mesh_cache.h"
+#include "engine/importer/mesh_codec.h"
+#include "objects/mesh.h"
+#include "util/gvr_log.h"
+
 namespace gvr {
-AssimpImporter* Importer::readFileFromAssets(char* buffer,
+const unsigned int Importer::IMPORT_FLAGS;
+
+AssimpImporter* Importer::readFileFromAssets(const char* buffer,
         long size) {
     Assimp::Importer* importer = new Assimp::Importer();
-    importer->ReadFileFromMemory(buffer, size,
-            aiProcess_JoinIdenticalVertices | aiProcess_FlipUVs, 0);
+    importer->ReadFileFromMemory(buffer, size, IMPORT_FLAGS, 0);
     return new AssimpImporter(importer);
 }
 
 AssimpImporter* Importer::readFileFromSDCard(std::string str) {
     Assimp::Importer* importer = new Assimp::Importer();
     const char* c_str = str.c_str();
-    importer->ReadFile(str,
-            aiProcess_JoinIdenticalVertices | aiProcess_FlipUVs);
-    importer->ReadFileFromMemory(c_str, str.size(),
-            aiProcess_JoinIdenticalVertices | aiProcess_FlipUVs, 0);
+    importer->ReadFile(str, IMPORT_FLAGS);
+    importer->ReadFileFromMemory(c_str, str.size(), IMPORT_FLAGS, 0);
     return new AssimpImporter(importer);
 }
+
+Mesh* Importer::loadMesh(const char* buffer, long size,
+        const std::string& cache_dir) {
+    // compressed meshes decode faster than the cache would load
+    if (MeshCodec::isEncoded(buffer, size)) {
+        try {
+            return MeshCodec::decode(buffer, size);
+        } catch (std::string error) {
+            LOGE("%s", error.c_str());
+            return 0;
+        }
+    }
+
+    uint64_t key = MeshCache::key(buffer, size, IMPORT_FLAGS);
+    std::string path = MeshCache::path(cache_dir, key);
+    Mesh* mesh = MeshCache::read(path, key);
+    if (mesh != 0) {
+        return mesh;
+    }
+
+    AssimpImporter* assimp_importer = readFileFromAssets(buffer, size);
+    if (assimp_importer->getNumberOfMeshes() > 0) {
+        mesh = assimp_importer->getMesh(0);
+        MeshCache::write(path, key, *mesh);
+    }
+    delete assimp_importer;
+    return mesh;
+}
 }
@@ -21,6 +21,7 @@
 #define IMPORTER_H_
 
 #include <memory>
+#include <string>
 
 #include "assimp/scene.h"
 #include "assimp/Importer.hpp"
@@ -29,13 +30,27 @@
 #include "engine/importer/assimp_importer.h"
 
 namespace gvr {
+class Mesh;
+
 class Importer {
 private:
     Importer();
 
 public:
-    static AssimpImporter* readFileFromAssets(char* buffer, long size);
+    static const unsigned int IMPORT_FLAGS = aiProcess_JoinIdenticalVertices
+            | aiProcess_FlipUVs;
+
+    static AssimpImporter* readFileFromAssets(const char* buffer, long size);
     static AssimpImporter* readFileFromSDCard(std::string str);
+
+    /*
+     * The first mesh of a model file, taken from the binary cache in
+     * cache_dir when the same file was imported before; otherwise imported
+     * with Assimp and added to the cache. Files made by MeshCodec are
+     * decoded directly.
+     */
+    static Mesh* loadMesh(const char* buffer, long size,
+            const std::string& cache_dir);
 };
 }
 #endif
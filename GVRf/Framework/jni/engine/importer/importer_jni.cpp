@@ -37,6 +37,9 @@ Java_org_gearvrf_NativeImporter_readFileFromSDCard(JNIEnv * env,
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeImporter_readFromByteArray(JNIEnv * env,
         jobject obj, jbyteArray bytes);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeImporter_loadMesh(JNIEnv * env,
+        jobject obj, jbyteArray bytes, jstring cache_dir);
 }
 
 JNIEXPORT jlong JNICALL
@@ -44,22 +47,27 @@ Java_org_gearvrf_NativeImporter_readFileFromAssets(JNIEnv * env,
         jobject obj, jobject asset_manager, jstring filename) {
     const char* native_string = env->GetStringUTFChars(filename, 0);
     AAssetManager* mgr = AAssetManager_fromJava(env, asset_manager);
-    AAsset* asset = AAssetManager_open(mgr, native_string, AASSET_MODE_UNKNOWN);
+    AAsset* asset = AAssetManager_open(mgr, native_string, AASSET_MODE_BUFFER);
     if (NULL == asset) {
         LOGE("_ASSET_NOT_FOUND_");
+        env->ReleaseStringUTFChars(filename, native_string);
         return JNI_FALSE;
     }
+    // uncompressed assets are mapped straight from the APK
     long size = AAsset_getLength(asset);
-    char* buffer = (char*) malloc(sizeof(char) * size);
-    AAsset_read(asset, buffer, size);
+    const char* buffer = static_cast<const char*>(AAsset_getBuffer(asset));
+    if (NULL == buffer) {
+        LOGE("_ASSET_NOT_READABLE_");
+        AAsset_close(asset);
+        env->ReleaseStringUTFChars(filename, native_string);
+        return JNI_FALSE;
+    }
 
     AssimpImporter* assimp_scene = Importer::readFileFromAssets(
             buffer, size);
 
     AAsset_close(asset);
 
-    free(buffer);
-
     env->ReleaseStringUTFChars(filename, native_string);
 
     return reinterpret_cast<jlong>(assimp_scene);
@@ -79,6 +87,22 @@ Java_org_gearvrf_NativeImporter_readFromByteArray(JNIEnv * env,jobject obj,
     return reinterpret_cast<jlong>(assimp_scene);
 }
 
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeImporter_loadMesh(JNIEnv * env, jobject obj,
+        jbyteArray bytes, jstring cache_dir) {
+    const char* native_cache_dir = env->GetStringUTFChars(cache_dir, 0);
+    jbyte* data = env->GetByteArrayElements(bytes, 0);
+    int length = static_cast<int>(env->GetArrayLength(bytes));
+
+    Mesh* mesh = Importer::loadMesh(reinterpret_cast<const char*>(data),
+            length, native_cache_dir);
+
+    env->ReleaseByteArrayElements(bytes, data, JNI_ABORT);
+    env->ReleaseStringUTFChars(cache_dir, native_cache_dir);
+
+    return reinterpret_cast<jlong>(mesh);
+}
+
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeImporter_readFileFromSDCard(JNIEnv * env,
         jobject obj, jstring filename) {
@@ -0,0 +1,260 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Binary cache of imported meshes.
+ ***************************************************************************/
+
+#include "mesh_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "objects/mesh.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+
+const uint32_t MeshCache::VERSION;
+const uint32_t MeshCache::BLOCK_ALIGNMENT;
+
+static const char MAGIC[4] = { 'G', 'V', 'R', 'M' };
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+static uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static uint32_t align(uint32_t offset) {
+    return (offset + MeshCache::BLOCK_ALIGNMENT - 1)
+            & ~(MeshCache::BLOCK_ALIGNMENT - 1);
+}
+
+/*
+ * Pointer to the block's data if it is present and laid out as expected.
+ * The size is computed in 64 bits, so a forged count cannot wrap it into
+ * one that passes.
+ */
+static const void* blockData(const MeshCacheHeader& header,
+        const char* file, size_t file_size, int block, uint32_t count,
+        uint32_t components, uint32_t type, size_t component_size) {
+    if (!(header.block_mask & (1u << block))) {
+        return 0;
+    }
+    const MeshCacheBlock& info = header.blocks[block];
+    uint64_t bytes = static_cast<uint64_t>(count) * components
+            * component_size;
+    if (bytes > file_size || info.components != components
+            || info.type != type || info.size != bytes
+            || info.offset % MeshCache::BLOCK_ALIGNMENT != 0
+            || info.offset < sizeof(MeshCacheHeader)
+            || info.offset > file_size || info.size > file_size - info.offset) {
+        return 0;
+    }
+    return file + info.offset;
+}
+
+uint64_t MeshCache::key(const void* source, size_t size,
+        unsigned int import_flags) {
+    uint64_t hash = fnv1a(FNV_OFFSET_BASIS, source, size);
+    hash = fnv1a(hash, &import_flags, sizeof(import_flags));
+    return fnv1a(hash, &VERSION, sizeof(VERSION));
+}
+
+std::string MeshCache::path(const std::string& cache_dir, uint64_t key) {
+    char name[32];
+    snprintf(name, sizeof(name), "/%016llx.gvrm",
+            static_cast<unsigned long long>(key));
+    return cache_dir + name;
+}
+
+Mesh* MeshCache::read(const std::string& path, uint64_t key) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < 0
+            || static_cast<size_t>(info.st_size) < sizeof(MeshCacheHeader)) {
+        close(fd);
+        return 0;
+    }
+    size_t file_size = info.st_size;
+    void* mapping = mmap(0, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return 0;
+    }
+    // every block is read front to back exactly once
+    madvise(mapping, file_size, MADV_SEQUENTIAL);
+
+    const char* file = static_cast<const char*>(mapping);
+    MeshCacheHeader header;
+    memcpy(&header, file, sizeof(header));
+
+    // counts the file cannot hold are stale before anything is read
+    Mesh* mesh = 0;
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+            && header.version == VERSION && header.key == key
+            && static_cast<uint64_t>(header.vertex_count) * sizeof(glm::vec3)
+                    <= file_size
+            && static_cast<uint64_t>(header.index_count)
+                    * sizeof(unsigned short) <= file_size) {
+        const glm::vec3* positions =
+                static_cast<const glm::vec3*>(blockData(header, file,
+                        file_size, MeshCacheHeader::POSITIONS,
+                        header.vertex_count, 3, GL_FLOAT, sizeof(float)));
+        const glm::vec3* normals = static_cast<const glm::vec3*>(blockData(
+                header, file, file_size, MeshCacheHeader::NORMALS,
+                header.vertex_count, 3, GL_FLOAT, sizeof(float)));
+        const glm::vec2* tex_coords =
+                static_cast<const glm::vec2*>(blockData(header, file,
+                        file_size, MeshCacheHeader::TEX_COORDS,
+                        header.vertex_count, 2, GL_FLOAT, sizeof(float)));
+        const unsigned short* indices =
+                static_cast<const unsigned short*>(blockData(header, file,
+                        file_size, MeshCacheHeader::INDICES,
+                        header.index_count, 1, GL_UNSIGNED_SHORT,
+                        sizeof(unsigned short)));
+
+        // a block that is flagged but unusable makes the whole file stale
+        bool valid = positions != 0 && indices != 0
+                && (normals != 0
+                        || !(header.block_mask
+                                & (1u << MeshCacheHeader::NORMALS)))
+                && (tex_coords != 0
+                        || !(header.block_mask
+                                & (1u << MeshCacheHeader::TEX_COORDS)));
+        for (uint32_t i = 0; valid && i < header.index_count; ++i) {
+            valid = indices[i] < header.vertex_count;
+        }
+
+        if (valid) {
+            // the blocks have the in-memory layout of the mesh's arrays, so
+            // each one is a single bulk copy out of the mapping
+            mesh = new Mesh();
+            mesh->set_vertices(
+                    std::vector<glm::vec3>(positions,
+                            positions + header.vertex_count));
+            if (normals != 0) {
+                mesh->set_normals(
+                        std::vector<glm::vec3>(normals,
+                                normals + header.vertex_count));
+            }
+            if (tex_coords != 0) {
+                mesh->set_tex_coords(
+                        std::vector<glm::vec2>(tex_coords,
+                                tex_coords + header.vertex_count));
+            }
+            mesh->set_triangles(
+                    std::vector<unsigned short>(indices,
+                            indices + header.index_count));
+
+            BoundingVolume bounding_volume;
+            bounding_volume.deserialize(header.bounds);
+            mesh->setBoundingVolume(bounding_volume);
+        }
+    }
+
+    munmap(mapping, file_size);
+    if (mesh == 0) {
+        LOGW("MeshCache::read() : ignoring stale cache %s", path.c_str());
+    }
+    return mesh;
+}
+
+bool MeshCache::write(const std::string& path, uint64_t key, Mesh& mesh) {
+    const void* data[MeshCacheHeader::NUM_BLOCKS] = { mesh.vertices().data(),
+            mesh.normals().data(), mesh.tex_coords().data(),
+            mesh.triangles().data() };
+    uint32_t vertex_count = mesh.vertices().size();
+    uint32_t index_count = mesh.triangles().size();
+
+    MeshCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.key = key;
+    header.vertex_count = vertex_count;
+    header.index_count = index_count;
+    mesh.getBoundingVolume().serialize(header.bounds);
+
+    MeshCacheBlock layouts[MeshCacheHeader::NUM_BLOCKS] = {
+            { 0, static_cast<uint32_t>(vertex_count * 3 * sizeof(float)), 3,
+                    GL_FLOAT },
+            { 0, static_cast<uint32_t>(vertex_count * 3 * sizeof(float)), 3,
+                    GL_FLOAT },
+            { 0, static_cast<uint32_t>(vertex_count * 2 * sizeof(float)), 2,
+                    GL_FLOAT },
+            { 0, static_cast<uint32_t>(index_count * sizeof(unsigned short)),
+                    1, GL_UNSIGNED_SHORT } };
+    bool present[MeshCacheHeader::NUM_BLOCKS] = { true,
+            mesh.normals().size() == vertex_count && vertex_count > 0,
+            mesh.tex_coords().size() == vertex_count && vertex_count > 0, true };
+
+    uint32_t offset = sizeof(MeshCacheHeader);
+    for (int i = 0; i < MeshCacheHeader::NUM_BLOCKS; ++i) {
+        if (!present[i]) {
+            continue;
+        }
+        offset = align(offset);
+        header.blocks[i] = layouts[i];
+        header.blocks[i].offset = offset;
+        header.block_mask |= 1u << i;
+        offset += layouts[i].size;
+    }
+
+    std::string temp_path = path + ".tmp";
+    FILE* file = fopen(temp_path.c_str(), "wb");
+    if (file == 0) {
+        LOGE("MeshCache::write() : cannot create %s", temp_path.c_str());
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    static const char padding[BLOCK_ALIGNMENT] = { 0 };
+    long position = sizeof(header);
+    for (int i = 0; ok && i < MeshCacheHeader::NUM_BLOCKS; ++i) {
+        if (!(header.block_mask & (1u << i))) {
+            continue;
+        }
+        size_t pad = header.blocks[i].offset - position;
+        ok = fwrite(padding, 1, pad, file) == pad
+                && fwrite(data[i], 1, header.blocks[i].size, file)
+                        == header.blocks[i].size;
+        position = header.blocks[i].offset + header.blocks[i].size;
+    }
+    ok = fclose(file) == 0 && ok;
+
+    if (!ok || rename(temp_path.c_str(), path.c_str()) != 0) {
+        LOGE("MeshCache::write() : failed to write %s", path.c_str());
+        unlink(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+}
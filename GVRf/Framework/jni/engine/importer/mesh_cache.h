@@ -0,0 +1,91 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Binary cache of imported meshes.
+ ***************************************************************************/
+
+#ifndef MESH_CACHE_H_
+#define MESH_CACHE_H_
+
+#include <stdint.h>
+#include <string>
+
+#include "GLES3/gl3.h"
+
+#include "objects/bounding_volume.h"
+
+namespace gvr {
+class Mesh;
+
+/*
+ * File layout, little endian as the devices are:
+ *   MeshCacheHeader
+ *   one block per attribute present, each starting on a BLOCK_ALIGNMENT
+ *   boundary and holding the tightly packed data glBufferData expects
+ * Anything unexpected, including a different version, makes the file a miss.
+ */
+struct MeshCacheBlock {
+    uint32_t offset;        // from the start of the file
+    uint32_t size;          // in bytes
+    uint32_t components;    // per element
+    uint32_t type;          // GL_FLOAT or GL_UNSIGNED_SHORT
+};
+
+struct MeshCacheHeader {
+    enum Block {
+        POSITIONS = 0, NORMALS, TEX_COORDS, INDICES, NUM_BLOCKS
+    };
+
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t vertex_count;
+    uint32_t index_count;
+    // bit per Block that is present
+    uint32_t block_mask;
+    uint32_t reserved;
+    float bounds[BoundingVolume::SERIALIZED_SIZE];
+    MeshCacheBlock blocks[NUM_BLOCKS];
+};
+
+class MeshCache {
+private:
+    MeshCache();
+
+public:
+    static const uint32_t VERSION = 1;
+    static const uint32_t BLOCK_ALIGNMENT = 16;
+
+    // FNV-1a of the source file, the import flags and the format version
+    static uint64_t key(const void* source, size_t size,
+            unsigned int import_flags);
+
+    // cache_dir/<key in hex>.gvrm
+    static std::string path(const std::string& cache_dir, uint64_t key);
+
+    /*
+     * Map the file and build the mesh from its blocks, or return 0 if it is
+     * missing, stale or malformed.
+     */
+    static Mesh* read(const std::string& path, uint64_t key);
+
+    // Write through a temporary file, so readers never see half a cache.
+    static bool write(const std::string& path, uint64_t key, Mesh& mesh);
+};
+
+}
+#endif
@@ -0,0 +1,899 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Compressed mesh format: quantized, predicted attributes and rANS coded
+ * streams.
+ ***************************************************************************/
+
+#include "mesh_codec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <pthread.h>
+#include <stdint.h>
+
+#include "glm/glm.hpp"
+
+#include "objects/mesh.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+
+namespace {
+
+const char MAGIC[4] = { 'G', 'V', 'R', 'C' };
+const uint32_t VERSION = 1;
+
+const uint32_t HAS_NORMALS = 0x1;
+const uint32_t HAS_TEX_COORDS = 0x2;
+
+// rANS with byte-wise renormalization and 12 bit probabilities
+const int SCALE_BITS = 12;
+const uint32_t SCALE = 1u << SCALE_BITS;
+const uint32_t RANS_L = 1u << 23;
+
+// varint bytes of an index distance, which stays below 2^21, and of an
+// attribute residual, which stays below 2^(24 + 3) once zigzagged
+const uint32_t MAX_INDEX_SYMBOLS = 3;
+const uint32_t MAX_RESIDUAL_SYMBOLS = 4;
+
+// far beyond what 16 bit indices are drawn with; a header claiming more is
+// taken as corrupt rather than allocated
+const uint32_t MAX_INDEX_COUNT = 1u << 24;
+
+void fail(const char* what) {
+    std::string error = "MeshCodec::decode() : ";
+    error += what;
+    throw error;
+}
+
+/*
+ * Little endian output.
+ */
+class Writer {
+public:
+    explicit Writer(std::vector<unsigned char>& data) :
+            data_(data) {
+    }
+
+    void bytes(const void* data, size_t size) {
+        const unsigned char* begin = static_cast<const unsigned char*>(data);
+        data_.insert(data_.end(), begin, begin + size);
+    }
+
+    void u8(uint32_t value) {
+        data_.push_back(value);
+    }
+
+    void u32(uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            data_.push_back(value >> (i * 8));
+        }
+    }
+
+    void f32(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        u32(bits);
+    }
+
+    void varint(uint32_t value) {
+        while (value >= 0x80) {
+            data_.push_back((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        data_.push_back(value);
+    }
+
+private:
+    std::vector<unsigned char>& data_;
+};
+
+/*
+ * Bounds checked little endian input.
+ */
+class Reader {
+public:
+    Reader(const unsigned char* begin, const unsigned char* end) :
+            cursor_(begin), end_(end) {
+    }
+
+    const unsigned char* take(size_t size) {
+        if (size > static_cast<size_t>(end_ - cursor_)) {
+            fail("truncated data");
+        }
+        const unsigned char* begin = cursor_;
+        cursor_ += size;
+        return begin;
+    }
+
+    uint32_t u8() {
+        return *take(1);
+    }
+
+    uint32_t u32() {
+        const unsigned char* p = take(4);
+        return p[0] | (p[1] << 8) | (p[2] << 16)
+                | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    float f32() {
+        uint32_t bits = u32();
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    uint32_t varint() {
+        uint32_t value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            uint32_t byte = u8();
+            value |= (byte & 0x7f) << shift;
+            if (byte < 0x80) {
+                return value;
+            }
+        }
+        fail("bad varint");
+        return 0;
+    }
+
+    bool done() const {
+        return cursor_ == end_;
+    }
+
+private:
+    const unsigned char* cursor_;
+    const unsigned char* end_;
+};
+
+inline uint32_t zigzag(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^ (value >> 31);
+}
+
+inline int32_t unzigzag(uint32_t value) {
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+void appendVarint(std::vector<unsigned char>& symbols, uint32_t value) {
+    while (value >= 0x80) {
+        symbols.push_back((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    symbols.push_back(value);
+}
+
+/*
+ * Byte stream entropy coded with a static frequency table, stored as a
+ * bitmap of the symbols present followed by their frequencies.
+ */
+void writeStream(Writer& writer, const std::vector<unsigned char>& symbols) {
+    writer.u32(symbols.size());
+    if (symbols.empty()) {
+        return;
+    }
+
+    uint32_t counts[256] = { 0 };
+    for (auto it = symbols.begin(); it != symbols.end(); ++it) {
+        ++counts[*it];
+    }
+
+    // scale the counts to SCALE, keeping every present symbol codable
+    uint32_t freqs[256] = { 0 };
+    uint32_t sum = 0;
+    for (int s = 0; s < 256; ++s) {
+        if (counts[s] != 0) {
+            uint64_t scaled = static_cast<uint64_t>(counts[s]) * SCALE
+                    / symbols.size();
+            freqs[s] = std::max<uint32_t>(1, scaled);
+            sum += freqs[s];
+        }
+    }
+    while (sum != SCALE) {
+        int largest = std::max_element(freqs, freqs + 256) - freqs;
+        if (sum < SCALE) {
+            freqs[largest] += SCALE - sum;
+            sum = SCALE;
+        } else {
+            // the largest entry always exceeds 1 while the sum is too big
+            uint32_t excess = std::min(sum - SCALE, freqs[largest] - 1);
+            freqs[largest] -= excess;
+            sum -= excess;
+        }
+    }
+
+    unsigned char present[32] = { 0 };
+    uint32_t starts[256];
+    uint32_t start = 0;
+    for (int s = 0; s < 256; ++s) {
+        starts[s] = start;
+        start += freqs[s];
+        if (freqs[s] != 0) {
+            present[s >> 3] |= 1 << (s & 7);
+        }
+    }
+    writer.bytes(present, sizeof(present));
+    for (int s = 0; s < 256; ++s) {
+        if (freqs[s] != 0) {
+            writer.varint(freqs[s]);
+        }
+    }
+
+    // rANS emits in reverse: code the symbols back to front, filling the
+    // buffer from its end; at most two bytes leave per symbol
+    std::vector<unsigned char> coded(symbols.size() * 2 + 4);
+    unsigned char* out = coded.data() + coded.size();
+    uint32_t x = RANS_L;
+    for (size_t i = symbols.size(); i-- > 0;) {
+        uint32_t freq = freqs[symbols[i]];
+        uint32_t x_max = ((RANS_L >> SCALE_BITS) << 8) * freq;
+        while (x >= x_max) {
+            *--out = x & 0xff;
+            x >>= 8;
+        }
+        x = ((x / freq) << SCALE_BITS) + (x % freq) + starts[symbols[i]];
+    }
+    out -= 4;
+    out[0] = x;
+    out[1] = x >> 8;
+    out[2] = x >> 16;
+    out[3] = x >> 24;
+
+    size_t coded_size = coded.data() + coded.size() - out;
+    writer.u32(coded_size);
+    writer.bytes(out, coded_size);
+}
+
+// max_count comes from the header, so a corrupt count fails before it
+// is allocated
+void readStream(Reader& reader, std::vector<unsigned char>& symbols,
+        size_t max_count) {
+    uint32_t count = reader.u32();
+    if (count > max_count) {
+        fail("bad stream length");
+    }
+    symbols.resize(count);
+    if (count == 0) {
+        return;
+    }
+
+    const unsigned char* present = reader.take(32);
+    uint32_t freqs[256] = { 0 };
+    uint32_t starts[256] = { 0 };
+    uint32_t start = 0;
+    for (int s = 0; s < 256; ++s) {
+        if (present[s >> 3] & (1 << (s & 7))) {
+            freqs[s] = reader.varint();
+            starts[s] = start;
+            start += freqs[s];
+            if (freqs[s] == 0 || start > SCALE) {
+                fail("bad frequency table");
+            }
+        }
+    }
+    if (start != SCALE) {
+        fail("bad frequency table");
+    }
+    unsigned char slots[SCALE];
+    for (int s = 0; s < 256; ++s) {
+        memset(slots + starts[s], s, freqs[s]);
+    }
+
+    uint32_t coded_size = reader.u32();
+    if (coded_size < 4) {
+        fail("bad stream");
+    }
+    const unsigned char* in = reader.take(coded_size);
+    const unsigned char* end = in + coded_size;
+    uint32_t x = in[0] | (in[1] << 8) | (in[2] << 16)
+            | (static_cast<uint32_t>(in[3]) << 24);
+    in += 4;
+
+    const uint32_t mask = SCALE - 1;
+    unsigned char* out = symbols.data();
+    for (uint32_t i = 0; i < count; ++i) {
+        unsigned char s = slots[x & mask];
+        out[i] = s;
+        x = freqs[s] * (x >> SCALE_BITS) + (x & mask) - starts[s];
+        while (x < RANS_L) {
+            if (in == end) {
+                fail("truncated stream");
+            }
+            x = (x << 8) | *in++;
+        }
+    }
+}
+
+/*
+ * How a vertex is predicted from vertices decoded before it.
+ */
+struct Prediction {
+    enum Kind {
+        // a + b - c, across the edge a b shared with an earlier triangle
+        PARALLELOGRAM,
+        // (a + b) / 2
+        MIDPOINT,
+        // a
+        NEIGHBOR,
+        // the vertex with the previous number, or 0 for the first one
+        PREVIOUS
+    };
+
+    Kind kind;
+    uint32_t a, b, c;
+};
+
+const uint64_t EMPTY_EDGE = ~0ULL;
+
+/*
+ * Directed edge -> opposite vertex, open addressing; the walk only ever
+ * inserts, so there are no tombstones to handle.
+ */
+class EdgeTable {
+public:
+    explicit EdgeTable(size_t edge_count) {
+        size_t capacity = 16;
+        while (capacity < edge_count * 2) {
+            capacity <<= 1;
+        }
+        keys_.assign(capacity, EMPTY_EDGE);
+        values_.resize(capacity);
+        mask_ = capacity - 1;
+    }
+
+    void insert(uint32_t from, uint32_t to, uint32_t opposite) {
+        uint64_t key = (static_cast<uint64_t>(from) << 32) | to;
+        size_t slot = hash(key);
+        while (keys_[slot] != EMPTY_EDGE && keys_[slot] != key) {
+            slot = (slot + 1) & mask_;
+        }
+        keys_[slot] = key;
+        values_[slot] = opposite;
+    }
+
+    bool find(uint32_t from, uint32_t to, uint32_t& opposite) const {
+        uint64_t key = (static_cast<uint64_t>(from) << 32) | to;
+        for (size_t slot = hash(key); keys_[slot] != EMPTY_EDGE;
+                slot = (slot + 1) & mask_) {
+            if (keys_[slot] == key) {
+                opposite = values_[slot];
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    size_t hash(uint64_t key) const {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32)
+                & mask_;
+    }
+
+    std::vector<uint64_t> keys_;
+    std::vector<uint32_t> values_;
+    size_t mask_;
+};
+
+/*
+ * Walk the triangles in order and pick a prediction for every vertex at
+ * its first use. Encoder and decoder both run this on the renumbered
+ * indices, so they agree on every prediction.
+ */
+std::vector<Prediction> predictVertices(const unsigned short* triangles,
+        size_t index_count, uint32_t vertex_count) {
+    std::vector<Prediction> predictions(vertex_count);
+    EdgeTable opposite(index_count);
+    uint32_t next = 0;
+
+    for (size_t t = 0; t + 2 < index_count; t += 3) {
+        const unsigned short* p = triangles + t;
+        for (int i = 0; i < 3; ++i) {
+            if (p[i] != next) {
+                continue;
+            }
+            uint32_t a = p[(i + 1) % 3];
+            uint32_t b = p[(i + 2) % 3];
+            bool known_a = a < next;
+            bool known_b = b < next;
+            Prediction& prediction = predictions[next];
+            if (known_a && known_b) {
+                prediction.a = a;
+                prediction.b = b;
+                prediction.kind =
+                        opposite.find(b, a, prediction.c) ?
+                                Prediction::PARALLELOGRAM :
+                                Prediction::MIDPOINT;
+            } else if (known_a || known_b) {
+                prediction.kind = Prediction::NEIGHBOR;
+                prediction.a = known_a ? a : b;
+            } else {
+                prediction.kind = Prediction::PREVIOUS;
+            }
+            ++next;
+        }
+        for (int i = 0; i < 3; ++i) {
+            opposite.insert(p[(i + 1) % 3], p[(i + 2) % 3], p[i]);
+        }
+    }
+
+    // vertices no triangle uses
+    for (; next < vertex_count; ++next) {
+        predictions[next].kind = Prediction::PREVIOUS;
+    }
+    return predictions;
+}
+
+template<int N>
+inline void predict(const std::vector<int32_t>& values,
+        const Prediction& prediction, uint32_t vertex, int32_t* predicted) {
+    const int32_t* a = &values[prediction.a * N];
+    const int32_t* b = &values[prediction.b * N];
+    switch (prediction.kind) {
+    case Prediction::PARALLELOGRAM: {
+        const int32_t* c = &values[prediction.c * N];
+        for (int k = 0; k < N; ++k) {
+            predicted[k] = a[k] + b[k] - c[k];
+        }
+        break;
+    }
+    case Prediction::MIDPOINT:
+        for (int k = 0; k < N; ++k) {
+            predicted[k] = (a[k] + b[k]) >> 1;
+        }
+        break;
+    case Prediction::NEIGHBOR:
+        for (int k = 0; k < N; ++k) {
+            predicted[k] = a[k];
+        }
+        break;
+    default:
+        for (int k = 0; k < N; ++k) {
+            predicted[k] = vertex > 0 ? values[(vertex - 1) * N + k] : 0;
+        }
+        break;
+    }
+}
+
+// values holds N quantized components per vertex, in decoding order
+template<int N>
+std::vector<unsigned char> encodeResiduals(const std::vector<int32_t>& values,
+        const std::vector<Prediction>& predictions) {
+    std::vector<unsigned char> residuals;
+    residuals.reserve(values.size() * 2);
+    int32_t predicted[N];
+    for (uint32_t v = 0; v < predictions.size(); ++v) {
+        predict<N>(values, predictions[v], v, predicted);
+        for (int k = 0; k < N; ++k) {
+            appendVarint(residuals, zigzag(values[v * N + k] - predicted[k]));
+        }
+    }
+    return residuals;
+}
+
+/*
+ * Every decoded value must be a quantized one, in [0, max_value]; that
+ * also keeps the predictions made from them far from overflowing.
+ */
+template<int N>
+std::vector<int32_t> decodeResiduals(const std::vector<unsigned char>& residuals,
+        const std::vector<Prediction>& predictions, int32_t max_value) {
+    std::vector<int32_t> values(predictions.size() * N);
+    const unsigned char* in = residuals.data();
+    const unsigned char* end = in + residuals.size();
+    int32_t predicted[N];
+    for (uint32_t v = 0; v < predictions.size(); ++v) {
+        predict<N>(values, predictions[v], v, predicted);
+        for (int k = 0; k < N; ++k) {
+            uint32_t value = 0;
+            for (int shift = 0;; shift += 7) {
+                if (in == end || shift > 28) {
+                    fail("bad attribute stream");
+                }
+                uint32_t byte = *in++;
+                value |= (byte & 0x7f) << shift;
+                if (byte < 0x80) {
+                    break;
+                }
+            }
+            int64_t decoded = static_cast<int64_t>(predicted[k])
+                    + unzigzag(value);
+            if (decoded < 0 || decoded > max_value) {
+                fail("bad attribute stream");
+            }
+            values[v * N + k] = static_cast<int32_t>(decoded);
+        }
+    }
+    return values;
+}
+
+/*
+ * Maps each component of [min, min + extent] onto [0, 2^bits - 1].
+ */
+template<int N>
+struct Quantizer {
+    float min[N];
+    float extent[N];
+    int bits;
+
+    template<class Vector>
+    void fit(const std::vector<Vector>& data) {
+        for (int k = 0; k < N; ++k) {
+            float low = data.empty() ? 0.0f : data[0][k];
+            float high = low;
+            for (auto it = data.begin(); it != data.end(); ++it) {
+                low = std::min(low, (*it)[k]);
+                high = std::max(high, (*it)[k]);
+            }
+            min[k] = low;
+            extent[k] = high - low;
+        }
+    }
+
+    int32_t quantize(float value, int k) const {
+        if (extent[k] <= 0.0f) {
+            return 0;
+        }
+        float steps = static_cast<float>((1 << bits) - 1);
+        float q = std::floor((value - min[k]) / extent[k] * steps + 0.5f);
+        return static_cast<int32_t>(std::max(0.0f, std::min(steps, q)));
+    }
+
+    float dequantize(int32_t value, int k) const {
+        float steps = static_cast<float>((1 << bits) - 1);
+        return min[k] + value * (extent[k] / steps);
+    }
+
+    void write(Writer& writer) const {
+        for (int k = 0; k < N; ++k) {
+            writer.f32(min[k]);
+            writer.f32(extent[k]);
+        }
+    }
+
+    void read(Reader& reader) {
+        for (int k = 0; k < N; ++k) {
+            min[k] = reader.f32();
+            extent[k] = reader.f32();
+        }
+    }
+};
+
+// octahedral mapping of a unit vector onto [-1, 1]^2
+glm::vec2 octEncode(glm::vec3 normal) {
+    float length = std::fabs(normal.x) + std::fabs(normal.y)
+            + std::fabs(normal.z);
+    if (length <= 0.0f) {
+        return glm::vec2(0.0f);
+    }
+    normal /= length;
+    glm::vec2 p(normal.x, normal.y);
+    if (normal.z < 0.0f) {
+        p = glm::vec2((1.0f - std::fabs(normal.y)) * (normal.x >= 0 ? 1 : -1),
+                (1.0f - std::fabs(normal.x)) * (normal.y >= 0 ? 1 : -1));
+    }
+    return p;
+}
+
+glm::vec3 octDecode(const glm::vec2& p) {
+    glm::vec3 normal(p.x, p.y, 1.0f - std::fabs(p.x) - std::fabs(p.y));
+    float t = std::max(-normal.z, 0.0f);
+    normal.x += normal.x >= 0.0f ? -t : t;
+    normal.y += normal.y >= 0.0f ? -t : t;
+    return glm::normalize(normal);
+}
+
+// octahedral coordinates always span [-1, 1]
+Quantizer<2> octQuantizer(int bits) {
+    Quantizer<2> quantizer;
+    quantizer.bits = bits;
+    for (int k = 0; k < 2; ++k) {
+        quantizer.min[k] = -1.0f;
+        quantizer.extent[k] = 2.0f;
+    }
+    return quantizer;
+}
+
+void checkBits(int bits) {
+    if (bits < 1 || bits > 24) {
+        std::string error = "MeshCodec::encode() : bits out of range";
+        throw error;
+    }
+}
+
+struct Job {
+    const std::vector<const void*>* data;
+    const std::vector<size_t>* sizes;
+    std::vector<Mesh*>* results;
+    size_t next;
+    pthread_mutex_t mutex;
+};
+
+void* worker(void* data) {
+    Job* job = static_cast<Job*>(data);
+    for (;;) {
+        pthread_mutex_lock(&job->mutex);
+        size_t index = job->next++;
+        pthread_mutex_unlock(&job->mutex);
+        if (index >= job->data->size()) {
+            return 0;
+        }
+        try {
+            (*job->results)[index] = MeshCodec::decode((*job->data)[index],
+                    (*job->sizes)[index]);
+        } catch (std::string error) {
+            LOGE("%s (mesh %d)", error.c_str(), static_cast<int>(index));
+        }
+    }
+}
+
+}
+
+bool MeshCodec::isEncoded(const void* data, size_t size) {
+    return size >= sizeof(MAGIC) && memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+std::vector<unsigned char> MeshCodec::encode(const Mesh& mesh,
+        int position_bits, int tex_coord_bits, int normal_bits) {
+    checkBits(position_bits);
+    checkBits(tex_coord_bits);
+    checkBits(normal_bits);
+
+    const std::vector<glm::vec3>& vertices = mesh.vertices();
+    const std::vector<unsigned short>& triangles = mesh.triangles();
+    uint32_t vertex_count = vertices.size();
+    size_t index_count = triangles.size() - triangles.size() % 3;
+    bool has_normals = mesh.normals().size() == vertex_count;
+    bool has_tex_coords = mesh.tex_coords().size() == vertex_count;
+    for (size_t i = 0; i < index_count; ++i) {
+        if (triangles[i] >= vertex_count) {
+            std::string error = "MeshCodec::encode() : index out of range";
+            throw error;
+        }
+    }
+
+    // renumber the vertices in order of first use; the unused ones go last
+    const uint32_t unassigned = 0xffffffff;
+    std::vector<uint32_t> remap(vertex_count, unassigned);
+    std::vector<uint32_t> order;
+    order.reserve(vertex_count);
+    std::vector<unsigned short> indices(index_count);
+    std::vector<unsigned char> index_symbols;
+    index_symbols.reserve(index_count);
+    for (size_t i = 0; i < index_count; ++i) {
+        uint32_t& id = remap[triangles[i]];
+        uint32_t high_water = order.size();
+        if (id == unassigned) {
+            id = high_water;
+            order.push_back(triangles[i]);
+        }
+        indices[i] = id;
+        // 0 for a new vertex, the distance back from the newest otherwise
+        appendVarint(index_symbols, high_water - id);
+    }
+    for (uint32_t v = 0; v < vertex_count; ++v) {
+        if (remap[v] == unassigned) {
+            remap[v] = order.size();
+            order.push_back(v);
+        }
+    }
+
+    std::vector<Prediction> predictions = predictVertices(indices.data(),
+            index_count, vertex_count);
+
+    std::vector<unsigned char> data;
+    Writer writer(data);
+    writer.bytes(MAGIC, sizeof(MAGIC));
+    writer.u32(VERSION);
+    writer.u32(vertex_count);
+    writer.u32(index_count);
+    writer.u32((has_normals ? HAS_NORMALS : 0)
+            | (has_tex_coords ? HAS_TEX_COORDS : 0));
+    writer.u8(position_bits);
+    writer.u8(tex_coord_bits);
+    writer.u8(normal_bits);
+    writeStream(writer, index_symbols);
+
+    Quantizer<3> position_quantizer;
+    position_quantizer.bits = position_bits;
+    position_quantizer.fit(vertices);
+    position_quantizer.write(writer);
+    std::vector<int32_t> positions(vertex_count * 3);
+    for (uint32_t v = 0; v < vertex_count; ++v) {
+        for (int k = 0; k < 3; ++k) {
+            positions[v * 3 + k] = position_quantizer.quantize(
+                    vertices[order[v]][k], k);
+        }
+    }
+    writeStream(writer, encodeResiduals<3>(positions, predictions));
+
+    if (has_tex_coords) {
+        Quantizer<2> tex_coord_quantizer;
+        tex_coord_quantizer.bits = tex_coord_bits;
+        tex_coord_quantizer.fit(mesh.tex_coords());
+        tex_coord_quantizer.write(writer);
+        std::vector<int32_t> tex_coords(vertex_count * 2);
+        for (uint32_t v = 0; v < vertex_count; ++v) {
+            for (int k = 0; k < 2; ++k) {
+                tex_coords[v * 2 + k] = tex_coord_quantizer.quantize(
+                        mesh.tex_coords()[order[v]][k], k);
+            }
+        }
+        writeStream(writer, encodeResiduals<2>(tex_coords, predictions));
+    }
+
+    if (has_normals) {
+        Quantizer<2> normal_quantizer = octQuantizer(normal_bits);
+        std::vector<int32_t> normals(vertex_count * 2);
+        for (uint32_t v = 0; v < vertex_count; ++v) {
+            glm::vec2 p = octEncode(mesh.normals()[order[v]]);
+            normals[v * 2] = normal_quantizer.quantize(p.x, 0);
+            normals[v * 2 + 1] = normal_quantizer.quantize(p.y, 1);
+        }
+        writeStream(writer, encodeResiduals<2>(normals, predictions));
+    }
+    return data;
+}
+
+Mesh* MeshCodec::decode(const void* data, size_t size) {
+    const unsigned char* begin = static_cast<const unsigned char*>(data);
+    Reader reader(begin, begin + size);
+    if (!isEncoded(data, size)) {
+        fail("not an encoded mesh");
+    }
+    reader.take(sizeof(MAGIC));
+    if (reader.u32() != VERSION) {
+        fail("unsupported version");
+    }
+    uint32_t vertex_count = reader.u32();
+    uint32_t index_count = reader.u32();
+    uint32_t flags = reader.u32();
+    int position_bits = reader.u8();
+    int tex_coord_bits = reader.u8();
+    int normal_bits = reader.u8();
+    if (vertex_count > 65536 || index_count > MAX_INDEX_COUNT
+            || index_count % 3 != 0 || position_bits < 1
+            || position_bits > 24 || tex_coord_bits < 1
+            || tex_coord_bits > 24 || normal_bits < 1 || normal_bits > 24) {
+        fail("bad header");
+    }
+
+    std::vector<unsigned char> symbols;
+    readStream(reader, symbols,
+            static_cast<size_t>(index_count) * MAX_INDEX_SYMBOLS);
+    std::vector<unsigned short> indices(index_count);
+    const unsigned char* in = symbols.data();
+    const unsigned char* end = in + symbols.size();
+    uint32_t high_water = 0;
+    for (uint32_t i = 0; i < index_count; ++i) {
+        uint32_t distance = 0;
+        for (int shift = 0;; shift += 7) {
+            if (in == end || shift > 28) {
+                fail("bad index stream");
+            }
+            uint32_t byte = *in++;
+            distance |= (byte & 0x7f) << shift;
+            if (byte < 0x80) {
+                break;
+            }
+        }
+        if (distance == 0 ? high_water == vertex_count : distance > high_water) {
+            fail("bad index stream");
+        }
+        indices[i] = distance == 0 ? high_water++ : high_water - distance;
+    }
+
+    std::vector<Prediction> predictions = predictVertices(indices.data(),
+            index_count, vertex_count);
+
+    // decode everything before building the mesh, so a malformed stream
+    // leaves nothing behind
+    Quantizer<3> position_quantizer;
+    position_quantizer.bits = position_bits;
+    position_quantizer.read(reader);
+    readStream(reader, symbols,
+            static_cast<size_t>(vertex_count) * 3 * MAX_RESIDUAL_SYMBOLS);
+    std::vector<int32_t> quantized = decodeResiduals<3>(symbols, predictions,
+            (1 << position_bits) - 1);
+    std::vector<glm::vec3> vertices(vertex_count);
+    for (uint32_t v = 0; v < vertex_count; ++v) {
+        for (int k = 0; k < 3; ++k) {
+            vertices[v][k] = position_quantizer.dequantize(
+                    quantized[v * 3 + k], k);
+        }
+    }
+
+    std::vector<glm::vec2> tex_coords;
+    if (flags & HAS_TEX_COORDS) {
+        Quantizer<2> tex_coord_quantizer;
+        tex_coord_quantizer.bits = tex_coord_bits;
+        tex_coord_quantizer.read(reader);
+        readStream(reader, symbols,
+                static_cast<size_t>(vertex_count) * 2 * MAX_RESIDUAL_SYMBOLS);
+        quantized = decodeResiduals<2>(symbols, predictions,
+                (1 << tex_coord_bits) - 1);
+        tex_coords.resize(vertex_count);
+        for (uint32_t v = 0; v < vertex_count; ++v) {
+            tex_coords[v].x = tex_coord_quantizer.dequantize(
+                    quantized[v * 2], 0);
+            tex_coords[v].y = tex_coord_quantizer.dequantize(
+                    quantized[v * 2 + 1], 1);
+        }
+    }
+
+    std::vector<glm::vec3> normals;
+    if (flags & HAS_NORMALS) {
+        Quantizer<2> normal_quantizer = octQuantizer(normal_bits);
+        readStream(reader, symbols,
+                static_cast<size_t>(vertex_count) * 2 * MAX_RESIDUAL_SYMBOLS);
+        quantized = decodeResiduals<2>(symbols, predictions,
+                (1 << normal_bits) - 1);
+        normals.resize(vertex_count);
+        for (uint32_t v = 0; v < vertex_count; ++v) {
+            normals[v] = octDecode(
+                    glm::vec2(normal_quantizer.dequantize(quantized[v * 2], 0),
+                            normal_quantizer.dequantize(quantized[v * 2 + 1],
+                                    1)));
+        }
+    }
+
+    Mesh* mesh = new Mesh();
+    mesh->set_vertices(std::move(vertices));
+    if (flags & HAS_NORMALS) {
+        mesh->set_normals(std::move(normals));
+    }
+    if (flags & HAS_TEX_COORDS) {
+        mesh->set_tex_coords(std::move(tex_coords));
+    }
+    mesh->set_triangles(std::move(indices));
+    return mesh;
+}
+
+std::vector<Mesh*> MeshCodec::decode(const std::vector<const void*>& data,
+        const std::vector<size_t>& sizes, int thread_count) {
+    std::vector<Mesh*> results(data.size(), static_cast<Mesh*>(0));
+
+    Job job;
+    job.data = &data;
+    job.sizes = &sizes;
+    job.results = &results;
+    job.next = 0;
+    pthread_mutex_init(&job.mutex, 0);
+
+    thread_count = std::max(1,
+            std::min(thread_count, static_cast<int>(data.size())));
+    std::vector<pthread_t> threads;
+    for (int i = 1; i < thread_count; ++i) {
+        pthread_t thread;
+        if (pthread_create(&thread, 0, worker, &job) == 0) {
+            threads.push_back(thread);
+        } else {
+            LOGE("MeshCodec: could not start a worker thread");
+        }
+    }
+    // the calling thread works too
+    worker(&job);
+    for (auto it = threads.begin(); it != threads.end(); ++it) {
+        pthread_join(*it, 0);
+    }
+
+    pthread_mutex_destroy(&job.mutex);
+    return results;
+}
+
+}
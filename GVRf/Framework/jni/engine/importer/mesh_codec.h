@@ -0,0 +1,71 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Compressed mesh format for shipping geometry assets.
+ ***************************************************************************/
+
+#ifndef MESH_CODEC_H_
+#define MESH_CODEC_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace gvr {
+class Mesh;
+
+/*
+ * Positions, texture coordinates and octahedral normals are quantized to a
+ * fixed number of bits, predicted from already decoded vertices
+ * (parallelogram rule across the shared edge where there is one, the
+ * neighbor otherwise) and only the residuals are stored. Vertices are
+ * renumbered in first use order, so each index is coded relative to the
+ * highest one seen so far. Every stream is entropy coded with rANS.
+ *
+ * The codec is lossy in the quantized attributes and in vertex order; the
+ * triangle order and winding are kept.
+ */
+class MeshCodec {
+private:
+    MeshCodec();
+
+public:
+    static const int DEFAULT_POSITION_BITS = 14;
+    static const int DEFAULT_TEX_COORD_BITS = 12;
+    static const int DEFAULT_NORMAL_BITS = 10;
+
+    // true if data starts like an encoded mesh
+    static bool isEncoded(const void* data, size_t size);
+
+    // Bit counts must be between 1 and 24.
+    static std::vector<unsigned char> encode(const Mesh& mesh,
+            int position_bits = DEFAULT_POSITION_BITS,
+            int tex_coord_bits = DEFAULT_TEX_COORD_BITS,
+            int normal_bits = DEFAULT_NORMAL_BITS);
+
+    // Throws a std::string describing the problem if data is malformed.
+    static Mesh* decode(const void* data, size_t size);
+
+    /*
+     * Decode several meshes spread over thread_count threads. A mesh that
+     * fails to decode is logged and returned as 0.
+     */
+    static std::vector<Mesh*> decode(const std::vector<const void*>& data,
+            const std::vector<size_t>& sizes, int thread_count);
+};
+
+}
+#endif
@@ -0,0 +1,87 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "mesh_codec.h"
+
+#include "objects/mesh.h"
+#include "util/gvr_jni.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jbyteArray JNICALL
+Java_org_gearvrf_NativeMeshCodec_encode(JNIEnv * env,
+        jobject obj, jlong jmesh, jint position_bits, jint tex_coord_bits,
+        jint normal_bits);
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeMeshCodec_decode(JNIEnv * env,
+        jobject obj, jobjectArray jdata, jint thread_count);
+}
+
+JNIEXPORT jbyteArray JNICALL
+Java_org_gearvrf_NativeMeshCodec_encode(JNIEnv * env,
+        jobject obj, jlong jmesh, jint position_bits, jint tex_coord_bits,
+        jint normal_bits) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    try {
+        std::vector<unsigned char> data = MeshCodec::encode(*mesh,
+                position_bits, tex_coord_bits, normal_bits);
+        jbyteArray jdata = env->NewByteArray(data.size());
+        env->SetByteArrayRegion(jdata, 0, data.size(),
+                reinterpret_cast<const jbyte*>(data.data()));
+        return jdata;
+    } catch (std::string error) {
+        LOGE("%s", error.c_str());
+        return 0;
+    }
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeMeshCodec_decode(JNIEnv * env,
+        jobject obj, jobjectArray jdata, jint thread_count) {
+    int count = env->GetArrayLength(jdata);
+    std::vector<jbyteArray> arrays(count);
+    std::vector<jbyte*> elements(count);
+    std::vector<const void*> data(count);
+    std::vector<size_t> sizes(count);
+    for (int i = 0; i < count; ++i) {
+        arrays[i] = static_cast<jbyteArray>(env->GetObjectArrayElement(jdata,
+                i));
+        elements[i] = env->GetByteArrayElements(arrays[i], 0);
+        data[i] = elements[i];
+        sizes[i] = env->GetArrayLength(arrays[i]);
+    }
+
+    std::vector<Mesh*> meshes = MeshCodec::decode(data, sizes, thread_count);
+
+    for (int i = 0; i < count; ++i) {
+        env->ReleaseByteArrayElements(arrays[i], elements[i], JNI_ABORT);
+        env->DeleteLocalRef(arrays[i]);
+    }
+
+    std::vector<jlong> pointers(count);
+    for (int i = 0; i < count; ++i) {
+        pointers[i] = reinterpret_cast<jlong>(meshes[i]);
+    }
+    jlongArray jmeshes = env->NewLongArray(count);
+    env->SetLongArrayRegion(jmeshes, 0, count, pointers.data());
+    return jmeshes;
+}
+
+}
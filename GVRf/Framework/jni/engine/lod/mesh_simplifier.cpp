@@ -0,0 +1,757 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Generates levels of detail of a mesh by quadric error edge collapse
+ * (Garland and Heckbert). Collapses are half-edge collapses, the surviving
+ * vertex keeps its position, normal and texture coordinates, so no
+ * attribute is ever interpolated.
+ ***************************************************************************/
+
+#include "mesh_simplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <pthread.h>
+
+#include "glm/glm.hpp"
+
+#include "objects/mesh.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+
+namespace {
+
+// border edges are held in place by planes this much heavier than the
+// surface planes
+const double BORDER_WEIGHT = 100.0;
+
+// a collapse may not turn a triangle by more than ~78 degrees
+const float MIN_NORMAL_COSINE = 0.2f;
+
+// times a triangle is split in four while bounding the error
+const int MAX_ERROR_SPLITS = 4;
+
+// distance from p to the closest point of triangle abc (Ericson, Real-Time
+// Collision Detection, 5.1.5)
+float pointTriangleDistance(const glm::vec3& p, const glm::vec3& a,
+        const glm::vec3& b, const glm::vec3& c) {
+    glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+    float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        return glm::length(ap);
+    }
+    glm::vec3 bp = p - b;
+    float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) {
+        return glm::length(bp);
+    }
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return glm::length(ap - ab * (d1 / (d1 - d3)));
+    }
+    glm::vec3 cp = p - c;
+    float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) {
+        return glm::length(cp);
+    }
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return glm::length(ap - ac * (d2 / (d2 - d6)));
+    }
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+        float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        return glm::length(bp - (c - b) * w);
+    }
+    float denominator = 1.0f / (va + vb + vc);
+    return glm::length(ap - ab * (vb * denominator) - ac * (vc * denominator));
+}
+
+// Sum of squared distances to a set of planes, a symmetric 4x4 matrix
+// stored as its upper triangle.
+struct Quadric {
+    Quadric() {
+        std::fill(a, a + 10, 0.0);
+    }
+
+    Quadric(const glm::vec3& normal, float d, double weight) {
+        double x = normal.x, y = normal.y, z = normal.z, w = d;
+        a[0] = x * x * weight;
+        a[1] = x * y * weight;
+        a[2] = x * z * weight;
+        a[3] = x * w * weight;
+        a[4] = y * y * weight;
+        a[5] = y * z * weight;
+        a[6] = y * w * weight;
+        a[7] = z * z * weight;
+        a[8] = z * w * weight;
+        a[9] = w * w * weight;
+    }
+
+    void add(const Quadric& quadric) {
+        for (int i = 0; i < 10; ++i) {
+            a[i] += quadric.a[i];
+        }
+    }
+
+    double evaluate(const glm::vec3& p) const {
+        double x = p.x, y = p.y, z = p.z;
+        double error = a[0] * x * x + 2.0 * a[1] * x * y + 2.0 * a[2] * x * z
+                + 2.0 * a[3] * x + a[4] * y * y + 2.0 * a[5] * y * z
+                + 2.0 * a[6] * y + a[7] * z * z + 2.0 * a[8] * z + a[9];
+        return error > 0.0 ? error : 0.0;
+    }
+
+    double a[10];
+};
+
+struct Collapse {
+    double cost;
+    int from;
+    int to;
+    unsigned int from_version;
+    unsigned int to_version;
+
+    bool operator<(const Collapse& collapse) const {
+        // std::priority_queue pops the largest, we want the cheapest
+        return cost > collapse.cost;
+    }
+};
+
+class Simplifier {
+public:
+    explicit Simplifier(const Mesh& mesh);
+
+    // collapse edges until at most target_triangles are left or no valid
+    // collapse remains
+    void simplifyTo(size_t target_triangles);
+
+    Mesh* extract() const;
+
+    // bound on the distance between the source and the current level, in
+    // either direction
+    float error();
+
+    size_t triangleCount() const {
+        return live_triangles_;
+    }
+
+private:
+    bool faceHas(int face, int vertex) const {
+        return faces_[face * 3] == vertex || faces_[face * 3 + 1] == vertex
+                || faces_[face * 3 + 2] == vertex;
+    }
+
+    int sharedFaceCount(int u, int v) const;
+    bool canMove(int from, int to) const;
+    void pushCandidate(int a, int b);
+    bool isValid(const Collapse& collapse) const;
+    void collapse(const Collapse& collapse);
+    void neighbors(int vertex, std::vector<int>& result) const;
+    int survivor(int vertex);
+    static float coverBound(const glm::vec3& a, const glm::vec3& b,
+            const glm::vec3& c, const std::vector<glm::vec3>& candidates,
+            float threshold, int depth);
+
+    const Mesh& mesh_;
+    std::vector<glm::vec3> positions_;
+    std::vector<int> faces_;
+    std::vector<bool> face_alive_;
+    std::vector<std::vector<int> > vertex_faces_;
+    std::vector<Quadric> quadrics_;
+    std::vector<bool> locked_;
+    std::vector<bool> border_;
+    std::vector<bool> removed_;
+    std::vector<unsigned int> versions_;
+    // the vertex each removed vertex was collapsed into, -1 for live ones
+    std::vector<int> collapsed_into_;
+    std::priority_queue<Collapse> queue_;
+    size_t live_triangles_;
+};
+
+Simplifier::Simplifier(const Mesh& mesh) :
+        mesh_(mesh), positions_(mesh.vertices()), live_triangles_(0) {
+    const std::vector<unsigned short>& triangles = mesh.triangles();
+    size_t vertex_count = positions_.size();
+    size_t face_count = triangles.size() / 3;
+
+    faces_.assign(triangles.begin(), triangles.begin() + face_count * 3);
+    face_alive_.assign(face_count, true);
+    vertex_faces_.resize(vertex_count);
+    quadrics_.resize(vertex_count);
+    locked_.assign(vertex_count, false);
+    border_.assign(vertex_count, false);
+    removed_.assign(vertex_count, false);
+    versions_.assign(vertex_count, 0);
+    collapsed_into_.assign(vertex_count, -1);
+
+    for (size_t f = 0; f < face_count; ++f) {
+        size_t i0 = faces_[f * 3], i1 = faces_[f * 3 + 1], i2 = faces_[f * 3
+                + 2];
+        if (i0 == i1 || i1 == i2 || i0 == i2 || i0 >= vertex_count
+                || i1 >= vertex_count || i2 >= vertex_count) {
+            face_alive_[f] = false;
+            continue;
+        }
+        vertex_faces_[i0].push_back(f);
+        vertex_faces_[i1].push_back(f);
+        vertex_faces_[i2].push_back(f);
+        ++live_triangles_;
+    }
+
+    // UV seams and hard edges show up as several vertices at the same
+    // position; they are locked so both sides of the seam stay welded
+    std::vector<int> order(vertex_count);
+    for (size_t i = 0; i < vertex_count; ++i) {
+        order[i] = i;
+    }
+    const std::vector<glm::vec3>& positions = positions_;
+    std::sort(order.begin(), order.end(), [&positions](int a, int b) {
+        const glm::vec3& pa = positions[a];
+        const glm::vec3& pb = positions[b];
+        if (pa.x != pb.x) return pa.x < pb.x;
+        if (pa.y != pb.y) return pa.y < pb.y;
+        return pa.z < pb.z;
+    });
+    for (size_t i = 1; i < vertex_count; ++i) {
+        if (positions_[order[i]] == positions_[order[i - 1]]) {
+            locked_[order[i]] = true;
+            locked_[order[i - 1]] = true;
+        }
+    }
+
+    // count the faces around each edge, edges with one face are borders
+    std::unordered_map<unsigned int, int> edge_faces;
+    for (size_t f = 0; f < face_count; ++f) {
+        if (!face_alive_[f]) {
+            continue;
+        }
+        for (int e = 0; e < 3; ++e) {
+            unsigned int a = faces_[f * 3 + e];
+            unsigned int b = faces_[f * 3 + (e + 1) % 3];
+            ++edge_faces[std::min(a, b) << 16 | std::max(a, b)];
+        }
+    }
+
+    for (size_t f = 0; f < face_count; ++f) {
+        if (!face_alive_[f]) {
+            continue;
+        }
+        const glm::vec3& p0 = positions_[faces_[f * 3]];
+        const glm::vec3& p1 = positions_[faces_[f * 3 + 1]];
+        const glm::vec3& p2 = positions_[faces_[f * 3 + 2]];
+        glm::vec3 normal(glm::cross(p1 - p0, p2 - p0));
+        float length = glm::length(normal);
+        if (length == 0.0f) {
+            continue;
+        }
+        normal /= length;
+
+        // planes weighted by triangle area
+        Quadric quadric(normal, -glm::dot(normal, p0), length * 0.5f);
+        for (int e = 0; e < 3; ++e) {
+            quadrics_[faces_[f * 3 + e]].add(quadric);
+        }
+
+        for (int e = 0; e < 3; ++e) {
+            unsigned int a = faces_[f * 3 + e];
+            unsigned int b = faces_[f * 3 + (e + 1) % 3];
+            if (edge_faces[std::min(a, b) << 16 | std::max(a, b)] != 1) {
+                continue;
+            }
+            border_[a] = border_[b] = true;
+
+            // plane through the border edge, perpendicular to the face
+            glm::vec3 edge(positions_[b] - positions_[a]);
+            glm::vec3 border_normal(glm::cross(edge, normal));
+            float border_length = glm::length(border_normal);
+            if (border_length == 0.0f) {
+                continue;
+            }
+            border_normal /= border_length;
+            Quadric border_quadric(border_normal,
+                    -glm::dot(border_normal, positions_[a]),
+                    BORDER_WEIGHT * glm::dot(edge, edge));
+            quadrics_[a].add(border_quadric);
+            quadrics_[b].add(border_quadric);
+        }
+    }
+
+    for (auto it = edge_faces.begin(); it != edge_faces.end(); ++it) {
+        pushCandidate(it->first >> 16, it->first & 0xffff);
+    }
+}
+
+int Simplifier::sharedFaceCount(int u, int v) const {
+    int count = 0;
+    const std::vector<int>& faces = vertex_faces_[u];
+    for (auto it = faces.begin(); it != faces.end(); ++it) {
+        if (face_alive_[*it] && faceHas(*it, v)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+bool Simplifier::canMove(int from, int to) const {
+    if (locked_[from]) {
+        return false;
+    }
+    // border vertices only slide along their own border
+    if (border_[from]) {
+        return border_[to] && sharedFaceCount(from, to) == 1;
+    }
+    return true;
+}
+
+void Simplifier::pushCandidate(int a, int b) {
+    Quadric quadric(quadrics_[a]);
+    quadric.add(quadrics_[b]);
+
+    Collapse collapse;
+    collapse.cost = -1.0;
+    if (canMove(a, b)) {
+        collapse.cost = quadric.evaluate(positions_[b]);
+        collapse.from = a;
+        collapse.to = b;
+    }
+    if (canMove(b, a)) {
+        double cost = quadric.evaluate(positions_[a]);
+        if (collapse.cost < 0.0 || cost < collapse.cost) {
+            collapse.cost = cost;
+            collapse.from = b;
+            collapse.to = a;
+        }
+    }
+    if (collapse.cost < 0.0) {
+        return;
+    }
+    collapse.from_version = versions_[collapse.from];
+    collapse.to_version = versions_[collapse.to];
+    queue_.push(collapse);
+}
+
+void Simplifier::neighbors(int vertex, std::vector<int>& result) const {
+    result.clear();
+    const std::vector<int>& faces = vertex_faces_[vertex];
+    for (auto it = faces.begin(); it != faces.end(); ++it) {
+        if (!face_alive_[*it]) {
+            continue;
+        }
+        for (int e = 0; e < 3; ++e) {
+            int other = faces_[*it * 3 + e];
+            if (other != vertex
+                    && std::find(result.begin(), result.end(), other)
+                            == result.end()) {
+                result.push_back(other);
+            }
+        }
+    }
+}
+
+bool Simplifier::isValid(const Collapse& collapse) const {
+    int u = collapse.from;
+    int v = collapse.to;
+
+    // link condition: u and v may only share the vertices opposite to
+    // their common edge, otherwise the collapse pinches the surface
+    std::vector<int> u_neighbors, v_neighbors;
+    neighbors(u, u_neighbors);
+    neighbors(v, v_neighbors);
+    int shared_vertices = 0;
+    for (auto it = u_neighbors.begin(); it != u_neighbors.end(); ++it) {
+        if (std::find(v_neighbors.begin(), v_neighbors.end(), *it)
+                != v_neighbors.end()) {
+            ++shared_vertices;
+        }
+    }
+    if (shared_vertices > sharedFaceCount(u, v)) {
+        return false;
+    }
+
+    // no triangle may fold over or degenerate
+    const std::vector<int>& faces = vertex_faces_[u];
+    for (auto it = faces.begin(); it != faces.end(); ++it) {
+        if (!face_alive_[*it] || faceHas(*it, v)) {
+            continue;
+        }
+        glm::vec3 p[3], q[3];
+        for (int e = 0; e < 3; ++e) {
+            int index = faces_[*it * 3 + e];
+            p[e] = positions_[index];
+            q[e] = index == u ? positions_[v] : p[e];
+        }
+        glm::vec3 before(glm::cross(p[1] - p[0], p[2] - p[0]));
+        glm::vec3 after(glm::cross(q[1] - q[0], q[2] - q[0]));
+        float before_length = glm::length(before);
+        float after_length = glm::length(after);
+        if (after_length == 0.0f
+                || glm::dot(before, after)
+                        < MIN_NORMAL_COSINE * before_length * after_length) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Simplifier::collapse(const Collapse& collapse) {
+    int u = collapse.from;
+    int v = collapse.to;
+
+    std::vector<int>& faces = vertex_faces_[u];
+    for (auto it = faces.begin(); it != faces.end(); ++it) {
+        if (!face_alive_[*it]) {
+            continue;
+        }
+        if (faceHas(*it, v)) {
+            face_alive_[*it] = false;
+            --live_triangles_;
+            continue;
+        }
+        for (int e = 0; e < 3; ++e) {
+            if (faces_[*it * 3 + e] == u) {
+                faces_[*it * 3 + e] = v;
+            }
+        }
+        vertex_faces_[v].push_back(*it);
+    }
+    faces.clear();
+
+    std::vector<int>& v_faces = vertex_faces_[v];
+    std::vector<bool>& face_alive = face_alive_;
+    v_faces.erase(std::remove_if(v_faces.begin(), v_faces.end(),
+            [&face_alive](int face) {return !face_alive[face];}),
+            v_faces.end());
+
+    quadrics_[v].add(quadrics_[u]);
+    removed_[u] = true;
+    collapsed_into_[u] = v;
+    ++versions_[u];
+    ++versions_[v];
+
+    std::vector<int> v_neighbors;
+    neighbors(v, v_neighbors);
+    for (auto it = v_neighbors.begin(); it != v_neighbors.end(); ++it) {
+        pushCandidate(*it, v);
+    }
+}
+
+void Simplifier::simplifyTo(size_t target_triangles) {
+    while (live_triangles_ > target_triangles && !queue_.empty()) {
+        Collapse collapse = queue_.top();
+        queue_.pop();
+        if (removed_[collapse.from] || removed_[collapse.to]
+                || versions_[collapse.from] != collapse.from_version
+                || versions_[collapse.to] != collapse.to_version) {
+            continue;
+        }
+        if (!isValid(collapse)) {
+            continue;
+        }
+        this->collapse(collapse);
+    }
+}
+
+int Simplifier::survivor(int vertex) {
+    int root = vertex;
+    while (collapsed_into_[root] >= 0) {
+        root = collapsed_into_[root];
+    }
+    // shorten the chains for the next levels
+    while (collapsed_into_[vertex] >= 0) {
+        int next = collapsed_into_[vertex];
+        collapsed_into_[vertex] = root;
+        vertex = next;
+    }
+    return root;
+}
+
+/*
+ * Bound on how far points of triangle abc lie from the closest of the
+ * candidate triangles (stored as corner triples), or a value no larger than
+ * threshold. The distance to a triangle is convex, so over abc it peaks at a
+ * corner; where no single candidate covers abc, its quarters are bounded
+ * separately.
+ */
+float Simplifier::coverBound(const glm::vec3& a, const glm::vec3& b,
+        const glm::vec3& c, const std::vector<glm::vec3>& candidates,
+        float threshold, int depth) {
+    float bound = std::numeric_limits<float>::max();
+    for (size_t i = 0; i + 2 < candidates.size() && bound > threshold; i +=
+            3) {
+        const glm::vec3& p = candidates[i];
+        const glm::vec3& q = candidates[i + 1];
+        const glm::vec3& r = candidates[i + 2];
+        float distance = pointTriangleDistance(a, p, q, r);
+        distance = std::max(distance, pointTriangleDistance(b, p, q, r));
+        distance = std::max(distance, pointTriangleDistance(c, p, q, r));
+        bound = std::min(bound, distance);
+    }
+    if (bound <= threshold || depth == 0) {
+        return bound;
+    }
+
+    glm::vec3 ab((a + b) * 0.5f), bc((b + c) * 0.5f), ca((c + a) * 0.5f);
+    float split = coverBound(a, ab, ca, candidates, threshold, depth - 1);
+    threshold = std::max(threshold, split);
+    split = std::max(split,
+            coverBound(ab, b, bc, candidates, threshold, depth - 1));
+    threshold = std::max(threshold, split);
+    split = std::max(split,
+            coverBound(ca, bc, c, candidates, threshold, depth - 1));
+    threshold = std::max(threshold, split);
+    split = std::max(split,
+            coverBound(ab, bc, ca, candidates, threshold, depth - 1));
+    return std::min(bound, split);
+}
+
+/*
+ * A source triangle is compared with the live triangles within two rings of
+ * the survivors of its corners, a live triangle with the source triangles
+ * whose corners collapsed into its own. Where the candidates miss the
+ * closest surface the bound is just looser.
+ */
+float Simplifier::error() {
+    const std::vector<unsigned short>& triangles = mesh_.triangles();
+    size_t vertex_count = positions_.size();
+
+    // source triangles by the survivors of their corners
+    std::vector<std::vector<int> > collapsed_faces(vertex_count);
+    for (size_t f = 0; f < face_alive_.size(); ++f) {
+        size_t i0 = triangles[f * 3], i1 = triangles[f * 3 + 1], i2 =
+                triangles[f * 3 + 2];
+        if (i0 == i1 || i1 == i2 || i0 == i2 || i0 >= vertex_count
+                || i1 >= vertex_count || i2 >= vertex_count) {
+            continue;
+        }
+        int s0 = survivor(i0), s1 = survivor(i1), s2 = survivor(i2);
+        collapsed_faces[s0].push_back(f);
+        if (s1 != s0) {
+            collapsed_faces[s1].push_back(f);
+        }
+        if (s2 != s0 && s2 != s1) {
+            collapsed_faces[s2].push_back(f);
+        }
+    }
+
+    float max_error = 0.0f;
+    std::vector<glm::vec3> candidates;
+    // marks the live faces already taken for the current source triangle
+    std::vector<size_t> taken(face_alive_.size(), face_alive_.size());
+    for (size_t f = 0; f < face_alive_.size(); ++f) {
+        // source triangles recorded above
+        size_t corners[3] = { triangles[f * 3], triangles[f * 3 + 1],
+                triangles[f * 3 + 2] };
+        if (corners[0] == corners[1] || corners[1] == corners[2]
+                || corners[0] == corners[2] || corners[0] >= vertex_count
+                || corners[1] >= vertex_count || corners[2] >= vertex_count) {
+            continue;
+        }
+        candidates.clear();
+        for (int e = 0; e < 3; ++e) {
+            const std::vector<int>& faces = vertex_faces_[survivor(
+                    corners[e])];
+            for (auto it = faces.begin(); it != faces.end(); ++it) {
+                if (!face_alive_[*it]) {
+                    continue;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const std::vector<int>& ring = vertex_faces_[faces_[*it
+                            * 3 + k]];
+                    for (auto ring_it = ring.begin(); ring_it != ring.end();
+                            ++ring_it) {
+                        if (!face_alive_[*ring_it] || taken[*ring_it] == f) {
+                            continue;
+                        }
+                        taken[*ring_it] = f;
+                        candidates.push_back(positions_[faces_[*ring_it * 3]]);
+                        candidates.push_back(
+                                positions_[faces_[*ring_it * 3 + 1]]);
+                        candidates.push_back(
+                                positions_[faces_[*ring_it * 3 + 2]]);
+                    }
+                }
+            }
+        }
+        const glm::vec3& a = positions_[corners[0]];
+        const glm::vec3& b = positions_[corners[1]];
+        const glm::vec3& c = positions_[corners[2]];
+        if (candidates.empty()) {
+            // nothing left around it, fall back to how far it moved
+            for (int e = 0; e < 3; ++e) {
+                max_error = std::max(max_error,
+                        glm::distance(positions_[corners[e]],
+                                positions_[survivor(corners[e])]));
+            }
+            continue;
+        }
+        max_error = std::max(max_error,
+                coverBound(a, b, c, candidates, max_error, MAX_ERROR_SPLITS));
+    }
+
+    for (size_t f = 0; f < face_alive_.size(); ++f) {
+        if (!face_alive_[f]) {
+            continue;
+        }
+        candidates.clear();
+        for (int e = 0; e < 3; ++e) {
+            const std::vector<int>& faces = collapsed_faces[faces_[f * 3 + e]];
+            for (auto it = faces.begin(); it != faces.end(); ++it) {
+                candidates.push_back(positions_[triangles[*it * 3]]);
+                candidates.push_back(positions_[triangles[*it * 3 + 1]]);
+                candidates.push_back(positions_[triangles[*it * 3 + 2]]);
+            }
+        }
+        max_error = std::max(max_error,
+                coverBound(positions_[faces_[f * 3]],
+                        positions_[faces_[f * 3 + 1]],
+                        positions_[faces_[f * 3 + 2]], candidates, max_error,
+                        MAX_ERROR_SPLITS));
+    }
+    return max_error;
+}
+
+Mesh* Simplifier::extract() const {
+    const std::vector<glm::vec3>& normals = mesh_.normals();
+    const std::vector<glm::vec2>& tex_coords = mesh_.tex_coords();
+    bool has_normals = normals.size() == positions_.size();
+    bool has_tex_coords = tex_coords.size() == positions_.size();
+
+    std::vector<int> remap(positions_.size(), -1);
+    std::vector<glm::vec3> new_vertices;
+    std::vector<glm::vec3> new_normals;
+    std::vector<glm::vec2> new_tex_coords;
+    std::vector<unsigned short> new_triangles;
+    new_triangles.reserve(live_triangles_ * 3);
+
+    for (size_t f = 0; f < face_alive_.size(); ++f) {
+        if (!face_alive_[f]) {
+            continue;
+        }
+        for (int e = 0; e < 3; ++e) {
+            int index = faces_[f * 3 + e];
+            if (remap[index] < 0) {
+                remap[index] = new_vertices.size();
+                new_vertices.push_back(positions_[index]);
+                if (has_normals) {
+                    new_normals.push_back(normals[index]);
+                }
+                if (has_tex_coords) {
+                    new_tex_coords.push_back(tex_coords[index]);
+                }
+            }
+            new_triangles.push_back(remap[index]);
+        }
+    }
+
+    Mesh* mesh = new Mesh();
+    mesh->set_vertices(std::move(new_vertices));
+    mesh->set_normals(std::move(new_normals));
+    mesh->set_tex_coords(std::move(new_tex_coords));
+    mesh->set_triangles(std::move(new_triangles));
+    return mesh;
+}
+
+struct Job {
+    const std::vector<const Mesh*>* meshes;
+    const std::vector<float>* triangle_ratios;
+    std::vector<std::vector<LodLevel> >* results;
+    size_t next;
+    pthread_mutex_t mutex;
+};
+
+void* worker(void* data) {
+    Job* job = static_cast<Job*>(data);
+    for (;;) {
+        pthread_mutex_lock(&job->mutex);
+        size_t index = job->next++;
+        pthread_mutex_unlock(&job->mutex);
+        if (index >= job->meshes->size()) {
+            return 0;
+        }
+        (*job->results)[index] = MeshSimplifier::generateLods(
+                *(*job->meshes)[index], *job->triangle_ratios);
+    }
+}
+
+}
+
+std::vector<LodLevel> MeshSimplifier::generateLods(const Mesh& mesh,
+        const std::vector<float>& triangle_ratios) {
+    std::vector<LodLevel> levels(triangle_ratios.size());
+
+    // one progressive pass: produce the levels from finest to coarsest
+    std::vector<int> order(triangle_ratios.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&triangle_ratios](int a, int b) {
+        return triangle_ratios[a] > triangle_ratios[b];
+    });
+
+    Simplifier simplifier(mesh);
+    size_t source_triangles = simplifier.triangleCount();
+    // coarser levels never report less error than finer ones
+    float error = 0.0f;
+    for (auto it = order.begin(); it != order.end(); ++it) {
+        float ratio = std::max(0.0f, std::min(1.0f, triangle_ratios[*it]));
+        simplifier.simplifyTo(static_cast<size_t>(source_triangles * ratio));
+        error = std::max(error, simplifier.error());
+        levels[*it].mesh = simplifier.extract();
+        levels[*it].geometric_error = error;
+    }
+    return levels;
+}
+
+std::vector<std::vector<LodLevel> > MeshSimplifier::generateLods(
+        const std::vector<const Mesh*>& meshes,
+        const std::vector<float>& triangle_ratios, int thread_count) {
+    std::vector<std::vector<LodLevel> > results(meshes.size());
+
+    Job job;
+    job.meshes = &meshes;
+    job.triangle_ratios = &triangle_ratios;
+    job.results = &results;
+    job.next = 0;
+    pthread_mutex_init(&job.mutex, 0);
+
+    thread_count = std::max(1,
+            std::min(thread_count, static_cast<int>(meshes.size())));
+    std::vector<pthread_t> threads;
+    for (int i = 1; i < thread_count; ++i) {
+        pthread_t thread;
+        if (pthread_create(&thread, 0, worker, &job) == 0) {
+            threads.push_back(thread);
+        } else {
+            LOGE("MeshSimplifier: could not start a worker thread");
+        }
+    }
+    // the calling thread works too
+    worker(&job);
+    for (auto it = threads.begin(); it != threads.end(); ++it) {
+        pthread_join(*it, 0);
+    }
+
+    pthread_mutex_destroy(&job.mutex);
+    return results;
+}
+
+}
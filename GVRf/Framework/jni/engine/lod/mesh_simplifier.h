@@ -0,0 +1,62 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Generates levels of detail of a mesh by quadric error edge collapse.
+ ***************************************************************************/
+
+#ifndef MESH_SIMPLIFIER_H_
+#define MESH_SIMPLIFIER_H_
+
+#include <vector>
+
+namespace gvr {
+class Mesh;
+
+struct LodLevel {
+    LodLevel() :
+            mesh(0), geometric_error(0.0f) {
+    }
+
+    Mesh* mesh;
+    // bound on how far, in mesh units, any point of the level lies from
+    // the source surface and the other way round
+    float geometric_error;
+};
+
+class MeshSimplifier {
+private:
+    MeshSimplifier();
+
+public:
+    /*
+     * Simplify mesh down to each of triangle_ratios (fractions of the source
+     * triangle count, e.g. 0.5, 0.25, 0.125). The levels are produced by one
+     * progressive pass, so their errors grow with the reduction. Open borders
+     * and UV seams (vertices split at the same position) never move.
+     * The caller owns the returned meshes.
+     */
+    static std::vector<LodLevel> generateLods(const Mesh& mesh,
+            const std::vector<float>& triangle_ratios);
+
+    // Same for several meshes at once, spread over thread_count threads.
+    static std::vector<std::vector<LodLevel> > generateLods(
+            const std::vector<const Mesh*>& meshes,
+            const std::vector<float>& triangle_ratios, int thread_count);
+};
+
+}
+#endif
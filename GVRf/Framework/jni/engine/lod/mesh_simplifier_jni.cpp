@@ -0,0 +1,73 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "mesh_simplifier.h"
+
+#include "objects/mesh.h"
+#include "util/gvr_jni.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeMeshSimplifier_generateLods(JNIEnv * env,
+        jobject obj, jlongArray jmeshes, jfloatArray jtriangle_ratios,
+        jint thread_count, jfloatArray jerrors);
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeMeshSimplifier_generateLods(JNIEnv * env,
+        jobject obj, jlongArray jmeshes, jfloatArray jtriangle_ratios,
+        jint thread_count, jfloatArray jerrors) {
+    int mesh_count = env->GetArrayLength(jmeshes);
+    int ratio_count = env->GetArrayLength(jtriangle_ratios);
+
+    std::vector<const Mesh*> meshes(mesh_count);
+    jlong* mesh_pointers = env->GetLongArrayElements(jmeshes, 0);
+    for (int i = 0; i < mesh_count; ++i) {
+        meshes[i] = reinterpret_cast<Mesh*>(mesh_pointers[i]);
+    }
+    env->ReleaseLongArrayElements(jmeshes, mesh_pointers, JNI_ABORT);
+
+    std::vector<float> triangle_ratios(ratio_count);
+    env->GetFloatArrayRegion(jtriangle_ratios, 0, ratio_count,
+            triangle_ratios.data());
+
+    std::vector<std::vector<LodLevel> > levels = MeshSimplifier::generateLods(
+            meshes, triangle_ratios, thread_count);
+
+    // flattened mesh major: level j of mesh i is at i * ratio_count + j
+    std::vector<jlong> lod_meshes(mesh_count * ratio_count);
+    std::vector<jfloat> errors(mesh_count * ratio_count);
+    for (int i = 0; i < mesh_count; ++i) {
+        for (int j = 0; j < ratio_count; ++j) {
+            lod_meshes[i * ratio_count + j] = reinterpret_cast<jlong>(
+                    levels[i][j].mesh);
+            errors[i * ratio_count + j] = levels[i][j].geometric_error;
+        }
+    }
+    env->SetFloatArrayRegion(jerrors, 0, errors.size(), errors.data());
+
+    jlongArray jlod_meshes = env->NewLongArray(lod_meshes.size());
+    env->SetLongArrayRegion(jlod_meshes, 0, lod_meshes.size(),
+            lod_meshes.data());
+    return jlod_meshes;
+}
+
+}
@@ -13,118 +13,184 @@
  * limitations under the License.
  */
 
-//#include "util/gvr_log.h"
 #include "gl_delete.h"
 
+#include "engine/memory/gl_name_pool.h"
+#include "util/gvr_gl.h"
+
 namespace gvr {
 
 GlDelete gl_delete;
 
-void GlDelete::queueBuffer(GLuint buffer) {
-    lock();
-    buffers_.push_back(buffer);
-//    LOGD("queueBuffer(%d) buffers_.size() = %d", buffer, buffers_.size());
-    dirty = true;
-    unlock();
-}
+const int GlDelete::UNLIMITED;
 
-void GlDelete::queueFrameBuffer(GLuint buffer) {
-    lock();
-    frame_buffers_.push_back(buffer);
-//    LOGD("queueFrameBuffer(%d) frame_buffers_.size() = %d", buffer,
-//            frame_buffers_.size());
-    dirty = true;
-    unlock();
+GlDelete::Queue::~Queue() {
+    std::vector<Entry> entries;
+    takeAll(entries);
 }
 
-void GlDelete::queueProgram(GLuint program) {
-    lock();
-    programs_.push_back(program);
-//    LOGD("queueProgram(%d) programs_.size() = %d", program, programs_.size());
-    dirty = true;
-    unlock();
+void GlDelete::Queue::push(GLuint name, GLenum detail, GLsizeiptr size) {
+    Node* node = new Node;
+    node->entry.name = name;
+    node->entry.detail = detail;
+    node->entry.size = size;
+    node->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(node->next, node,
+            std::memory_order_release, std::memory_order_relaxed)) {
+    }
 }
 
-void GlDelete::queueRenderBuffer(GLuint buffer) {
-    lock();
-    render_buffers_.push_back(buffer);
-//    LOGD("queueRenderBuffer(%d) render_buffers_.size() = %d", buffer,
-//            render_buffers_.size());
-    dirty = true;
-    unlock();
+void GlDelete::Queue::takeAll(std::vector<Entry>& entries) {
+    /*
+     * A plain load first, so an empty queue costs no atomic write each
+     * frame. Taking the whole list at once leaves nothing for a producer to
+     * race with, so there is no ABA problem.
+     */
+    if (head_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    Node* node = head_.exchange(0, std::memory_order_acquire);
+    while (node != 0) {
+        entries.push_back(node->entry);
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
 }
 
-void GlDelete::queueShader(GLuint shader) {
-    lock();
-    shaders_.push_back(shader);
-//    LOGD("queueShader(%d) shaders_.size() = %d", shader, shaders_.size());
-    dirty = true;
-    unlock();
+GlDelete::~GlDelete() {
+    // the context is gone by now, only the memory is freed
+    for (auto it = pending_.begin(); it != pending_.end(); ++it) {
+        delete *it;
+    }
 }
 
-void GlDelete::queueTexture(GLuint texture) {
-    lock();
-    textures_.push_back(texture);
-//    LOGD("queueTexture(%d) textures_.size() = %d", texture, textures_.size());
-    dirty = true;
-    unlock();
-}
+void GlDelete::release(Kind kind, const Entry* entries, int count) {
+    std::vector<GLuint> doomed;
+    for (int index = 0; index < count; ++index) {
+        const Entry& entry = entries[index];
+        bool recycled = false;
+        switch (kind) {
+        case BUFFER:
+            recycled = gl_name_pool.recycleBuffer(entry.name, entry.detail,
+                    entry.size);
+            break;
+        case FRAME_BUFFER:
+            recycled = gl_name_pool.recycleFramebuffer(entry.name);
+            break;
+        case TEXTURE:
+            recycled = gl_name_pool.recycleTexture(entry.name, entry.detail);
+            break;
+        case VERTEX_ARRAY:
+            recycled = gl_name_pool.recycleVertexArray(entry.name);
+            break;
+        default:
+            break;
+        }
+        if (!recycled) {
+            doomed.push_back(entry.name);
+        }
+    }
+    if (doomed.empty()) {
+        return;
+    }
 
-void GlDelete::queueVertexArray(GLuint vertex_array) {
-    lock();
-    vertex_arrays_.push_back(vertex_array);
-//    LOGD("queueVertexArray(%d) vertex_arrays_.size() = %d", vertex_array,
-//            vertex_arrays_.size());
-    dirty = true;
-    unlock();
+    const GLuint* names = doomed.data();
+    count = doomed.size();
+    switch (kind) {
+    case BUFFER:
+        glDeleteBuffers(count, names);
+        break;
+    case FRAME_BUFFER:
+        glDeleteFramebuffers(count, names);
+        break;
+    case PROGRAM:
+        for (int index = 0; index < count; ++index) {
+            glDeleteProgram(names[index]);
+        }
+        break;
+    case RENDER_BUFFER:
+        glDeleteRenderbuffers(count, names);
+        break;
+    case SHADER:
+        for (int index = 0; index < count; ++index) {
+            glDeleteShader(names[index]);
+        }
+        break;
+    case TEXTURE:
+        glDeleteTextures(count, names);
+        break;
+    case VERTEX_ARRAY:
+        glDeleteVertexArrays(count, names);
+        break;
+    default:
+        break;
+    }
 }
 
 void GlDelete::processQueues() {
-    /*
-     * Do an unsynchronized check of the dirty flag, so that we don't have to
-     * call lock() on each and every frame. The consequences of 'just missing'
-     * a queue op and leaving a handle on a queue for an extra frame are quite
-     * minimal, but locking every frame is not free.
-     */
-    if (dirty) {
-        lock();
-//    LOGD("GlDelete::processQueues()");
-        if (buffers_.size() > 0) {
-            glDeleteBuffers(buffers_.size(), buffers_.data());
-            buffers_.clear();
+    Batch* batch = 0;
+    for (int kind = 0; kind < KIND_COUNT; ++kind) {
+        std::vector<Entry> entries;
+        queues_[kind].takeAll(entries);
+        if (entries.empty()) {
+            continue;
         }
-        if (frame_buffers_.size() > 0) {
-            glDeleteFramebuffers(frame_buffers_.size(), frame_buffers_.data());
-            frame_buffers_.clear();
+        if (batch == 0) {
+            batch = new Batch();
+            batch->fence = 0;
         }
-        if (programs_.size() > 0) {
-            for (int index = 0, size = programs_.size(); index < size;
-                    ++index) {
-                glDeleteProgram(programs_[index]);
+        batch->entries[kind].swap(entries);
+    }
+    if (batch != 0) {
+#if _GVRF_USE_GLES3_
+        // the names may still be used by the frame in flight
+        batch->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+        pending_.push_back(batch);
+    }
+
+    int budget = budget_;
+    int left = budget != UNLIMITED ? budget : -1;
+    while (!pending_.empty() && left != 0) {
+        batch = pending_.front();
+#if _GVRF_USE_GLES3_
+        if (batch->fence != 0) {
+            GLenum status = glClientWaitSync(batch->fence, 0, 0);
+            if (status == GL_TIMEOUT_EXPIRED) {
+                // later batches were fenced later still
+                break;
             }
-            programs_.clear();
+            glDeleteSync(batch->fence);
+            batch->fence = 0;
         }
-        if (render_buffers_.size() > 0) {
-            glDeleteRenderbuffers(render_buffers_.size(),
-                    render_buffers_.data());
-            render_buffers_.clear();
-        }
-        if (shaders_.size() > 0) {
-            for (int index = 0, size = shaders_.size(); index < size; ++index) {
-                glDeleteShader(shaders_[index]);
+#endif
+        for (int kind = 0; kind < KIND_COUNT && left != 0; ++kind) {
+            std::vector<Entry>& entries = batch->entries[kind];
+            if (entries.empty()) {
+                continue;
+            }
+            int count = entries.size();
+            if (left > 0 && count > left) {
+                count = left;
+            }
+            // from the back, the names queued first
+            release(static_cast<Kind>(kind),
+                    &entries[entries.size() - count], count);
+            entries.resize(entries.size() - count);
+            if (left > 0) {
+                left -= count;
             }
-            shaders_.clear();
         }
-        if (textures_.size() > 0) {
-            glDeleteTextures(textures_.size(), textures_.data());
-            textures_.clear();
+        bool empty = true;
+        for (int kind = 0; kind < KIND_COUNT; ++kind) {
+            empty = empty && batch->entries[kind].empty();
         }
-        if (vertex_arrays_.size() > 0) {
-            glDeleteVertexArrays(vertex_arrays_.size(), vertex_arrays_.data());
-            vertex_arrays_.clear();
+        if (!empty) {
+            break;
         }
-        dirty = false;
-        unlock();
+        pending_.pop_front();
+        delete batch;
     }
 }
 
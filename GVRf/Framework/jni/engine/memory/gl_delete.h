@@ -16,51 +16,131 @@
 #ifndef GL_DELETE_H_
 #define GL_DELETE_H_
 
+#include <atomic>
+#include <deque>
 #include <vector>
-#include <pthread.h>
 #include "GLES3/gl3.h"
 
 namespace gvr {
+
+/*
+ * Names are queued from any thread, typically the finalizer's, without a
+ * lock: each kind has a lock-free stack that processQueues() empties in one
+ * exchange. The names taken in a frame are released once a fence placed
+ * after that frame's commands has signaled, at most budget() of them per
+ * call, so tearing down a big scene is spread over several frames.
+ * Released names go to GlNamePool first, and are deleted if it has no use
+ * for them.
+ */
 class GlDelete {
 
 public:
-    GlDelete() {
-        pthread_mutex_init(&mutex, 0);
+    // no budget, whatever is due is deleted at once
+    static const int UNLIMITED = 0;
+
+    GlDelete() :
+            pending_(), budget_(UNLIMITED) {
     }
 
-    ~GlDelete() {
-        pthread_mutex_destroy(&mutex);
+    ~GlDelete();
+
+    // with its usage and store size, GlNamePool can reuse the buffer
+    void queueBuffer(GLuint buffer, GLenum usage = 0, GLsizeiptr capacity =
+            0) {
+        queues_[BUFFER].push(buffer, usage, capacity);
+    }
+    void queueFrameBuffer(GLuint buffer) {
+        queues_[FRAME_BUFFER].push(buffer);
+    }
+    void queueProgram(GLuint program) {
+        queues_[PROGRAM].push(program);
+    }
+    void queueRenderBuffer(GLuint buffer) {
+        queues_[RENDER_BUFFER].push(buffer);
+    }
+    void queueShader(GLuint shader) {
+        queues_[SHADER].push(shader);
+    }
+    void queueTexture(GLuint texture, GLenum target = 0) {
+        queues_[TEXTURE].push(texture, target);
+    }
+    void queueVertexArray(GLuint vertex_array) {
+        queues_[VERTEX_ARRAY].push(vertex_array);
     }
 
-    void queueBuffer(GLuint buffer);
-    void queueFrameBuffer(GLuint buffer);
-    void queueProgram(GLuint program);
-    void queueRenderBuffer(GLuint buffer);
-    void queueShader(GLuint shader);
-    void queueTexture(GLuint texture);
-    void queueVertexArray(GLuint vertex_array);
+    // names deleted per processQueues(), any thread
+    void setBudget(int budget) {
+        budget_ = budget;
+    }
+
+    int budget() const {
+        return budget_;
+    }
 
+    // once per frame, on the GL thread
     void processQueues();
 
 private:
+    enum Kind {
+        BUFFER,
+        FRAME_BUFFER,
+        PROGRAM,
+        RENDER_BUFFER,
+        SHADER,
+        TEXTURE,
+        VERTEX_ARRAY,
+        KIND_COUNT
+    };
 
-    pthread_mutex_t mutex;
-    bool dirty = false;
+    struct Entry {
+        GLuint name;
+        // a buffer's usage or a texture's target
+        GLenum detail;
+        GLsizeiptr size;
+    };
 
-    void lock() {
-        pthread_mutex_lock(&mutex);
-    }
-    void unlock() {
-        pthread_mutex_unlock(&mutex);
-    }
+    // multi-producer, single-consumer
+    class Queue {
+    public:
+        Queue() :
+                head_(0) {
+        }
+
+        ~Queue();
+
+        void push(GLuint name, GLenum detail = 0, GLsizeiptr size = 0);
+
+        // everything pushed so far, most recent first
+        void takeAll(std::vector<Entry>& entries);
+
+    private:
+        struct Node {
+            Entry entry;
+            Node* next;
+        };
 
-    std::vector<GLuint> buffers_;
-    std::vector<GLuint> frame_buffers_;
-    std::vector<GLuint> programs_;
-    std::vector<GLuint> render_buffers_;
-    std::vector<GLuint> shaders_;
-    std::vector<GLuint> textures_;
-    std::vector<GLuint> vertex_arrays_;
+        std::atomic<Node*> head_;
+    };
+
+    // names taken in one frame, and the fence after that frame
+    struct Batch {
+        GLsync fence;
+        std::vector<Entry> entries[KIND_COUNT];
+    };
+
+    // to GlNamePool, or deleted
+    static void release(Kind kind, const Entry* entries, int count);
+
+private:
+    GlDelete(const GlDelete& gl_delete);
+    GlDelete(GlDelete&& gl_delete);
+    GlDelete& operator=(const GlDelete& gl_delete);
+    GlDelete& operator=(GlDelete&& gl_delete);
+
+private:
+    Queue queues_[KIND_COUNT];
+    std::deque<Batch*> pending_;
+    std::atomic<int> budget_;
 };
 
 extern GlDelete gl_delete;
@@ -21,6 +21,11 @@ namespace gvr {
 extern "C" {
 JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeGLDelete_processQueues(JNIEnv * env, jobject obj);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeGLDelete_setBudget(JNIEnv * env, jobject obj,
+        jint budget);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeGLDelete_getBudget(JNIEnv * env, jobject obj);
 }
 
 JNIEXPORT void JNICALL
@@ -28,5 +33,16 @@ Java_org_gearvrf_NativeGLDelete_processQueues(JNIEnv * env, jobject obj) {
     gl_delete.processQueues();
 }
 
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeGLDelete_setBudget(JNIEnv * env, jobject obj,
+        jint budget) {
+    gl_delete.setBudget(budget > 0 ? budget : GlDelete::UNLIMITED);
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeGLDelete_getBudget(JNIEnv * env, jobject obj) {
+    return gl_delete.budget();
+}
+
 
 }
@@ -0,0 +1,307 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Recycles the names of deleted GL objects.
+ ***************************************************************************/
+
+#include "gl_name_pool.h"
+
+#include <string.h>
+
+#include "util/gvr_gl.h"
+
+namespace gvr {
+
+GlNamePool gl_name_pool;
+
+const int GlNamePool::MAX_BUCKET_BUFFERS;
+const GLsizeiptr GlNamePool::MAX_POOLED_BYTES;
+const int GlNamePool::MAX_VERTEX_ARRAYS;
+const int GlNamePool::MAX_FRAME_BUFFERS;
+const int GlNamePool::MAX_TEXTURES;
+const int GlNamePool::MAX_TEXTURE_LEVELS;
+
+// lower bound of size class c
+static GLsizeiptr classSize(int c) {
+    if (c < 3) {
+        return c + 1;
+    }
+    int octave = (c - 3) / 4;
+    int step = (c - 3) % 4;
+    return static_cast<GLsizeiptr>(4 + step) << octave;
+}
+
+GlNamePool::GlNamePool() :
+        buffers_(), pooled_bytes_(0), vertex_arrays_(), frame_buffers_(), textures_(), max_vertex_attribs_(
+                0) {
+    pthread_mutex_init(&mutex_, 0);
+    memset(&stats_, 0, sizeof(stats_));
+}
+
+GlNamePool::~GlNamePool() {
+    pthread_mutex_destroy(&mutex_);
+}
+
+int GlNamePool::floorClass(GLsizeiptr size) {
+    if (size < 4) {
+        return size - 1;
+    }
+    int octave = 0;
+    while ((size >> octave) >= 8) {
+        ++octave;
+    }
+    // size >> octave is in [4, 8): the octave's four steps
+    return 3 + octave * 4 + static_cast<int>((size >> octave) - 4);
+}
+
+int GlNamePool::ceilClass(GLsizeiptr size) {
+    int c = floorClass(size);
+    return classSize(c) == size ? c : c + 1;
+}
+
+bool GlNamePool::takeBuffer(GLenum usage, GLsizeiptr size,
+        PooledBuffer& buffer) {
+    // every buffer in the ceiling class is large enough
+    auto it = buffers_.find(BucketKey(usage, ceilClass(size)));
+    if (it != buffers_.end() && !it->second.empty()) {
+        buffer = it->second.back();
+        it->second.pop_back();
+        pooled_bytes_ -= buffer.capacity;
+        return true;
+    }
+    // in the floor class only some are; notably those of exactly size
+    it = buffers_.find(BucketKey(usage, floorClass(size)));
+    if (it != buffers_.end()) {
+        std::vector<PooledBuffer>& bucket = it->second;
+        for (auto pooled = bucket.begin(); pooled != bucket.end(); ++pooled) {
+            if (pooled->capacity >= size) {
+                buffer = *pooled;
+                bucket.erase(pooled);
+                pooled_bytes_ -= buffer.capacity;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+GLuint GlNamePool::createBuffer(GLenum target, GLsizeiptr size,
+        const void* data, GLenum usage, GLsizeiptr* capacity) {
+    PooledBuffer buffer;
+    lock();
+    bool hit = size > 0 && takeBuffer(usage, size, buffer);
+    ++(hit ? stats_.hits : stats_.misses)[BUFFER];
+    unlock();
+
+    if (hit) {
+        glBindBuffer(target, buffer.id);
+        if (data != 0) {
+            glBufferSubData(target, 0, size, data);
+        }
+    } else {
+        glGenBuffers(1, &buffer.id);
+        glBindBuffer(target, buffer.id);
+        glBufferData(target, size, data, usage);
+        buffer.capacity = size;
+    }
+    if (capacity != 0) {
+        *capacity = buffer.capacity;
+    }
+    return buffer.id;
+}
+
+GLuint GlNamePool::take(std::vector<GLuint>& names, Kind kind) {
+    GLuint name = 0;
+    lock();
+    if (!names.empty()) {
+        name = names.back();
+        names.pop_back();
+        ++stats_.hits[kind];
+    } else {
+        ++stats_.misses[kind];
+    }
+    unlock();
+    return name;
+}
+
+GLuint GlNamePool::genVertexArray() {
+    GLuint vertex_array = take(vertex_arrays_, VERTEX_ARRAY);
+    if (vertex_array == 0) {
+        glGenVertexArrays(1, &vertex_array);
+    }
+    return vertex_array;
+}
+
+GLuint GlNamePool::genFramebuffer() {
+    GLuint frame_buffer = take(frame_buffers_, FRAME_BUFFER);
+    if (frame_buffer == 0) {
+        glGenFramebuffers(1, &frame_buffer);
+    }
+    return frame_buffer;
+}
+
+GLuint GlNamePool::genTexture(GLenum target) {
+    GLuint texture = 0;
+    if (target == GL_TEXTURE_2D) {
+        texture = take(textures_, TEXTURE);
+    }
+    if (texture == 0) {
+        glGenTextures(1, &texture);
+    }
+    return texture;
+}
+
+bool GlNamePool::recycleBuffer(GLuint buffer, GLenum usage,
+        GLsizeiptr capacity) {
+    if (usage == 0 || capacity <= 0) {
+        return false;
+    }
+    bool taken = false;
+    lock();
+    std::vector<PooledBuffer>& bucket = buffers_[BucketKey(usage,
+            floorClass(capacity))];
+    if (bucket.size() < MAX_BUCKET_BUFFERS
+            && pooled_bytes_ + capacity <= MAX_POOLED_BYTES) {
+        PooledBuffer pooled = { buffer, capacity };
+        bucket.push_back(pooled);
+        pooled_bytes_ += capacity;
+        taken = true;
+    }
+    unlock();
+    return taken;
+}
+
+bool GlNamePool::recycleVertexArray(GLuint vertex_array) {
+    lock();
+    bool full = vertex_arrays_.size() >= MAX_VERTEX_ARRAYS;
+    unlock();
+    if (full) {
+        return false;
+    }
+
+#if _GVRF_USE_GLES3_
+    if (max_vertex_attribs_ == 0) {
+        glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &max_vertex_attribs_);
+    }
+    GLint bound = 0;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &bound);
+    // an array left enabled could point at a deleted buffer
+    glBindVertexArray(vertex_array);
+    for (GLint index = 0; index < max_vertex_attribs_; ++index) {
+        glDisableVertexAttribArray(index);
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindVertexArray(bound);
+#endif
+
+    lock();
+    vertex_arrays_.push_back(vertex_array);
+    unlock();
+    return true;
+}
+
+bool GlNamePool::recycleFramebuffer(GLuint frame_buffer) {
+    lock();
+    bool full = frame_buffers_.size() >= MAX_FRAME_BUFFERS;
+    unlock();
+    if (full) {
+        return false;
+    }
+
+    GLint bound = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &bound);
+    glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+            GL_TEXTURE_2D, 0, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+            GL_RENDERBUFFER, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT,
+            GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, bound);
+
+    lock();
+    frame_buffers_.push_back(frame_buffer);
+    unlock();
+    return true;
+}
+
+bool GlNamePool::recycleTexture(GLuint texture, GLenum target) {
+    // a name once bound to a target cannot be bound to another
+    if (target != GL_TEXTURE_2D) {
+        return false;
+    }
+    lock();
+    bool full = textures_.size() >= MAX_TEXTURES;
+    unlock();
+    if (full) {
+        return false;
+    }
+
+    GLint bound = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+    glBindTexture(GL_TEXTURE_2D, texture);
+#if _GVRF_USE_GLES3_
+    GLint immutable = GL_FALSE;
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_IMMUTABLE_FORMAT,
+            &immutable);
+    if (immutable) {
+        glBindTexture(GL_TEXTURE_2D, bound);
+        return false;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_RED);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_GREEN);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_BLUE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_ALPHA);
+#endif
+    // give the images back; the next user specifies its own
+    for (int level = 0; level < MAX_TEXTURE_LEVELS; ++level) {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, 0, 0, 0, GL_RGBA,
+                GL_UNSIGNED_BYTE, 0);
+    }
+    glBindTexture(GL_TEXTURE_2D, bound);
+
+    lock();
+    textures_.push_back(texture);
+    unlock();
+    return true;
+}
+
+void GlNamePool::clear() {
+    lock();
+    buffers_.clear();
+    pooled_bytes_ = 0;
+    vertex_arrays_.clear();
+    frame_buffers_.clear();
+    textures_.clear();
+    unlock();
+}
+
+GlNamePool::Stats GlNamePool::stats() {
+    lock();
+    Stats stats = stats_;
+    unlock();
+    return stats;
+}
+
+void GlNamePool::resetStats() {
+    lock();
+    memset(&stats_, 0, sizeof(stats_));
+    unlock();
+}
+
+}
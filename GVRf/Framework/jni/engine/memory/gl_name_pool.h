@@ -0,0 +1,135 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Recycles the names of deleted GL objects.
+ ***************************************************************************/
+
+#ifndef GL_NAME_POOL_H_
+#define GL_NAME_POOL_H_
+
+#include <map>
+#include <utility>
+#include <vector>
+#include <pthread.h>
+
+#include "GLES3/gl3.h"
+
+namespace gvr {
+
+/*
+ * GlDelete hands the names it would delete here once their fence has
+ * signaled, and the gen*() calls take them back before asking the driver
+ * for new ones. Objects are reset on the way in: VAOs lose their enabled
+ * arrays, framebuffers their attachments, textures their level 0 image.
+ * Buffers keep their data store and are bucketed by usage and size class,
+ * four classes per power of two, so one can be refilled with
+ * glBufferSubData() instead of being reallocated. Immutable textures, and
+ * anything past the pool's limits, are deleted after all.
+ *
+ * Every call is for a thread with a GL context.
+ */
+class GlNamePool {
+public:
+    enum Kind {
+        BUFFER, VERTEX_ARRAY, FRAME_BUFFER, TEXTURE, KIND_COUNT
+    };
+
+    struct Stats {
+        int hits[KIND_COUNT];
+        int misses[KIND_COUNT];
+    };
+
+    GlNamePool();
+    ~GlNamePool();
+
+    /*
+     * A buffer bound to target holding size bytes of data, with usage. Its
+     * store may be larger, capacity says how large.
+     */
+    GLuint createBuffer(GLenum target, GLsizeiptr size, const void* data,
+            GLenum usage, GLsizeiptr* capacity);
+    GLuint genVertexArray();
+    GLuint genFramebuffer();
+    GLuint genTexture(GLenum target);
+
+    /*
+     * Called by GlDelete; false if the name was not taken and must be
+     * deleted. Buffers without a usage are not taken.
+     */
+    bool recycleBuffer(GLuint buffer, GLenum usage, GLsizeiptr capacity);
+    bool recycleVertexArray(GLuint vertex_array);
+    bool recycleFramebuffer(GLuint frame_buffer);
+    bool recycleTexture(GLuint texture, GLenum target);
+
+    /*
+     * Forget every pooled name without deleting it, for when the context
+     * that owned them is gone; the new one may hand out the same names.
+     */
+    void clear();
+
+    // since the last resetStats()
+    Stats stats();
+    void resetStats();
+
+private:
+    GlNamePool(const GlNamePool& gl_name_pool);
+    GlNamePool(GlNamePool&& gl_name_pool);
+    GlNamePool& operator=(const GlNamePool& gl_name_pool);
+    GlNamePool& operator=(GlNamePool&& gl_name_pool);
+
+    static const int MAX_BUCKET_BUFFERS = 8;
+    static const GLsizeiptr MAX_POOLED_BYTES = 8 * 1024 * 1024;
+    static const int MAX_VERTEX_ARRAYS = 64;
+    static const int MAX_FRAME_BUFFERS = 16;
+    static const int MAX_TEXTURES = 16;
+    // up to 8192 x 8192
+    static const int MAX_TEXTURE_LEVELS = 14;
+
+    struct PooledBuffer {
+        GLuint id;
+        GLsizeiptr capacity;
+    };
+    // usage and size class
+    typedef std::pair<GLenum, int> BucketKey;
+
+    // largest class not above size, and smallest class not below it
+    static int floorClass(GLsizeiptr size);
+    static int ceilClass(GLsizeiptr size);
+    bool takeBuffer(GLenum usage, GLsizeiptr size, PooledBuffer& buffer);
+    GLuint take(std::vector<GLuint>& names, Kind kind);
+
+    void lock() {
+        pthread_mutex_lock(&mutex_);
+    }
+    void unlock() {
+        pthread_mutex_unlock(&mutex_);
+    }
+
+private:
+    pthread_mutex_t mutex_;
+    std::map<BucketKey, std::vector<PooledBuffer>> buffers_;
+    GLsizeiptr pooled_bytes_;
+    std::vector<GLuint> vertex_arrays_;
+    std::vector<GLuint> frame_buffers_;
+    std::vector<GLuint> textures_;
+    GLint max_vertex_attribs_;
+    Stats stats_;
+};
+
+extern GlNamePool gl_name_pool;
+}
+
+#endif
@@ -0,0 +1,126 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Accounts for the GPU memory the engine allocates.
+ ***************************************************************************/
+
+#include "gpu_memory.h"
+
+#include <algorithm>
+
+#include "util/gvr_log.h"
+
+namespace gvr {
+
+GpuMemory gpu_memory;
+
+const size_t GpuMemory::UNLIMITED;
+
+static bool lessRecentlyUsed(GpuAllocation* i, GpuAllocation* j) {
+    return i->last_used() < j->last_used();
+}
+
+GpuMemory::GpuMemory() :
+        allocations_(), total_(0), budget_(UNLIMITED), frame_(0) {
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&mutex_, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+    for (int i = 0; i < CATEGORY_COUNT; ++i) {
+        usage_[i] = 0;
+    }
+}
+
+GpuMemory::~GpuMemory() {
+    pthread_mutex_destroy(&mutex_);
+}
+
+void GpuMemory::setBudget(size_t budget) {
+    lock();
+    budget_ = budget;
+    unlock();
+}
+
+size_t GpuMemory::budget() {
+    lock();
+    size_t budget = budget_;
+    unlock();
+    return budget;
+}
+
+size_t GpuMemory::usage(Category category) {
+    lock();
+    size_t usage = usage_[category];
+    unlock();
+    return usage;
+}
+
+size_t GpuMemory::total() {
+    lock();
+    size_t total = total_;
+    unlock();
+    return total;
+}
+
+void GpuMemory::resize(GpuAllocation* allocation, size_t bytes) {
+    lock();
+    usage_[allocation->category_] += bytes - allocation->bytes_;
+    total_ += bytes - allocation->bytes_;
+    allocation->bytes_ = bytes;
+
+    if (bytes != 0 && allocation->index_ < 0) {
+        allocation->index_ = allocations_.size();
+        allocations_.push_back(allocation);
+    } else if (bytes == 0 && allocation->index_ >= 0) {
+        GpuAllocation* last = allocations_.back();
+        allocations_[allocation->index_] = last;
+        last->index_ = allocation->index_;
+        allocations_.pop_back();
+        allocation->index_ = -1;
+    }
+    unlock();
+}
+
+void GpuMemory::update() {
+    lock();
+    unsigned int drawn = frame_++;
+    if (budget_ == UNLIMITED || total_ <= budget_) {
+        unlock();
+        return;
+    }
+
+    // spare what the frame just drawn and the one before it used
+    std::vector<GpuAllocation*> lru;
+    for (auto it = allocations_.begin(); it != allocations_.end(); ++it) {
+        if ((*it)->evictable_ != 0 && drawn - (*it)->last_used() > 1) {
+            lru.push_back(*it);
+        }
+    }
+    std::sort(lru.begin(), lru.end(), lessRecentlyUsed);
+
+    size_t before = total_;
+    for (auto it = lru.begin(); it != lru.end() && total_ > budget_; ++it) {
+        (*it)->evictable_->evict();
+    }
+    if (total_ < before) {
+        LOGD("GpuMemory: evicted %zu bytes, %zu in use", before - total_,
+                total_);
+    }
+    unlock();
+}
+
+}
@@ -0,0 +1,162 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Accounts for the GPU memory the engine allocates.
+ ***************************************************************************/
+
+#ifndef GPU_MEMORY_H_
+#define GPU_MEMORY_H_
+
+#include <stddef.h>
+#include <vector>
+#include <pthread.h>
+
+namespace gvr {
+class GpuAllocation;
+
+/*
+ * Textures, render targets and meshes report what their GL objects take
+ * through a GpuAllocation each, and mark it used whenever they are drawn.
+ * Once per frame, update() checks the total against the budget and, while it
+ * is over, asks the evictable allocations least recently drawn to give
+ * their memory back - they must be able to recreate it on their next use.
+ * Sizes are estimates: what the engine asked for, not what the driver
+ * really allocated.
+ */
+class GpuMemory {
+public:
+    enum Category {
+        TEXTURE = 0, RENDER_TARGET = 1, MESH = 2, CATEGORY_COUNT
+    };
+
+    // no budget, nothing is ever evicted
+    static const size_t UNLIMITED = 0;
+
+    class Evictable {
+    public:
+        virtual ~Evictable() {
+        }
+
+        // free what can be recreated on the next use; GL thread
+        virtual void evict() = 0;
+    };
+
+    GpuMemory();
+    ~GpuMemory();
+
+    void setBudget(size_t budget);
+    size_t budget();
+
+    size_t usage(Category category);
+    size_t total();
+
+    // the frame being drawn
+    unsigned int frame() const {
+        return frame_;
+    }
+
+    // Ends a frame, evicting while over budget; GL thread.
+    void update();
+
+private:
+    GpuMemory(const GpuMemory& gpu_memory);
+    GpuMemory(GpuMemory&& gpu_memory);
+    GpuMemory& operator=(const GpuMemory& gpu_memory);
+    GpuMemory& operator=(GpuMemory&& gpu_memory);
+
+    friend class GpuAllocation;
+    void resize(GpuAllocation* allocation, size_t bytes);
+
+    void lock() {
+        pthread_mutex_lock(&mutex_);
+    }
+    void unlock() {
+        pthread_mutex_unlock(&mutex_);
+    }
+
+private:
+    // recursive, evict() resizes while update() holds it
+    pthread_mutex_t mutex_;
+    std::vector<GpuAllocation*> allocations_;
+    size_t usage_[CATEGORY_COUNT];
+    size_t total_;
+    size_t budget_;
+    volatile unsigned int frame_;
+};
+
+extern GpuMemory gpu_memory;
+
+/*
+ * One owner's share of GPU memory. An owner with an evictable allocation
+ * must release() it first thing in its destructor, so an eviction cannot
+ * run into its teardown.
+ */
+class GpuAllocation {
+public:
+    explicit GpuAllocation(GpuMemory::Category category,
+            GpuMemory::Evictable* evictable = 0) :
+            category_(category), evictable_(evictable), bytes_(0), last_used_(
+                    0), index_(-1) {
+    }
+
+    ~GpuAllocation() {
+        release();
+    }
+
+    // any thread
+    void resize(size_t bytes) {
+        gpu_memory.resize(this, bytes);
+    }
+
+    void release() {
+        resize(0);
+    }
+
+    void touch() const {
+        last_used_ = gpu_memory.frame();
+    }
+
+    GpuMemory::Category category() const {
+        return category_;
+    }
+
+    size_t bytes() const {
+        return bytes_;
+    }
+
+    unsigned int last_used() const {
+        return last_used_;
+    }
+
+private:
+    GpuAllocation(const GpuAllocation& gpu_allocation);
+    GpuAllocation(GpuAllocation&& gpu_allocation);
+    GpuAllocation& operator=(const GpuAllocation& gpu_allocation);
+    GpuAllocation& operator=(GpuAllocation&& gpu_allocation);
+
+    friend class GpuMemory;
+
+private:
+    GpuMemory::Category category_;
+    GpuMemory::Evictable* evictable_;
+    size_t bytes_;
+    mutable unsigned int last_used_;
+    // position in GpuMemory::allocations_ while bytes_ is not 0
+    int index_;
+};
+
+}
+#endif
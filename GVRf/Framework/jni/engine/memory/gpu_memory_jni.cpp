@@ -0,0 +1,70 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "util/gvr_jni.h"
+#include "gpu_memory.h"
+
+namespace gvr {
+
+extern "C" {
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeGpuMemory_getUsage(JNIEnv * env, jobject obj,
+        jint category);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeGpuMemory_getTotal(JNIEnv * env, jobject obj);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeGpuMemory_setBudget(JNIEnv * env, jobject obj,
+        jlong bytes);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeGpuMemory_getBudget(JNIEnv * env, jobject obj);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeGpuMemory_update(JNIEnv * env, jobject obj);
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeGpuMemory_getUsage(JNIEnv * env, jobject obj,
+        jint category) {
+    if (category < 0 || category >= GpuMemory::CATEGORY_COUNT) {
+        return 0;
+    }
+    return gpu_memory.usage(static_cast<GpuMemory::Category>(category));
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeGpuMemory_getTotal(JNIEnv * env, jobject obj) {
+    return gpu_memory.total();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeGpuMemory_setBudget(JNIEnv * env, jobject obj,
+        jlong bytes) {
+    gpu_memory.setBudget(bytes > 0 ? bytes : GpuMemory::UNLIMITED);
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeGpuMemory_getBudget(JNIEnv * env, jobject obj) {
+    return gpu_memory.budget();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeGpuMemory_update(JNIEnv * env, jobject obj) {
+    gpu_memory.update();
+}
+
+}
@@ -0,0 +1,138 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Keeps the mip levels of streamed textures within a GPU memory budget.
+ ***************************************************************************/
+
+#include "texture_streamer.h"
+
+#include <algorithm>
+
+#include "objects/textures/streamed_texture.h"
+
+namespace gvr {
+
+TextureStreamer texture_streamer;
+
+const size_t TextureStreamer::DEFAULT_BUDGET;
+
+static bool lessRecentlyUsed(StreamedTexture* i, StreamedTexture* j) {
+    return i->last_used() < j->last_used();
+}
+
+void TextureStreamer::add(StreamedTexture* texture) {
+    lock();
+    textures_.push_back(texture);
+    unlock();
+}
+
+void TextureStreamer::remove(StreamedTexture* texture) {
+    lock();
+    auto it = std::find(textures_.begin(), textures_.end(), texture);
+    if (it != textures_.end()) {
+        textures_.erase(it);
+    }
+    unlock();
+}
+
+void TextureStreamer::setBudget(size_t budget) {
+    lock();
+    budget_ = budget;
+    unlock();
+}
+
+size_t TextureStreamer::budget() {
+    lock();
+    size_t budget = budget_;
+    unlock();
+    return budget;
+}
+
+size_t TextureStreamer::residentBytes() {
+    lock();
+    size_t resident = 0;
+    for (auto it = textures_.begin(); it != textures_.end(); ++it) {
+        resident += (*it)->residentBytes();
+    }
+    unlock();
+    return resident;
+}
+
+bool TextureStreamer::evictOne(const std::vector<StreamedTexture*>& lru,
+        unsigned int frame, size_t& resident) {
+    // finer than what was asked for in this frame first
+    for (auto it = lru.begin(); it != lru.end(); ++it) {
+        StreamedTexture* texture = *it;
+        if (texture->last_used() == frame
+                && texture->resident_base() < texture->wanted_level()) {
+            resident -= texture->levelBytes(texture->resident_base());
+            texture->makeResident(texture->resident_base() + 1);
+            return true;
+        }
+    }
+    // then whatever was not drawn, least recently used first
+    for (auto it = lru.begin(); it != lru.end(); ++it) {
+        StreamedTexture* texture = *it;
+        if (texture->last_used() != frame
+                && texture->resident_base() < texture->level_count() - 1) {
+            resident -= texture->levelBytes(texture->resident_base());
+            texture->makeResident(texture->resident_base() + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TextureStreamer::update() {
+    lock();
+    unsigned int frame = frame_++;
+
+    std::vector<StreamedTexture*> lru(textures_);
+    std::sort(lru.begin(), lru.end(), lessRecentlyUsed);
+    size_t resident = 0;
+    for (auto it = lru.begin(); it != lru.end(); ++it) {
+        resident += (*it)->residentBytes();
+    }
+
+    // the most recently used are raised first
+    for (auto it = lru.rbegin(); it != lru.rend(); ++it) {
+        StreamedTexture* texture = *it;
+        if (texture->last_used() != frame
+                || texture->wanted_level() >= texture->resident_base()) {
+            continue;
+        }
+        int level = texture->resident_base() - 1;
+        size_t bytes = texture->levelBytes(level);
+        while (resident + bytes > budget_ && evictOne(lru, frame, resident)) {
+        }
+        if (resident + bytes > budget_) {
+            break;
+        }
+        texture->makeResident(level);
+        resident += bytes;
+    }
+
+    // the budget may have been lowered
+    while (resident > budget_ && evictOne(lru, frame, resident)) {
+    }
+
+    for (auto it = lru.begin(); it != lru.end(); ++it) {
+        (*it)->clearRequest();
+    }
+    unlock();
+}
+
+}
@@ -0,0 +1,93 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Keeps the mip levels of streamed textures within a GPU memory budget.
+ ***************************************************************************/
+
+#ifndef TEXTURE_STREAMER_H_
+#define TEXTURE_STREAMER_H_
+
+#include <stddef.h>
+#include <vector>
+#include <pthread.h>
+
+namespace gvr {
+class StreamedTexture;
+
+/*
+ * Streamed textures ask for the finest level they need while they are
+ * culled, and update() moves them towards it once per frame: one level up
+ * per texture and frame, as far as the budget lets. When the budget is
+ * exceeded, the finest resident levels go first - detail nothing asked for,
+ * then the textures used least recently.
+ */
+class TextureStreamer {
+public:
+    static const size_t DEFAULT_BUDGET = 64 * 1024 * 1024;
+
+    TextureStreamer() :
+            textures_(), budget_(DEFAULT_BUDGET), frame_(0) {
+        pthread_mutex_init(&mutex_, 0);
+    }
+
+    ~TextureStreamer() {
+        pthread_mutex_destroy(&mutex_);
+    }
+
+    // called by StreamedTexture, from any thread
+    void add(StreamedTexture* texture);
+    void remove(StreamedTexture* texture);
+
+    void setBudget(size_t budget);
+    size_t budget();
+    size_t residentBytes();
+
+    // the frame requests are counted for
+    unsigned int frame() const {
+        return frame_;
+    }
+
+    // Applies the requests since the last call; GL thread.
+    void update();
+
+private:
+    TextureStreamer(const TextureStreamer& texture_streamer);
+    TextureStreamer(TextureStreamer&& texture_streamer);
+    TextureStreamer& operator=(const TextureStreamer& texture_streamer);
+    TextureStreamer& operator=(TextureStreamer&& texture_streamer);
+
+    // drop the finest level of the best candidate, false if there is none
+    static bool evictOne(const std::vector<StreamedTexture*>& lru,
+            unsigned int frame, size_t& resident);
+
+    void lock() {
+        pthread_mutex_lock(&mutex_);
+    }
+    void unlock() {
+        pthread_mutex_unlock(&mutex_);
+    }
+
+private:
+    pthread_mutex_t mutex_;
+    std::vector<StreamedTexture*> textures_;
+    size_t budget_;
+    unsigned int frame_;
+};
+
+extern TextureStreamer texture_streamer;
+}
+
+#endif
@@ -0,0 +1,667 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Uploads texture images on a worker thread with a shared GL context.
+ ***************************************************************************/
+
+#include "texture_uploader.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include <android/bitmap.h>
+
+#include "engine/memory/gl_name_pool.h"
+#include "gl/gl_program.h"
+#include "objects/textures/texture.h"
+#include "util/gvr_gl.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+
+TextureUploader texture_uploader;
+
+// how long finish() blocks between checks, in nanoseconds
+static const GLuint64 FINISH_TIMEOUT = 1000000000;
+
+TextureUploader::TextureUploader() :
+        thread_(), running_(false), quit_(false), worker_state_(0), display_(
+                EGL_NO_DISPLAY), share_context_(EGL_NO_CONTEXT), context_(
+                EGL_NO_CONTEXT), surface_(EGL_NO_SURFACE), next_ticket_(0), waiting_(), sync_(), queue_(), current_(
+                0), done_(), links_(), current_link_(0) {
+    pthread_mutex_init(&mutex_, 0);
+    pthread_cond_init(&work_cond_, 0);
+    pthread_cond_init(&done_cond_, 0);
+}
+
+TextureUploader::~TextureUploader() {
+    if (running_) {
+        stop();
+    }
+    pthread_cond_destroy(&done_cond_);
+    pthread_cond_destroy(&work_cond_);
+    pthread_mutex_destroy(&mutex_);
+}
+
+void TextureUploader::upload(JNIEnv* env, Texture* texture, GLuint id,
+        GLenum target, const std::vector<Image>& images, bool mipmap) {
+    Job* job = new Job();
+    job->ticket = 0;
+    job->texture = texture;
+    job->id = id;
+    job->target = target;
+    job->images = images;
+    job->mipmap = mipmap;
+    job->fence = 0;
+
+    for (auto it = job->images.begin(); it != job->images.end(); ++it) {
+        if (it->pixels != 0) {
+            continue;
+        }
+        // copied now: apps recycle their bitmaps as soon as this returns
+        AndroidBitmapInfo info;
+        void* pixels = 0;
+        int ret;
+        std::string error;
+        if (it->bitmap == NULL) {
+            error = "TextureUploader::upload() failed! Input bitmap is NULL.";
+        } else if ((ret = AndroidBitmap_getInfo(env, it->bitmap, &info)) < 0) {
+            error = "AndroidBitmap_getInfo () failed! error = "
+                    + std::to_string(ret);
+        } else if (info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) {
+            error = "TextureUploader::upload() failed! Only RGBA_8888 bitmaps are supported.";
+        } else if ((ret = AndroidBitmap_lockPixels(env, it->bitmap, &pixels))
+                < 0) {
+            error = "AndroidBitmap_lockPixels () failed! error = "
+                    + std::to_string(ret);
+        }
+        if (!error.empty()) {
+            LOGE("%s", error.c_str());
+            release(job);
+            delete job;
+            throw error;
+        }
+        size_t row = info.width * 4;
+        it->width = info.width;
+        it->height = info.height;
+        it->pixels = static_cast<unsigned char*>(malloc(row * info.height));
+        for (unsigned int y = 0; y < info.height; ++y) {
+            memcpy(it->pixels + y * row,
+                    static_cast<const unsigned char*>(pixels) + y * info.stride,
+                    row);
+        }
+        AndroidBitmap_unlockPixels(env, it->bitmap);
+        it->bitmap = 0;
+    }
+
+    if (!start()) {
+        specify(job, 0);
+        release(job);
+        delete job;
+        return;
+    }
+    texture->set_upload_pending(true);
+
+    pthread_mutex_lock(&mutex_);
+    queue_.push_back(job);
+    pthread_cond_signal(&work_cond_);
+    pthread_mutex_unlock(&mutex_);
+}
+
+unsigned int TextureUploader::expect(Texture* texture, GLuint id,
+        GLenum target, bool mipmap) {
+    start();
+
+    Job* job = new Job();
+    job->texture = texture;
+    job->id = id;
+    job->target = target;
+    job->mipmap = mipmap;
+    job->fence = 0;
+    texture->set_upload_pending(true);
+
+    pthread_mutex_lock(&mutex_);
+    job->ticket = ++next_ticket_;
+    waiting_.push_back(job);
+    pthread_mutex_unlock(&mutex_);
+    return job->ticket;
+}
+
+void TextureUploader::supply(unsigned int ticket,
+        const std::vector<Image>& images) {
+    pthread_mutex_lock(&mutex_);
+    Job* job = 0;
+    for (auto it = waiting_.begin(); it != waiting_.end(); ++it) {
+        if ((*it)->ticket == ticket) {
+            job = *it;
+            waiting_.erase(it);
+            break;
+        }
+    }
+    if (job == 0) {
+        // cancelled meanwhile
+        pthread_mutex_unlock(&mutex_);
+        Job unclaimed;
+        unclaimed.images = images;
+        release(&unclaimed);
+        return;
+    }
+
+    job->images = images;
+    if (images.empty()) {
+        // nothing to upload; published as it is
+        done_.push_back(job);
+    } else if (running_) {
+        queue_.push_back(job);
+        pthread_cond_signal(&work_cond_);
+    } else {
+        sync_.push_back(job);
+    }
+    pthread_cond_broadcast(&done_cond_);
+    pthread_mutex_unlock(&mutex_);
+}
+
+void TextureUploader::update() {
+    pthread_mutex_lock(&mutex_);
+    for (auto it = sync_.begin(); it != sync_.end(); ++it) {
+        specify(*it, 0);
+        release(*it);
+        publish(*it, 0);
+        delete *it;
+    }
+    sync_.clear();
+    for (auto it = done_.begin(); it != done_.end();) {
+        if (publish(*it, 0)) {
+            delete *it;
+            it = done_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    pthread_mutex_unlock(&mutex_);
+}
+
+void TextureUploader::finish(Texture* texture) {
+    if (!texture->upload_pending()) {
+        return;
+    }
+    pthread_mutex_lock(&mutex_);
+    while (true) {
+        bool queued = current_ != 0 && current_->texture == texture;
+        for (auto it = waiting_.begin(); !queued && it != waiting_.end();
+                ++it) {
+            queued = (*it)->texture == texture;
+        }
+        for (auto it = queue_.begin(); !queued && it != queue_.end(); ++it) {
+            queued = (*it)->texture == texture;
+        }
+        if (!queued) {
+            break;
+        }
+        pthread_cond_wait(&done_cond_, &mutex_);
+    }
+    for (auto it = sync_.begin(); it != sync_.end(); ++it) {
+        if ((*it)->texture == texture) {
+            specify(*it, 0);
+            release(*it);
+            publish(*it, 0);
+            delete *it;
+            sync_.erase(it);
+            break;
+        }
+    }
+    for (auto it = done_.begin(); it != done_.end(); ++it) {
+        if ((*it)->texture == texture) {
+            while (!publish(*it, FINISH_TIMEOUT)) {
+            }
+            delete *it;
+            done_.erase(it);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&mutex_);
+}
+
+void TextureUploader::cancel(Texture* texture) {
+    pthread_mutex_lock(&mutex_);
+    // the name may be reused as soon as this returns
+    while (current_ != 0 && current_->texture == texture) {
+        pthread_cond_wait(&done_cond_, &mutex_);
+    }
+    for (auto it = waiting_.begin(); it != waiting_.end();) {
+        if ((*it)->texture == texture) {
+            delete *it;
+            it = waiting_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = sync_.begin(); it != sync_.end();) {
+        if ((*it)->texture == texture) {
+            release(*it);
+            delete *it;
+            it = sync_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+        if ((*it)->texture == texture) {
+            (*it)->texture = 0;
+        }
+    }
+    for (auto it = done_.begin(); it != done_.end(); ++it) {
+        if ((*it)->texture == texture) {
+            (*it)->texture = 0;
+        }
+    }
+    pthread_mutex_unlock(&mutex_);
+}
+
+unsigned int TextureUploader::link(GLuint program, const char* vertex_source,
+        const char* fragment_source) {
+    if (!start()) {
+        return 0;
+    }
+    LinkJob* job = new LinkJob();
+    job->program = program;
+    job->vertex_source = vertex_source;
+    job->fragment_source = fragment_source;
+
+    pthread_mutex_lock(&mutex_);
+    job->ticket = ++next_ticket_;
+    links_.push_back(job);
+    pthread_cond_signal(&work_cond_);
+    pthread_mutex_unlock(&mutex_);
+    return job->ticket;
+}
+
+bool TextureUploader::linking(unsigned int ticket) {
+    pthread_mutex_lock(&mutex_);
+    bool queued = queuedLink(ticket);
+    pthread_mutex_unlock(&mutex_);
+    return queued;
+}
+
+void TextureUploader::finishLink(unsigned int ticket) {
+    pthread_mutex_lock(&mutex_);
+    while (queuedLink(ticket)) {
+        pthread_cond_wait(&done_cond_, &mutex_);
+    }
+    pthread_mutex_unlock(&mutex_);
+}
+
+void TextureUploader::cancelLink(unsigned int ticket) {
+    pthread_mutex_lock(&mutex_);
+    for (auto it = links_.begin(); it != links_.end(); ++it) {
+        if ((*it)->ticket == ticket) {
+            delete *it;
+            links_.erase(it);
+            break;
+        }
+    }
+    while (current_link_ != 0 && current_link_->ticket == ticket) {
+        pthread_cond_wait(&done_cond_, &mutex_);
+    }
+    pthread_mutex_unlock(&mutex_);
+}
+
+bool TextureUploader::queuedLink(unsigned int ticket) {
+    if (current_link_ != 0 && current_link_->ticket == ticket) {
+        return true;
+    }
+    for (auto it = links_.begin(); it != links_.end(); ++it) {
+        if ((*it)->ticket == ticket) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TextureUploader::start() {
+#if _GVRF_USE_GLES3_
+    EGLContext current = eglGetCurrentContext();
+    if (running_ && current == share_context_) {
+        return true;
+    }
+    if (running_) {
+        // the GL context was recreated; its textures went with it, and
+        // the pooled names would collide with the new context's
+        stop();
+        gl_name_pool.clear();
+    }
+    if (current == EGL_NO_CONTEXT) {
+        return false;
+    }
+
+    display_ = eglGetCurrentDisplay();
+    EGLint config_id = 0;
+    eglQueryContext(display_, current, EGL_CONFIG_ID, &config_id);
+    const EGLint config_attribs[] = { EGL_CONFIG_ID, config_id, EGL_NONE };
+    EGLConfig config;
+    EGLint count = 0;
+    if (!eglChooseConfig(display_, config_attribs, &config, 1, &count)
+            || count != 1) {
+        LOGE("TextureUploader: no config for a shared context");
+        return false;
+    }
+
+    const EGLint context_attribs[] = { EGL_CONTEXT_CLIENT_VERSION, 3,
+            EGL_NONE };
+    context_ = eglCreateContext(display_, config, current, context_attribs);
+    if (context_ == EGL_NO_CONTEXT) {
+        LOGE("TextureUploader: eglCreateContext() failed: 0x%x",
+                eglGetError());
+        return false;
+    }
+
+    // the worker never draws, so it needs no surface if the driver agrees
+    const char* extensions = eglQueryString(display_, EGL_EXTENSIONS);
+    surface_ = EGL_NO_SURFACE;
+    if (extensions == 0
+            || strstr(extensions, "EGL_KHR_surfaceless_context") == 0) {
+        const EGLint surface_attribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1,
+                EGL_NONE };
+        surface_ = eglCreatePbufferSurface(display_, config, surface_attribs);
+        if (surface_ == EGL_NO_SURFACE) {
+            LOGE("TextureUploader: eglCreatePbufferSurface() failed: 0x%x",
+                    eglGetError());
+            eglDestroyContext(display_, context_);
+            context_ = EGL_NO_CONTEXT;
+            return false;
+        }
+    }
+
+    share_context_ = current;
+    quit_ = false;
+    worker_state_ = 0;
+    if (pthread_create(&thread_, 0, threadMain, this) != 0) {
+        LOGE("TextureUploader: pthread_create() failed");
+        worker_state_ = -1;
+    } else {
+        pthread_mutex_lock(&mutex_);
+        while (worker_state_ == 0) {
+            pthread_cond_wait(&done_cond_, &mutex_);
+        }
+        pthread_mutex_unlock(&mutex_);
+        if (worker_state_ < 0) {
+            pthread_join(thread_, 0);
+        }
+    }
+    if (worker_state_ < 0) {
+        if (surface_ != EGL_NO_SURFACE) {
+            eglDestroySurface(display_, surface_);
+            surface_ = EGL_NO_SURFACE;
+        }
+        eglDestroyContext(display_, context_);
+        context_ = EGL_NO_CONTEXT;
+        share_context_ = EGL_NO_CONTEXT;
+        return false;
+    }
+    pthread_mutex_lock(&mutex_);
+    running_ = true;
+    pthread_mutex_unlock(&mutex_);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void TextureUploader::stop() {
+    pthread_mutex_lock(&mutex_);
+    quit_ = true;
+    pthread_cond_signal(&work_cond_);
+    pthread_mutex_unlock(&mutex_);
+    pthread_join(thread_, 0);
+
+    if (surface_ != EGL_NO_SURFACE) {
+        eglDestroySurface(display_, surface_);
+        surface_ = EGL_NO_SURFACE;
+    }
+    eglDestroyContext(display_, context_);
+    context_ = EGL_NO_CONTEXT;
+    share_context_ = EGL_NO_CONTEXT;
+
+    // the fences belong to the old share group too
+    pthread_mutex_lock(&mutex_);
+    for (auto it = done_.begin(); it != done_.end(); ++it) {
+        if ((*it)->texture != 0) {
+            (*it)->texture->set_upload_pending(false);
+        }
+        delete *it;
+    }
+    done_.clear();
+    running_ = false;
+    quit_ = false;
+    pthread_mutex_unlock(&mutex_);
+}
+
+void* TextureUploader::threadMain(void* uploader) {
+    static_cast<TextureUploader*>(uploader)->run();
+    return 0;
+}
+
+void TextureUploader::run() {
+#if _GVRF_USE_GLES3_
+    bool current = eglMakeCurrent(display_, surface_, surface_, context_);
+    if (!current) {
+        LOGE("TextureUploader: eglMakeCurrent() failed: 0x%x", eglGetError());
+    }
+
+    pthread_mutex_lock(&mutex_);
+    worker_state_ = current ? 1 : -1;
+    pthread_cond_broadcast(&done_cond_);
+    if (!current) {
+        pthread_mutex_unlock(&mutex_);
+        return;
+    }
+
+    GLuint pixel_buffer;
+    glGenBuffers(1, &pixel_buffer);
+    while (true) {
+        while (!quit_ && queue_.empty() && links_.empty()) {
+            pthread_cond_wait(&work_cond_, &mutex_);
+        }
+        if (quit_) {
+            break;
+        }
+        if (!links_.empty()) {
+            current_link_ = links_.front();
+            links_.pop_front();
+            pthread_mutex_unlock(&mutex_);
+
+            compile(current_link_);
+
+            pthread_mutex_lock(&mutex_);
+            delete current_link_;
+            current_link_ = 0;
+            pthread_cond_broadcast(&done_cond_);
+            continue;
+        }
+        current_ = queue_.front();
+        queue_.pop_front();
+        bool cancelled = current_->texture == 0;
+        pthread_mutex_unlock(&mutex_);
+
+        if (!cancelled) {
+            specify(current_, pixel_buffer);
+        }
+        release(current_);
+
+        pthread_mutex_lock(&mutex_);
+        if (cancelled) {
+            delete current_;
+        } else {
+            done_.push_back(current_);
+        }
+        current_ = 0;
+        pthread_cond_broadcast(&done_cond_);
+    }
+
+    // whatever is left belonged to the context going away
+    for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+        if ((*it)->texture != 0) {
+            (*it)->texture->set_upload_pending(false);
+        }
+        release(*it);
+        delete *it;
+    }
+    queue_.clear();
+    for (auto it = links_.begin(); it != links_.end(); ++it) {
+        delete *it;
+    }
+    links_.clear();
+    pthread_cond_broadcast(&done_cond_);
+    pthread_mutex_unlock(&mutex_);
+
+    glDeleteBuffers(1, &pixel_buffer);
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+#endif
+}
+
+void TextureUploader::compile(LinkJob* job) {
+    const char* vertex_source = job->vertex_source.c_str();
+    const char* fragment_source = job->fragment_source.c_str();
+    GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertex_shader, 1, &vertex_source, NULL);
+    glCompileShader(vertex_shader);
+    GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragment_shader, 1, &fragment_source, NULL);
+    glCompileShader(fragment_shader);
+    glAttachShader(job->program, vertex_shader);
+    glAttachShader(job->program, fragment_shader);
+    glLinkProgram(job->program);
+
+    // blocks until the driver is done, here instead of on the GL thread
+    GLint link_status = GL_FALSE;
+    glGetProgramiv(job->program, GL_LINK_STATUS, &link_status);
+    if (link_status != GL_TRUE) {
+        GLProgram::logShaderError(vertex_shader, GL_VERTEX_SHADER);
+        GLProgram::logShaderError(fragment_shader, GL_FRAGMENT_SHADER);
+    }
+    glDetachShader(job->program, vertex_shader);
+    glDetachShader(job->program, fragment_shader);
+    glDeleteShader(vertex_shader);
+    glDeleteShader(fragment_shader);
+    // the linked program is visible to the GL thread's context after this
+    glFinish();
+}
+
+void TextureUploader::specify(Job* job, GLuint pixel_buffer) {
+    size_t total = 0;
+    for (auto it = job->images.begin(); it != job->images.end(); ++it) {
+        total += it->width * it->height * 4;
+    }
+
+    unsigned char* staging = 0;
+#if _GVRF_USE_GLES3_
+    if (pixel_buffer != 0) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixel_buffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, total, 0, GL_STREAM_DRAW);
+        staging = static_cast<unsigned char*>(glMapBufferRange(
+                GL_PIXEL_UNPACK_BUFFER, 0, total,
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+        if (staging == 0) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+    }
+#endif
+
+    glBindTexture(job->target, job->id);
+    size_t offset = 0;
+    for (size_t i = 0; i < job->images.size(); ++i) {
+        Image& image = job->images[i];
+        GLenum face =
+                job->target == GL_TEXTURE_CUBE_MAP ?
+                        GL_TEXTURE_CUBE_MAP_POSITIVE_X + i : job->target;
+        size_t size = image.width * image.height * 4;
+        if (staging != 0) {
+            memcpy(staging + offset, image.pixels, size);
+        } else {
+            glTexImage2D(face, 0, GL_RGBA, image.width, image.height, 0,
+                    GL_RGBA, GL_UNSIGNED_BYTE, image.pixels);
+        }
+        offset += size;
+    }
+
+#if _GVRF_USE_GLES3_
+    if (staging != 0) {
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        offset = 0;
+        for (size_t i = 0; i < job->images.size(); ++i) {
+            const Image& image = job->images[i];
+            GLenum face =
+                    job->target == GL_TEXTURE_CUBE_MAP ?
+                            GL_TEXTURE_CUBE_MAP_POSITIVE_X + i : job->target;
+            glTexImage2D(face, 0, GL_RGBA, image.width, image.height, 0,
+                    GL_RGBA, GL_UNSIGNED_BYTE,
+                    reinterpret_cast<const void*>(offset));
+            offset += image.width * image.height * 4;
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+#endif
+
+    if (job->mipmap) {
+        glGenerateMipmap(job->target);
+    }
+    glBindTexture(job->target, 0);
+
+#if _GVRF_USE_GLES3_
+    if (pixel_buffer != 0) {
+        // the render thread waits on this; flush so it can signal
+        job->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+    }
+#endif
+}
+
+void TextureUploader::release(Job* job) {
+    for (auto it = job->images.begin(); it != job->images.end(); ++it) {
+        free(it->pixels);
+        it->pixels = 0;
+    }
+}
+
+bool TextureUploader::publish(Job* job, GLuint64 timeout) {
+#if _GVRF_USE_GLES3_
+    if (job->fence != 0) {
+        GLenum status = glClientWaitSync(job->fence,
+                timeout != 0 ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, timeout);
+        if (status == GL_TIMEOUT_EXPIRED) {
+            return false;
+        }
+        if (status == GL_WAIT_FAILED) {
+            LOGE("TextureUploader: glClientWaitSync() failed");
+        }
+        glDeleteSync(job->fence);
+        job->fence = 0;
+    }
+#endif
+    if (job->texture != 0) {
+        size_t bytes = 0;
+        for (auto it = job->images.begin(); it != job->images.end(); ++it) {
+            bytes += it->width * it->height * 4;
+        }
+        job->texture->set_gpu_size(
+                job->mipmap ? Texture::mipChainSize(bytes) : bytes);
+        job->texture->set_upload_pending(false);
+    }
+    return true;
+}
+
+}
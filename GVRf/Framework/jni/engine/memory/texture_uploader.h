@@ -0,0 +1,178 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Uploads texture images on a worker thread with a shared GL context.
+ ***************************************************************************/
+
+#ifndef TEXTURE_UPLOADER_H_
+#define TEXTURE_UPLOADER_H_
+
+#include <list>
+#include <string>
+#include <vector>
+#include <pthread.h>
+
+#include "EGL/egl.h"
+#include "GLES3/gl3.h"
+
+#include "util/gvr_jni.h"
+
+namespace gvr {
+class Texture;
+
+/*
+ * Bitmaps are copied when the upload is queued, so they can be recycled
+ * right after. The worker stages the pixels in a pixel unpack buffer,
+ * specifies the
+ * texture from it, generates the mipmaps, and fences. The texture reads as
+ * 0 from Texture::getId() until update() on the GL thread sees the fence
+ * signalled, so nothing samples it half written.
+ *
+ * The worker's context shares objects with the context current when the
+ * first upload is queued. Without GLES3 or a shared context, upload()
+ * specifies the texture right away as before.
+ *
+ * The worker also compiles and links the deferred programs of drivers
+ * without GL_KHR_parallel_shader_compile, which cannot tell the GL thread
+ * whether a link is done without blocking it.
+ */
+class TextureUploader {
+public:
+    // one level 0 image: either a bitmap or a malloc()ed RGBA buffer
+    struct Image {
+        Image(jobject bitmap) :
+                bitmap(bitmap), pixels(0), width(0), height(0) {
+        }
+        Image(unsigned char* pixels, int width, int height) :
+                bitmap(0), pixels(pixels), width(width), height(height) {
+        }
+
+        jobject bitmap;
+        unsigned char* pixels;
+        int width;
+        int height;
+    };
+
+    TextureUploader();
+    ~TextureUploader();
+
+    /*
+     * Fill texture, whose GL name is id, with images: one for
+     * GL_TEXTURE_2D, the six faces in order for GL_TEXTURE_CUBE_MAP. The
+     * bitmaps must be RGBA_8888; pixels are freed by the uploader. GL
+     * thread.
+     */
+    void upload(JNIEnv* env, Texture* texture, GLuint id, GLenum target,
+            const std::vector<Image>& images, bool mipmap);
+
+    /*
+     * Reserve texture for images that arrive later through supply(), e.g.
+     * from PngDecodePool. The texture is pending from now on. GL thread.
+     */
+    unsigned int expect(Texture* texture, GLuint id, GLenum target,
+            bool mipmap);
+
+    // the images for ticket, none if they could not be made; any thread
+    void supply(unsigned int ticket, const std::vector<Image>& images);
+
+    // publish the textures whose uploads completed; GL thread
+    void update();
+
+    // wait for texture's upload and publish it; GL thread
+    void finish(Texture* texture);
+
+    // forget texture's upload; it must not touch its name afterwards
+    void cancel(Texture* texture);
+
+    /*
+     * Compile the sources and link them into program on the worker; 0 if
+     * there is no worker to do it. GL thread.
+     */
+    unsigned int link(GLuint program, const char* vertex_source,
+            const char* fragment_source);
+
+    // whether the link for ticket is still queued or running; any thread
+    bool linking(unsigned int ticket);
+
+    // wait for the link for ticket; GL thread
+    void finishLink(unsigned int ticket);
+
+    // forget the link for ticket; the program may be deleted afterwards
+    void cancelLink(unsigned int ticket);
+
+private:
+    TextureUploader(const TextureUploader& texture_uploader);
+    TextureUploader(TextureUploader&& texture_uploader);
+    TextureUploader& operator=(const TextureUploader& texture_uploader);
+    TextureUploader& operator=(TextureUploader&& texture_uploader);
+
+    struct Job {
+        unsigned int ticket;
+        Texture* texture;
+        GLuint id;
+        GLenum target;
+        std::vector<Image> images;
+        bool mipmap;
+        GLsync fence;
+    };
+
+    struct LinkJob {
+        unsigned int ticket;
+        GLuint program;
+        std::string vertex_source;
+        std::string fragment_source;
+    };
+
+    bool start();
+    void stop();
+    static void* threadMain(void* uploader);
+    void run();
+    static void specify(Job* job, GLuint pixel_buffer);
+    static void release(Job* job);
+    bool publish(Job* job, GLuint64 timeout);
+    static void compile(LinkJob* job);
+    // mutex_ held
+    bool queuedLink(unsigned int ticket);
+
+private:
+    pthread_mutex_t mutex_;
+    pthread_cond_t work_cond_;
+    pthread_cond_t done_cond_;
+    pthread_t thread_;
+    bool running_;
+    bool quit_;
+    // 0 while the worker starts, 1 once its context is current, -1 if not
+    int worker_state_;
+    EGLDisplay display_;
+    EGLContext share_context_;
+    EGLContext context_;
+    EGLSurface surface_;
+    unsigned int next_ticket_;
+    // expected, waiting for supply()
+    std::list<Job*> waiting_;
+    // supplied without a worker, specified by update()
+    std::list<Job*> sync_;
+    std::list<Job*> queue_;
+    Job* current_;
+    std::list<Job*> done_;
+    std::list<LinkJob*> links_;
+    LinkJob* current_link_;
+};
+
+extern TextureUploader texture_uploader;
+}
+
+#endif
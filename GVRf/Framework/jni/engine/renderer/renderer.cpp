@@ -22,6 +22,7 @@
 #include "glm/gtc/matrix_inverse.hpp"
 
 #include "eglextension/tiledrendering/tiled_rendering_enhancer.h"
+#include "engine/memory/texture_uploader.h"
 #include "objects/material.h"
 #include "objects/post_effect_data.h"
 #include "objects/scene.h"
@@ -72,6 +73,12 @@ void Renderer::renderCamera(Scene* scene, Camera* camera, int framebufferId,
     // on hold and do this kind of conversion fist
 
     numberDrawCalls = 0;
+
+    // pick up custom shaders that finished linking since the last pass
+    shader_manager->update();
+    post_effect_shader_manager->update();
+    // textures uploaded in the background become visible once complete
+    texture_uploader.update();
     numberTriangles = 0;
 
     if (scene->getSceneDirtyFlag()) {
@@ -80,21 +87,72 @@ void Renderer::renderCamera(Scene* scene, Camera* camera, int framebufferId,
         glm::mat4 projection_matrix = camera->getProjectionMatrix();
         glm::mat4 vp_matrix = glm::mat4(projection_matrix * view_matrix);
 
+        FrameUniforms frame;
+        frame.view = view_matrix;
+        frame.projection = projection_matrix;
+        frame.view_inverse = glm::inverse(view_matrix);
+
         std::vector<SceneObject*> scene_objects = scene->getWholeSceneObjects();
         std::vector<RenderData*> render_data_vector;
 
         // do occlusion culling, if enabled
         occlusion_cull(scene, scene_objects);
 
-        // do frustum culling, if enabled
+        // a world space length l at distance d covers l * pixels_per_unit / d
+        // pixels of the viewport's height
+        glm::vec3 camera_position(frame.view_inverse[3]);
+        float pixels_per_unit = 0.5f * viewportHeight
+                * projection_matrix[1][1];
+
+        // do frustum culling, if enabled, and pick the levels of detail
         frustum_cull(scene, scene_objects, render_data_vector, vp_matrix,
-                shader_manager);
+                camera_position, pixels_per_unit, shader_manager);
 
         // do sorting based on render order
+        for (auto it = render_data_vector.begin();
+                it != render_data_vector.end(); ++it) {
+            (*it)->set_sort_key(sortKey(*it));
+        }
         std::sort(render_data_vector.begin(), render_data_vector.end(),
                 compareRenderData);
 
-        std::vector<PostEffectData*> post_effects = camera->post_effect_data();
+        // the matrices of everything drawn, computed in one pass for the
+        // plain uniforms of the stock shaders and streamed to the uniform
+        // blocks of the custom ones
+        std::vector<TransformUniforms> transforms(render_data_vector.size());
+        std::vector<GLintptr> transform_offsets(render_data_vector.size(), 0);
+        for (int i = 0; i < render_data_vector.size(); ++i) {
+            computeTransform(render_data_vector[i], frame, transforms[i]);
+        }
+
+#if _GVRF_USE_GLES3_
+        UniformRingBuffer* uniform_ring_buffer =
+                shader_manager->getUniformRingBuffer();
+        uniform_ring_buffer->map(
+                uniform_ring_buffer->alignedSize(sizeof(FrameUniforms), 1)
+                        + uniform_ring_buffer->alignedSize(
+                                sizeof(TransformUniforms), transforms.size()));
+        GLintptr frame_offset = uniform_ring_buffer->write(&frame,
+                sizeof(FrameUniforms));
+        for (int i = 0; i < transforms.size(); ++i) {
+            transform_offsets[i] = uniform_ring_buffer->write(&transforms[i],
+                    sizeof(TransformUniforms));
+        }
+        uniform_ring_buffer->unmap();
+        glBindBufferRange(GL_UNIFORM_BUFFER, FrameUniforms::BINDING_POINT,
+                uniform_ring_buffer->id(), frame_offset, sizeof(FrameUniforms));
+#endif
+
+        // custom effects still linking are left out instead of waited for
+        std::vector<PostEffectData*> post_effects;
+        const std::vector<PostEffectData*>& camera_post_effects =
+                camera->post_effect_data();
+        for (auto it = camera_post_effects.begin();
+                it != camera_post_effects.end(); ++it) {
+            if (post_effect_ready(*it, post_effect_shader_manager)) {
+                post_effects.push_back(*it);
+            }
+        }
 
         glEnable (GL_DEPTH_TEST);
         glDepthFunc (GL_LEQUAL);
@@ -115,10 +173,10 @@ void Renderer::renderCamera(Scene* scene, Camera* camera, int framebufferId,
                     camera->background_color_a());
             glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
 
-            for (auto it = render_data_vector.begin();
-                    it != render_data_vector.end(); ++it) {
-                renderRenderData(*it, view_matrix, projection_matrix,
-                        camera->render_mask(), shader_manager);
+            for (int i = 0; i < render_data_vector.size(); ++i) {
+                renderRenderData(render_data_vector[i], frame, transforms[i],
+                        transform_offsets[i], camera->render_mask(),
+                        shader_manager);
             }
         } else {
             RenderTexture* texture_render_texture = post_effect_render_texture_a;
@@ -134,10 +192,10 @@ void Renderer::renderCamera(Scene* scene, Camera* camera, int framebufferId,
                     camera->background_color_a());
             glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
 
-            for (auto it = render_data_vector.begin();
-                    it != render_data_vector.end(); ++it) {
-                renderRenderData(*it, view_matrix, projection_matrix,
-                        camera->render_mask(), shader_manager);
+            for (int i = 0; i < render_data_vector.size(); ++i) {
+                renderRenderData(render_data_vector[i], frame, transforms[i],
+                        transform_offsets[i], camera->render_mask(),
+                        shader_manager);
             }
 
             glDisable(GL_DEPTH_TEST);
@@ -166,6 +224,10 @@ void Renderer::renderCamera(Scene* scene, Camera* camera, int framebufferId,
                     post_effects.back(), post_effect_shader_manager);
         }
 
+#if _GVRF_USE_GLES3_
+        // the segment is rewritten once the GPU passed this point
+        uniform_ring_buffer->fence();
+#endif
     } // flag checking
 
 }
@@ -212,18 +274,34 @@ void Renderer::occlusion_cull(Scene* scene,
 void Renderer::frustum_cull(Scene* scene,
         std::vector<SceneObject*> scene_objects,
         std::vector<RenderData* >& render_data_vector,
-        glm::mat4 vp_matrix, ShaderManager* shader_manager) {
+        glm::mat4 vp_matrix, glm::vec3 camera_position, float pixels_per_unit,
+        ShaderManager* shader_manager) {
+    // the planes are extracted from the view projection matrix, so they are
+    // in world space and shared by every object
+    float frustum[6][4];
+    build_frustum(frustum, glm::value_ptr(vp_matrix));
+
+    // screen-space error thresholds become switch distances: an error e
+    // shows as e * pixels_per_unit / d pixels at distance d
+    float error_scale = pixels_per_unit / scene->get_lod_error_pixels();
+    float lod_bias = scene->get_lod_bias();
+    float lod_hysteresis = scene->get_lod_hysteresis();
+    float small_feature_pixels = scene->get_small_feature_pixels();
+
     for (auto it = scene_objects.begin(); it != scene_objects.end(); ++it) {
 
         RenderData* render_data = (*it)->render_data();
         if (render_data == 0 || render_data->material() == 0) {
             continue;
         }
+        render_data->clearDrawRanges();
 
         // Check for frustum culling flag
-        if (!scene->get_frustum_culling()) {
+        if (!scene->get_frustum_culling() && render_data->lod_count() == 0) {
             //No occlusion or frustum tests enabled
             render_data_vector.push_back(render_data);
+            request_texture_detail(render_data, glm::mat4(), 0.0f,
+                    pixels_per_unit);
             continue;
         }
 
@@ -233,29 +311,47 @@ void Renderer::frustum_cull(Scene* scene,
             continue;
         }
 
-        const float* bounding_box_info = currentMesh->getBoundingBoxInfo();
-        if(bounding_box_info == NULL) {
+        const BoundingVolume& bounding_volume =
+                currentMesh->getBoundingVolume();
+        if (bounding_volume.empty()) {
             continue;
         }
 
         glm::mat4 model_matrix_tmp(
                 render_data->owner_object()->transform()->getModelMatrix());
-        glm::mat4 mvp_matrix_tmp(vp_matrix * model_matrix_tmp);
-
-        // Frustum
-        float frustum[6][4];
-
-        // Matrix to array
-        float mvp_matrix_array[16] = { 0.0 };
-        const float *mat_to_array = (const float*) glm::value_ptr(
-                mvp_matrix_tmp);
-        memcpy(mvp_matrix_array, mat_to_array, sizeof(float) * 16);
+        BoundingVolume world_volume;
+        world_volume.transform(bounding_volume, model_matrix_tmp);
+
+        // distance from the camera to the nearest point of the bounds
+        float center_distance = glm::length(
+                world_volume.center() - camera_position);
+        float distance = std::max(center_distance - world_volume.radius(),
+                0.0f);
+        // from inside, as for a sky sphere, the surface is about as far
+        // as the bounding sphere around the camera
+        float texture_distance = std::abs(
+                center_distance - world_volume.radius());
+
+        if (render_data->lod_count() > 0) {
+            // geometric errors are in mesh units, so they grow with the
+            // object's scale
+            float threshold_scale =
+                    render_data->lod_mode() == RenderData::LOD_SCREEN_ERROR ?
+                            error_scale * max_axis_scale(model_matrix_tmp) :
+                            1.0f;
+            render_data->selectLod(distance * lod_bias, threshold_scale,
+                    lod_hysteresis);
+        }
 
-        // Build the frustum
-        build_frustum(frustum, mvp_matrix_array);
+        if (!scene->get_frustum_culling()) {
+            render_data_vector.push_back(render_data);
+            request_texture_detail(render_data, model_matrix_tmp,
+                    texture_distance, pixels_per_unit);
+            continue;
+        }
 
         // Check for being inside or outside frustum
-        bool is_inside = is_cube_in_frustum(frustum, bounding_box_info);
+        bool is_inside = is_cube_in_frustum(frustum, world_volume);
 
         // Only push those scene objects that are inside of the frustum
         if (!is_inside) {
@@ -263,6 +359,21 @@ void Renderer::frustum_cull(Scene* scene,
             continue;
         }
 
+        // Skip objects too small to cover more than a few pixels
+        if (small_feature_pixels > 0.0f && distance > 0.0f
+                && 2.0f * world_volume.radius() * pixels_per_unit
+                        < small_feature_pixels * distance) {
+            (*it)->set_in_frustum(false);
+            continue;
+        }
+
+        // Narrow a clustered mesh down to its visible clusters
+        if (!cluster_cull(frustum, render_data, model_matrix_tmp,
+                camera_position)) {
+            (*it)->set_in_frustum(false);
+            continue;
+        }
+
         (*it)->set_in_frustum();
         bool visible = (*it)->visible();
 
@@ -270,6 +381,8 @@ void Renderer::frustum_cull(Scene* scene,
         //turn visibility on for the object
         if (visible) {
             render_data_vector.push_back(render_data);
+            request_texture_detail(render_data, model_matrix_tmp,
+                    texture_distance, pixels_per_unit);
         }
 
         if (render_data->material() == 0 || !scene->get_occlusion_culling()) {
@@ -283,6 +396,8 @@ void Renderer::frustum_cull(Scene* scene,
 
         bool is_query_issued = (*it)->is_query_issued();
         if (!is_query_issued) {
+            glm::mat4 mvp_matrix_tmp(vp_matrix * model_matrix_tmp);
+
             //Setup basic bounding box and material
             RenderData* bounding_box_render_data(
                     new RenderData());
@@ -312,7 +427,76 @@ void Renderer::frustum_cull(Scene* scene,
     }
 }
 
-void Renderer::build_frustum(float frustum[6][4], float mvp_matrix[16]) {
+void Renderer::request_texture_detail(RenderData* render_data,
+        const glm::mat4& model_matrix, float distance, float pixels_per_unit) {
+    Texture* texture = render_data->material()->findTexture(NAME_MAIN_TEXTURE);
+    if (texture == 0) {
+        return;
+    }
+    float uv_per_pixel = 0.0f;
+    Mesh* mesh = render_data->mesh();
+    if (mesh != 0 && distance > 0.0f) {
+        // the largest axis scale asks for the finest detail the object needs
+        float max_scale = max_axis_scale(model_matrix);
+        if (max_scale > 0.0f) {
+            uv_per_pixel = mesh->getUVDensity() / max_scale * distance
+                    / pixels_per_unit;
+        }
+    }
+    texture->requestDetail(uv_per_pixel);
+}
+
+// how much the model matrix stretches mesh units at most
+float Renderer::max_axis_scale(const glm::mat4& model_matrix) {
+    glm::mat3 linear(model_matrix);
+    return std::max(glm::length(linear[0]),
+            std::max(glm::length(linear[1]), glm::length(linear[2])));
+}
+
+bool Renderer::cluster_cull(float frustum[6][4], RenderData* render_data,
+        const glm::mat4& model_matrix, const glm::vec3& camera_position) {
+    const std::vector<MeshCluster>& clusters =
+            render_data->mesh()->getClusters();
+    if (clusters.empty() || render_data->draw_mode() != GL_TRIANGLES) {
+        return true;
+    }
+
+    // Spheres are tested in world space. The cones are tested in model
+    // space, which only matches the rasterizer's face culling when the
+    // model matrix neither mirrors nor scales unevenly.
+    glm::mat3 linear(model_matrix);
+    float scale_x = glm::length(linear[0]);
+    float scale_y = glm::length(linear[1]);
+    float scale_z = glm::length(linear[2]);
+    float max_scale = std::max(scale_x, std::max(scale_y, scale_z));
+    float min_scale = std::min(scale_x, std::min(scale_y, scale_z));
+    bool cone_test = render_data->cull_test()
+            && min_scale > 0.99f * max_scale
+            && glm::determinant(linear) > 0.0f;
+    glm::vec3 local_camera(
+            glm::inverse(model_matrix) * glm::vec4(camera_position, 1.0f));
+
+    int visible = 0;
+    for (auto it = clusters.begin(); it != clusters.end(); ++it) {
+        if (cone_test && it->backfacing(local_camera)) {
+            continue;
+        }
+        glm::vec3 center(model_matrix * glm::vec4(it->center, 1.0f));
+        if (!is_sphere_in_frustum(frustum, center, it->radius * max_scale)) {
+            continue;
+        }
+        render_data->addDrawRange(it->first_index, it->index_count);
+        ++visible;
+    }
+
+    if (visible == static_cast<int>(clusters.size())) {
+        // everything is visible, a single draw covers it
+        render_data->clearDrawRanges();
+    }
+    return visible > 0;
+}
+
+void Renderer::build_frustum(float frustum[6][4], const float mvp_matrix[16]) {
     float t;
 
     /* Extract the numbers for the RIGHT plane */
@@ -406,41 +590,39 @@ void Renderer::build_frustum(float frustum[6][4], float mvp_matrix[16]) {
     frustum[5][3] /= t;
 }
 
-bool Renderer::is_cube_in_frustum(float frustum[6][4], const float *vertex_limit) {
-    int p;
-    float Xmin = vertex_limit[0];
-    float Ymin = vertex_limit[1];
-    float Zmin = vertex_limit[2];
-    float Xmax = vertex_limit[3];
-    float Ymax = vertex_limit[4];
-    float Zmax = vertex_limit[5];
-
-    for (p = 0; p < 6; p++) {
-        if (frustum[p][0] * (Xmin) + frustum[p][1] * (Ymin)
-                + frustum[p][2] * (Zmin) + frustum[p][3] > 0)
-            continue;
-        if (frustum[p][0] * (Xmax) + frustum[p][1] * (Ymin)
-                + frustum[p][2] * (Zmin) + frustum[p][3] > 0)
-            continue;
-        if (frustum[p][0] * (Xmin) + frustum[p][1] * (Ymax)
-                + frustum[p][2] * (Zmin) + frustum[p][3] > 0)
-            continue;
-        if (frustum[p][0] * (Xmax) + frustum[p][1] * (Ymax)
-                + frustum[p][2] * (Zmin) + frustum[p][3] > 0)
-            continue;
-        if (frustum[p][0] * (Xmin) + frustum[p][1] * (Ymin)
-                + frustum[p][2] * (Zmax) + frustum[p][3] > 0)
-            continue;
-        if (frustum[p][0] * (Xmax) + frustum[p][1] * (Ymin)
-                + frustum[p][2] * (Zmax) + frustum[p][3] > 0)
-            continue;
-        if (frustum[p][0] * (Xmin) + frustum[p][1] * (Ymax)
-                + frustum[p][2] * (Zmax) + frustum[p][3] > 0)
-            continue;
-        if (frustum[p][0] * (Xmax) + frustum[p][1] * (Ymax)
-                + frustum[p][2] * (Zmax) + frustum[p][3] > 0)
-            continue;
-        return false;
+bool Renderer::is_sphere_in_frustum(float frustum[6][4],
+        const glm::vec3& center, float radius) {
+    for (int p = 0; p < 6; p++) {
+        if (frustum[p][0] * center.x + frustum[p][1] * center.y
+                + frustum[p][2] * center.z + frustum[p][3] < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Renderer::is_cube_in_frustum(float frustum[6][4],
+        const BoundingVolume& volume) {
+    const glm::vec3& center = volume.center();
+    const glm::vec3& min_corner = volume.min_corner();
+    const glm::vec3& max_corner = volume.max_corner();
+
+    for (int p = 0; p < 6; p++) {
+        // the sphere rejects cheaply when it is fully behind a plane
+        float distance = frustum[p][0] * center.x + frustum[p][1] * center.y
+                + frustum[p][2] * center.z + frustum[p][3];
+        if (distance < -volume.radius()) {
+            return false;
+        }
+
+        // otherwise test the box corner furthest along the plane normal
+        float x = frustum[p][0] > 0 ? max_corner.x : min_corner.x;
+        float y = frustum[p][1] > 0 ? max_corner.y : min_corner.y;
+        float z = frustum[p][2] > 0 ? max_corner.z : min_corner.z;
+        if (frustum[p][0] * x + frustum[p][1] * y + frustum[p][2] * z
+                + frustum[p][3] <= 0) {
+            return false;
+        }
     }
     return true;
 }
@@ -485,8 +667,51 @@ void Renderer::renderCamera(Scene* scene, Camera* camera, int viewportX,
             post_effect_render_texture_a, post_effect_render_texture_b);
 }
 
+/*
+ * The program in the high word - the variant keywords for the unlit and
+ * OES types, the shader type above them for the others - and the main
+ * texture in the low one, so materials sharing an atlas page or any other
+ * texture are drawn together. Materials without a main texture sort by
+ * themselves.
+ */
+uint64_t Renderer::sortKey(RenderData* render_data) {
+    Material* material = render_data->material();
+    if (material == 0) {
+        return 0;
+    }
+    uint32_t program = (material->shader_type() + 1) << 8;
+    if (VariantShader::handles(material->shader_type())) {
+        try {
+            program = VariantShader::keywords(material);
+        } catch (std::string error) {
+            // drawn by the error shader anyway
+        }
+    }
+    Texture* main_texture = material->findTexture(NAME_MAIN_TEXTURE);
+    uint32_t state_bits = static_cast<uint32_t>(
+            main_texture != 0 ?
+                    reinterpret_cast<uintptr_t>(main_texture) :
+                    reinterpret_cast<uintptr_t>(material));
+    return (static_cast<uint64_t>(program) << 32) | state_bits;
+}
+
+void Renderer::computeTransform(RenderData* render_data,
+        const FrameUniforms& frame, TransformUniforms& transform) {
+    transform.model =
+            render_data->owner_object()->transform()->getModelMatrix();
+    transform.mv = frame.view * transform.model;
+    transform.mvp = frame.projection * transform.mv;
+
+    // only the reflection and custom shaders read the normal matrix
+    int shader_type = render_data->material()->shader_type();
+    if (shader_type >= Material::CUBEMAP_REFLECTION_SHADER) {
+        transform.mv_inverse_transpose = glm::inverseTranspose(transform.mv);
+    }
+}
+
 void Renderer::renderRenderData(RenderData* render_data,
-		const glm::mat4& view_matrix, const glm::mat4& projection_matrix, int render_mask,
+        const FrameUniforms& frame, const TransformUniforms& transform,
+        GLintptr transform_offset, int render_mask,
         ShaderManager* shader_manager) {
     if (render_mask & render_data->render_mask()) {
         if (!render_data->cull_test()) {
@@ -503,55 +728,59 @@ void Renderer::renderRenderData(RenderData* render_data,
         if (!render_data->alpha_blend()) {
             glDisable (GL_BLEND);
         }
-        if (render_data->mesh() != 0) {
-            numberTriangles += render_data->mesh()->getNumTriangles();
-            numberDrawCalls++;
-            glm::mat4 model_matrix(
-                    render_data->owner_object()->transform()->getModelMatrix());
-            glm::mat4 mv_matrix(view_matrix * model_matrix);
-            glm::mat4 mvp_matrix(projection_matrix * mv_matrix);
+        // not drawn until its texture has finished uploading
+        Texture* main_texture = render_data->material()->findTexture(
+                NAME_MAIN_TEXTURE);
+        bool upload_pending = main_texture != 0
+                && main_texture->upload_pending();
+        if (render_data->mesh() != 0 && !upload_pending) {
+            const glm::mat4& mvp_matrix = transform.mvp;
+            // counted in the stats only once a draw is issued
+            bool drawn = true;
             try {
                 bool right = render_mask & RenderData::RenderMaskBit::Right;
                 switch (render_data->material()->shader_type()) {
                 case Material::ShaderType::UNLIT_SHADER:
-                    shader_manager->getUnlitShader()->render(mvp_matrix,
-                            render_data);
-                    break;
                 case Material::ShaderType::UNLIT_HORIZONTAL_STEREO_SHADER:
-                    shader_manager->getUnlitHorizontalStereoShader()->render(
-                            mvp_matrix, render_data, right);
-                    break;
                 case Material::ShaderType::UNLIT_VERTICAL_STEREO_SHADER:
-                    shader_manager->getUnlitVerticalStereoShader()->render(
-                            mvp_matrix, render_data, right);
-                    break;
                 case Material::ShaderType::OES_SHADER:
-                    shader_manager->getOESShader()->render(mvp_matrix,
-                            render_data);
-                    break;
                 case Material::ShaderType::OES_HORIZONTAL_STEREO_SHADER:
-                    shader_manager->getOESHorizontalStereoShader()->render(
-                            mvp_matrix, render_data, right);
-                    break;
                 case Material::ShaderType::OES_VERTICAL_STEREO_SHADER:
-                    shader_manager->getOESVerticalStereoShader()->render(
-                            mvp_matrix, render_data, right);
+                    shader_manager->getVariantShader()->render(mvp_matrix,
+                            render_data,
+                            VariantShader::keywords(render_data->material()),
+                            right);
                     break;
                 case Material::ShaderType::CUBEMAP_SHADER:
-                    shader_manager->getCubemapShader()->render(model_matrix,
-                            mvp_matrix, render_data);
+                    shader_manager->getCubemapShader()->render(
+                            transform.model, mvp_matrix, render_data);
                     break;
                 case Material::ShaderType::CUBEMAP_REFLECTION_SHADER:
                     shader_manager->getCubemapReflectionShader()->render(
-                            mv_matrix, glm::inverseTranspose(mv_matrix),
-                            glm::inverse(view_matrix), mvp_matrix, render_data);
+                            transform.mv, transform.mv_inverse_transpose,
+                            frame.view_inverse, mvp_matrix, render_data);
                     break;
-                default:
-                    shader_manager->getCustomShader(
-                            render_data->material()->shader_type())->render(
-                            mvp_matrix, render_data, right);
+                default: {
+                    CustomShader* custom_shader =
+                            shader_manager->getCustomShader(
+                                    render_data->material()->shader_type());
+                    // not drawn until its program has linked
+                    if (!custom_shader->ready()) {
+                        drawn = false;
+                        break;
+                    }
+#if _GVRF_USE_GLES3_
+                    if (custom_shader->uses_transform_block()) {
+                        glBindBufferRange(GL_UNIFORM_BUFFER,
+                                TransformUniforms::BINDING_POINT,
+                                shader_manager->getUniformRingBuffer()->id(),
+                                transform_offset, sizeof(TransformUniforms));
+                    }
+#endif
+                    custom_shader->render(mvp_matrix, render_data, right);
                     break;
                 }
+                }
             } catch (std::string error) {
                 LOGE(
                         "Error detected in Renderer::renderRenderData; name : %s, error : %s",
@@ -560,6 +789,10 @@ void Renderer::renderRenderData(RenderData* render_data,
                 shader_manager->getErrorShader()->render(mvp_matrix,
                         render_data);
             }
+            if (drawn) {
+                numberTriangles += render_data->drawn_triangle_count();
+                numberDrawCalls++;
+            }
         }
         if (!render_data->cull_test()) {
             glEnable (GL_CULL_FACE);
@@ -576,6 +809,18 @@ void Renderer::renderRenderData(RenderData* render_data,
     }
 }
 
+bool Renderer::post_effect_ready(PostEffectData* post_effect_data,
+        PostEffectShaderManager* post_effect_shader_manager) {
+    switch (post_effect_data->shader_type()) {
+    case PostEffectData::ShaderType::COLOR_BLEND_SHADER:
+    case PostEffectData::ShaderType::HORIZONTAL_FLIP_SHADER:
+        return true;
+    default:
+        return post_effect_shader_manager->getCustomPostEffectShader(
+                post_effect_data->shader_type())->ready();
+    }
+}
+
 void Renderer::renderPostEffectData(Camera* camera,
         RenderTexture* render_texture,
         PostEffectData* post_effect_data,
@@ -596,15 +841,18 @@ void Renderer::renderPostEffectData(Camera* camera,
                     post_effect_shader_manager->quad_uvs(),
                     post_effect_shader_manager->quad_triangles());
             break;
-        default:
-            post_effect_shader_manager->getCustomPostEffectShader(
-                    post_effect_data->shader_type())->render(camera,
-                    render_texture, post_effect_data,
+        default: {
+            CustomPostEffectShader* custom_post_effect_shader =
+                    post_effect_shader_manager->getCustomPostEffectShader(
+                            post_effect_data->shader_type());
+            custom_post_effect_shader->render(camera, render_texture,
+                    post_effect_data,
                     post_effect_shader_manager->quad_vertices(),
                     post_effect_shader_manager->quad_uvs(),
                     post_effect_shader_manager->quad_triangles());
             break;
         }
+        }
     } catch (std::string error) {
         LOGE("Error detected in Renderer::renderPostEffectData; error : %s",
                 error.c_str());
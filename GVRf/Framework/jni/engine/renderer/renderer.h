@@ -33,9 +33,11 @@
 
 #include "glm/glm.hpp"
 
+#include "objects/bounding_volume.h"
 #include "objects/eye_type.h"
 #include "objects/mesh.h"
 #include "gl/gl_program.h"
+#include "shaders/material/transform_uniforms.h"
 
 namespace gvr {
 class Camera;
@@ -93,21 +95,38 @@ public:
 
 private:
     static void renderRenderData(RenderData* render_data,
-    		const glm::mat4& view_matrix, const glm::mat4& projection_matrix, int render_mask,
+            const FrameUniforms& frame, const TransformUniforms& transform,
+            GLintptr transform_offset, int render_mask,
             ShaderManager* shader_manager);
+    static uint64_t sortKey(RenderData* render_data);
+    static void computeTransform(RenderData* render_data,
+            const FrameUniforms& frame, TransformUniforms& transform);
     static void renderPostEffectData(Camera* camera,
             RenderTexture* render_texture,
             PostEffectData* post_effect_data,
             PostEffectShaderManager* post_effect_shader_manager);
+    static bool post_effect_ready(PostEffectData* post_effect_data,
+            PostEffectShaderManager* post_effect_shader_manager);
 
     static void occlusion_cull(Scene* scene, std::vector <  SceneObject* > scene_objects);
     static void frustum_cull(Scene* scene,
         std::vector < SceneObject* > scene_objects,
         std::vector < RenderData* >& render_data_vector,
         glm::mat4 vp_matrix,
+        glm::vec3 camera_position,
+        float pixels_per_unit,
         ShaderManager* shader_manager);
-    static void build_frustum(float frustum[6][4], float mvp_matrix[16]);
-    static bool is_cube_in_frustum( float frustum[6][4], const float *vertex_limit);
+    static void request_texture_detail(RenderData* render_data,
+            const glm::mat4& model_matrix, float distance,
+            float pixels_per_unit);
+    static float max_axis_scale(const glm::mat4& model_matrix);
+    static bool cluster_cull(float frustum[6][4], RenderData* render_data,
+            const glm::mat4& model_matrix, const glm::vec3& camera_position);
+    static void build_frustum(float frustum[6][4], const float mvp_matrix[16]);
+    static bool is_sphere_in_frustum(float frustum[6][4],
+            const glm::vec3& center, float radius);
+    static bool is_cube_in_frustum(float frustum[6][4],
+            const BoundingVolume& volume);
 
     Renderer(const Renderer& render_engine);
     Renderer(Renderer&& render_engine);
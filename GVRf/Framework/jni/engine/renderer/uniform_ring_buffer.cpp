@@ -0,0 +1,127 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * A uniform buffer streamed in segments, one per rendered view, that are
+ * only rewritten after the GPU is done reading them.
+ ***************************************************************************/
+
+#include "uniform_ring_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "engine/memory/gl_delete.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+
+// how long to block on a fence before complaining, in nanoseconds
+static const GLuint64 FENCE_TIMEOUT = 100000000;
+
+UniformRingBuffer::UniformRingBuffer() :
+        id_(0), alignment_(256), segment_size_(0), segment_(0), mapped_(0), mapped_offset_(
+                0), mapped_size_(0) {
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment > 0) {
+        alignment_ = alignment;
+    }
+    for (int i = 0; i < SEGMENT_COUNT; ++i) {
+        fences_[i] = 0;
+    }
+    glGenBuffers(1, &id_);
+}
+
+UniformRingBuffer::~UniformRingBuffer() {
+    for (int i = 0; i < SEGMENT_COUNT; ++i) {
+        if (fences_[i] != 0) {
+            glDeleteSync(fences_[i]);
+        }
+    }
+    gl_delete.queueBuffer(id_);
+}
+
+void UniformRingBuffer::grow(size_t size) {
+    // drop the fences: the old storage is orphaned and stays alive for
+    // the draws still reading it
+    for (int i = 0; i < SEGMENT_COUNT; ++i) {
+        if (fences_[i] != 0) {
+            glDeleteSync(fences_[i]);
+            fences_[i] = 0;
+        }
+    }
+    segment_size_ = std::max(size, 2 * segment_size_);
+    segment_size_ = (segment_size_ + alignment_ - 1) / alignment_ * alignment_;
+    glBindBuffer(GL_UNIFORM_BUFFER, id_);
+    glBufferData(GL_UNIFORM_BUFFER, segment_size_ * SEGMENT_COUNT, 0,
+            GL_STREAM_DRAW);
+}
+
+void UniformRingBuffer::map(size_t size) {
+    segment_ = (segment_ + 1) % SEGMENT_COUNT;
+    if (size > segment_size_) {
+        grow(size);
+    }
+
+    GLsync fence = fences_[segment_];
+    if (fence != 0) {
+        GLenum result;
+        while ((result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                FENCE_TIMEOUT)) == GL_TIMEOUT_EXPIRED) {
+            LOGW("UniformRingBuffer::map() : waiting for the GPU");
+        }
+        if (result == GL_WAIT_FAILED) {
+            LOGE("UniformRingBuffer::map() : glClientWaitSync failed");
+        }
+        glDeleteSync(fence);
+        fences_[segment_] = 0;
+    }
+
+    // unsynchronized: the fence already guarantees the GPU is done with it
+    mapped_offset_ = segment_ * segment_size_;
+    mapped_size_ = 0;
+    glBindBuffer(GL_UNIFORM_BUFFER, id_);
+    mapped_ = static_cast<unsigned char*>(glMapBufferRange(GL_UNIFORM_BUFFER,
+            mapped_offset_, segment_size_,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+                    | GL_MAP_UNSYNCHRONIZED_BIT));
+    if (mapped_ == 0) {
+        LOGE("UniformRingBuffer::map() : glMapBufferRange failed");
+    }
+}
+
+GLintptr UniformRingBuffer::write(const void* data, size_t size) {
+    size_t offset = mapped_size_;
+    mapped_size_ += (size + alignment_ - 1) / alignment_ * alignment_;
+    if (mapped_ != 0 && mapped_size_ <= segment_size_) {
+        memcpy(mapped_ + offset, data, size);
+    }
+    return mapped_offset_ + offset;
+}
+
+void UniformRingBuffer::unmap() {
+    if (mapped_ != 0) {
+        glBindBuffer(GL_UNIFORM_BUFFER, id_);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+        mapped_ = 0;
+    }
+}
+
+void UniformRingBuffer::fence() {
+    fences_[segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+}
@@ -0,0 +1,82 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * A uniform buffer streamed in segments, one per rendered view, that are
+ * only rewritten after the GPU is done reading them.
+ ***************************************************************************/
+
+#ifndef UNIFORM_RING_BUFFER_H_
+#define UNIFORM_RING_BUFFER_H_
+
+#include <cstddef>
+
+#include "GLES3/gl3.h"
+
+namespace gvr {
+
+class UniformRingBuffer {
+public:
+    // three frames of two eyes in flight
+    static const int SEGMENT_COUNT = 6;
+
+    UniformRingBuffer();
+    ~UniformRingBuffer();
+
+    GLuint id() const {
+        return id_;
+    }
+
+    /*
+     * Map the next segment with room for size bytes, counting the alignment
+     * of each write. Waits if the GPU still reads the segment from
+     * SEGMENT_COUNT views ago.
+     */
+    void map(size_t size);
+
+    // copy a block into the mapped segment and return its buffer offset
+    GLintptr write(const void* data, size_t size);
+
+    void unmap();
+
+    // call after the draws that read the segment were issued
+    void fence();
+
+    // the size map() needs for count blocks of size bytes
+    size_t alignedSize(size_t size, int count) const {
+        return count * ((size + alignment_ - 1) / alignment_ * alignment_);
+    }
+
+private:
+    void grow(size_t size);
+
+    UniformRingBuffer(const UniformRingBuffer& buffer);
+    UniformRingBuffer(UniformRingBuffer&& buffer);
+    UniformRingBuffer& operator=(const UniformRingBuffer& buffer);
+    UniformRingBuffer& operator=(UniformRingBuffer&& buffer);
+
+private:
+    GLuint id_;
+    size_t alignment_;
+    size_t segment_size_;
+    int segment_;
+    GLsync fences_[SEGMENT_COUNT];
+    unsigned char* mapped_;
+    size_t mapped_offset_;
+    size_t mapped_size_;
+};
+
+}
+#endif
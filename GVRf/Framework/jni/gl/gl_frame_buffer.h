@@ -24,13 +24,14 @@
 #include "GLES3/gl3.h"
 
 #include "engine/memory/gl_delete.h"
+#include "engine/memory/gl_name_pool.h"
 
 namespace gvr {
 
 class GLFrameBuffer {
 public:
     GLFrameBuffer() {
-        glGenFramebuffers(1, &id_);
+        id_ = gl_name_pool.genFramebuffer();
     }
 
     ~GLFrameBuffer() {
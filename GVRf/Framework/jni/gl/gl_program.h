@@ -21,20 +21,101 @@
 #ifndef GL_PROGRAM_H_
 #define GL_PROGRAM_H_
 
+#include <string>
+#include <cstring>
+
+#include "EGL/egl.h"
 #include "GLES3/gl3.h"
 
 #include "engine/memory/gl_delete.h"
+#include "engine/memory/texture_uploader.h"
+#include "gl/program_cache.h"
 
+#include "util/gvr_gl.h"
 #include "util/gvr_log.h"
 
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace gvr {
+typedef void (*PFNGLMAXSHADERCOMPILERTHREADSKHR)(GLuint count);
+
 class GLProgram {
 public:
     GLProgram(const char* pVertexSource, const char* pFragmentSource) :
-            id_(createProgram(pVertexSource, pFragmentSource)) {
+            id_(createProgram(pVertexSource, pFragmentSource)), pending_(
+                    false), link_ticket_(0), vertex_shader_(0), fragment_shader_(
+                    0) {
+    }
+
+    /*
+     * Attribute i of attribute_names is bound to location i, so programs
+     * declaring the same attributes can share VAOs.
+     */
+    GLProgram(const char* pVertexSource, const char* pFragmentSource,
+            const char* const * attribute_names, int attribute_count) :
+            id_(createProgram(pVertexSource, pFragmentSource, attribute_names,
+                    attribute_count)), pending_(false), link_ticket_(0), vertex_shader_(
+                    0), fragment_shader_(0) {
+    }
+
+    /*
+     * A deferred program only issues compile and link; nothing waits for
+     * them until poll(). A cached binary is still used when there is one.
+     * Without GL_KHR_parallel_shader_compile, the texture uploader's shared
+     * context compiles and links it, if there is one.
+     */
+    GLProgram(const char* pVertexSource, const char* pFragmentSource,
+            bool deferred) :
+            id_(0), pending_(false), link_ticket_(0), vertex_shader_(0), fragment_shader_(
+                    0) {
+        if (!deferred) {
+            id_ = createProgram(pVertexSource, pFragmentSource);
+            return;
+        }
+#if _GVRF_USE_GLES3_
+        id_ = ProgramCache::load(pVertexSource, pFragmentSource);
+        if (id_) {
+            return;
+        }
+#endif
+        vertex_source_ = pVertexSource;
+        fragment_source_ = pFragmentSource;
+        pending_ = true;
+        id_ = glCreateProgram();
+#if _GVRF_USE_GLES3_
+        glProgramParameteri(id_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+        if (!parallelCompile()) {
+            link_ticket_ = texture_uploader.link(id_, pVertexSource,
+                    pFragmentSource);
+            if (link_ticket_ != 0) {
+                return;
+            }
+        }
+
+        vertex_shader_ = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(vertex_shader_, 1, &pVertexSource, NULL);
+        glCompileShader(vertex_shader_);
+        fragment_shader_ = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(fragment_shader_, 1, &pFragmentSource, NULL);
+        glCompileShader(fragment_shader_);
+        glAttachShader(id_, vertex_shader_);
+        glAttachShader(id_, fragment_shader_);
+        glLinkProgram(id_);
     }
 
     ~GLProgram() {
+        if (link_ticket_ != 0) {
+            texture_uploader.cancelLink(link_ticket_);
+        }
+        if (vertex_shader_) {
+            gl_delete.queueShader(vertex_shader_);
+        }
+        if (fragment_shader_) {
+            gl_delete.queueShader(fragment_shader_);
+        }
         gl_delete.queueProgram(id_);
     }
 
@@ -42,6 +123,95 @@ public:
         return id_;
     }
 
+    /*
+     * Whether a deferred program is done linking; id() is 0 afterwards if
+     * that failed. Without wait it only asks the driver when
+     * GL_KHR_parallel_shader_compile can say so without blocking.
+     */
+    bool poll(bool wait) {
+        if (!pending_) {
+            return true;
+        }
+        if (link_ticket_ != 0) {
+            if (wait) {
+                texture_uploader.finishLink(link_ticket_);
+            } else if (texture_uploader.linking(link_ticket_)) {
+                return false;
+            }
+            link_ticket_ = 0;
+        } else if (!wait) {
+            if (!parallelCompile()) {
+                return false;
+            }
+            GLint completed = GL_FALSE;
+            glGetProgramiv(id_, GL_COMPLETION_STATUS_KHR, &completed);
+            if (completed != GL_TRUE) {
+                return false;
+            }
+        }
+        pending_ = false;
+
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(id_, GL_LINK_STATUS, &linkStatus);
+        if (linkStatus != GL_TRUE) {
+            // the uploader logs the shaders it compiled itself
+            if (vertex_shader_) {
+                logShaderError(vertex_shader_, GL_VERTEX_SHADER);
+                logShaderError(fragment_shader_, GL_FRAGMENT_SHADER);
+            }
+            logProgramError(id_);
+            gl_delete.queueProgram(id_);
+            id_ = 0;
+        } else {
+#if _GVRF_USE_GLES3_
+            ProgramCache::store(id_, vertex_source_.c_str(),
+                    fragment_source_.c_str());
+#endif
+        }
+        if (vertex_shader_) {
+            gl_delete.queueShader(vertex_shader_);
+            gl_delete.queueShader(fragment_shader_);
+        }
+        vertex_shader_ = 0;
+        fragment_shader_ = 0;
+        vertex_source_.clear();
+        fragment_source_.clear();
+        return true;
+    }
+
+    /*
+     * Whether only poll(true) can tell when the program is done: it is
+     * linked on the GL thread by a driver that cannot say.
+     */
+    bool needsWait() const {
+        return pending_ && link_ticket_ == 0 && !parallelCompile();
+    }
+
+    /*
+     * Whether the driver compiles and links on threads of its own, so
+     * completion can be polled. Asks for as many threads as it likes the
+     * first time.
+     */
+    static bool parallelCompile() {
+        static int supported = -1;
+        if (supported < 0) {
+            const char* extensions =
+                    reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+            supported = extensions != 0
+                    && strstr(extensions, "GL_KHR_parallel_shader_compile")
+                            != 0;
+            if (supported) {
+                PFNGLMAXSHADERCOMPILERTHREADSKHR glMaxShaderCompilerThreadsKHR =
+                        reinterpret_cast<PFNGLMAXSHADERCOMPILERTHREADSKHR>(eglGetProcAddress(
+                                "glMaxShaderCompilerThreadsKHR"));
+                if (glMaxShaderCompilerThreadsKHR != 0) {
+                    glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+                }
+            }
+        }
+        return supported != 0;
+    }
+
     static void checkGlError(const char* op) {
         for (GLint error = glGetError(); error; error = glGetError()) {
             LOGI("after %s() glError (0x%x)\n", op, error);
@@ -74,8 +244,49 @@ public:
         return shader;
     }
 
+    static void logShaderError(GLuint shader, GLenum shaderType) {
+        GLint compiled = GL_FALSE;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+        if (compiled) {
+            return;
+        }
+        GLint infoLen = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLen);
+        if (infoLen) {
+            char* buf = (char*) malloc(infoLen);
+            if (buf) {
+                glGetShaderInfoLog(shader, infoLen, NULL, buf);
+                LOGE("Could not compile shader %d:\n%s\n", shaderType, buf);
+                free(buf);
+            }
+        }
+    }
+
+    static void logProgramError(GLuint program) {
+        GLint bufLength = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &bufLength);
+        if (bufLength) {
+            char* buf = (char*) malloc(bufLength);
+            if (buf) {
+                glGetProgramInfoLog(program, bufLength, NULL, buf);
+                LOGE("Could not link program:\n%s\n", buf);
+                free(buf);
+            }
+        }
+    }
+
     static GLuint createProgram(const char* pVertexSource,
-            const char* pFragmentSource) {
+            const char* pFragmentSource,
+            const char* const * attribute_names = 0,
+            int attribute_count = 0) {
+#if _GVRF_USE_GLES3_
+        GLuint cachedProgram = ProgramCache::load(pVertexSource,
+                pFragmentSource, attribute_names, attribute_count);
+        if (cachedProgram) {
+            return cachedProgram;
+        }
+#endif
+
         GLuint vertexShader = loadShader(GL_VERTEX_SHADER, pVertexSource);
         if (!vertexShader) {
             return 0;
@@ -92,6 +303,13 @@ public:
             checkGlError("glAttachShader");
             glAttachShader(program, pixelShader);
             checkGlError("glAttachShader");
+            for (int i = 0; i < attribute_count; ++i) {
+                glBindAttribLocation(program, i, attribute_names[i]);
+            }
+#if _GVRF_USE_GLES3_
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+                    GL_TRUE);
+#endif
             glLinkProgram(program);
             GLint linkStatus = GL_FALSE;
             glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
@@ -108,6 +326,11 @@ public:
                 }
                 gl_delete.queueProgram(program);
                 program = 0;
+            } else {
+#if _GVRF_USE_GLES3_
+                ProgramCache::store(program, pVertexSource, pFragmentSource,
+                        attribute_names, attribute_count);
+#endif
             }
         }
         return program;
@@ -115,6 +338,14 @@ public:
 
 private:
     GLuint id_;
+    // state of a deferred program until poll() sees it linked
+    bool pending_;
+    // its link on the texture uploader's context, 0 for none
+    unsigned int link_ticket_;
+    GLuint vertex_shader_;
+    GLuint fragment_shader_;
+    std::string vertex_source_;
+    std::string fragment_source_;
 };
 }
 #endif
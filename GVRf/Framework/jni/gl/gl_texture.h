@@ -24,13 +24,14 @@
 #include "GLES3/gl3.h"
 
 #include "engine/memory/gl_delete.h"
+#include "engine/memory/gl_name_pool.h"
 
 namespace gvr {
 class GLTexture {
 public:
     explicit GLTexture(GLenum target) :
             target_(target) {
-        glGenTextures(1, &id_);
+        id_ = gl_name_pool.genTexture(target);
         glBindTexture(target, id_);
         glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -40,7 +41,7 @@ public:
     }
 
     ~GLTexture() {
-        gl_delete.queueTexture(id_);
+        gl_delete.queueTexture(id_, target_);
     }
 
     GLuint id() const {
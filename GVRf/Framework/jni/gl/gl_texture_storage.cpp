@@ -0,0 +1,119 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Immutable texture storage, refilled through a ring of pixel buffers.
+ ***************************************************************************/
+
+#include "gl_texture_storage.h"
+
+#include <string.h>
+
+#include "util/gvr_log.h"
+
+namespace gvr {
+
+const int GLTextureStorage::RING_SIZE;
+
+GLTextureStorage::GLTextureStorage(GLenum internal_format, GLenum format,
+        GLenum type, int pixel_size) :
+        internal_format_(internal_format), format_(format), type_(type), pixel_size_(
+                pixel_size), width_(0), height_(0), levels_(0)
+#if _GVRF_USE_GLES3_
+                , next_buffer_(0)
+#endif
+{
+}
+
+bool GLTextureStorage::update(GLuint texture, int width, int height,
+        const void* pixels, bool mipmap) {
+    if (levels_ != 0 && (width != width_ || height != height_)) {
+        LOGE("GLTextureStorage: %dx%d update of %dx%d storage", width, height,
+                width_, height_);
+        return false;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, texture);
+    size_t row_size = width * pixel_size_;
+    if (row_size % 4 != 0) {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    }
+
+    bool allocate = levels_ == 0;
+    if (allocate) {
+        width_ = width;
+        height_ = height;
+        levels_ = 1;
+        if (mipmap) {
+            while ((width >> levels_) > 0 || (height >> levels_) > 0) {
+                ++levels_;
+            }
+        }
+#if _GVRF_USE_GLES3_
+        glTexStorage2D(GL_TEXTURE_2D, levels_, internal_format_, width,
+                height);
+#else
+        glTexImage2D(GL_TEXTURE_2D, 0, format_, width, height, 0, format_,
+                type_, pixels);
+#endif
+    }
+
+#if _GVRF_USE_GLES3_
+    size_t size = row_size * height;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixel_buffers_[next_buffer_].id());
+    // the driver hands back fresh memory if the GPU still reads the old
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, 0, GL_STREAM_DRAW);
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped != 0) {
+        memcpy(mapped, pixels, size);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format_, type_,
+                0);
+    } else {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format_, type_,
+                pixels);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    next_buffer_ = (next_buffer_ + 1) % RING_SIZE;
+#else
+    if (!allocate) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format_, type_,
+                pixels);
+    }
+#endif
+
+    if (mipmap && levels_ > 1) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    if (row_size % 4 != 0) {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+    return glGetError() == GL_NO_ERROR;
+}
+
+size_t GLTextureStorage::size() const {
+    size_t size = 0;
+    for (int level = 0; level < levels_; ++level) {
+        int width = width_ >> level;
+        int height = height_ >> level;
+        size += (width > 0 ? width : 1) * (height > 0 ? height : 1)
+                * pixel_size_;
+    }
+    return size;
+}
+
+}
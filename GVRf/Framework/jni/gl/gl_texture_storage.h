@@ -0,0 +1,81 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Immutable texture storage, refilled through a ring of pixel buffers.
+ ***************************************************************************/
+
+#ifndef GL_TEXTURE_STORAGE_H_
+#define GL_TEXTURE_STORAGE_H_
+
+#include <stddef.h>
+
+#include "GLES3/gl3.h"
+
+#include "gl/gl_buffer.h"
+#include "util/gvr_gl.h"
+
+namespace gvr {
+
+/*
+ * For textures updated every frame or so. The first update allocates the
+ * storage with glTexStorage2D(); later ones must match its size, and copy
+ * into it with glTexSubImage2D() from one of two PBOs in turn, so the copy
+ * into one never waits for the GPU to finish reading the other.
+ *
+ * Without GLES3 the first update is a glTexImage2D() of format, and later
+ * ones a glTexSubImage2D() from client memory.
+ */
+class GLTextureStorage {
+public:
+    GLTextureStorage(GLenum internal_format, GLenum format, GLenum type,
+            int pixel_size);
+
+    /*
+     * Copy width x height tightly packed pixels to level 0 of texture, a
+     * GL_TEXTURE_2D. The storage has a full mip chain if the first update
+     * asked for mipmaps, which are regenerated whenever an update does.
+     * False if the size differs from the first update's or GL failed.
+     */
+    bool update(GLuint texture, int width, int height, const void* pixels,
+            bool mipmap);
+
+    // of every level, 0 before the first update
+    size_t size() const;
+
+private:
+    GLTextureStorage(const GLTextureStorage& gl_texture_storage);
+    GLTextureStorage(GLTextureStorage&& gl_texture_storage);
+    GLTextureStorage& operator=(const GLTextureStorage& gl_texture_storage);
+    GLTextureStorage& operator=(GLTextureStorage&& gl_texture_storage);
+
+private:
+    static const int RING_SIZE = 2;
+
+    GLenum internal_format_;
+    GLenum format_;
+    GLenum type_;
+    int pixel_size_;
+    int width_;
+    int height_;
+    int levels_;
+#if _GVRF_USE_GLES3_
+    GLBuffer pixel_buffers_[RING_SIZE];
+    int next_buffer_;
+#endif
+};
+
+}
+#endif
@@ -0,0 +1,187 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * On-disk cache of linked GL program binaries.
+ ***************************************************************************/
+
+#include "program_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "engine/memory/gl_delete.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+
+const uint32_t ProgramCache::VERSION;
+std::mutex ProgramCache::lock_;
+std::string ProgramCache::directory_;
+
+static const char MAGIC[4] = { 'G', 'V', 'R', 'P' };
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+static uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// hashes the terminating zero too, so "ab" + "c" differs from "a" + "bc"
+static uint64_t fnv1a(uint64_t hash, const char* string) {
+    if (string == 0) {
+        string = "";
+    }
+    return fnv1a(hash, string, strlen(string) + 1);
+}
+
+void ProgramCache::setDirectory(const std::string& directory) {
+    mkdir(directory.c_str(), 0700);
+    std::lock_guard<std::mutex> lock(lock_);
+    directory_ = directory;
+}
+
+uint64_t ProgramCache::key(const char* vertex_source,
+        const char* fragment_source, const char* const * attribute_names,
+        int attribute_count) {
+    uint64_t hash = fnv1a(FNV_OFFSET_BASIS, vertex_source);
+    hash = fnv1a(hash, fragment_source);
+    hash = fnv1a(hash, &attribute_count, sizeof(attribute_count));
+    for (int i = 0; i < attribute_count; ++i) {
+        hash = fnv1a(hash, attribute_names[i]);
+    }
+    hash = fnv1a(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hash = fnv1a(hash,
+            reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    hash = fnv1a(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    return fnv1a(hash, &VERSION, sizeof(VERSION));
+}
+
+std::string ProgramCache::path(uint64_t key) {
+    std::lock_guard<std::mutex> lock(lock_);
+    if (directory_.empty()) {
+        return directory_;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "/%016llx.gvrp",
+            static_cast<unsigned long long>(key));
+    return directory_ + name;
+}
+
+GLuint ProgramCache::load(const char* vertex_source,
+        const char* fragment_source, const char* const * attribute_names,
+        int attribute_count) {
+    uint64_t key = ProgramCache::key(vertex_source, fragment_source,
+            attribute_names, attribute_count);
+    std::string path = ProgramCache::path(key);
+    if (path.empty()) {
+        return 0;
+    }
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == 0) {
+        return 0;
+    }
+
+    ProgramCacheHeader header;
+    std::vector<char> binary;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1
+            && memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+            && header.version == VERSION && header.key == key
+            && header.length > 0;
+    if (ok) {
+        binary.resize(header.length);
+        ok = fread(binary.data(), 1, binary.size(), file) == binary.size();
+    }
+    fclose(file);
+    if (!ok) {
+        unlink(path.c_str());
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    if (program == 0) {
+        return 0;
+    }
+    glProgramBinary(program, header.format, binary.data(), binary.size());
+    GLint link_status = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &link_status);
+    if (link_status != GL_TRUE) {
+        // the driver changed under the same strings, or the file is corrupt
+        LOGW("ProgramCache::load() : driver rejected %s", path.c_str());
+        while (glGetError() != GL_NO_ERROR) {
+        }
+        gl_delete.queueProgram(program);
+        unlink(path.c_str());
+        return 0;
+    }
+    return program;
+}
+
+void ProgramCache::store(GLuint program, const char* vertex_source,
+        const char* fragment_source, const char* const * attribute_names,
+        int attribute_count) {
+    uint64_t key = ProgramCache::key(vertex_source, fragment_source,
+            attribute_names, attribute_count);
+    std::string path = ProgramCache::path(key);
+    if (path.empty()) {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+    if (length <= 0) {
+        return;
+    }
+
+    ProgramCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.key = key;
+    header.format = format;
+    header.length = length;
+
+    std::string temp_path = path + ".tmp";
+    FILE* file = fopen(temp_path.c_str(), "wb");
+    if (file == 0) {
+        LOGE("ProgramCache::store() : cannot create %s", temp_path.c_str());
+        return;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+            && fwrite(binary.data(), 1, length, file)
+                    == static_cast<size_t>(length);
+    ok = fclose(file) == 0 && ok;
+
+    if (!ok || rename(temp_path.c_str(), path.c_str()) != 0) {
+        LOGE("ProgramCache::store() : failed to write %s", path.c_str());
+        unlink(temp_path.c_str());
+    }
+}
+
+}
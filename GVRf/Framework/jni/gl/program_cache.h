@@ -0,0 +1,89 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * On-disk cache of linked GL program binaries.
+ ***************************************************************************/
+
+#ifndef PROGRAM_CACHE_H_
+#define PROGRAM_CACHE_H_
+
+#include <stdint.h>
+#include <mutex>
+#include <string>
+
+#include "GLES3/gl3.h"
+
+namespace gvr {
+
+/*
+ * File layout:
+ *   ProgramCacheHeader
+ *   length bytes of binary as returned by glGetProgramBinary
+ * The key covers both sources, the attribute locations bound before the
+ * link and the GL vendor, renderer and version strings, so a driver update
+ * makes every file a miss.
+ */
+struct ProgramCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t length;
+};
+
+class ProgramCache {
+private:
+    ProgramCache();
+
+public:
+    static const uint32_t VERSION = 1;
+
+    // Where binaries are kept; caching is off until this is set.
+    static void setDirectory(const std::string& directory);
+
+    /*
+     * A program loaded from the binary of these sources, or 0 if there is
+     * none. Attribute i of attribute_names is the one bound to location i
+     * before linking. A binary the driver rejects is deleted, so the next
+     * link replaces it.
+     */
+    static GLuint load(const char* vertex_source, const char* fragment_source,
+            const char* const * attribute_names = 0, int attribute_count = 0);
+
+    /*
+     * Save the binary of a program linked from these sources and attribute
+     * bindings, which should have GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+     */
+    static void store(GLuint program, const char* vertex_source,
+            const char* fragment_source,
+            const char* const * attribute_names = 0, int attribute_count = 0);
+
+private:
+    // FNV-1a of the sources, the attribute bindings, the driver strings
+    // and the format version
+    static uint64_t key(const char* vertex_source,
+            const char* fragment_source, const char* const * attribute_names,
+            int attribute_count);
+    // directory/<key in hex>.gvrp, empty if caching is off
+    static std::string path(uint64_t key);
+
+private:
+    static std::mutex lock_;
+    static std::string directory_;
+};
+
+}
+#endif
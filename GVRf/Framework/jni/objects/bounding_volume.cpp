@@ -0,0 +1,203 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Axis aligned bounding box plus bounding sphere of a set of points.
+ ***************************************************************************/
+
+#include "bounding_volume.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace gvr {
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+static inline float horizontal_min(float32x4_t v) {
+    float32x2_t m = vpmin_f32(vget_low_f32(v), vget_high_f32(v));
+    m = vpmin_f32(m, m);
+    return vget_lane_f32(m, 0);
+}
+
+static inline float horizontal_max(float32x4_t v) {
+    float32x2_t m = vpmax_f32(vget_low_f32(v), vget_high_f32(v));
+    m = vpmax_f32(m, m);
+    return vget_lane_f32(m, 0);
+}
+#endif
+
+void BoundingVolume::reset() {
+    float infinity = std::numeric_limits<float>::infinity();
+    min_corner_ = glm::vec3(infinity);
+    max_corner_ = glm::vec3(-infinity);
+    center_ = glm::vec3(0.0f);
+    radius_ = 0.0f;
+}
+
+void BoundingVolume::compute(const glm::vec3* points, size_t count) {
+    reset();
+    if (count == 0) {
+        return;
+    }
+
+    glm::vec3 min_corner(points[0]);
+    glm::vec3 max_corner(points[0]);
+    size_t i = 0;
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+    // glm::vec3 is three packed floats, so the points can be loaded four at
+    // a time and de-interleaved into x, y and z lanes
+    const float* data = &points[0].x;
+    if (count >= 4) {
+        float32x4x3_t p = vld3q_f32(data);
+        float32x4_t min_x = p.val[0], min_y = p.val[1], min_z = p.val[2];
+        float32x4_t max_x = p.val[0], max_y = p.val[1], max_z = p.val[2];
+        for (i = 4; i + 4 <= count; i += 4) {
+            p = vld3q_f32(data + i * 3);
+            min_x = vminq_f32(min_x, p.val[0]);
+            min_y = vminq_f32(min_y, p.val[1]);
+            min_z = vminq_f32(min_z, p.val[2]);
+            max_x = vmaxq_f32(max_x, p.val[0]);
+            max_y = vmaxq_f32(max_y, p.val[1]);
+            max_z = vmaxq_f32(max_z, p.val[2]);
+        }
+        min_corner = glm::vec3(horizontal_min(min_x), horizontal_min(min_y),
+                horizontal_min(min_z));
+        max_corner = glm::vec3(horizontal_max(max_x), horizontal_max(max_y),
+                horizontal_max(max_z));
+    }
+#endif
+    for (; i < count; ++i) {
+        min_corner = glm::min(min_corner, points[i]);
+        max_corner = glm::max(max_corner, points[i]);
+    }
+
+    min_corner_ = min_corner;
+    max_corner_ = max_corner;
+    center_ = (min_corner + max_corner) * 0.5f;
+
+    // sphere radius: largest squared distance from the box center
+    float max_distance2 = 0.0f;
+    i = 0;
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+    if (count >= 4) {
+        const float* data = &points[0].x;
+        float32x4_t center_x = vdupq_n_f32(center_.x);
+        float32x4_t center_y = vdupq_n_f32(center_.y);
+        float32x4_t center_z = vdupq_n_f32(center_.z);
+        float32x4_t distance2 = vdupq_n_f32(0.0f);
+        for (; i + 4 <= count; i += 4) {
+            float32x4x3_t p = vld3q_f32(data + i * 3);
+            float32x4_t dx = vsubq_f32(p.val[0], center_x);
+            float32x4_t dy = vsubq_f32(p.val[1], center_y);
+            float32x4_t dz = vsubq_f32(p.val[2], center_z);
+            float32x4_t d2 = vmulq_f32(dx, dx);
+            d2 = vmlaq_f32(d2, dy, dy);
+            d2 = vmlaq_f32(d2, dz, dz);
+            distance2 = vmaxq_f32(distance2, d2);
+        }
+        max_distance2 = horizontal_max(distance2);
+    }
+#endif
+    for (; i < count; ++i) {
+        glm::vec3 d(points[i] - center_);
+        max_distance2 = std::max(max_distance2, glm::dot(d, d));
+    }
+    radius_ = sqrtf(max_distance2);
+}
+
+void BoundingVolume::expand(const BoundingVolume& volume) {
+    if (volume.empty()) {
+        return;
+    }
+    if (empty()) {
+        *this = volume;
+        return;
+    }
+
+    min_corner_ = glm::min(min_corner_, volume.min_corner_);
+    max_corner_ = glm::max(max_corner_, volume.max_corner_);
+
+    // smallest sphere enclosing both spheres
+    glm::vec3 d(volume.center_ - center_);
+    float distance = glm::length(d);
+    if (distance + volume.radius_ <= radius_) {
+        return;
+    }
+    if (distance + radius_ <= volume.radius_) {
+        center_ = volume.center_;
+        radius_ = volume.radius_;
+        return;
+    }
+    float radius = (distance + radius_ + volume.radius_) * 0.5f;
+    center_ += d * ((radius - radius_) / distance);
+    radius_ = radius;
+}
+
+// Arvo's method: the world extent along each axis is the sum of the local
+// half extents weighted by the absolute values of the matrix row.
+void BoundingVolume::transform(const BoundingVolume& local,
+        const glm::mat4& matrix) {
+    if (local.empty()) {
+        reset();
+        return;
+    }
+
+    glm::vec3 center((local.min_corner_ + local.max_corner_) * 0.5f);
+    glm::vec3 extent((local.max_corner_ - local.min_corner_) * 0.5f);
+    glm::vec3 world_center(matrix * glm::vec4(center, 1.0f));
+    glm::vec3 world_extent;
+    for (int row = 0; row < 3; ++row) {
+        world_extent[row] = fabsf(matrix[0][row]) * extent.x
+                + fabsf(matrix[1][row]) * extent.y
+                + fabsf(matrix[2][row]) * extent.z;
+    }
+    min_corner_ = world_center - world_extent;
+    max_corner_ = world_center + world_extent;
+
+    glm::vec3 x_axis(matrix[0]), y_axis(matrix[1]), z_axis(matrix[2]);
+    float scale2 = std::max(glm::dot(x_axis, x_axis),
+            std::max(glm::dot(y_axis, y_axis), glm::dot(z_axis, z_axis)));
+    center_ = glm::vec3(matrix * glm::vec4(local.center_, 1.0f));
+    radius_ = local.radius_ * sqrtf(scale2);
+}
+
+void BoundingVolume::serialize(float* data) const {
+    data[0] = min_corner_.x;
+    data[1] = min_corner_.y;
+    data[2] = min_corner_.z;
+    data[3] = max_corner_.x;
+    data[4] = max_corner_.y;
+    data[5] = max_corner_.z;
+    data[6] = center_.x;
+    data[7] = center_.y;
+    data[8] = center_.z;
+    data[9] = radius_;
+}
+
+void BoundingVolume::deserialize(const float* data) {
+    min_corner_ = glm::vec3(data[0], data[1], data[2]);
+    max_corner_ = glm::vec3(data[3], data[4], data[5]);
+    center_ = glm::vec3(data[6], data[7], data[8]);
+    radius_ = data[9];
+}
+
+}
@@ -0,0 +1,86 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Axis aligned bounding box plus bounding sphere of a set of points.
+ ***************************************************************************/
+
+#ifndef BOUNDING_VOLUME_H_
+#define BOUNDING_VOLUME_H_
+
+#include <cstddef>
+
+#include "glm/glm.hpp"
+
+namespace gvr {
+
+class BoundingVolume {
+public:
+    // number of floats written by serialize():
+    // min x, y, z, max x, y, z, center x, y, z, radius
+    static const int SERIALIZED_SIZE = 10;
+
+    BoundingVolume() {
+        reset();
+    }
+
+    // empty volume, contains nothing
+    void reset();
+
+    bool empty() const {
+        return min_corner_.x > max_corner_.x;
+    }
+
+    // Fit the volume around count points; the box is the tight AABB and
+    // the sphere is centered on it.
+    void compute(const glm::vec3* points, size_t count);
+
+    // Enclose another volume as well.
+    void expand(const BoundingVolume& volume);
+
+    // The volume of local after applying matrix: the box is the AABB of
+    // the transformed box, the sphere is scaled by the largest axis scale.
+    void transform(const BoundingVolume& local, const glm::mat4& matrix);
+
+    void serialize(float* data) const;
+    void deserialize(const float* data);
+
+    const glm::vec3& min_corner() const {
+        return min_corner_;
+    }
+
+    const glm::vec3& max_corner() const {
+        return max_corner_;
+    }
+
+    const glm::vec3& center() const {
+        return center_;
+    }
+
+    float radius() const {
+        return radius_;
+    }
+
+private:
+    glm::vec3 min_corner_;
+    glm::vec3 max_corner_;
+    glm::vec3 center_;
+    float radius_;
+};
+
+}
+
+#endif
@@ -121,9 +121,9 @@ void CameraRig::predict(float time) {
     } else if (camera_rig_type_ == FREEZE) {
         owner_object()->transform()->set_rotation(glm::quat());
     } else if (camera_rig_type_ == ORBIT_PIVOT) {
-        glm::vec3 pivot(getVec3("pivot"));
+        glm::vec3 pivot(getVec3(NAME_PIVOT));
         owner_object()->transform()->set_position(pivot.x, pivot.y,
-                pivot.z + getFloat("distance"));
+                pivot.z + getFloat(NAME_DISTANCE));
         owner_object()->transform()->set_rotation(glm::quat());
         owner_object()->transform()->rotateWithPivot(transfrom_rotation.w,
                 transfrom_rotation.x, transfrom_rotation.y,
@@ -21,7 +21,6 @@
 #ifndef CAMERA_RIG_H_
 #define CAMERA_RIG_H_
 
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,6 +30,7 @@
 
 #include "objects/components/component.h"
 #include "objects/rotation_sensor_data.h"
+#include "util/gvr_name_registry.h"
 
 namespace gvr {
 class Camera;
@@ -76,59 +76,96 @@ public:
         camera_separation_distance_ = distance;
     }
 
-    float getFloat(std::string key) {
-        auto it = floats_.find(key);
-        if (it != floats_.end()) {
-            return it->second;
+    float getFloat(int handle) {
+        const float* value = floats_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "CameraRig::getFloat() : " + key + " not found";
+            std::string error = "CameraRig::getFloat() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
+
+    float getFloat(std::string key) {
+        return getFloat(NameRegistry::intern(key));
+    }
+
+    void setFloat(int handle, float value) {
+        floats_[handle] = value;
+    }
+
     void setFloat(std::string key, float value) {
-        floats_[key] = value;
+        setFloat(NameRegistry::intern(key), value);
     }
 
-    glm::vec2 getVec2(std::string key) {
-        auto it = vec2s_.find(key);
-        if (it != vec2s_.end()) {
-            return it->second;
+    glm::vec2 getVec2(int handle) {
+        const glm::vec2* value = vec2s_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "CameraRig::getVec2() : " + key + " not found";
+            std::string error = "CameraRig::getVec2() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    glm::vec2 getVec2(std::string key) {
+        return getVec2(NameRegistry::intern(key));
+    }
+
+    void setVec2(int handle, glm::vec2 vector) {
+        vec2s_[handle] = vector;
+    }
+
     void setVec2(std::string key, glm::vec2 vector) {
-        vec2s_[key] = vector;
+        setVec2(NameRegistry::intern(key), vector);
     }
 
-    glm::vec3 getVec3(std::string key) {
-        auto it = vec3s_.find(key);
-        if (it != vec3s_.end()) {
-            return it->second;
+    glm::vec3 getVec3(int handle) {
+        const glm::vec3* value = vec3s_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "CameraRig::getVec3() : " + key + " not found";
+            std::string error = "CameraRig::getVec3() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    glm::vec3 getVec3(std::string key) {
+        return getVec3(NameRegistry::intern(key));
+    }
+
+    void setVec3(int handle, glm::vec3 vector) {
+        vec3s_[handle] = vector;
+    }
+
     void setVec3(std::string key, glm::vec3 vector) {
-        vec3s_[key] = vector;
+        setVec3(NameRegistry::intern(key), vector);
     }
 
-    glm::vec4 getVec4(std::string key) {
-        auto it = vec4s_.find(key);
-        if (it != vec4s_.end()) {
-            return it->second;
+    glm::vec4 getVec4(int handle) {
+        const glm::vec4* value = vec4s_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "CameraRig::getVec4() : " + key + " not found";
+            std::string error = "CameraRig::getVec4() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    glm::vec4 getVec4(std::string key) {
+        return getVec4(NameRegistry::intern(key));
+    }
+
+    void setVec4(int handle, glm::vec4 vector) {
+        vec4s_[handle] = vector;
+    }
+
     void setVec4(std::string key, glm::vec4 vector) {
-        vec4s_[key] = vector;
+        setVec4(NameRegistry::intern(key), vector);
     }
 
     void attachLeftCamera(Camera* const left_camera);
@@ -155,10 +192,10 @@ private:
     Camera* right_camera_;
     static float default_camera_separation_distance_;
     float camera_separation_distance_;
-    std::map<std::string, float> floats_;
-    std::map<std::string, glm::vec2> vec2s_;
-    std::map<std::string, glm::vec3> vec3s_;
-    std::map<std::string, glm::vec4> vec4s_;
+    HandleMap<float> floats_;
+    HandleMap<glm::vec2> vec2s_;
+    HandleMap<glm::vec3> vec3s_;
+    HandleMap<glm::vec4> vec4s_;
     glm::quat complementary_rotation_;
     RotationSensorData rotation_sensor_data_;
     std::vector<glm::quat> rotation_buffer_;
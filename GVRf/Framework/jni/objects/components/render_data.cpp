@@ -0,0 +1,47 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Containing data about how to render an object.
+ ***************************************************************************/
+
+#include "render_data.h"
+
+#include "objects/mesh.h"
+
+namespace gvr {
+
+int RenderData::drawn_triangle_count() const {
+    if (draw_ranges_.empty()) {
+        return mesh()->triangles().size() / 3;
+    }
+    return draw_range_index_count_ / 3;
+}
+
+void RenderData::drawElements(GLenum mode,
+        const unsigned short* indices) const {
+    if (draw_ranges_.empty()) {
+        glDrawElements(mode, mesh()->triangles().size(), GL_UNSIGNED_SHORT,
+                indices);
+        return;
+    }
+    for (auto it = draw_ranges_.begin(); it != draw_ranges_.end(); ++it) {
+        glDrawElements(mode, it->index_count, GL_UNSIGNED_SHORT,
+                indices + it->first_index);
+    }
+}
+
+}
@@ -20,7 +20,9 @@
 #ifndef RENDER_DATA_H_
 #define RENDER_DATA_H_
 
+#include <algorithm>
 #include <memory>
+#include <stdint.h>
 #include <vector>
 
 #include "gl/gl_program.h"
@@ -42,25 +44,132 @@ public:
         Left = 0x1, Right = 0x2
     };
 
+    // what the thresholds passed to addLod() mean
+    enum LodMode {
+        // largest geometric error of the level, in mesh units; the level is
+        // used once that error projects to less than the scene's pixel budget
+        LOD_SCREEN_ERROR = 0,
+        // camera distance from which on the level is used
+        LOD_DISTANCE = 1
+    };
+
     RenderData() :
-            Component(), mesh_(0), material_(0), render_mask_(
+            Component(), mesh_(0), lod_mode_(LOD_SCREEN_ERROR), lod_level_(0), draw_range_index_count_(
+                    0), material_(
+                    0), render_mask_(
                     DEFAULT_RENDER_MASK), rendering_order_(
                     DEFAULT_RENDERING_ORDER), cull_test_(true), offset_(false), offset_factor_(
                     0.0f), offset_units_(0.0f), depth_test_(true), alpha_blend_(
-                    true), draw_mode_(GL_TRIANGLES) {
+                    true), draw_mode_(GL_TRIANGLES), sort_key_(0) {
     }
 
     ~RenderData() {
     }
 
+    // the mesh to draw, which is the active level when an LOD set is present
     Mesh* mesh() const {
-        return mesh_;
+        if (lods_.empty()) {
+            return mesh_;
+        }
+        return lods_[lod_level_].mesh;
     }
 
     void set_mesh(Mesh* mesh) {
         mesh_ = mesh;
     }
 
+    /*
+     * Add a level to the LOD set. Level 0 is the finest one; the levels are
+     * kept ordered by threshold, so they may be added in any order.
+     */
+    void addLod(Mesh* mesh, float threshold) {
+        Lod lod = { mesh, threshold };
+        auto it = lods_.begin();
+        while (it != lods_.end() && it->threshold <= threshold) {
+            ++it;
+        }
+        lods_.insert(it, lod);
+        lod_level_ = 0;
+    }
+
+    void clearLods() {
+        lods_.clear();
+        lod_level_ = 0;
+    }
+
+    int lod_count() const {
+        return lods_.size();
+    }
+
+    int lod_level() const {
+        return lod_level_;
+    }
+
+    LodMode lod_mode() const {
+        return lod_mode_;
+    }
+
+    void set_lod_mode(LodMode lod_mode) {
+        lod_mode_ = lod_mode;
+    }
+
+    /*
+     * Pick the level for an object seen from distance. Each level's threshold
+     * times threshold_scale is the distance it switches in at; to switch,
+     * the distance must pass that point by the hysteresis fraction, so an
+     * object sitting on a boundary does not flip levels every frame.
+     */
+    void selectLod(float distance, float threshold_scale, float hysteresis) {
+        int count = lods_.size();
+        if (count == 0) {
+            return;
+        }
+        int level = std::min(lod_level_, count - 1);
+        while (level + 1 < count
+                && distance
+                        >= lods_[level + 1].threshold * threshold_scale
+                                * (1.0f + hysteresis)) {
+            ++level;
+        }
+        while (level > 0
+                && distance
+                        < lods_[level].threshold * threshold_scale
+                                * (1.0f - hysteresis)) {
+            --level;
+        }
+        lod_level_ = level;
+    }
+
+    // Index ranges of the visible clusters, set by the cull pass for the
+    // camera being rendered; with none set the whole mesh is drawn.
+    void clearDrawRanges() {
+        draw_ranges_.clear();
+        draw_range_index_count_ = 0;
+    }
+
+    void addDrawRange(int first_index, int index_count) {
+        draw_range_index_count_ += index_count;
+        if (!draw_ranges_.empty()) {
+            DrawRange& last = draw_ranges_.back();
+            if (last.first_index + last.index_count == first_index) {
+                last.index_count += index_count;
+                return;
+            }
+        }
+        DrawRange range = { first_index, index_count };
+        draw_ranges_.push_back(range);
+    }
+
+    // number of triangles the next drawElements() submits
+    int drawn_triangle_count() const;
+
+    /*
+     * Draw the mesh's triangles, or only the visible ranges of them. indices
+     * is the client side index array, or 0 when the mesh's element buffer is
+     * bound through its VAO.
+     */
+    void drawElements(GLenum mode, const unsigned short* indices) const;
+
     Material* material() const {
         return material_;
     }
@@ -141,16 +250,42 @@ public:
         draw_mode_ = draw_mode;
     }
 
+    // Orders draws of the same rendering order, so programs and materials
+    // change as rarely as possible; set by the renderer every frame.
+    uint64_t sort_key() const {
+        return sort_key_;
+    }
+
+    void set_sort_key(uint64_t sort_key) {
+        sort_key_ = sort_key;
+    }
+
 private:
     RenderData(const RenderData& render_data);
     RenderData(RenderData&& render_data);
     RenderData& operator=(const RenderData& render_data);
     RenderData& operator=(RenderData&& render_data);
 
+private:
+    struct Lod {
+        Mesh* mesh;
+        float threshold;
+    };
+
+    struct DrawRange {
+        int first_index;
+        int index_count;
+    };
+
 private:
     static const int DEFAULT_RENDER_MASK = Left | Right;
     static const int DEFAULT_RENDERING_ORDER = Geometry;
     Mesh* mesh_;
+    std::vector<Lod> lods_;
+    LodMode lod_mode_;
+    int lod_level_;
+    std::vector<DrawRange> draw_ranges_;
+    int draw_range_index_count_;
     Material* material_;
     int render_mask_;
     int rendering_order_;
@@ -161,10 +296,14 @@ private:
     bool depth_test_;
     bool alpha_blend_;
     GLenum draw_mode_;
+    uint64_t sort_key_;
 };
 
 inline bool compareRenderData(RenderData* i, RenderData* j) {
-    return i->rendering_order() < j->rendering_order();
+    if (i->rendering_order() != j->rendering_order()) {
+        return i->rendering_order() < j->rendering_order();
+    }
+    return i->sort_key() < j->sort_key();
 }
 
 }
@@ -36,6 +36,22 @@ JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeRenderData_setMesh(JNIEnv * env,
         jobject obj, jlong jrender_data, jlong jmesh);
 
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_addLod(JNIEnv * env,
+        jobject obj, jlong jrender_data, jlong jmesh, jfloat threshold);
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_clearLods(JNIEnv * env,
+        jobject obj, jlong jrender_data);
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_setLodMode(JNIEnv * env,
+        jobject obj, jlong jrender_data, jint lod_mode);
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeRenderData_getLodLevel(JNIEnv * env,
+        jobject obj, jlong jrender_data);
+
 JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeRenderData_setMaterial(JNIEnv * env,
         jobject obj, jlong jrender_data, jlong jmaterial);
@@ -120,6 +136,35 @@ Java_org_gearvrf_NativeRenderData_setMesh(JNIEnv * env,
     render_data->set_mesh(mesh);
 }
 
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_addLod(JNIEnv * env,
+        jobject obj, jlong jrender_data, jlong jmesh, jfloat threshold) {
+    RenderData* render_data = reinterpret_cast<RenderData*>(jrender_data);
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    render_data->addLod(mesh, threshold);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_clearLods(JNIEnv * env,
+        jobject obj, jlong jrender_data) {
+    RenderData* render_data = reinterpret_cast<RenderData*>(jrender_data);
+    render_data->clearLods();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_setLodMode(JNIEnv * env,
+        jobject obj, jlong jrender_data, jint lod_mode) {
+    RenderData* render_data = reinterpret_cast<RenderData*>(jrender_data);
+    render_data->set_lod_mode(static_cast<RenderData::LodMode>(lod_mode));
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeRenderData_getLodLevel(JNIEnv * env,
+        jobject obj, jlong jrender_data) {
+    RenderData* render_data = reinterpret_cast<RenderData*>(jrender_data);
+    return render_data->lod_level();
+}
+
 JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeRenderData_setMaterial(JNIEnv * env,
         jobject obj, jlong jrender_data, jlong jmaterial) {
@@ -0,0 +1,33 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Links textures and shaders.
+ ***************************************************************************/
+
+#include "material.h"
+
+#include <atomic>
+
+namespace gvr {
+
+unsigned int Material::nextVersion() {
+    // 0 is never handed out, it marks a buffer that was never filled
+    static std::atomic<unsigned int> next_version(0);
+    unsigned int version = ++next_version;
+    return version != 0 ? version : ++next_version;
+}
+
+}
@@ -25,10 +25,14 @@
 #include <memory>
 #include <string>
 
+#include "GLES3/gl3.h"
 #include "glm/glm.hpp"
 
 #include "objects/hybrid_object.h"
 #include "objects/textures/texture.h"
+#include "util/gvr_name_registry.h"
+
+#include "engine/memory/gl_delete.h"
 
 namespace gvr {
 class Color;
@@ -46,17 +50,53 @@ public:
         CUBEMAP_REFLECTION_SHADER = 7
     };
 
+    /*
+     * This material's values packed for one uniform block layout, together
+     * with the material version and layout revision they were packed at.
+     */
+    struct UniformBuffer {
+        UniformBuffer() :
+                id(0), capacity(0), version(0), revision(0) {
+        }
+
+        GLuint id;
+        GLsizeiptr capacity;
+        unsigned int version;
+        int revision;
+    };
+
     explicit Material(ShaderType shader_type) :
-            shader_type_(shader_type), textures_(), floats_(), vec2s_(), vec3s_(), vec4s_() {
+            shader_type_(shader_type), textures_(), floats_(), vec2s_(), vec3s_(), vec4s_(), version_(
+                    nextVersion()), uniform_buffers_() {
         switch (shader_type) {
         default:
-            vec3s_["color"] = glm::vec3(1.0f, 1.0f, 1.0f);
-            floats_["opacity"] = 1.0f;
+            vec3s_[NAME_COLOR] = glm::vec3(1.0f, 1.0f, 1.0f);
+            floats_[NAME_OPACITY] = 1.0f;
             break;
         }
     }
 
     ~Material() {
+        for (auto it = uniform_buffers_.begin(); it != uniform_buffers_.end();
+                ++it) {
+            if (it->second.id != 0) {
+                gl_delete.queueBuffer(it->second.id, GL_DYNAMIC_DRAW,
+                        it->second.capacity);
+            }
+        }
+    }
+
+    /*
+     * Changes whenever a uniform value is set. Versions are unique across
+     * all materials, so a shader that remembers the version it uploaded
+     * last can skip the upload when the next draw uses the same values.
+     */
+    unsigned int version() const {
+        return version_;
+    }
+
+    UniformBuffer& uniform_buffer(int layout_id) {
+        return uniform_buffers_[layout_id];
     }
 
     ShaderType shader_type() const {
@@ -67,90 +107,163 @@ public:
         shader_type_ = shader_type;
     }
 
-    Texture* getTexture(std::string key) const {
-        auto it = textures_.find(key);
-        if (it != textures_.end()) {
-            return it->second;
+    Texture* getTexture(int handle) const {
+        Texture* const* value = textures_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "Material::getTexture() : " + key
-                    + " not found";
+            std::string error = "Material::getTexture() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    Texture* getTexture(std::string key) const {
+        return getTexture(NameRegistry::intern(key));
+    }
+
+    // like getTexture(), but 0 if the material has none under handle
+    Texture* findTexture(int handle) const {
+        Texture* const* value = textures_.find(handle);
+        return value != 0 ? *value : 0;
+    }
+
+    void setTexture(int handle, Texture* texture) {
+        textures_[handle] = texture;
+    }
+
     void setTexture(std::string key, Texture* texture) {
-        textures_[key] = texture;
+        setTexture(NameRegistry::intern(key), texture);
     }
 
-    float getFloat(std::string key) {
-        auto it = floats_.find(key);
-        if (it != floats_.end()) {
-            return it->second;
+    float getFloat(int handle) {
+        const float* value = floats_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "Material::getFloat() : " + key + " not found";
+            std::string error = "Material::getFloat() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
+
+    float getFloat(std::string key) {
+        return getFloat(NameRegistry::intern(key));
+    }
+
+    void setFloat(int handle, float value) {
+        floats_[handle] = value;
+        version_ = nextVersion();
+    }
+
     void setFloat(std::string key, float value) {
-        floats_[key] = value;
+        setFloat(NameRegistry::intern(key), value);
     }
 
-    glm::vec2 getVec2(std::string key) {
-        auto it = vec2s_.find(key);
-        if (it != vec2s_.end()) {
-            return it->second;
+    glm::vec2 getVec2(int handle) {
+        const glm::vec2* value = vec2s_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "Material::getVec2() : " + key + " not found";
+            std::string error = "Material::getVec2() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    glm::vec2 getVec2(std::string key) {
+        return getVec2(NameRegistry::intern(key));
+    }
+
+    void setVec2(int handle, glm::vec2 vector) {
+        vec2s_[handle] = vector;
+        version_ = nextVersion();
+    }
+
     void setVec2(std::string key, glm::vec2 vector) {
-        vec2s_[key] = vector;
+        setVec2(NameRegistry::intern(key), vector);
     }
 
-    glm::vec3 getVec3(std::string key) {
-        auto it = vec3s_.find(key);
-        if (it != vec3s_.end()) {
-            return it->second;
+    glm::vec3 getVec3(int handle) {
+        const glm::vec3* value = vec3s_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "Material::getVec3() : " + key + " not found";
+            std::string error = "Material::getVec3() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    glm::vec3 getVec3(std::string key) {
+        return getVec3(NameRegistry::intern(key));
+    }
+
+    void setVec3(int handle, glm::vec3 vector) {
+        vec3s_[handle] = vector;
+        version_ = nextVersion();
+    }
+
     void setVec3(std::string key, glm::vec3 vector) {
-        vec3s_[key] = vector;
+        setVec3(NameRegistry::intern(key), vector);
     }
 
-    glm::vec4 getVec4(std::string key) {
-        auto it = vec4s_.find(key);
-        if (it != vec4s_.end()) {
-            return it->second;
+    glm::vec4 getVec4(int handle) {
+        const glm::vec4* value = vec4s_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "Material::getVec4() : " + key + " not found";
+            std::string error = "Material::getVec4() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    glm::vec4 getVec4(std::string key) {
+        return getVec4(NameRegistry::intern(key));
+    }
+
+    // like getVec4(), but 0 if the material has none under handle
+    const glm::vec4* findVec4(int handle) const {
+        return vec4s_.find(handle);
+    }
+
+    void setVec4(int handle, glm::vec4 vector) {
+        vec4s_[handle] = vector;
+        version_ = nextVersion();
+    }
+
     void setVec4(std::string key, glm::vec4 vector) {
-        vec4s_[key] = vector;
+        setVec4(NameRegistry::intern(key), vector);
     }
 
-    glm::mat4 getMat4(std::string key) {
-        auto it = mat4s_.find(key);
-        if (it != mat4s_.end()) {
-            return it->second;
+    glm::mat4 getMat4(int handle) {
+        const glm::mat4* value = mat4s_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "Material::getMat4() : " + key + " not found";
+            std::string error = "Material::getMat4() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    glm::mat4 getMat4(std::string key) {
+        return getMat4(NameRegistry::intern(key));
+    }
+
+    void setMat4(int handle, glm::mat4 matrix) {
+        mat4s_[handle] = matrix;
+        version_ = nextVersion();
+    }
+
     void setMat4(std::string key, glm::mat4 matrix) {
-        mat4s_[key] = matrix;
+        setMat4(NameRegistry::intern(key), matrix);
     }
 
+private:
+    static unsigned int nextVersion();
+
 private:
     Material(const Material& material);
     Material(Material&& material);
@@ -159,12 +272,15 @@ private:
 
 private:
     ShaderType shader_type_;
-    std::map<std::string, Texture*> textures_;
-    std::map<std::string, float> floats_;
-    std::map<std::string, glm::vec2> vec2s_;
-    std::map<std::string, glm::vec3> vec3s_;
-    std::map<std::string, glm::vec4> vec4s_;
-    std::map<std::string, glm::mat4> mat4s_;
+    HandleMap<Texture*> textures_;
+    HandleMap<float> floats_;
+    HandleMap<glm::vec2> vec2s_;
+    HandleMap<glm::vec3> vec3s_;
+    HandleMap<glm::vec4> vec4s_;
+    HandleMap<glm::mat4> mat4s_;
+    unsigned int version_;
+    // layout id to GL buffer, see MaterialUniformBlock
+    std::map<int, UniformBuffer> uniform_buffers_;
 };
 }
 #endif
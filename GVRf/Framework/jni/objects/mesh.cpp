@@ -19,6 +19,7 @@
 
 #include "mesh.h"
 
+#include <cmath>
 #include <limits>
 
 #include "assimp/Importer.hpp"
@@ -32,14 +33,14 @@ namespace gvr {
 Mesh* Mesh::getBoundingBox() {
     Mesh* mesh = new Mesh();
 
-    getBoundingBoxInfo(); // Make sure bounding_box_info_ is valid
+    const BoundingVolume& bounding_volume = getBoundingVolume();
 
-    float min_x = bounding_box_info_[0];
-    float max_x = bounding_box_info_[3];
-    float min_y = bounding_box_info_[1];
-    float max_y = bounding_box_info_[4];
-    float min_z = bounding_box_info_[2];
-    float max_z = bounding_box_info_[5];
+    float min_x = bounding_volume.min_corner().x;
+    float max_x = bounding_volume.max_corner().x;
+    float min_y = bounding_volume.min_corner().y;
+    float max_y = bounding_volume.max_corner().y;
+    float min_z = bounding_volume.min_corner().z;
+    float max_z = bounding_volume.max_corner().z;
 
     mesh->vertices_.push_back(glm::vec3(min_x, min_y, min_z));
     mesh->vertices_.push_back(glm::vec3(max_x, min_y, min_z));
@@ -95,66 +96,229 @@ Mesh* Mesh::getBoundingBox() {
     return mesh;
 }
 
-// an array of size:6 with Xmin, Ymin, Zmin and Xmax, Ymax, Zmax values
-const float* Mesh::getBoundingBoxInfo() {
-    if (have_bounding_box_) {
-        return bounding_box_info_;
+const BoundingVolume& Mesh::getBoundingVolume() {
+    if (bounding_volume_dirty_) {
+        bounding_volume_.compute(vertices_.data(), vertices_.size());
+        bounding_volume_dirty_ = false;
     }
+    return bounding_volume_;
+}
 
-    float min_x = std::numeric_limits<float>::infinity();
-    float max_x = -std::numeric_limits<float>::infinity();
-    float min_y = std::numeric_limits<float>::infinity();
-    float max_y = -std::numeric_limits<float>::infinity();
-    float min_z = std::numeric_limits<float>::infinity();
-    float max_z = -std::numeric_limits<float>::infinity();
+float Mesh::getUVDensity() {
+    if (!uv_density_dirty_) {
+        return uv_density_;
+    }
+    float uv_area = 0.0f;
+    float area = 0.0f;
+    if (tex_coords_.size() == vertices_.size()) {
+        for (int i = 0; i + 2 < triangles_.size(); i += 3) {
+            unsigned short a = triangles_[i];
+            unsigned short b = triangles_[i + 1];
+            unsigned short c = triangles_[i + 2];
+            if (a >= vertices_.size() || b >= vertices_.size()
+                    || c >= vertices_.size()) {
+                continue;
+            }
+            area += glm::length(
+                    glm::cross(vertices_[b] - vertices_[a],
+                            vertices_[c] - vertices_[a]));
+            glm::vec2 u = tex_coords_[b] - tex_coords_[a];
+            glm::vec2 v = tex_coords_[c] - tex_coords_[a];
+            uv_area += std::fabs(u.x * v.y - u.y * v.x);
+        }
+    }
+    uv_density_ = area > 0.0f ? std::sqrt(uv_area / area) : 0.0f;
+    uv_density_dirty_ = false;
+    return uv_density_;
+}
 
-    if (vertices_.size() == 0) {
-        return NULL;
+void Mesh::buildClusters(int max_triangles) {
+    if (max_triangles <= 0) {
+        std::string error = "Mesh::buildClusters() : invalid cluster size";
+        throw error;
     }
+    clusters_ = MeshClusterBuilder::build(vertices_, triangles_, max_triangles);
+    clusters_dirty_ = false;
+    triangle_buffer_.markDirty(0, triangles_.size());
+    bvh_dirty_ = true;
+}
 
-    for (auto it = vertices_.begin(); it != vertices_.end(); ++it) {
-        if (it->x < min_x) {
-            min_x = it->x;
-        }
-        if (it->x > max_x) {
-            max_x = it->x;
-        }
-        if (it->y < min_y) {
-            min_y = it->y;
-        }
-        if (it->y > max_y) {
-            max_y = it->y;
+const std::vector<MeshCluster>& Mesh::getClusters() {
+    if (clusters_dirty_) {
+        for (auto it = clusters_.begin(); it != clusters_.end(); ++it) {
+            it->computeBounds(vertices_.data(), triangles_.data());
         }
-        if (it->z < min_z) {
-            min_z = it->z;
-        }
-        if (it->z > max_z) {
-            max_z = it->z;
+        clusters_dirty_ = false;
+    }
+    return clusters_;
+}
+
+bool Mesh::intersect(const glm::vec3& origin, const glm::vec3& direction,
+        float& distance, glm::vec3& hit) {
+    pthread_mutex_lock(&bvh_mutex_);
+    // cleared before building, so a change made meanwhile is not lost
+    if (bvh_dirty_.exchange(false)) {
+        bvh_.build(vertices_, triangles_);
+    }
+    bool intersects = bvh_.intersect(vertices_, triangles_, origin,
+            direction, distance, hit);
+    pthread_mutex_unlock(&bvh_mutex_);
+    return intersects;
+}
+
+void Mesh::updateVertices(int first, const glm::vec3* vertices, int count) {
+    if (first < 0 || count < 0 || first + count > vertices_.size()) {
+        std::string error = "Mesh::updateVertices() : range out of bounds";
+        throw error;
+    }
+    std::copy(vertices, vertices + count, vertices_.begin() + first);
+    vert_buffer_.markDirty(first, count);
+    bounding_volume_dirty_ = true;
+    clusters_dirty_ = true;
+    uv_density_dirty_ = true;
+    bvh_dirty_ = true;
+}
+
+void Mesh::updateNormals(int first, const glm::vec3* normals, int count) {
+    if (first < 0 || count < 0 || first + count > normals_.size()) {
+        std::string error = "Mesh::updateNormals() : range out of bounds";
+        throw error;
+    }
+    std::copy(normals, normals + count, normals_.begin() + first);
+    norm_buffer_.markDirty(first, count);
+}
+
+void Mesh::updateTexCoords(int first, const glm::vec2* tex_coords, int count) {
+    if (first < 0 || count < 0 || first + count > tex_coords_.size()) {
+        std::string error = "Mesh::updateTexCoords() : range out of bounds";
+        throw error;
+    }
+    std::copy(tex_coords, tex_coords + count, tex_coords_.begin() + first);
+    tex_buffer_.markDirty(first, count);
+    uv_density_dirty_ = true;
+}
+
+// create the buffer on first use, otherwise push whatever changed since the
+// last upload according to the usage hint
+bool Mesh::uploadBuffer(GLenum target, MeshBuffer& buffer, const void* data,
+        size_t element_size, size_t count) {
+    if (count == 0) {
+        return false;
+    }
+
+    GLenum usage = GL_STATIC_DRAW;
+    if (usage_hint_ == DYNAMIC_USAGE) {
+        usage = GL_DYNAMIC_DRAW;
+    } else if (usage_hint_ == STREAM_USAGE) {
+        usage = GL_STREAM_DRAW;
+    }
+
+    GLsizeiptr size = element_size * count;
+    bool created = buffer.id == 0;
+    if (created) {
+        buffer.id = gl_name_pool.createBuffer(target, size, data, usage,
+                &buffer.capacity);
+        buffer.usage = usage;
+        buffer.size = size;
+    } else if (buffer.dirty()) {
+        glBindBuffer(target, buffer.id);
+        if (usage_hint_ != DYNAMIC_USAGE || size > buffer.capacity
+                || usage != buffer.usage) {
+            // Re-specifying the whole store orphans the old one, so a
+            // STREAM mesh never stalls on draws still reading last frame's
+            // data.
+            glBufferData(target, size, data, usage);
+            buffer.usage = usage;
+            buffer.size = size;
+            buffer.capacity = size;
+        } else if (size != buffer.size) {
+            glBufferSubData(target, 0, size, data);
+            buffer.size = size;
+        } else {
+            size_t end = std::min(buffer.dirty_end, count);
+            if (buffer.dirty_begin < end) {
+                glBufferSubData(target, buffer.dirty_begin * element_size,
+                        (end - buffer.dirty_begin) * element_size,
+                        static_cast<const char*>(data)
+                                + buffer.dirty_begin * element_size);
+            }
         }
     }
+    buffer.dirty_begin = buffer.dirty_end = 0;
+    return created;
+}
+
+void Mesh::uploadBuffers() {
+    // the index buffer binding is VAO state, keep it out of the caller's VAO
+    glBindVertexArray(0);
+
+    bool created = false;
+    created |= uploadBuffer(GL_ELEMENT_ARRAY_BUFFER, triangle_buffer_,
+            triangles_.data(), sizeof(unsigned short), triangles_.size());
+    created |= uploadBuffer(GL_ARRAY_BUFFER, vert_buffer_, vertices_.data(),
+            sizeof(glm::vec3), vertices_.size());
+    created |= uploadBuffer(GL_ARRAY_BUFFER, norm_buffer_, normals_.data(),
+            sizeof(glm::vec3), normals_.size());
+    created |= uploadBuffer(GL_ARRAY_BUFFER, tex_buffer_, tex_coords_.data(),
+            sizeof(glm::vec2), tex_coords_.size());
+    numTriangles_ = triangles_.size() / 3;
+
+    for (auto it = attribute_float_keys_.begin();
+            it != attribute_float_keys_.end(); ++it) {
+        const std::vector<float>& vector = getFloatVector(it->second);
+        created |= uploadBuffer(GL_ARRAY_BUFFER,
+                attribute_buffers_[it->second], vector.data(), sizeof(float), vector.size());
+    }
 
-    bounding_box_info_[0] = min_x;
-    bounding_box_info_[1] = min_y;
-    bounding_box_info_[2] = min_z;
+    for (auto it = attribute_vec2_keys_.begin();
+            it != attribute_vec2_keys_.end(); ++it) {
+        const std::vector<glm::vec2>& vector = getVec2Vector(it->second);
+        created |= uploadBuffer(GL_ARRAY_BUFFER,
+                attribute_buffers_[it->second], vector.data(), sizeof(glm::vec2), vector.size());
+    }
 
-    bounding_box_info_[3] = max_x;
-    bounding_box_info_[4] = max_y;
-    bounding_box_info_[5] = max_z;
+    for (auto it = attribute_vec3_keys_.begin();
+            it != attribute_vec3_keys_.end(); ++it) {
+        const std::vector<glm::vec3>& vector = getVec3Vector(it->second);
+        created |= uploadBuffer(GL_ARRAY_BUFFER,
+                attribute_buffers_[it->second], vector.data(), sizeof(glm::vec3), vector.size());
+    }
+
+    for (auto it = attribute_vec4_keys_.begin();
+            it != attribute_vec4_keys_.end(); ++it) {
+        const std::vector<glm::vec4>& vector = getVec4Vector(it->second);
+        created |= uploadBuffer(GL_ARRAY_BUFFER,
+                attribute_buffers_[it->second], vector.data(), sizeof(glm::vec4), vector.size());
+    }
 
-    have_bounding_box_ = true;
-    return bounding_box_info_;
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    size_t bytes = triangle_buffer_.capacity + vert_buffer_.capacity
+            + norm_buffer_.capacity + tex_buffer_.capacity;
+    for (int handle = 0; handle < attribute_buffers_.capacity(); ++handle) {
+        const MeshBuffer* buffer = attribute_buffers_.find(handle);
+        if (buffer != 0) {
+            bytes += buffer->capacity;
+        }
+    }
+    if (bytes != gpu_allocation_.bytes()) {
+        gpu_allocation_.resize(bytes);
+    }
+
+    // an attribute that appeared after the VAOs were built is missing from
+    // them, so rebuild every VAO on its next use
+    if (created) {
+        for (auto it = vaoID_map_.begin(); it != vaoID_map_.end(); ++it) {
+            gl_delete.queueVertexArray(it->second);
+        }
+        vaoID_map_.clear();
+    }
 }
 
 // generate vertex array object
 void Mesh::generateVAO(Material::ShaderType key) {
 #if _GVRF_USE_GLES3_
-    GLuint tmpID;
-
-    if (vaoID_map_.find(key) != vaoID_map_.end()) {
-        // already initialized
-        return;
-    }
-
     if (vertices_.size() == 0 && normals_.size() == 0
             && tex_coords_.size() == 0) {
         std::string error = "no vertex data yet, shouldn't call here. ";
@@ -162,6 +326,16 @@ void Mesh::generateVAO(Material::ShaderType key) {
         return;
     }
 
+    // the VBOs are shared, so this also refreshes the VAOs of every other
+    // shader type
+    uploadBuffers();
+    gpu_allocation_.touch();
+
+    if (vaoID_map_.find(key) != vaoID_map_.end()) {
+        // already initialized
+        return;
+    }
+
     if (vertexLoc_ == -1 && normalLoc_ == -1 && texCoordLoc_ == -1) {
         std::string error =
                 "no attrib loc setup yet, please compile shader and set attribLoc first. ";
@@ -170,94 +344,59 @@ void Mesh::generateVAO(Material::ShaderType key) {
     }
 
     GLuint vaoID_ = 0;
-    GLuint triangle_vboID_, vert_vboID_, norm_vboID_, tex_vboID_;
 
-    glGenVertexArrays(1, &vaoID_);
+    vaoID_ = gl_name_pool.genVertexArray();
     glBindVertexArray(vaoID_);
 
-    glGenBuffers(1, &triangle_vboID_);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, triangle_vboID_);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-            sizeof(unsigned short) * triangles_.size(), &triangles_[0],
-            GL_STATIC_DRAW);
-    numTriangles_ = triangles_.size() / 3;
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, triangle_buffer_.id);
 
     if (vertices_.size()) {
-        glGenBuffers(1, &vert_vboID_);
-        glBindBuffer(GL_ARRAY_BUFFER, vert_vboID_);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec3) * vertices_.size(),
-                &vertices_[0], GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, vert_buffer_.id);
         glEnableVertexAttribArray(getVertexLoc());
         glVertexAttribPointer(getVertexLoc(), 3, GL_FLOAT, 0, 0, 0);
     }
 
     if (normals_.size()) {
-        glGenBuffers(1, &norm_vboID_);
-        glBindBuffer(GL_ARRAY_BUFFER, norm_vboID_);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec3) * normals_.size(),
-                &normals_[0], GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, norm_buffer_.id);
         glEnableVertexAttribArray(getNormalLoc());
         glVertexAttribPointer(getNormalLoc(), 3, GL_FLOAT, 0, 0, 0);
     }
 
     if (tex_coords_.size()) {
-        glGenBuffers(1, &tex_vboID_);
-        glBindBuffer(GL_ARRAY_BUFFER, tex_vboID_);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2) * tex_coords_.size(),
-                &tex_coords_[0], GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, tex_buffer_.id);
         glEnableVertexAttribArray(getTexCoordLoc());
         glVertexAttribPointer(getTexCoordLoc(), 2, GL_FLOAT, 0, 0, 0);
     }
 
     for (auto it = attribute_float_keys_.begin();
             it != attribute_float_keys_.end(); ++it) {
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ARRAY_BUFFER,
-                sizeof(GLfloat) * getFloatVector(it->second).size(),
-                getFloatVector(it->second).data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, attribute_buffers_[it->second].id);
         glEnableVertexAttribArray(it->first);
         glVertexAttribPointer(it->first, 1, GL_FLOAT, 0, 0, 0);
     }
 
     for (auto it = attribute_vec2_keys_.begin();
             it != attribute_vec2_keys_.end(); ++it) {
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ARRAY_BUFFER,
-                sizeof(glm::vec2) * getVec2Vector(it->second).size(),
-                getVec2Vector(it->second).data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, attribute_buffers_[it->second].id);
         glEnableVertexAttribArray(it->first);
         glVertexAttribPointer(it->first, 2, GL_FLOAT, 0, 0, 0);
     }
 
     for (auto it = attribute_vec3_keys_.begin();
             it != attribute_vec3_keys_.end(); ++it) {
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ARRAY_BUFFER,
-                sizeof(glm::vec3) * getVec3Vector(it->second).size(),
-                getVec3Vector(it->second).data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, attribute_buffers_[it->second].id);
         glEnableVertexAttribArray(it->first);
         glVertexAttribPointer(it->first, 3, GL_FLOAT, 0, 0, 0);
     }
 
     for (auto it = attribute_vec4_keys_.begin();
             it != attribute_vec4_keys_.end(); ++it) {
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ARRAY_BUFFER,
-                sizeof(glm::vec4) * getVec4Vector(it->second).size(),
-                getVec4Vector(it->second).data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, attribute_buffers_[it->second].id);
         glEnableVertexAttribArray(it->first);
         glVertexAttribPointer(it->first, 4, GL_FLOAT, 0, 0, 0);
     }
 
     vaoID_map_[key] = vaoID_;
-    triangle_vboID_map_[key] = triangle_vboID_;
-    vert_vboID_map_[key] = vert_vboID_;
-    norm_vboID_map_[key] = norm_vboID_;
-    tex_vboID_map_[key] = tex_vboID_;
 
     // done generation
     glBindVertexArray(0);
@@ -20,31 +20,61 @@
 #ifndef MESH_H_
 #define MESH_H_
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <vector>
 #include <string>
+#include <pthread.h>
 
 #include "GLES3/gl3.h"
 #include "glm/glm.hpp"
 #include "gl/gl_buffer.h"
 
+#include "objects/bounding_volume.h"
 #include "objects/hybrid_object.h"
 #include "objects/material.h"
+#include "objects/mesh_bvh.h"
+#include "objects/mesh_cluster.h"
+#include "util/gvr_name_registry.h"
 
 #include "engine/memory/gl_delete.h"
+#include "engine/memory/gl_name_pool.h"
+#include "engine/memory/gpu_memory.h"
 
 namespace gvr {
-class Mesh: public HybridObject {
+/*
+ * The vertex data stays on the CPU after upload, so over the GpuMemory
+ * budget a mesh not drawn lately gives up its buffers and VAOs, and uploads
+ * them again when it is next drawn.
+ */
+class Mesh: public HybridObject, public GpuMemory::Evictable {
 public:
+    /*
+     * How often the vertex data is expected to change. Selects the GL usage
+     * flag and how dirty data is streamed to the buffers:
+     * STATIC is uploaded once and fully re-specified on change,
+     * DYNAMIC streams only the dirty ranges with glBufferSubData,
+     * STREAM orphans the whole buffer every time it is touched.
+     */
+    enum UsageHint {
+        STATIC_USAGE = 0, DYNAMIC_USAGE = 1, STREAM_USAGE = 2
+    };
+
     Mesh() :
             vertices_(), normals_(), tex_coords_(), triangles_(), float_vectors_(), vec2_vectors_(), vec3_vectors_(), vec4_vectors_(), vertexLoc_(
-                    -1), normalLoc_(-1), texCoordLoc_(-1), have_bounding_box_(
-                    false) {
+                    -1), normalLoc_(-1), texCoordLoc_(-1), numTriangles_(0), usage_hint_(
+                    STATIC_USAGE), bounding_volume_(), bounding_volume_dirty_(
+                    true), clusters_(), clusters_dirty_(false), uv_density_(0.0f), uv_density_dirty_(
+                    true), bvh_(), bvh_dirty_(true), gpu_allocation_(GpuMemory::MESH, this) {
+        pthread_mutex_init(&bvh_mutex_, 0);
     }
 
     ~Mesh() {
+        gpu_allocation_.release();
         cleanUp();
+        pthread_mutex_destroy(&bvh_mutex_);
     }
 
     void cleanUp() {
@@ -56,36 +86,24 @@ public:
         tex_coords.swap(tex_coords_);
         std::vector<unsigned short> triangles;
         triangles.swap(triangles_);
+        std::vector<MeshCluster> clusters;
+        clusters.swap(clusters_);
+        pthread_mutex_lock(&bvh_mutex_);
+        bvh_.clear();
+        bvh_dirty_ = true;
+        pthread_mutex_unlock(&bvh_mutex_);
 
-        for (auto iterator = vaoID_map_.begin(); iterator != vaoID_map_.end();
-                iterator++) {
-            gl_delete.queueVertexArray(iterator->second);
-        }
-        vaoID_map_.clear();
-
-        for (auto iterator = triangle_vboID_map_.begin();
-                iterator != triangle_vboID_map_.end(); iterator++) {
-            gl_delete.queueBuffer(iterator->second);
-        }
-        triangle_vboID_map_.clear();
-
-        for (auto iterator = vert_vboID_map_.begin();
-                iterator != vert_vboID_map_.end(); iterator++) {
-            gl_delete.queueBuffer(iterator->second);
-        }
-        vert_vboID_map_.clear();
+        releaseBuffers();
+    }
 
-        for (auto iterator = norm_vboID_map_.begin();
-                iterator != norm_vboID_map_.end(); iterator++) {
-            gl_delete.queueBuffer(iterator->second);
-        }
-        norm_vboID_map_.clear();
+    // drop the GL objects; the next generateVAO() makes them again
+    void evict() {
+        releaseBuffers();
+    }
 
-        for (auto iterator = tex_vboID_map_.begin();
-                iterator != tex_vboID_map_.end(); iterator++) {
-            gl_delete.queueBuffer(iterator->second);
-        }
-        tex_vboID_map_.clear();
+    // what the vertex and index buffers take on the GPU, in bytes
+    size_t gpu_size() const {
+        return gpu_allocation_.bytes();
     }
 
     std::vector<glm::vec3>& vertices() {
@@ -98,10 +116,34 @@ public:
 
     void set_vertices(const std::vector<glm::vec3>& vertices) {
         vertices_ = vertices;
+        vert_buffer_.markDirty(0, vertices_.size());
+        bounding_volume_dirty_ = true;
+        clusters_dirty_ = true;
+        uv_density_dirty_ = true;
+        bvh_dirty_ = true;
     }
 
     void set_vertices(std::vector<glm::vec3>&& vertices) {
         vertices_ = std::move(vertices);
+        verticesChanged();
+    }
+
+    /*
+     * For callers that write the storage in place, like Java through a
+     * direct ByteBuffer: resize*() makes room without marking anything for
+     * upload, *Changed() publishes whatever was written. Pointers into the
+     * storage stay valid until the next resize or set.
+     */
+    void resizeVertices(size_t count) {
+        vertices_.resize(count);
+    }
+
+    void verticesChanged() {
+        vert_buffer_.markDirty(0, vertices_.size());
+        bounding_volume_dirty_ = true;
+        clusters_dirty_ = true;
+        uv_density_dirty_ = true;
+        bvh_dirty_ = true;
     }
 
     std::vector<glm::vec3>& normals() {
@@ -114,10 +156,20 @@ public:
 
     void set_normals(const std::vector<glm::vec3>& normals) {
         normals_ = normals;
+        norm_buffer_.markDirty(0, normals_.size());
     }
 
     void set_normals(std::vector<glm::vec3>&& normals) {
         normals_ = std::move(normals);
+        normalsChanged();
+    }
+
+    void resizeNormals(size_t count) {
+        normals_.resize(count);
+    }
+
+    void normalsChanged() {
+        norm_buffer_.markDirty(0, normals_.size());
     }
 
     std::vector<glm::vec2>& tex_coords() {
@@ -130,10 +182,22 @@ public:
 
     void set_tex_coords(const std::vector<glm::vec2>& tex_coords) {
         tex_coords_ = tex_coords;
+        tex_buffer_.markDirty(0, tex_coords_.size());
+        uv_density_dirty_ = true;
     }
 
     void set_tex_coords(std::vector<glm::vec2>&& tex_coords) {
         tex_coords_ = std::move(tex_coords);
+        texCoordsChanged();
+    }
+
+    void resizeTexCoords(size_t count) {
+        tex_coords_.resize(count);
+    }
+
+    void texCoordsChanged() {
+        tex_buffer_.markDirty(0, tex_coords_.size());
+        uv_density_dirty_ = true;
     }
 
     std::vector<unsigned short>& triangles() {
@@ -146,112 +210,290 @@ public:
 
     void set_triangles(const std::vector<unsigned short>& triangles) {
         triangles_ = triangles;
+        triangle_buffer_.markDirty(0, triangles_.size());
+        clusters_.clear();
+        uv_density_dirty_ = true;
+        bvh_dirty_ = true;
     }
 
     void set_triangles(std::vector<unsigned short>&& triangles) {
         triangles_ = std::move(triangles);
+        trianglesChanged();
     }
 
-    std::vector<float>& getFloatVector(std::string key) {
-        auto it = float_vectors_.find(key);
-        if (it != float_vectors_.end()) {
-            return it->second;
+    void resizeTriangles(size_t count) {
+        triangles_.resize(count);
+    }
+
+    void trianglesChanged() {
+        triangle_buffer_.markDirty(0, triangles_.size());
+        clusters_.clear();
+        uv_density_dirty_ = true;
+        bvh_dirty_ = true;
+    }
+
+    std::vector<float>& getFloatVector(int handle) {
+        std::vector<float>* vector = float_vectors_.find(handle);
+        if (vector != 0) {
+            return *vector;
         } else {
-            std::string error = "Mesh::getFloatVector() : " + key
-                    + " not found";
+            std::string error = "Mesh::getFloatVector() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
-    const std::vector<float>& getFloatVector(std::string key) const {
-        auto it = float_vectors_.find(key);
-        if (it != float_vectors_.end()) {
-            return it->second;
+    const std::vector<float>& getFloatVector(int handle) const {
+        const std::vector<float>* vector = float_vectors_.find(handle);
+        if (vector != 0) {
+            return *vector;
         } else {
-            std::string error = "Mesh::getFloatVector() : " + key
-                    + " not found";
+            std::string error = "Mesh::getFloatVector() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
-    void setFloatVector(std::string key, const std::vector<float>& vector) {
-        float_vectors_[key] = vector;
+    std::vector<float>& getFloatVector(std::string key) {
+        return getFloatVector(NameRegistry::intern(key));
     }
 
-    std::vector<glm::vec2>& getVec2Vector(std::string key) {
-        auto it = vec2_vectors_.find(key);
-        if (it != vec2_vectors_.end()) {
-            return it->second;
+    const std::vector<float>& getFloatVector(std::string key) const {
+        return getFloatVector(NameRegistry::intern(key));
+    }
+
+    void setFloatVector(int handle, const std::vector<float>& vector) {
+        float_vectors_[handle] = vector;
+        markAttributeDirty(handle, vector.size());
+    }
+
+    void setFloatVector(int handle, std::vector<float>&& vector) {
+        float_vectors_[handle] = std::move(vector);
+        floatVectorChanged(handle);
+    }
+
+    void setFloatVector(std::string key,
+            const std::vector<float>& vector) {
+        setFloatVector(NameRegistry::intern(key), vector);
+    }
+
+    void setFloatVector(std::string key, std::vector<float>&& vector) {
+        setFloatVector(NameRegistry::intern(key), std::move(vector));
+    }
+
+    // creates the attribute if needed; see resizeVertices()
+    std::vector<float>& resizeFloatVector(int handle, size_t count) {
+        std::vector<float>& vector = float_vectors_[handle];
+        vector.resize(count);
+        return vector;
+    }
+
+    void floatVectorChanged(int handle) {
+        markAttributeDirty(handle, getFloatVector(handle).size());
+    }
+
+    std::vector<glm::vec2>& getVec2Vector(int handle) {
+        std::vector<glm::vec2>* vector = vec2_vectors_.find(handle);
+        if (vector != 0) {
+            return *vector;
         } else {
-            std::string error = "Mesh::getVec2Vector() : " + key + " not found";
+            std::string error = "Mesh::getVec2Vector() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
-    const std::vector<glm::vec2>& getVec2Vector(std::string key) const {
-        auto it = vec2_vectors_.find(key);
-        if (it != vec2_vectors_.end()) {
-            return it->second;
+    const std::vector<glm::vec2>& getVec2Vector(int handle) const {
+        const std::vector<glm::vec2>* vector = vec2_vectors_.find(handle);
+        if (vector != 0) {
+            return *vector;
         } else {
-            std::string error = "Mesh::getVec2Vector() : " + key + " not found";
+            std::string error = "Mesh::getVec2Vector() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
-    void setVec2Vector(std::string key, const std::vector<glm::vec2>& vector) {
-        vec2_vectors_[key] = vector;
+    std::vector<glm::vec2>& getVec2Vector(std::string key) {
+        return getVec2Vector(NameRegistry::intern(key));
     }
 
-    std::vector<glm::vec3>& getVec3Vector(std::string key) {
-        auto it = vec3_vectors_.find(key);
-        if (it != vec3_vectors_.end()) {
-            return it->second;
+    const std::vector<glm::vec2>& getVec2Vector(std::string key) const {
+        return getVec2Vector(NameRegistry::intern(key));
+    }
+
+    void setVec2Vector(int handle, const std::vector<glm::vec2>& vector) {
+        vec2_vectors_[handle] = vector;
+        markAttributeDirty(handle, vector.size());
+    }
+
+    void setVec2Vector(int handle, std::vector<glm::vec2>&& vector) {
+        vec2_vectors_[handle] = std::move(vector);
+        markAttributeDirty(handle, vec2_vectors_[handle].size());
+    }
+
+    void setVec2Vector(std::string key,
+            const std::vector<glm::vec2>& vector) {
+        setVec2Vector(NameRegistry::intern(key), vector);
+    }
+
+    void setVec2Vector(std::string key, std::vector<glm::vec2>&& vector) {
+        setVec2Vector(NameRegistry::intern(key), std::move(vector));
+    }
+
+    std::vector<glm::vec3>& getVec3Vector(int handle) {
+        std::vector<glm::vec3>* vector = vec3_vectors_.find(handle);
+        if (vector != 0) {
+            return *vector;
         } else {
-            std::string error = "Mesh::getVec3Vector() : " + key + " not found";
+            std::string error = "Mesh::getVec3Vector() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
-    const std::vector<glm::vec3>& getVec3Vector(std::string key) const {
-        auto it = vec3_vectors_.find(key);
-        if (it != vec3_vectors_.end()) {
-            return it->second;
+    const std::vector<glm::vec3>& getVec3Vector(int handle) const {
+        const std::vector<glm::vec3>* vector = vec3_vectors_.find(handle);
+        if (vector != 0) {
+            return *vector;
         } else {
-            std::string error = "Mesh::getVec3Vector() : " + key + " not found";
+            std::string error = "Mesh::getVec3Vector() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
-    void setVec3Vector(std::string key, const std::vector<glm::vec3>& vector) {
-        vec3_vectors_[key] = vector;
+    std::vector<glm::vec3>& getVec3Vector(std::string key) {
+        return getVec3Vector(NameRegistry::intern(key));
+    }
+
+    const std::vector<glm::vec3>& getVec3Vector(std::string key) const {
+        return getVec3Vector(NameRegistry::intern(key));
     }
 
-    std::vector<glm::vec4>& getVec4Vector(std::string key) {
-        auto it = vec4_vectors_.find(key);
-        if (it != vec4_vectors_.end()) {
-            return it->second;
+    void setVec3Vector(int handle, const std::vector<glm::vec3>& vector) {
+        vec3_vectors_[handle] = vector;
+        markAttributeDirty(handle, vector.size());
+    }
+
+    void setVec3Vector(int handle, std::vector<glm::vec3>&& vector) {
+        vec3_vectors_[handle] = std::move(vector);
+        markAttributeDirty(handle, vec3_vectors_[handle].size());
+    }
+
+    void setVec3Vector(std::string key,
+            const std::vector<glm::vec3>& vector) {
+        setVec3Vector(NameRegistry::intern(key), vector);
+    }
+
+    void setVec3Vector(std::string key, std::vector<glm::vec3>&& vector) {
+        setVec3Vector(NameRegistry::intern(key), std::move(vector));
+    }
+
+    std::vector<glm::vec4>& getVec4Vector(int handle) {
+        std::vector<glm::vec4>* vector = vec4_vectors_.find(handle);
+        if (vector != 0) {
+            return *vector;
         } else {
-            std::string error = "Mesh::getVec4Vector() : " + key + " not found";
+            std::string error = "Mesh::getVec4Vector() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
-    const std::vector<glm::vec4>& getVec4Vector(std::string key) const {
-        auto it = vec4_vectors_.find(key);
-        if (it != vec4_vectors_.end()) {
-            return it->second;
+    const std::vector<glm::vec4>& getVec4Vector(int handle) const {
+        const std::vector<glm::vec4>* vector = vec4_vectors_.find(handle);
+        if (vector != 0) {
+            return *vector;
         } else {
-            std::string error = "Mesh::getVec4Vector() : " + key + " not found";
+            std::string error = "Mesh::getVec4Vector() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
-    void setVec4Vector(std::string key, const std::vector<glm::vec4>& vector) {
-        vec4_vectors_[key] = vector;
+    std::vector<glm::vec4>& getVec4Vector(std::string key) {
+        return getVec4Vector(NameRegistry::intern(key));
+    }
+
+    const std::vector<glm::vec4>& getVec4Vector(std::string key) const {
+        return getVec4Vector(NameRegistry::intern(key));
+    }
+
+    void setVec4Vector(int handle, const std::vector<glm::vec4>& vector) {
+        vec4_vectors_[handle] = vector;
+        markAttributeDirty(handle, vector.size());
+    }
+
+    void setVec4Vector(int handle, std::vector<glm::vec4>&& vector) {
+        vec4_vectors_[handle] = std::move(vector);
+        markAttributeDirty(handle, vec4_vectors_[handle].size());
+    }
+
+    void setVec4Vector(std::string key,
+            const std::vector<glm::vec4>& vector) {
+        setVec4Vector(NameRegistry::intern(key), vector);
+    }
+
+    void setVec4Vector(std::string key, std::vector<glm::vec4>&& vector) {
+        setVec4Vector(NameRegistry::intern(key), std::move(vector));
+    }
+
+    // Overwrite count elements starting at first and mark only that range
+    // for upload. The attribute must already hold first + count elements.
+    void updateVertices(int first, const glm::vec3* vertices, int count);
+    void updateNormals(int first, const glm::vec3* normals, int count);
+    void updateTexCoords(int first, const glm::vec2* tex_coords, int count);
+
+    UsageHint usage_hint() const {
+        return usage_hint_;
+    }
+
+    void set_usage_hint(UsageHint usage_hint) {
+        usage_hint_ = usage_hint;
     }
 
     Mesh* getBoundingBox();
-    const float* getBoundingBoxInfo(); // Xmin, Ymin, Zmin and Xmax, Ymax, Zmax
+
+    // local space bounds, recomputed after the vertices change
+    const BoundingVolume& getBoundingVolume();
+
+    /*
+     * Texture coordinate units per mesh unit, averaged over the triangles'
+     * areas; 0 without texture coordinates. The texture streamer uses it to
+     * tell how many texels land on a pixel.
+     */
+    float getUVDensity();
+
+    // Bounds known ahead of time, e.g. stored with an imported model; they
+    // stay valid until the vertices change.
+    void setBoundingVolume(const BoundingVolume& bounding_volume) {
+        bounding_volume_ = bounding_volume;
+        bounding_volume_dirty_ = false;
+    }
+
+    /*
+     * Split the mesh into clusters of at most max_triangles triangles (64 to
+     * 256 works well) that the renderer culls one by one. This reorders the
+     * triangles so each cluster is a contiguous index range; setting new
+     * triangles drops the clusters again.
+     */
+    void buildClusters(int max_triangles);
+
+    void clearClusters() {
+        clusters_.clear();
+    }
+
+    // per cluster bounds, refreshed after the vertices change
+    const std::vector<MeshCluster>& getClusters();
+
+    /*
+     * Nearest hit of origin + t * direction, t > 0, in local space. The
+     * triangle hierarchy it searches is built on first use and again after
+     * the vertices or triangles change. Pickers call it from any thread.
+     */
+    bool intersect(const glm::vec3& origin, const glm::vec3& direction,
+            float& distance, glm::vec3& hit);
 
     // /////////////////////////////////////////////////
     //  code for vertex attribute location
@@ -280,23 +522,39 @@ public:
         return texCoordLoc_;
     }
 
+    void setVertexAttribLocF(GLuint location, int handle) {
+        attribute_float_keys_[location] = handle;
+    }
+
     void setVertexAttribLocF(GLuint location, std::string key) {
-        attribute_float_keys_[location] = key;
+        setVertexAttribLocF(location, NameRegistry::intern(key));
+    }
+
+    void setVertexAttribLocV2(GLuint location, int handle) {
+        attribute_vec2_keys_[location] = handle;
     }
 
     void setVertexAttribLocV2(GLuint location, std::string key) {
-        attribute_vec2_keys_[location] = key;
+        setVertexAttribLocV2(location, NameRegistry::intern(key));
+    }
+
+    void setVertexAttribLocV3(GLuint location, int handle) {
+        attribute_vec3_keys_[location] = handle;
     }
 
     void setVertexAttribLocV3(GLuint location, std::string key) {
-        attribute_vec3_keys_[location] = key;
+        setVertexAttribLocV3(location, NameRegistry::intern(key));
+    }
+
+    void setVertexAttribLocV4(GLuint location, int handle) {
+        attribute_vec4_keys_[location] = handle;
     }
 
     void setVertexAttribLocV4(GLuint location, std::string key) {
-        attribute_vec4_keys_[location] = key;
+        setVertexAttribLocV4(location, NameRegistry::intern(key));
     }
 
-    // generate VAO
+    // generate VAO, streaming any dirty vertex data to the shared VBOs
     void generateVAO(Material::ShaderType key);
 
     const GLuint getVAOId(Material::ShaderType key) const {
@@ -308,6 +566,88 @@ public:
         return numTriangles_;
     }
 
+private:
+    /*
+     * A vertex or index buffer shared by the VAOs of every shader type,
+     * together with the element range [dirty_begin, dirty_end) that has
+     * changed on the CPU side since the last upload.
+     */
+    struct MeshBuffer {
+        MeshBuffer() :
+                id(0), usage(0), size(0), capacity(0), dirty_begin(0), dirty_end(
+                        0) {
+        }
+
+        void markDirty(size_t first, size_t count) {
+            if (count == 0) {
+                return;
+            }
+            if (dirty_begin == dirty_end) {
+                dirty_begin = first;
+                dirty_end = first + count;
+            } else {
+                dirty_begin = std::min(dirty_begin, first);
+                dirty_end = std::max(dirty_end, first + count);
+            }
+        }
+
+        bool dirty() const {
+            return dirty_begin != dirty_end;
+        }
+
+        void release() {
+            if (id != 0) {
+                gl_delete.queueBuffer(id, usage, capacity);
+                id = 0;
+            }
+            size = 0;
+            capacity = 0;
+            dirty_begin = dirty_end = 0;
+        }
+
+        GLuint id;
+        GLenum usage;
+        // of the data, and of the store, which may be a larger pooled one
+        GLsizeiptr size;
+        GLsizeiptr capacity;
+        size_t dirty_begin;
+        size_t dirty_end;
+    };
+
+    void markAttributeDirty(int handle, size_t count) {
+        MeshBuffer* buffer = attribute_buffers_.find(handle);
+        if (buffer != 0) {
+            buffer->markDirty(0, count);
+        }
+    }
+
+    bool uploadBuffer(GLenum target, MeshBuffer& buffer, const void* data,
+            size_t element_size, size_t count);
+    void uploadBuffers();
+
+    void releaseBuffers() {
+        for (auto iterator = vaoID_map_.begin(); iterator != vaoID_map_.end();
+                iterator++) {
+            gl_delete.queueVertexArray(iterator->second);
+        }
+        vaoID_map_.clear();
+
+        triangle_buffer_.release();
+        vert_buffer_.release();
+        norm_buffer_.release();
+        tex_buffer_.release();
+
+        for (int handle = 0; handle < attribute_buffers_.capacity();
+                ++handle) {
+            MeshBuffer* buffer = attribute_buffers_.find(handle);
+            if (buffer != 0) {
+                buffer->release();
+            }
+        }
+        attribute_buffers_.clear();
+        gpu_allocation_.release();
+    }
+
 private:
     Mesh(const Mesh& mesh);
     Mesh(Mesh&& mesh);
@@ -318,24 +658,25 @@ private:
     std::vector<glm::vec3> vertices_;
     std::vector<glm::vec3> normals_;
     std::vector<glm::vec2> tex_coords_;
-    std::map<std::string, std::vector<float>> float_vectors_;
-    std::map<std::string, std::vector<glm::vec2>> vec2_vectors_;
-    std::map<std::string, std::vector<glm::vec3>> vec3_vectors_;
-    std::map<std::string, std::vector<glm::vec4>> vec4_vectors_;
+    HandleMap<std::vector<float>> float_vectors_;
+    HandleMap<std::vector<glm::vec2>> vec2_vectors_;
+    HandleMap<std::vector<glm::vec3>> vec3_vectors_;
+    HandleMap<std::vector<glm::vec4>> vec4_vectors_;
     std::vector<unsigned short> triangles_;
 
-    // add location slot map
-    std::map<int, std::string> attribute_float_keys_;
-    std::map<int, std::string> attribute_vec2_keys_;
-    std::map<int, std::string> attribute_vec3_keys_;
-    std::map<int, std::string> attribute_vec4_keys_;
+    // add location slot map, attribute location to NameRegistry handle
+    std::map<int, int> attribute_float_keys_;
+    std::map<int, int> attribute_vec2_keys_;
+    std::map<int, int> attribute_vec3_keys_;
+    std::map<int, int> attribute_vec4_keys_;
 
-    // add vertex array object and VBO
+    // one vertex array object per shader type, all sharing the same VBOs
     std::map<Material::ShaderType, GLuint> vaoID_map_;
-    std::map<Material::ShaderType, GLuint> triangle_vboID_map_;
-    std::map<Material::ShaderType, GLuint> vert_vboID_map_;
-    std::map<Material::ShaderType, GLuint> norm_vboID_map_;
-    std::map<Material::ShaderType, GLuint> tex_vboID_map_;
+    MeshBuffer triangle_buffer_;
+    MeshBuffer vert_buffer_;
+    MeshBuffer norm_buffer_;
+    MeshBuffer tex_buffer_;
+    HandleMap<MeshBuffer> attribute_buffers_;
 
     // attribute locations
     GLuint vertexLoc_;
@@ -345,9 +686,26 @@ private:
     // triangle information
     GLuint numTriangles_;
 
-    // bounding box info
-    bool have_bounding_box_;
-    float bounding_box_info_[6];
+    UsageHint usage_hint_;
+
+    // bounding box and sphere
+    BoundingVolume bounding_volume_;
+    bool bounding_volume_dirty_;
+
+    // optional split of triangles_ for finer culling
+    std::vector<MeshCluster> clusters_;
+    bool clusters_dirty_;
+
+    float uv_density_;
+    bool uv_density_dirty_;
+
+    // for picking; the mutex keeps concurrent picks off a rebuild, the
+    // setters flag changes from any thread
+    MeshBVH bvh_;
+    std::atomic<bool> bvh_dirty_;
+    pthread_mutex_t bvh_mutex_;
+
+    GpuAllocation gpu_allocation_;
 };
 }
 #endif
@@ -0,0 +1,390 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Bounding volume hierarchy over a mesh's triangles, for ray picking.
+ ***************************************************************************/
+
+#include "mesh_bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace gvr {
+
+// centroid bins tried per axis when looking for a split
+static const int BIN_COUNT = 16;
+// cost of visiting a node, relative to one triangle test
+static const float TRAVERSAL_COST = 1.0f;
+// leaves this small are kept even if a split looks cheaper
+static const int MIN_SPLIT_TRIANGLES = 2;
+// leaves may exceed this only when the heuristic finds no split at all
+static const int MAX_LEAF_TRIANGLES = 8;
+// also bounds the traversal stack
+static const int MAX_DEPTH = 48;
+
+static const float EPSILON = 0.00001f;
+
+namespace {
+
+struct Bounds {
+    Bounds() :
+            min_corner(std::numeric_limits<float>::max()), max_corner(
+                    -std::numeric_limits<float>::max()) {
+    }
+
+    void expand(const glm::vec3& point) {
+        min_corner = glm::min(min_corner, point);
+        max_corner = glm::max(max_corner, point);
+    }
+
+    void expand(const Bounds& bounds) {
+        min_corner = glm::min(min_corner, bounds.min_corner);
+        max_corner = glm::max(max_corner, bounds.max_corner);
+    }
+
+    // half the surface area, which is all the heuristic needs
+    float area() const {
+        glm::vec3 extent = max_corner - min_corner;
+        if (extent.x < 0.0f) {
+            return 0.0f;
+        }
+        return extent.x * extent.y + extent.y * extent.z
+                + extent.z * extent.x;
+    }
+
+    glm::vec3 min_corner;
+    glm::vec3 max_corner;
+};
+
+struct Bin {
+    Bin() :
+            bounds(), count(0) {
+    }
+
+    Bounds bounds;
+    int count;
+};
+
+struct BuildTask {
+    int node;
+    int begin;
+    int end;
+    int depth;
+};
+
+struct TraversalEntry {
+    int node;
+    float distance;
+};
+
+}
+
+// entry distance of the ray into the box, if it enters before far
+static bool intersectBox(const glm::vec3& min_corner,
+        const glm::vec3& max_corner, const glm::vec3& origin,
+        const glm::vec3& inv_direction, float far, float& entry) {
+    glm::vec3 t0 = (min_corner - origin) * inv_direction;
+    glm::vec3 t1 = (max_corner - origin) * inv_direction;
+    glm::vec3 t_near = glm::min(t0, t1);
+    glm::vec3 t_far = glm::max(t0, t1);
+    entry = std::max(std::max(t_near.x, t_near.y), std::max(t_near.z, 0.0f));
+    float exit = std::min(std::min(t_far.x, t_far.y), std::min(t_far.z, far));
+    return entry <= exit;
+}
+
+// http://en.wikipedia.org/wiki/M%C3%B6ller%E2%80%93Trumbore_intersection_algorithm
+static bool intersectTriangle(const glm::vec3& V1, const glm::vec3& V2,
+        const glm::vec3& V3, const glm::vec3& O, const glm::vec3& D,
+        float& t, float& u, float& v) {
+    glm::vec3 e1(V2 - V1);
+    glm::vec3 e2(V3 - V1);
+
+    glm::vec3 P = glm::cross(D, e2);
+    float det = glm::dot(e1, P);
+    if (det > -EPSILON && det < EPSILON) {
+        return false;
+    }
+    float inv_det = 1.0f / det;
+
+    glm::vec3 T(O - V1);
+    u = glm::dot(T, P) * inv_det;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+
+    glm::vec3 Q = glm::cross(T, e1);
+    v = glm::dot(D, Q) * inv_det;
+    if (v < 0.0f || (u + v) > 1.0f) {
+        return false;
+    }
+
+    t = glm::dot(e2, Q) * inv_det;
+    return t > EPSILON;
+}
+
+void MeshBVH::build(const std::vector<glm::vec3>& vertices,
+        const std::vector<unsigned short>& triangles) {
+    clear();
+
+    std::vector<Bounds> triangle_bounds;
+    std::vector<glm::vec3> centroids;
+    for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+        unsigned short a = triangles[i];
+        unsigned short b = triangles[i + 1];
+        unsigned short c = triangles[i + 2];
+        if (a >= vertices.size() || b >= vertices.size()
+                || c >= vertices.size()) {
+            continue;
+        }
+        Bounds bounds;
+        bounds.expand(vertices[a]);
+        bounds.expand(vertices[b]);
+        bounds.expand(vertices[c]);
+        triangle_bounds.push_back(bounds);
+        centroids.push_back((vertices[a] + vertices[b] + vertices[c]) / 3.0f);
+        triangle_numbers_.push_back(i / 3);
+    }
+    if (triangle_numbers_.empty()) {
+        return;
+    }
+
+    // bounds and centroids are indexed like triangle_numbers_ is before
+    // partitioning, so partition a permutation and apply it at the end
+    int triangle_count = triangle_numbers_.size();
+    std::vector<int> order(triangle_count);
+    for (int i = 0; i < triangle_count; ++i) {
+        order[i] = i;
+    }
+
+    nodes_.reserve(triangle_count * 2);
+    nodes_.push_back(Node());
+    std::vector<BuildTask> tasks;
+    BuildTask root = { 0, 0, triangle_count, 0 };
+    tasks.push_back(root);
+
+    while (!tasks.empty()) {
+        BuildTask task = tasks.back();
+        tasks.pop_back();
+        int count = task.end - task.begin;
+
+        Bounds bounds;
+        Bounds centroid_bounds;
+        for (int i = task.begin; i < task.end; ++i) {
+            bounds.expand(triangle_bounds[order[i]]);
+            centroid_bounds.expand(centroids[order[i]]);
+        }
+        nodes_[task.node].min_corner = bounds.min_corner;
+        nodes_[task.node].max_corner = bounds.max_corner;
+        nodes_[task.node].first = task.begin;
+        nodes_[task.node].count = count;
+
+        if (count <= MIN_SPLIT_TRIANGLES || task.depth >= MAX_DEPTH) {
+            continue;
+        }
+
+        // cheapest split between bins along any axis
+        float leaf_cost = count;
+        float best_cost = std::numeric_limits<float>::max();
+        int best_axis = -1;
+        int best_split = 0;
+        glm::vec3 centroid_extent = centroid_bounds.max_corner
+                - centroid_bounds.min_corner;
+        float inv_area = 1.0f / std::max(bounds.area(), EPSILON);
+        for (int axis = 0; axis < 3; ++axis) {
+            if (centroid_extent[axis] <= 0.0f) {
+                continue;
+            }
+            float scale = BIN_COUNT / centroid_extent[axis];
+            Bin bins[BIN_COUNT];
+            for (int i = task.begin; i < task.end; ++i) {
+                int bin = std::min(BIN_COUNT - 1,
+                        static_cast<int>((centroids[order[i]][axis]
+                                - centroid_bounds.min_corner[axis]) * scale));
+                bins[bin].bounds.expand(triangle_bounds[order[i]]);
+                ++bins[bin].count;
+            }
+
+            // right hand costs swept from the top, then the left side
+            float right_cost[BIN_COUNT];
+            Bounds right;
+            int right_count = 0;
+            for (int bin = BIN_COUNT - 1; bin > 0; --bin) {
+                right.expand(bins[bin].bounds);
+                right_count += bins[bin].count;
+                right_cost[bin] = right_count == 0 ? -1.0f :
+                        right.area() * right_count;
+            }
+            Bounds left;
+            int left_count = 0;
+            for (int split = 1; split < BIN_COUNT; ++split) {
+                left.expand(bins[split - 1].bounds);
+                left_count += bins[split - 1].count;
+                if (left_count == 0 || right_cost[split] < 0.0f) {
+                    continue;
+                }
+                float cost = TRAVERSAL_COST
+                        + (left.area() * left_count + right_cost[split])
+                                * inv_area;
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_axis = axis;
+                    best_split = split;
+                }
+            }
+        }
+
+        if (best_axis < 0
+                || (best_cost >= leaf_cost && count <= MAX_LEAF_TRIANGLES)) {
+            continue;
+        }
+
+        float scale = BIN_COUNT / centroid_extent[best_axis];
+        float min_centroid = centroid_bounds.min_corner[best_axis];
+        int* middle = std::partition(&order[task.begin], &order[0] + task.end,
+                [&](int triangle) {
+                    int bin = std::min(BIN_COUNT - 1,
+                            static_cast<int>((centroids[triangle][best_axis]
+                                    - min_centroid) * scale));
+                    return bin < best_split;
+                });
+        int mid = middle - &order[0];
+
+        int children = nodes_.size();
+        nodes_.push_back(Node());
+        nodes_.push_back(Node());
+        nodes_[task.node].first = children;
+        nodes_[task.node].count = 0;
+        BuildTask left_task = { children, task.begin, mid, task.depth + 1 };
+        BuildTask right_task = { children + 1, mid, task.end, task.depth + 1 };
+        tasks.push_back(right_task);
+        tasks.push_back(left_task);
+    }
+
+    std::vector<int> triangle_numbers(triangle_count);
+    for (int i = 0; i < triangle_count; ++i) {
+        triangle_numbers[i] = triangle_numbers_[order[i]];
+    }
+    triangle_numbers_.swap(triangle_numbers);
+}
+
+bool MeshBVH::intersect(const std::vector<glm::vec3>& vertices,
+        const std::vector<unsigned short>& triangles, const glm::vec3& origin,
+        const glm::vec3& direction, float& distance, glm::vec3& hit) const {
+    if (nodes_.empty()) {
+        return false;
+    }
+
+    // a huge finite slope keeps axis parallel rays out of 0 * inf
+    glm::vec3 inv_direction;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (std::fabs(direction[axis]) > EPSILON * EPSILON) {
+            inv_direction[axis] = 1.0f / direction[axis];
+        } else {
+            inv_direction[axis] =
+                    direction[axis] < 0.0f ?
+                            -std::numeric_limits<float>::max() :
+                            std::numeric_limits<float>::max();
+        }
+    }
+
+    float closest = std::numeric_limits<float>::infinity();
+    int closest_triangle = -1;
+    float closest_u = 0.0f;
+    float closest_v = 0.0f;
+
+    // every inner node pops one entry and pushes at most two
+    TraversalEntry stack[MAX_DEPTH + 2];
+    int top = 0;
+    float entry;
+    if (!intersectBox(nodes_[0].min_corner, nodes_[0].max_corner, origin,
+            inv_direction, closest, entry)) {
+        return false;
+    }
+    stack[top].node = 0;
+    stack[top].distance = entry;
+    ++top;
+
+    while (top > 0) {
+        --top;
+        if (stack[top].distance > closest) {
+            continue;
+        }
+        const Node& node = nodes_[stack[top].node];
+
+        if (node.count > 0) {
+            for (int i = node.first; i < node.first + node.count; ++i) {
+                // a pick between resizing the data and the rebuild it asks
+                // for sees a hierarchy older than the lists
+                size_t index = triangle_numbers_[i] * 3;
+                if (index + 2 >= triangles.size()
+                        || triangles[index] >= vertices.size()
+                        || triangles[index + 1] >= vertices.size()
+                        || triangles[index + 2] >= vertices.size()) {
+                    continue;
+                }
+                float t, u, v;
+                if (intersectTriangle(vertices[triangles[index]],
+                        vertices[triangles[index + 1]],
+                        vertices[triangles[index + 2]], origin, direction, t,
+                        u, v) && t < closest) {
+                    closest = t;
+                    closest_triangle = index;
+                    closest_u = u;
+                    closest_v = v;
+                }
+            }
+            continue;
+        }
+
+        // pop the nearer child first so its hits can cull the other
+        int near_node = node.first;
+        int far_node = node.first + 1;
+        float near_entry, far_entry;
+        bool near_hit = intersectBox(nodes_[near_node].min_corner,
+                nodes_[near_node].max_corner, origin, inv_direction, closest,
+                near_entry);
+        bool far_hit = intersectBox(nodes_[far_node].min_corner,
+                nodes_[far_node].max_corner, origin, inv_direction, closest,
+                far_entry);
+        if (far_hit && (!near_hit || far_entry < near_entry)) {
+            std::swap(near_node, far_node);
+            std::swap(near_hit, far_hit);
+            std::swap(near_entry, far_entry);
+        }
+        if (far_hit) {
+            stack[top].node = far_node;
+            stack[top].distance = far_entry;
+            ++top;
+        }
+        if (near_hit) {
+            stack[top].node = near_node;
+            stack[top].distance = near_entry;
+            ++top;
+        }
+    }
+
+    if (closest_triangle < 0) {
+        return false;
+    }
+    distance = closest;
+    hit = (1.0f - closest_u - closest_v) * vertices[triangles[closest_triangle]]
+            + closest_u * vertices[triangles[closest_triangle + 1]]
+            + closest_v * vertices[triangles[closest_triangle + 2]];
+    return true;
+}
+
+}
@@ -0,0 +1,78 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Bounding volume hierarchy over a mesh's triangles, for ray picking.
+ ***************************************************************************/
+
+#ifndef MESH_BVH_H_
+#define MESH_BVH_H_
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace gvr {
+
+class MeshBVH {
+public:
+    MeshBVH() :
+            nodes_(), triangle_numbers_() {
+    }
+
+    /*
+     * Binned surface area heuristic build over the triangles; ones with
+     * out of range indices are left out. Triangle numbers refer to the
+     * index list, so the hierarchy must be rebuilt after either changes.
+     */
+    void build(const std::vector<glm::vec3>& vertices,
+            const std::vector<unsigned short>& triangles);
+
+    void clear() {
+        nodes_.clear();
+        triangle_numbers_.clear();
+    }
+
+    bool empty() const {
+        return nodes_.empty();
+    }
+
+    /*
+     * Nearest intersection of origin + t * direction, t > 0, with the
+     * triangles the hierarchy was built from. Subtrees entered beyond the
+     * closest hit so far are skipped. On a hit, t and the point are stored.
+     */
+    bool intersect(const std::vector<glm::vec3>& vertices,
+            const std::vector<unsigned short>& triangles,
+            const glm::vec3& origin, const glm::vec3& direction,
+            float& distance, glm::vec3& hit) const;
+
+private:
+    // a leaf has count triangles from triangle_numbers_[first], an inner
+    // node has count 0 and its children at nodes_[first] and [first + 1]
+    struct Node {
+        glm::vec3 min_corner;
+        glm::vec3 max_corner;
+        int first;
+        int count;
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<int> triangle_numbers_;
+};
+
+}
+
+#endif
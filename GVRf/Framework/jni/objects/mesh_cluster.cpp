@@ -0,0 +1,209 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Clusters of neighboring triangles that are culled individually.
+ ***************************************************************************/
+
+#include "mesh_cluster.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "objects/bounding_volume.h"
+
+namespace gvr {
+
+// a triangle joins a cluster only if its normal is within ~70 degrees of
+// the cluster's average, which keeps the normal cones narrow
+static const float MIN_NORMAL_DOT = 0.35f;
+
+void MeshCluster::computeBounds(const glm::vec3* vertices,
+        const unsigned short* triangles) {
+    std::vector<glm::vec3> points(index_count);
+    for (int i = 0; i < index_count; ++i) {
+        points[i] = vertices[triangles[first_index + i]];
+    }
+    BoundingVolume volume;
+    volume.compute(points.data(), points.size());
+    center = volume.center();
+    radius = volume.radius();
+
+    std::vector<glm::vec3> normals;
+    glm::vec3 sum(0.0f);
+    for (int i = 0; i + 2 < index_count; i += 3) {
+        glm::vec3 normal = glm::cross(points[i + 1] - points[i],
+                points[i + 2] - points[i]);
+        float length = glm::length(normal);
+        if (length > 0.0f) {
+            normal /= length;
+            normals.push_back(normal);
+            sum += normal;
+        }
+    }
+
+    cone_axis = glm::vec3(0.0f, 0.0f, 1.0f);
+    cone_cutoff = 1.0f;
+    float sum_length = glm::length(sum);
+    if (normals.empty() || sum_length <= 0.0f) {
+        return;
+    }
+    cone_axis = sum / sum_length;
+
+    float min_dot = 1.0f;
+    for (auto it = normals.begin(); it != normals.end(); ++it) {
+        min_dot = std::min(min_dot, glm::dot(*it, cone_axis));
+    }
+    // a cone wider than a hemisphere can always be seen from somewhere
+    if (min_dot > 0.0f) {
+        cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+    }
+}
+
+std::vector<MeshCluster> MeshClusterBuilder::build(
+        const std::vector<glm::vec3>& vertices,
+        std::vector<unsigned short>& triangles, int max_triangles) {
+    std::vector<MeshCluster> clusters;
+    int triangle_count = triangles.size() / 3;
+    if (triangle_count == 0 || max_triangles <= 0) {
+        return clusters;
+    }
+
+    // triangles around each vertex, in compressed rows
+    std::vector<int> first_adjacent(vertices.size() + 1, 0);
+    for (int i = 0; i < triangle_count * 3; ++i) {
+        ++first_adjacent[triangles[i] + 1];
+    }
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        first_adjacent[v + 1] += first_adjacent[v];
+    }
+    std::vector<int> adjacent(triangle_count * 3);
+    std::vector<int> fill(first_adjacent.begin(), first_adjacent.end() - 1);
+    for (int i = 0; i < triangle_count * 3; ++i) {
+        adjacent[fill[triangles[i]]++] = i / 3;
+    }
+
+    std::vector<glm::vec3> normals(triangle_count);
+    std::vector<glm::vec3> centroids(triangle_count);
+    for (int t = 0; t < triangle_count; ++t) {
+        const glm::vec3& a = vertices[triangles[t * 3]];
+        const glm::vec3& b = vertices[triangles[t * 3 + 1]];
+        const glm::vec3& c = vertices[triangles[t * 3 + 2]];
+        glm::vec3 normal = glm::cross(b - a, c - a);
+        float length = glm::length(normal);
+        normals[t] = length > 0.0f ? normal / length : normal;
+        centroids[t] = (a + b + c) / 3.0f;
+    }
+
+    std::vector<bool> assigned(triangle_count, false);
+    std::vector<bool> in_frontier(triangle_count, false);
+    std::vector<unsigned short> reordered;
+    reordered.reserve(triangles.size());
+    std::vector<int> members;
+    std::vector<int> frontier;
+    int seed = 0;
+
+    while (true) {
+        while (seed < triangle_count && assigned[seed]) {
+            ++seed;
+        }
+        if (seed == triangle_count) {
+            break;
+        }
+
+        members.clear();
+        frontier.clear();
+        frontier.push_back(seed);
+        in_frontier[seed] = true;
+        glm::vec3 normal_sum(0.0f);
+        glm::vec3 centroid_sum(0.0f);
+
+        while (static_cast<int>(members.size()) < max_triangles
+                && !frontier.empty()) {
+            // take the candidate closest to the cluster so far, skipping
+            // those that would widen the normal cone too much
+            int best = -1;
+            float best_distance = std::numeric_limits<float>::max();
+            glm::vec3 center =
+                    members.empty() ?
+                            centroids[seed] :
+                            centroid_sum / static_cast<float>(members.size());
+            float normal_length = glm::length(normal_sum);
+            for (size_t i = 0; i < frontier.size(); ++i) {
+                int t = frontier[i];
+                if (normal_length > 0.0f
+                        && glm::dot(normals[t], normal_sum)
+                                < MIN_NORMAL_DOT * normal_length) {
+                    continue;
+                }
+                glm::vec3 offset = centroids[t] - center;
+                float distance = glm::dot(offset, offset);
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best = i;
+                }
+            }
+            if (best < 0) {
+                break;
+            }
+
+            int t = frontier[best];
+            frontier[best] = frontier.back();
+            frontier.pop_back();
+            in_frontier[t] = false;
+            assigned[t] = true;
+            members.push_back(t);
+            normal_sum += normals[t];
+            centroid_sum += centroids[t];
+
+            for (int k = 0; k < 3; ++k) {
+                int v = triangles[t * 3 + k];
+                for (int j = first_adjacent[v]; j < first_adjacent[v + 1];
+                        ++j) {
+                    int neighbor = adjacent[j];
+                    if (!assigned[neighbor] && !in_frontier[neighbor]) {
+                        in_frontier[neighbor] = true;
+                        frontier.push_back(neighbor);
+                    }
+                }
+            }
+        }
+
+        for (size_t i = 0; i < frontier.size(); ++i) {
+            in_frontier[frontier[i]] = false;
+        }
+
+        MeshCluster cluster;
+        cluster.first_index = reordered.size();
+        cluster.index_count = members.size() * 3;
+        for (size_t i = 0; i < members.size(); ++i) {
+            reordered.push_back(triangles[members[i] * 3]);
+            reordered.push_back(triangles[members[i] * 3 + 1]);
+            reordered.push_back(triangles[members[i] * 3 + 2]);
+        }
+        clusters.push_back(cluster);
+    }
+
+    // trailing indices that do not form a triangle are dropped, as GL would
+    triangles.swap(reordered);
+    for (auto it = clusters.begin(); it != clusters.end(); ++it) {
+        it->computeBounds(vertices.data(), triangles.data());
+    }
+    return clusters;
+}
+
+}
@@ -0,0 +1,75 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Clusters of neighboring triangles that are culled individually.
+ ***************************************************************************/
+
+#ifndef MESH_CLUSTER_H_
+#define MESH_CLUSTER_H_
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace gvr {
+
+struct MeshCluster {
+    MeshCluster() :
+            center(), radius(0.0f), cone_axis(), cone_cutoff(1.0f), first_index(
+                    0), index_count(0) {
+    }
+
+    // Fit the sphere and normal cone to the cluster's triangles.
+    void computeBounds(const glm::vec3* vertices,
+            const unsigned short* triangles);
+
+    // True if no triangle of the cluster can face a viewer at eye.
+    bool backfacing(const glm::vec3& eye) const {
+        glm::vec3 direction = center - eye;
+        return glm::dot(direction, cone_axis)
+                >= cone_cutoff * glm::length(direction) + radius;
+    }
+
+    glm::vec3 center;
+    float radius;
+    // every face normal is within acos(sqrt(1 - cone_cutoff^2)) of the
+    // axis; a cutoff of 1 disables the backface test
+    glm::vec3 cone_axis;
+    float cone_cutoff;
+    // range in the mesh's index buffer
+    int first_index;
+    int index_count;
+};
+
+class MeshClusterBuilder {
+private:
+    MeshClusterBuilder();
+
+public:
+    /*
+     * Split the triangles into clusters of at most max_triangles each, grown
+     * over shared vertices while the face normals stay similar, and reorder
+     * triangles so every cluster is one contiguous index range.
+     */
+    static std::vector<MeshCluster> build(
+            const std::vector<glm::vec3>& vertices,
+            std::vector<unsigned short>& triangles, int max_triangles);
+};
+
+}
+
+#endif
@@ -20,8 +20,6 @@
 
 #include "mesh_eye_pointee.h"
 
-#include <limits>
-
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_inverse.hpp"
 
@@ -38,72 +36,19 @@ MeshEyePointee::~MeshEyePointee() {
 
 EyePointData MeshEyePointee::isPointed(const glm::mat4& mv_matrix, float ox,
         float oy, float oz, float dx, float dy, float dz) {
+    // an affine map keeps the ray parameter, so the distance found in
+    // model space is the same as along the eye space ray
     glm::mat4 inv_mv_matrix = glm::affineInverse(mv_matrix);
-    std::vector<glm::vec4> relative_veritces;
-    for (auto it = mesh_->vertices().begin(); it != mesh_->vertices().end();
-            ++it) {
-        glm::vec4 mesh_vertex(*it, 1.0f);
-        relative_veritces.push_back(mv_matrix * mesh_vertex);
-    }
+    glm::vec3 origin(inv_mv_matrix * glm::vec4(ox, oy, oz, 1.0f));
+    glm::vec3 direction(inv_mv_matrix * glm::vec4(dx, dy, dz, 0.0f));
 
     EyePointData data;
-
-    //http://en.wikipedia.org/wiki/M%C3%B6ller%E2%80%93Trumbore_intersection_algorithm
-    for (int i = 0; i < mesh_->triangles().size(); i += 3) {
-        glm::vec3 O(ox, oy, oz);
-        glm::vec3 D(dx, dy, dz);
-
-        glm::vec3 V1(relative_veritces[mesh_->triangles()[i]]);
-        glm::vec3 V2(relative_veritces[mesh_->triangles()[i + 1]]);
-        glm::vec3 V3(relative_veritces[mesh_->triangles()[i + 2]]);
-
-        glm::vec3 e1(V2 - V1);
-        glm::vec3 e2(V3 - V1);
-
-        glm::vec3 P = glm::cross(D, e2);
-
-        float det = glm::dot(e1, P);
-
-        const float EPSILON = 0.00001f;
-
-        if (det > -EPSILON && det < EPSILON) {
-            continue;
-        }
-
-        float inv_det = 1.0f / det;
-
-        glm::vec3 T(O - V1);
-
-        float u = glm::dot(T, P) * inv_det;
-
-        if (u < 0.0f || u > 1.0f) {
-            continue;
-        }
-
-        glm::vec3 Q = glm::cross(T, e1);
-
-        float v = glm::dot(D, Q) * inv_det;
-
-        if (v < 0.0f || (u + v) > 1.0f) {
-            continue;
-        }
-
-        float t = glm::dot(e2, Q) * inv_det;
-
-        if (t > EPSILON) {
-            float distance = t;
-            if (distance < data.distance()) {
-                data.setDistance(distance);
-                data.setHit(
-                        glm::vec3(
-                                inv_mv_matrix
-                                        * glm::vec4(
-                                                (1.0f - u - v) * V1 + u * V2
-                                                        + v * V3, 1.0f)));
-            }
-        }
+    float distance;
+    glm::vec3 hit;
+    if (mesh_->intersect(origin, direction, distance, hit)) {
+        data.setDistance(distance);
+        data.setHit(hit);
     }
-
     return data;
 }
 
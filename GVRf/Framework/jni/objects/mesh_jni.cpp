@@ -87,9 +87,110 @@ Java_org_gearvrf_NativeMesh_setVec4Vector(JNIEnv * env,
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeMesh_getBoundingBox(JNIEnv * env,
         jobject obj, jlong jmesh);
+
+JNIEXPORT jfloatArray JNICALL
+Java_org_gearvrf_NativeMesh_getBoundingVolume(JNIEnv * env,
+        jobject obj, jlong jmesh);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setBoundingVolume(JNIEnv * env,
+        jobject obj, jlong jmesh, jfloatArray bounding_volume);
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setUsageHint(JNIEnv * env,
+        jobject obj, jlong jmesh, jint usage_hint);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_updateVertices(JNIEnv * env,
+        jobject obj, jlong jmesh, jint first, jfloatArray vertices);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_updateNormals(JNIEnv * env,
+        jobject obj, jlong jmesh, jint first, jfloatArray normals);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_updateTexCoords(JNIEnv * env,
+        jobject obj, jlong jmesh, jint first, jfloatArray tex_coords);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_buildClusters(JNIEnv * env,
+        jobject obj, jlong jmesh, jint max_triangles);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_clearClusters(JNIEnv * env,
+        jobject obj, jlong jmesh);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeMesh_getClusterCount(JNIEnv * env,
+        jobject obj, jlong jmesh);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeMesh_getVertexCount(JNIEnv * env,
+        jobject obj, jlong jmesh);
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeMesh_mapVertices(JNIEnv * env,
+        jobject obj, jlong jmesh, jint count);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_unmapVertices(JNIEnv * env,
+        jobject obj, jlong jmesh);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setVerticesBuffer(JNIEnv * env,
+        jobject obj, jlong jmesh, jobject vertices, jint count);
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeMesh_mapNormals(JNIEnv * env,
+        jobject obj, jlong jmesh, jint count);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_unmapNormals(JNIEnv * env,
+        jobject obj, jlong jmesh);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setNormalsBuffer(JNIEnv * env,
+        jobject obj, jlong jmesh, jobject normals, jint count);
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeMesh_mapTexCoords(JNIEnv * env,
+        jobject obj, jlong jmesh, jint count);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_unmapTexCoords(JNIEnv * env,
+        jobject obj, jlong jmesh);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setTexCoordsBuffer(JNIEnv * env,
+        jobject obj, jlong jmesh, jobject tex_coords, jint count);
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeMesh_mapTriangles(JNIEnv * env,
+        jobject obj, jlong jmesh, jint count);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_unmapTriangles(JNIEnv * env,
+        jobject obj, jlong jmesh);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setTrianglesBuffer(JNIEnv * env,
+        jobject obj, jlong jmesh, jobject triangles, jint count);
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeMesh_mapFloatVector(JNIEnv * env,
+        jobject obj, jlong jmesh, jstring key, jint count);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_unmapFloatVector(JNIEnv * env,
+        jobject obj, jlong jmesh, jstring key);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setFloatVectorBuffer(JNIEnv * env,
+        jobject obj, jlong jmesh, jstring key, jobject float_vector,
+        jint count);
 }
 ;
 
+/*
+ * The map functions hand Java a direct buffer over the native storage of an
+ * attribute, so large meshes are written in place instead of being built in
+ * a Java array and copied over.
+ */
+template<class T>
+static jobject newDirectBuffer(JNIEnv* env, std::vector<T>& vector) {
+    return env->NewDirectByteBuffer(vector.data(), vector.size() * sizeof(T));
+}
+
+// A buffer that came from a map call already is the storage, anything else
+// is copied once.
+template<class T>
+static void assignDirectBuffer(JNIEnv* env, jobject buffer, jint count,
+        std::vector<T>& vector) {
+    const T* data = static_cast<const T*>(env->GetDirectBufferAddress(buffer));
+    if (data == vector.data()) {
+        vector.resize(count);
+    } else {
+        vector.assign(data, data + count);
+    }
+}
+
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeMesh_ctor(JNIEnv* env, jobject obj) {
     return reinterpret_cast<jlong>(new Mesh());
@@ -110,17 +211,13 @@ JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeMesh_setVertices(JNIEnv * env,
         jobject obj, jlong jmesh, jfloatArray vertices) {
     Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
-    jfloat* jvertices_pointer = env->GetFloatArrayElements(vertices, 0);
-    glm::vec3* vertices_pointer =
-            reinterpret_cast<glm::vec3*>(jvertices_pointer);
     int vertices_length = static_cast<int>(env->GetArrayLength(vertices))
             / (sizeof(glm::vec3) / sizeof(jfloat));
-    std::vector<glm::vec3> native_vertices;
-    for (int i = 0; i < vertices_length; ++i) {
-        native_vertices.push_back(vertices_pointer[i]);
-    }
-    mesh->set_vertices(native_vertices);
-    env->ReleaseFloatArrayElements(vertices, jvertices_pointer, 0);
+    std::vector<glm::vec3> native_vertices(vertices_length);
+    env->GetFloatArrayRegion(vertices, 0,
+            vertices_length * (sizeof(glm::vec3) / sizeof(jfloat)),
+            reinterpret_cast<jfloat*>(native_vertices.data()));
+    mesh->set_vertices(std::move(native_vertices));
 }
 
 JNIEXPORT jfloatArray JNICALL
@@ -138,16 +235,13 @@ JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeMesh_setNormals(JNIEnv * env,
         jobject obj, jlong jmesh, jfloatArray normals) {
     Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
-    jfloat* jnormals_pointer = env->GetFloatArrayElements(normals, 0);
-    glm::vec3* normals_pointer = reinterpret_cast<glm::vec3*>(jnormals_pointer);
     int normals_length = static_cast<int>(env->GetArrayLength(normals))
             / (sizeof(glm::vec3) / sizeof(jfloat));
-    std::vector<glm::vec3> native_normals;
-    for (int i = 0; i < normals_length; ++i) {
-        native_normals.push_back(normals_pointer[i]);
-    }
-    mesh->set_normals(native_normals);
-    env->ReleaseFloatArrayElements(normals, jnormals_pointer, 0);
+    std::vector<glm::vec3> native_normals(normals_length);
+    env->GetFloatArrayRegion(normals, 0,
+            normals_length * (sizeof(glm::vec3) / sizeof(jfloat)),
+            reinterpret_cast<jfloat*>(native_normals.data()));
+    mesh->set_normals(std::move(native_normals));
 }
 
 JNIEXPORT jfloatArray JNICALL
@@ -165,17 +259,13 @@ JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeMesh_setTexCoords(JNIEnv * env,
         jobject obj, jlong jmesh, jfloatArray tex_coords) {
     Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
-    jfloat* jtex_coords_pointer = env->GetFloatArrayElements(tex_coords, 0);
-    glm::vec2* tex_coords_pointer =
-            reinterpret_cast<glm::vec2*>(jtex_coords_pointer);
     int tex_coords_length = static_cast<int>(env->GetArrayLength(tex_coords))
             / (sizeof(glm::vec2) / sizeof(jfloat));
-    std::vector<glm::vec2> native_tex_coords;
-    for (int i = 0; i < tex_coords_length; ++i) {
-        native_tex_coords.push_back(tex_coords_pointer[i]);
-    }
-    mesh->set_tex_coords(native_tex_coords);
-    env->ReleaseFloatArrayElements(tex_coords, jtex_coords_pointer, 0);
+    std::vector<glm::vec2> native_tex_coords(tex_coords_length);
+    env->GetFloatArrayRegion(tex_coords, 0,
+            tex_coords_length * (sizeof(glm::vec2) / sizeof(jfloat)),
+            reinterpret_cast<jfloat*>(native_tex_coords.data()));
+    mesh->set_tex_coords(std::move(native_tex_coords));
 }
 
 JNIEXPORT jcharArray JNICALL
@@ -192,16 +282,11 @@ JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeMesh_setTriangles(JNIEnv * env,
         jobject obj, jlong jmesh, jcharArray triangles) {
     Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
-    jchar* jtriangles_pointer = env->GetCharArrayElements(triangles, 0);
-    unsigned short* triangles_pointer =
-            static_cast<unsigned short*>(jtriangles_pointer);
     int triangles_length = env->GetArrayLength(triangles);
-    std::vector<unsigned short> native_triangles;
-    for (int i = 0; i < triangles_length; ++i) {
-        native_triangles.push_back(triangles_pointer[i]);
-    }
-    mesh->set_triangles(native_triangles);
-    env->ReleaseCharArrayElements(triangles, jtriangles_pointer, 0);
+    std::vector<unsigned short> native_triangles(triangles_length);
+    env->GetCharArrayRegion(triangles, 0, triangles_length,
+            native_triangles.data());
+    mesh->set_triangles(std::move(native_triangles));
 }
 
 JNIEXPORT jfloatArray JNICALL
@@ -222,20 +307,14 @@ JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeMesh_setFloatVector(JNIEnv * env,
         jobject obj, jlong jmesh, jstring key, jfloatArray float_vector) {
     Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
-    jfloat* jfloat_vector_pointer = env->GetFloatArrayElements(float_vector, 0);
-    float* float_vector_pointer =
-            reinterpret_cast<float*>(jfloat_vector_pointer);
-    int float_vector_length =
-            static_cast<int>(env->GetArrayLength(float_vector));
-    std::vector<float> native_float_vector;
-    for (int i = 0; i < float_vector_length; ++i) {
-        native_float_vector.push_back(float_vector_pointer[i]);
-    }
+    int float_vector_length = static_cast<int>(env->GetArrayLength(float_vector));
+    std::vector<float> native_float_vector(float_vector_length);
+    env->GetFloatArrayRegion(float_vector, 0, float_vector_length,
+            reinterpret_cast<jfloat*>(native_float_vector.data()));
     const char* char_key = env->GetStringUTFChars(key, 0);
     std::string native_key = std::string(char_key);
-    mesh->setFloatVector(native_key, native_float_vector);
+    mesh->setFloatVector(native_key, std::move(native_float_vector));
     env->ReleaseStringUTFChars(key, char_key);
-    env->ReleaseFloatArrayElements(float_vector, jfloat_vector_pointer, 0);
 }
 
 JNIEXPORT jfloatArray JNICALL
@@ -256,20 +335,15 @@ JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeMesh_setVec2Vector(JNIEnv * env,
         jobject obj, jlong jmesh, jstring key, jfloatArray vec2_vector) {
     Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
-    jfloat* jvec2_vector_pointer = env->GetFloatArrayElements(vec2_vector, 0);
-    glm::vec2* vec2_vector_pointer =
-            reinterpret_cast<glm::vec2*>(jvec2_vector_pointer);
     int vec2_vector_length = static_cast<int>(env->GetArrayLength(vec2_vector))
             / (sizeof(glm::vec2) / sizeof(jfloat));
-    std::vector<glm::vec2> native_vec2_vector;
-    for (int i = 0; i < vec2_vector_length; ++i) {
-        native_vec2_vector.push_back(vec2_vector_pointer[i]);
-    }
+    std::vector<glm::vec2> native_vec2_vector(vec2_vector_length);
+    env->GetFloatArrayRegion(vec2_vector, 0, vec2_vector_length * (sizeof(glm::vec2) / sizeof(jfloat)),
+            reinterpret_cast<jfloat*>(native_vec2_vector.data()));
     const char* char_key = env->GetStringUTFChars(key, 0);
     std::string native_key = std::string(char_key);
-    mesh->setVec2Vector(native_key, native_vec2_vector);
+    mesh->setVec2Vector(native_key, std::move(native_vec2_vector));
     env->ReleaseStringUTFChars(key, char_key);
-    env->ReleaseFloatArrayElements(vec2_vector, jvec2_vector_pointer, 0);
 }
 
 JNIEXPORT jfloatArray JNICALL
@@ -290,20 +364,15 @@ JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeMesh_setVec3Vector(JNIEnv * env,
         jobject obj, jlong jmesh, jstring key, jfloatArray vec3_vector) {
     Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
-    jfloat* jvec3_vector_pointer = env->GetFloatArrayElements(vec3_vector, 0);
-    glm::vec3* vec3_vector_pointer =
-            reinterpret_cast<glm::vec3*>(jvec3_vector_pointer);
     int vec3_vector_length = static_cast<int>(env->GetArrayLength(vec3_vector))
             / (sizeof(glm::vec3) / sizeof(jfloat));
-    std::vector<glm::vec3> native_vec3_vector;
-    for (int i = 0; i < vec3_vector_length; ++i) {
-        native_vec3_vector.push_back(vec3_vector_pointer[i]);
-    }
+    std::vector<glm::vec3> native_vec3_vector(vec3_vector_length);
+    env->GetFloatArrayRegion(vec3_vector, 0, vec3_vector_length * (sizeof(glm::vec3) / sizeof(jfloat)),
+            reinterpret_cast<jfloat*>(native_vec3_vector.data()));
     const char* char_key = env->GetStringUTFChars(key, 0);
     std::string native_key = std::string(char_key);
-    mesh->setVec3Vector(native_key, native_vec3_vector);
+    mesh->setVec3Vector(native_key, std::move(native_vec3_vector));
     env->ReleaseStringUTFChars(key, char_key);
-    env->ReleaseFloatArrayElements(vec3_vector, jvec3_vector_pointer, 0);
 }
 
 JNIEXPORT jfloatArray JNICALL
@@ -324,20 +393,15 @@ JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeMesh_setVec4Vector(JNIEnv * env,
         jobject obj, jlong jmesh, jstring key, jfloatArray vec4_vector) {
     Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
-    jfloat* jvec4_vector_pointer = env->GetFloatArrayElements(vec4_vector, 0);
-    glm::vec4* vec4_vector_pointer =
-            reinterpret_cast<glm::vec4*>(jvec4_vector_pointer);
     int vec4_vector_length = static_cast<int>(env->GetArrayLength(vec4_vector))
             / (sizeof(glm::vec4) / sizeof(jfloat));
-    std::vector<glm::vec4> native_vec4_vector;
-    for (int i = 0; i < vec4_vector_length; ++i) {
-        native_vec4_vector.push_back(vec4_vector_pointer[i]);
-    }
+    std::vector<glm::vec4> native_vec4_vector(vec4_vector_length);
+    env->GetFloatArrayRegion(vec4_vector, 0, vec4_vector_length * (sizeof(glm::vec4) / sizeof(jfloat)),
+            reinterpret_cast<jfloat*>(native_vec4_vector.data()));
     const char* char_key = env->GetStringUTFChars(key, 0);
     std::string native_key = std::string(char_key);
-    mesh->setVec4Vector(native_key, native_vec4_vector);
+    mesh->setVec4Vector(native_key, std::move(native_vec4_vector));
     env->ReleaseStringUTFChars(key, char_key);
-    env->ReleaseFloatArrayElements(vec4_vector, jvec4_vector_pointer, 0);
 }
 
 JNIEXPORT jlong JNICALL
@@ -347,4 +411,247 @@ Java_org_gearvrf_NativeMesh_getBoundingBox(JNIEnv * env,
     return reinterpret_cast<jlong>(mesh->getBoundingBox());
 }
 
+JNIEXPORT jfloatArray JNICALL
+Java_org_gearvrf_NativeMesh_getBoundingVolume(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    jfloat data[BoundingVolume::SERIALIZED_SIZE];
+    mesh->getBoundingVolume().serialize(data);
+    jfloatArray jdata = env->NewFloatArray(BoundingVolume::SERIALIZED_SIZE);
+    env->SetFloatArrayRegion(jdata, 0, BoundingVolume::SERIALIZED_SIZE, data);
+    return jdata;
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setBoundingVolume(JNIEnv * env,
+        jobject obj, jlong jmesh, jfloatArray bounding_volume) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    jfloat data[BoundingVolume::SERIALIZED_SIZE];
+    env->GetFloatArrayRegion(bounding_volume, 0,
+            BoundingVolume::SERIALIZED_SIZE, data);
+    BoundingVolume native_bounding_volume;
+    native_bounding_volume.deserialize(data);
+    mesh->setBoundingVolume(native_bounding_volume);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setUsageHint(JNIEnv * env,
+        jobject obj, jlong jmesh, jint usage_hint) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    mesh->set_usage_hint(static_cast<Mesh::UsageHint>(usage_hint));
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_updateVertices(JNIEnv * env,
+        jobject obj, jlong jmesh, jint first, jfloatArray vertices) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    jfloat* jvertices_pointer = env->GetFloatArrayElements(vertices, 0);
+    int vertices_length = static_cast<int>(env->GetArrayLength(vertices))
+            / (sizeof(glm::vec3) / sizeof(jfloat));
+    try {
+        mesh->updateVertices(first,
+                reinterpret_cast<glm::vec3*>(jvertices_pointer),
+                vertices_length);
+    } catch (std::string error) {
+        LOGE("%s", error.c_str());
+    }
+    env->ReleaseFloatArrayElements(vertices, jvertices_pointer, JNI_ABORT);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_updateNormals(JNIEnv * env,
+        jobject obj, jlong jmesh, jint first, jfloatArray normals) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    jfloat* jnormals_pointer = env->GetFloatArrayElements(normals, 0);
+    int normals_length = static_cast<int>(env->GetArrayLength(normals))
+            / (sizeof(glm::vec3) / sizeof(jfloat));
+    try {
+        mesh->updateNormals(first,
+                reinterpret_cast<glm::vec3*>(jnormals_pointer),
+                normals_length);
+    } catch (std::string error) {
+        LOGE("%s", error.c_str());
+    }
+    env->ReleaseFloatArrayElements(normals, jnormals_pointer, JNI_ABORT);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_updateTexCoords(JNIEnv * env,
+        jobject obj, jlong jmesh, jint first, jfloatArray tex_coords) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    jfloat* jtex_coords_pointer = env->GetFloatArrayElements(tex_coords, 0);
+    int tex_coords_length = static_cast<int>(env->GetArrayLength(tex_coords))
+            / (sizeof(glm::vec2) / sizeof(jfloat));
+    try {
+        mesh->updateTexCoords(first,
+                reinterpret_cast<glm::vec2*>(jtex_coords_pointer),
+                tex_coords_length);
+    } catch (std::string error) {
+        LOGE("%s", error.c_str());
+    }
+    env->ReleaseFloatArrayElements(tex_coords, jtex_coords_pointer, JNI_ABORT);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_buildClusters(JNIEnv * env,
+        jobject obj, jlong jmesh, jint max_triangles) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    try {
+        mesh->buildClusters(max_triangles);
+    } catch (std::string error) {
+        LOGE("%s", error.c_str());
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_clearClusters(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    mesh->clearClusters();
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeMesh_getClusterCount(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    return mesh->getClusters().size();
+}
+
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeMesh_getVertexCount(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    return mesh->vertices().size();
+}
+
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeMesh_mapVertices(JNIEnv * env,
+        jobject obj, jlong jmesh, jint count) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    mesh->resizeVertices(count);
+    return newDirectBuffer(env, mesh->vertices());
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_unmapVertices(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    mesh->verticesChanged();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setVerticesBuffer(JNIEnv * env,
+        jobject obj, jlong jmesh, jobject vertices, jint count) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    assignDirectBuffer(env, vertices, count, mesh->vertices());
+    mesh->verticesChanged();
+}
+
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeMesh_mapNormals(JNIEnv * env,
+        jobject obj, jlong jmesh, jint count) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    mesh->resizeNormals(count);
+    return newDirectBuffer(env, mesh->normals());
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_unmapNormals(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    mesh->normalsChanged();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setNormalsBuffer(JNIEnv * env,
+        jobject obj, jlong jmesh, jobject normals, jint count) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    assignDirectBuffer(env, normals, count, mesh->normals());
+    mesh->normalsChanged();
+}
+
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeMesh_mapTexCoords(JNIEnv * env,
+        jobject obj, jlong jmesh, jint count) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    mesh->resizeTexCoords(count);
+    return newDirectBuffer(env, mesh->tex_coords());
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_unmapTexCoords(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    mesh->texCoordsChanged();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setTexCoordsBuffer(JNIEnv * env,
+        jobject obj, jlong jmesh, jobject tex_coords, jint count) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    assignDirectBuffer(env, tex_coords, count, mesh->tex_coords());
+    mesh->texCoordsChanged();
+}
+
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeMesh_mapTriangles(JNIEnv * env,
+        jobject obj, jlong jmesh, jint count) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    mesh->resizeTriangles(count);
+    return newDirectBuffer(env, mesh->triangles());
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_unmapTriangles(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    mesh->trianglesChanged();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setTrianglesBuffer(JNIEnv * env,
+        jobject obj, jlong jmesh, jobject triangles, jint count) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    assignDirectBuffer(env, triangles, count, mesh->triangles());
+    mesh->trianglesChanged();
+}
+
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeMesh_mapFloatVector(JNIEnv * env,
+        jobject obj, jlong jmesh, jstring key, jint count) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    const char* char_key = env->GetStringUTFChars(key, 0);
+    int handle = NameRegistry::intern(char_key);
+    env->ReleaseStringUTFChars(key, char_key);
+    return newDirectBuffer(env, mesh->resizeFloatVector(handle, count));
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_unmapFloatVector(JNIEnv * env,
+        jobject obj, jlong jmesh, jstring key) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    const char* char_key = env->GetStringUTFChars(key, 0);
+    int handle = NameRegistry::intern(char_key);
+    env->ReleaseStringUTFChars(key, char_key);
+    try {
+        mesh->floatVectorChanged(handle);
+    } catch (std::string error) {
+        LOGE("%s", error.c_str());
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setFloatVectorBuffer(JNIEnv * env,
+        jobject obj, jlong jmesh, jstring key, jobject float_vector,
+        jint count) {
+    Mesh* mesh = reinterpret_cast<Mesh*>(jmesh);
+    const char* char_key = env->GetStringUTFChars(key, 0);
+    int handle = NameRegistry::intern(char_key);
+    env->ReleaseStringUTFChars(key, char_key);
+    assignDirectBuffer(env, float_vector, count,
+            mesh->resizeFloatVector(handle, count));
+    mesh->floatVectorChanged(handle);
+}
+
 }
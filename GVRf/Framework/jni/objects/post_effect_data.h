@@ -21,7 +21,6 @@
 #ifndef COLOR_BLEND_POST_EFFECT_H_
 #define COLOR_BLEND_POST_EFFECT_H_
 
-#include <map>
 #include <memory>
 #include <string>
 
@@ -29,6 +28,7 @@
 #include "glm/gtc/type_ptr.hpp"
 
 #include "objects/hybrid_object.h"
+#include "util/gvr_name_registry.h"
 
 namespace gvr {
 class Texture;
@@ -43,10 +43,10 @@ public:
             shader_type_(shader_type), textures_(), floats_(), vec2s_(), vec3s_(), vec4s_(), mat4s_() {
         switch (shader_type) {
         case COLOR_BLEND_SHADER:
-            floats_["r"] = 0.0f;
-            floats_["g"] = 0.0f;
-            floats_["b"] = 0.0f;
-            floats_["factor"] = 0.0f;
+            floats_[NAME_R] = 0.0f;
+            floats_[NAME_G] = 0.0f;
+            floats_[NAME_B] = 0.0f;
+            floats_[NAME_FACTOR] = 0.0f;
             break;
         }
     }
@@ -62,94 +62,142 @@ public:
         shader_type_ = shader_type;
     }
 
-    Texture* getTexture(std::string key) const {
-        auto it = textures_.find(key);
-        if (it != textures_.end()) {
-            return it->second;
+    Texture* getTexture(int handle) const {
+        Texture* const* value = textures_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "PostEffectData::getTexture() : " + key
-                    + " not found";
+            std::string error = "PostEffectData::getTexture() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    Texture* getTexture(std::string key) const {
+        return getTexture(NameRegistry::intern(key));
+    }
+
+    void setTexture(int handle, Texture* texture) {
+        textures_[handle] = texture;
+    }
+
     void setTexture(std::string key, Texture* texture) {
-        textures_[key] = texture;
+        setTexture(NameRegistry::intern(key), texture);
     }
 
-    float getFloat(std::string key) {
-        auto it = floats_.find(key);
-        if (it != floats_.end()) {
-            return it->second;
+    float getFloat(int handle) {
+        const float* value = floats_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "PostEffectData::getFloat() : " + key
-                    + " not found";
+            std::string error = "PostEffectData::getFloat() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    float getFloat(std::string key) {
+        return getFloat(NameRegistry::intern(key));
+    }
+
+    void setFloat(int handle, float value) {
+        floats_[handle] = value;
+    }
+
     void setFloat(std::string key, float value) {
-        floats_[key] = value;
+        setFloat(NameRegistry::intern(key), value);
     }
 
-    glm::vec2 getVec2(std::string key) {
-        auto it = vec2s_.find(key);
-        if (it != vec2s_.end()) {
-            return it->second;
+    glm::vec2 getVec2(int handle) {
+        const glm::vec2* value = vec2s_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "PostEffectData::getVec2() : " + key
-                    + " not found";
+            std::string error = "PostEffectData::getVec2() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    glm::vec2 getVec2(std::string key) {
+        return getVec2(NameRegistry::intern(key));
+    }
+
+    void setVec2(int handle, glm::vec2 vector) {
+        vec2s_[handle] = vector;
+    }
+
     void setVec2(std::string key, glm::vec2 vector) {
-        vec2s_[key] = vector;
+        setVec2(NameRegistry::intern(key), vector);
     }
 
-    glm::vec3 getVec3(std::string key) {
-        auto it = vec3s_.find(key);
-        if (it != vec3s_.end()) {
-            return it->second;
+    glm::vec3 getVec3(int handle) {
+        const glm::vec3* value = vec3s_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "PostEffectData::getVec3() : " + key
-                    + " not found";
+            std::string error = "PostEffectData::getVec3() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    glm::vec3 getVec3(std::string key) {
+        return getVec3(NameRegistry::intern(key));
+    }
+
+    void setVec3(int handle, glm::vec3 vector) {
+        vec3s_[handle] = vector;
+    }
+
     void setVec3(std::string key, glm::vec3 vector) {
-        vec3s_[key] = vector;
+        setVec3(NameRegistry::intern(key), vector);
     }
 
-    glm::vec4 getVec4(std::string key) {
-        auto it = vec4s_.find(key);
-        if (it != vec4s_.end()) {
-            return it->second;
+    glm::vec4 getVec4(int handle) {
+        const glm::vec4* value = vec4s_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "PostEffectData::getVec4() : " + key
-                    + " not found";
+            std::string error = "PostEffectData::getVec4() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    glm::vec4 getVec4(std::string key) {
+        return getVec4(NameRegistry::intern(key));
+    }
+
+    void setVec4(int handle, glm::vec4 vector) {
+        vec4s_[handle] = vector;
+    }
+
     void setVec4(std::string key, glm::vec4 vector) {
-        vec4s_[key] = vector;
+        setVec4(NameRegistry::intern(key), vector);
     }
 
-    glm::mat4 getMat4(std::string key) {
-        auto it = mat4s_.find(key);
-        if (it != mat4s_.end()) {
-            return it->second;
+    glm::mat4 getMat4(int handle) {
+        const glm::mat4* value = mat4s_.find(handle);
+        if (value != 0) {
+            return *value;
         } else {
-            std::string error = "PostEffectData::getMat4() : " + key
-                    + " not found";
+            std::string error = "PostEffectData::getMat4() : "
+                    + NameRegistry::name(handle) + " not found";
             throw error;
         }
     }
 
+    glm::mat4 getMat4(std::string key) {
+        return getMat4(NameRegistry::intern(key));
+    }
+
+    void setMat4(int handle, glm::mat4 mat) {
+        mat4s_[handle] = mat;
+    }
+
     void setMat4(std::string key, glm::mat4 mat) {
-        mat4s_[key] = mat;
+        setMat4(NameRegistry::intern(key), mat);
     }
 
 private:
@@ -160,12 +208,12 @@ private:
 
 private:
     ShaderType shader_type_;
-    std::map<std::string, Texture*> textures_;
-    std::map<std::string, float> floats_;
-    std::map<std::string, glm::vec2> vec2s_;
-    std::map<std::string, glm::vec3> vec3s_;
-    std::map<std::string, glm::vec4> vec4s_;
-    std::map<std::string, glm::mat4> mat4s_;
+    HandleMap<Texture*> textures_;
+    HandleMap<float> floats_;
+    HandleMap<glm::vec2> vec2s_;
+    HandleMap<glm::vec3> vec3s_;
+    HandleMap<glm::vec4> vec4s_;
+    HandleMap<glm::mat4> mat4s_;
 };
 
 }
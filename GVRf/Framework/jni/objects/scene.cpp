@@ -24,7 +24,9 @@
 namespace gvr {
 Scene::Scene() :
         HybridObject(), scene_objects_(), main_camera_rig_(), frustum_flag_(
-                false), dirtyFlag_(0), occlusion_flag_(false) {
+                false), dirtyFlag_(0), occlusion_flag_(false), lod_bias_(
+                1.0f), lod_error_pixels_(1.0f), lod_hysteresis_(0.1f), small_feature_pixels_(
+                0.0f) {
 }
 
 Scene::~Scene() {
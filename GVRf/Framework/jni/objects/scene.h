@@ -27,6 +27,7 @@
 
 #include "objects/hybrid_object.h"
 #include "components/camera_rig.h"
+#include "engine/memory/gl_name_pool.h"
 #include "engine/renderer/renderer.h"
 
 namespace gvr {
@@ -58,12 +59,30 @@ public:
     void set_occlusion_culling( bool occlusion_flag){ occlusion_flag_ = occlusion_flag; }
     bool get_occlusion_culling(){ return occlusion_flag_; }
 
+    // > 1 picks coarser levels of detail, < 1 finer ones
+    void set_lod_bias(float lod_bias) { lod_bias_ = lod_bias; }
+    float get_lod_bias() { return lod_bias_; }
+
+    // screen-space error, in pixels, a level of detail may show
+    void set_lod_error_pixels(float pixels) { lod_error_pixels_ = pixels; }
+    float get_lod_error_pixels() { return lod_error_pixels_; }
+
+    // fraction a switch distance must be passed by before the level changes
+    void set_lod_hysteresis(float hysteresis) { lod_hysteresis_ = hysteresis; }
+    float get_lod_hysteresis() { return lod_hysteresis_; }
+
+    // objects whose bounds project smaller than this many pixels are skipped;
+    // 0 disables small feature culling
+    void set_small_feature_pixels(float pixels) { small_feature_pixels_ = pixels; }
+    float get_small_feature_pixels() { return small_feature_pixels_; }
+
     void resetStats() {
         if (!statsInitialized) {
             Renderer::initializeStats();
             statsInitialized = true;
         }
         Renderer::resetStats();
+        gl_name_pool.resetStats();
     }
     int getNumberDrawCalls() {
         return Renderer::getNumberDrawCalls();
@@ -71,6 +90,23 @@ public:
     int getNumberTriangles() {
         return Renderer::getNumberTriangles();
     }
+    // GL names taken from GlNamePool, and made anew, since resetStats()
+    int getNamePoolHits() {
+        GlNamePool::Stats stats = gl_name_pool.stats();
+        int hits = 0;
+        for (int kind = 0; kind < GlNamePool::KIND_COUNT; ++kind) {
+            hits += stats.hits[kind];
+        }
+        return hits;
+    }
+    int getNamePoolMisses() {
+        GlNamePool::Stats stats = gl_name_pool.stats();
+        int misses = 0;
+        for (int kind = 0; kind < GlNamePool::KIND_COUNT; ++kind) {
+            misses += stats.misses[kind];
+        }
+        return misses;
+    }
 
 private:
     Scene(const Scene& scene);
@@ -85,6 +121,10 @@ private:
     int dirtyFlag_;
     bool frustum_flag_;
     bool occlusion_flag_;
+    float lod_bias_;
+    float lod_error_pixels_;
+    float lod_hysteresis_;
+    float small_feature_pixels_;
     bool statsInitialized = false;
 
 };
@@ -44,6 +44,19 @@ JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeScene_setOcclusionQuery(JNIEnv * env,
         jobject obj, jlong jscene, jboolean flag);
 
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeScene_setLodBias(JNIEnv * env,
+        jobject obj, jlong jscene, jfloat lod_bias);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeScene_setLodErrorPixels(JNIEnv * env,
+        jobject obj, jlong jscene, jfloat pixels);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeScene_setLodHysteresis(JNIEnv * env,
+        jobject obj, jlong jscene, jfloat hysteresis);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeScene_setSmallFeatureCulling(JNIEnv * env,
+        jobject obj, jlong jscene, jfloat pixels);
+
 JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeScene_resetStats(JNIEnv * env,
         jobject obj, jlong jscene);
@@ -55,6 +68,14 @@ Java_org_gearvrf_NativeScene_getNumberDrawCalls(JNIEnv * env,
 JNIEXPORT int JNICALL
 Java_org_gearvrf_NativeScene_getNumberTriangles(JNIEnv * env,
         jobject obj, jlong jscene);
+
+JNIEXPORT int JNICALL
+Java_org_gearvrf_NativeScene_getNamePoolHits(JNIEnv * env,
+        jobject obj, jlong jscene);
+
+JNIEXPORT int JNICALL
+Java_org_gearvrf_NativeScene_getNamePoolMisses(JNIEnv * env,
+        jobject obj, jlong jscene);
 }
 ;
 
@@ -101,6 +122,34 @@ Java_org_gearvrf_NativeScene_setOcclusionQuery(JNIEnv * env,
     scene->set_occlusion_culling(static_cast<bool>(flag));
 }
 
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeScene_setLodBias(JNIEnv * env,
+        jobject obj, jlong jscene, jfloat lod_bias) {
+    Scene* scene = reinterpret_cast<Scene*>(jscene);
+    scene->set_lod_bias(lod_bias);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeScene_setLodErrorPixels(JNIEnv * env,
+        jobject obj, jlong jscene, jfloat pixels) {
+    Scene* scene = reinterpret_cast<Scene*>(jscene);
+    scene->set_lod_error_pixels(pixels);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeScene_setLodHysteresis(JNIEnv * env,
+        jobject obj, jlong jscene, jfloat hysteresis) {
+    Scene* scene = reinterpret_cast<Scene*>(jscene);
+    scene->set_lod_hysteresis(hysteresis);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeScene_setSmallFeatureCulling(JNIEnv * env,
+        jobject obj, jlong jscene, jfloat pixels) {
+    Scene* scene = reinterpret_cast<Scene*>(jscene);
+    scene->set_small_feature_pixels(pixels);
+}
+
 JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeScene_resetStats(JNIEnv * env,
         jobject obj, jlong jscene) {
@@ -125,4 +174,20 @@ Java_org_gearvrf_NativeScene_getNumberTriangles(JNIEnv * env,
 }
 
 
+JNIEXPORT int JNICALL
+Java_org_gearvrf_NativeScene_getNamePoolHits(JNIEnv * env,
+        jobject obj, jlong jscene) {
+    Scene* scene = reinterpret_cast<Scene*>(jscene);
+    return scene->getNamePoolHits();
+}
+
+
+JNIEXPORT int JNICALL
+Java_org_gearvrf_NativeScene_getNamePoolMisses(JNIEnv * env,
+        jobject obj, jlong jscene) {
+    Scene* scene = reinterpret_cast<Scene*>(jscene);
+    return scene->getNamePoolMisses();
+}
+
+
 }
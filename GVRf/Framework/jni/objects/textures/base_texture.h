@@ -21,61 +21,90 @@
 #ifndef BASE_TEXTURE_H_
 #define BASE_TEXTURE_H_
 
+#include <stdlib.h>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <android/bitmap.h>
 
+#include "gl/gl_texture_storage.h"
+#include "objects/textures/png_decode_pool.h"
 #include "objects/textures/texture.h"
 #include "util/gvr_log.h"
 
 namespace gvr {
 class BaseTexture: public Texture {
 public:
+    // the bitmap is read on the upload thread; see TextureUploader
     explicit BaseTexture(JNIEnv* env, jobject bitmap) :
             Texture(new GLTexture(TARGET)) {
-        AndroidBitmapInfo info;
-        void *pixels;
-        int ret;
-        if(bitmap == NULL){
-        	std::string error = "new BaseTexture() failed! Input bitmap is NULL.";
-        	throw error;
-        }
-        if ((ret = AndroidBitmap_getInfo(env, bitmap, &info)) < 0) {
-            std::string error = "AndroidBitmap_getInfo () failed! error = "
-                    + ret;
-            throw error;
-        }
-        if ((ret = AndroidBitmap_lockPixels(env, bitmap, &pixels)) < 0) {
-            std::string error = "AndroidBitmap_lockPixels () failed! error = "
-                    + ret;
-            throw error;
-        }
+        std::vector<TextureUploader::Image> images;
+        images.push_back(TextureUploader::Image(bitmap));
+        texture_uploader.upload(env, this, gl_texture_->id(), TARGET, images,
+                true);
+    }
 
-        glBindTexture(GL_TEXTURE_2D, gl_texture_->id());
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, info.width, info.height, 0,
-                GL_RGBA, GL_UNSIGNED_BYTE, pixels);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        AndroidBitmap_unlockPixels(env, bitmap);
+    // takes over pixels, which must come from malloc()
+    explicit BaseTexture(JNIEnv* env, int width, int height,
+            unsigned char* pixels) :
+            Texture(new GLTexture(TARGET)) {
+        std::vector<TextureUploader::Image> images;
+        images.push_back(TextureUploader::Image(pixels, width, height));
+        texture_uploader.upload(env, this, gl_texture_->id(), TARGET, images,
+                true);
     }
 
-    explicit BaseTexture(int width, int height, const unsigned char* pixels) :
+    /*
+     * Decodes asset, a PNG, on PngDecodePool and uploads it from there; the
+     * texture is pending until then. Takes over the asset.
+     */
+    explicit BaseTexture(AAsset* asset) :
             Texture(new GLTexture(TARGET)) {
-        glBindTexture(GL_TEXTURE_2D, gl_texture_->id());
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA,
-                GL_UNSIGNED_BYTE, pixels);
-        glGenerateMipmap(GL_TEXTURE_2D);
+        unsigned int ticket = texture_uploader.expect(this, gl_texture_->id(),
+                TARGET, true);
+        png_decode_pool.decode(asset, PngDecodePool::Options(),
+                PngDecodePool::mallocAllocator,
+                [ticket](bool decoded, int width, int height,
+                        unsigned char* pixels, size_t stride) {
+                    std::vector<TextureUploader::Image> images;
+                    if (decoded) {
+                        images.push_back(TextureUploader::Image(pixels, width,
+                                height));
+                    } else {
+                        free(pixels);
+                    }
+                    texture_uploader.supply(ticket, images);
+                });
     }
 
     explicit BaseTexture() : Texture(new GLTexture(TARGET)) {
 
     }
 
-    bool update(int width, int height, void* data) {
-        glBindTexture(GL_TEXTURE_2D, gl_texture_->id());
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, width, height, 0,
-                GL_LUMINANCE, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        return (glGetError() == 0) ? 1 : 0;
+    /*
+     * Replace the texture with width x height luminance bytes. The first
+     * update sizes the texture for good; see GLTextureStorage.
+     */
+    bool update(int width, int height, void* data, bool mipmap) {
+        if (!storage_) {
+#if _GVRF_USE_GLES3_
+            // GL_LUMINANCE cannot be immutable; read red as luminance
+            storage_.reset(new GLTextureStorage(GL_R8, GL_RED,
+                    GL_UNSIGNED_BYTE, 1));
+            glBindTexture(GL_TEXTURE_2D, gl_texture_->id());
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_ONE);
+#else
+            storage_.reset(new GLTextureStorage(GL_LUMINANCE, GL_LUMINANCE,
+                    GL_UNSIGNED_BYTE, 1));
+#endif
+        }
+        bool updated = storage_->update(gl_texture_->id(), width, height,
+                data, mipmap);
+        set_gpu_size(storage_->size());
+        return updated;
     }
 
     GLenum getTarget() const {
@@ -90,6 +119,7 @@ private:
 
 private:
     static const GLenum TARGET = GL_TEXTURE_2D;
+    std::unique_ptr<GLTextureStorage> storage_;
 };
 
 }
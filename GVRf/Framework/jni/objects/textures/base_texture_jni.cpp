@@ -31,10 +31,14 @@ JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeBaseTexture_fileConstructor(JNIEnv * env,
         jobject obj, jobject asset_manager, jstring filename);
 JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeBaseTexture_bitmapConstructor(JNIEnv * env,
+        jobject obj, jobject bitmap);
+JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeBaseTexture_bareConstructor(JNIEnv * env, jobject obj);
 JNIEXPORT jboolean JNICALL
 Java_org_gearvrf_NativeBaseTexture_update(JNIEnv * env, jobject obj,
-        jlong jtexture, jint width, jint height, jbyteArray jdata);
+        jlong jtexture, jint width, jint height, jbyteArray jdata,
+        jboolean mipmap);
 }
 ;
 
@@ -44,32 +48,26 @@ Java_org_gearvrf_NativeBaseTexture_fileConstructor(JNIEnv * env,
 
     const char* native_string = env->GetStringUTFChars(filename, 0);
     AAssetManager* mgr = AAssetManager_fromJava(env, asset_manager);
-    AAsset* asset = AAssetManager_open(mgr, native_string, AASSET_MODE_UNKNOWN);
+    AAsset* asset = AAssetManager_open(mgr, native_string, AASSET_MODE_STREAMING);
+    env->ReleaseStringUTFChars(filename, native_string);
     if (NULL == asset) {
         LOGE("_ASSET_NOT_FOUND_");
         return JNI_FALSE;
     }
 
-    PngLoader loader;
-    loader.loadFromAsset(asset);
-
-    AAsset_close(asset);
-    env->ReleaseStringUTFChars(filename, native_string);
-
-    if (loader.pOutImage.bits == NULL) {
-        LOGE("PNG decoder failed");
-        return JNI_FALSE;
-    }
+    // decoded and uploaded in the background
+    return reinterpret_cast<jlong>(new BaseTexture(asset));
+}
 
-    if (loader.pOutImage.format != PngLoader::RGBAFormat) {
-        LOGE("Only RGBA format supported");
-        return JNI_FALSE;
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeBaseTexture_bitmapConstructor(JNIEnv * env,
+        jobject obj, jobject bitmap) {
+    try {
+        return reinterpret_cast<jlong>(new BaseTexture(env, bitmap));
+    } catch (const std::string &err) {
+        printJavaCallStack(env, err);
+        throw err;
     }
-
-    int imgW = loader.pOutImage.width;
-    int imgH = loader.pOutImage.height;
-    unsigned char *pixels = loader.pOutImage.bits;
-    return reinterpret_cast<jlong>(new BaseTexture(imgW, imgH, pixels));
 }
 
 JNIEXPORT jlong JNICALL
@@ -79,11 +77,13 @@ Java_org_gearvrf_NativeBaseTexture_bareConstructor(JNIEnv * env, jobject obj) {
 
 JNIEXPORT jboolean JNICALL
 Java_org_gearvrf_NativeBaseTexture_update(JNIEnv * env, jobject obj,
-        jlong jtexture, jint width, jint height, jbyteArray jdata) {
+        jlong jtexture, jint width, jint height, jbyteArray jdata,
+        jboolean mipmap) {
     BaseTexture* texture = reinterpret_cast<BaseTexture*>(jtexture);
     jbyte* data = env->GetByteArrayElements(jdata, 0);
-    jboolean result = texture->update(width, height, data);
-    env->ReleaseByteArrayElements(jdata, data, 0);
+    jboolean result = texture->update(width, height, data, mipmap);
+    // only read, so nothing to copy back
+    env->ReleaseByteArrayElements(jdata, data, JNI_ABORT);
     return result;
 }
 
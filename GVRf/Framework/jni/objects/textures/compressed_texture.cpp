@@ -0,0 +1,96 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Texture from a (Java-loaded) byte stream containing a compressed texture
+ ***************************************************************************/
+
+#include "compressed_texture.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "objects/textures/etc_decoder.h"
+#include "util/gvr_gl.h"
+
+namespace gvr {
+
+CompressedTexture::CompressedTexture(const KtxFile& ktx_file) :
+        Texture(new GLTexture(ktx_file.target())), target(ktx_file.target()) {
+    GLenum internal_format = ktx_file.internal_format();
+    bool decode = !isFormatSupported(internal_format);
+    if (decode) {
+        if (!EtcDecoder::canDecode(internal_format)) {
+            std::string error = "CompressedTexture: format "
+                    + std::to_string(internal_format)
+                    + " is not supported by this GPU";
+            throw error;
+        }
+        LOGW("CompressedTexture: format 0x%x is not supported by this GPU, "
+                "decoding %dx%d on the CPU", internal_format,
+                ktx_file.width(), ktx_file.height());
+    }
+
+    glBindTexture(target, gl_texture_->id());
+    std::vector<unsigned char> rgba;
+    size_t bytes = 0;
+    for (auto it = ktx_file.images().begin(); it != ktx_file.images().end();
+            ++it) {
+        GLenum image_target =
+                target == GL_TEXTURE_CUBE_MAP ?
+                        GL_TEXTURE_CUBE_MAP_POSITIVE_X + it->face : target;
+        if (!decode) {
+            glCompressedTexImage2D(image_target, it->level, internal_format,
+                    it->width, it->height, 0, it->size, it->data);
+            bytes += it->size;
+            continue;
+        }
+        rgba.resize(it->width * it->height * 4);
+        if (!EtcDecoder::decode(internal_format, it->data, it->size,
+                it->width, it->height, rgba.data())) {
+            std::string error = "CompressedTexture: level "
+                    + std::to_string(it->level) + " is truncated";
+            throw error;
+        }
+        glTexImage2D(image_target, it->level, GL_RGBA, it->width, it->height,
+                0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+        bytes += rgba.size();
+    }
+    set_gpu_size(bytes);
+#if _GVRF_USE_GLES3_
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, ktx_file.levels() - 1);
+#endif
+    glBindTexture(target, 0);
+}
+
+bool CompressedTexture::isFormatSupported(GLenum internal_format) {
+    // queried once; the list does not change with the context
+    static std::vector<GLint> formats;
+    if (formats.empty()) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+        formats.resize(count + 1);
+        if (count > 0) {
+            glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+        }
+        formats[count] = 0; // queried, even if the list was empty
+    }
+    return internal_format != 0
+            && std::find(formats.begin(), formats.end(), GLint(internal_format))
+                    != formats.end();
+}
+
+}
@@ -21,6 +21,7 @@
 #define compressed_texture_H_
 
 //#include <GLES3/gl3.h>
+#include "objects/textures/ktx_file.h"
 #include "objects/textures/texture.h"
 #include "util/gvr_log.h"
 
@@ -42,12 +43,23 @@ public:
         glBindTexture(target, gl_texture_->id());
         glCompressedTexImage2D(target, 0, internalFormat, width, height, 0,
                 imageSize, data);
+        set_gpu_size(imageSize);
     }
 
+    /*
+     * Every level and cubemap face of a KTX file, uploaded straight from its
+     * mapped pages. Formats the GPU does not list are decoded to RGBA when
+     * EtcDecoder can; anything else throws.
+     */
+    explicit CompressedTexture(const KtxFile& ktx_file);
+
     GLenum getTarget() const {
         return target;
     }
 
+    // whether GL_COMPRESSED_TEXTURE_FORMATS lists internal_format
+    static bool isFormatSupported(GLenum internal_format);
+
 private:
     CompressedTexture(const CompressedTexture& compressed_texture);
     CompressedTexture(CompressedTexture&& compressed_texture);
@@ -29,8 +29,12 @@ Java_org_gearvrf_asynchronous_NativeCompressedTexture_normalConstructor(JNIEnv *
         jint width, jint height, jint imageSize, jbyteArray bytes);
 
 JNIEXPORT jlong JNICALL
-Java_org_gearvrf_asynchronous_1textures_NativeCompressedTexture_mipmappedConstructor(JNIEnv * env,
+Java_org_gearvrf_asynchronous_NativeCompressedTexture_mipmappedConstructor(JNIEnv * env,
         jobject obj, jint target);
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_asynchronous_NativeCompressedTexture_ktxConstructor(JNIEnv * env,
+        jobject obj, jlong jktx_file);
 }
 ;
 
@@ -50,9 +54,22 @@ Java_org_gearvrf_asynchronous_NativeCompressedTexture_normalConstructor(JNIEnv *
 }
 
 JNIEXPORT jlong JNICALL
-Java_org_gearvrf_asynchronous_1textures_NativeCompressedTexture_mipmappedConstructor(JNIEnv * env,
+Java_org_gearvrf_asynchronous_NativeCompressedTexture_mipmappedConstructor(JNIEnv * env,
     jobject obj, jint target) {
     return reinterpret_cast<jlong>(new CompressedTexture(target));
 }
 
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_asynchronous_NativeCompressedTexture_ktxConstructor(JNIEnv * env,
+    jobject obj, jlong jktx_file) {
+    KtxFile* ktx_file = reinterpret_cast<KtxFile*>(jktx_file);
+    try {
+        return reinterpret_cast<jlong>(new CompressedTexture(*ktx_file));
+    } catch (const std::string &err) {
+        // the caller reports the failure and keeps running
+        LOGE("%s", err.c_str());
+        return 0;
+    }
+}
+
 }
@@ -21,6 +21,7 @@
 #define CUBEMAP_TEXTURE_H_
 
 #include <string>
+#include <vector>
 
 #include <android/bitmap.h>
 
@@ -30,38 +31,16 @@
 namespace gvr {
 class CubemapTexture: public Texture {
 public:
+	// the faces are read on the upload thread; see TextureUploader
 	explicit CubemapTexture(JNIEnv* env, jobjectArray bitmapArray) :
 			Texture(new GLTexture(TARGET)) {
-		glBindTexture(TARGET, gl_texture_->id());
+		std::vector<TextureUploader::Image> images;
 		for (int i = 0; i < 6; i++) {
-			jobject bitmap = env->GetObjectArrayElement(bitmapArray, i);
-
-			AndroidBitmapInfo info;
-			void *pixels;
-			int ret;
-
-			if (bitmap == NULL) {
-				std::string error =
-						"new BaseTexture() failed! Input bitmap is NULL.";
-				throw error;
-			}
-			if ((ret = AndroidBitmap_getInfo(env, bitmap, &info)) < 0) {
-				std::string error = "AndroidBitmap_getInfo () failed! error = "
-						+ ret;
-				throw error;
-			}
-			if ((ret = AndroidBitmap_lockPixels(env, bitmap, &pixels)) < 0) {
-				std::string error =
-						"AndroidBitmap_lockPixels () failed! error = " + ret;
-				throw error;
-			}
-
-			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA,
-					info.width, info.height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
-					pixels);
-
-			AndroidBitmap_unlockPixels(env, bitmap);
+			images.push_back(TextureUploader::Image(
+					env->GetObjectArrayElement(bitmapArray, i)));
 		}
+		texture_uploader.upload(env, this, gl_texture_->id(), TARGET, images,
+				false);
 	}
 
 	explicit CubemapTexture() :
@@ -0,0 +1,242 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Decodes ETC1, ETC2 and EAC blocks to RGBA, for GPUs without them.
+ ***************************************************************************/
+
+#include "etc_decoder.h"
+
+#include <string.h>
+#include <stdint.h>
+
+#ifndef GL_ETC1_RGB8_OES
+#define GL_ETC1_RGB8_OES 0x8D64
+#endif
+
+namespace gvr {
+
+// pixels are numbered down the columns: i = x * 4 + y
+
+static const int ETC_MODIFIERS[8][4] = { { 2, 8, -2, -8 },
+        { 5, 17, -5, -17 }, { 9, 29, -9, -29 }, { 13, 42, -13, -42 }, { 18,
+                60, -18, -60 }, { 24, 80, -24, -80 }, { 33, 106, -33, -106 }, {
+                47, 183, -47, -183 } };
+
+static const int ETC_DISTANCES[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+static const int EAC_MODIFIERS[16][8] = { { -3, -6, -9, -15, 2, 5, 8, 14 }, {
+        -3, -7, -10, -13, 2, 6, 9, 12 }, { -2, -5, -8, -13, 1, 4, 7, 12 }, {
+        -2, -4, -6, -13, 1, 3, 5, 12 }, { -3, -6, -8, -12, 2, 5, 7, 11 }, {
+        -3, -7, -9, -11, 2, 6, 8, 10 }, { -4, -7, -8, -11, 3, 6, 7, 10 }, {
+        -3, -5, -8, -11, 2, 4, 7, 10 }, { -2, -6, -8, -10, 1, 5, 7, 9 }, { -2,
+        -5, -8, -10, 1, 4, 7, 9 }, { -2, -4, -8, -10, 1, 3, 7, 9 }, { -2, -5,
+        -7, -10, 1, 4, 6, 9 }, { -3, -4, -7, -10, 2, 3, 6, 9 }, { -1, -2, -3,
+        -10, 0, 1, 2, 9 }, { -4, -6, -8, -9, 3, 5, 7, 8 }, { -3, -5, -7, -9,
+        2, 4, 6, 8 } };
+
+static inline int clamp255(int value) {
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+static inline int extend4(int value) {
+    return value * 17;
+}
+
+static inline int extend5(int value) {
+    return (value << 3) | (value >> 2);
+}
+
+static inline int extend6(int value) {
+    return (value << 2) | (value >> 4);
+}
+
+static inline int extend7(int value) {
+    return (value << 1) | (value >> 6);
+}
+
+static inline uint32_t readBE32(const unsigned char* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16)
+            | (uint32_t(p[2]) << 8) | p[3];
+}
+
+// the 2-bit index of pixel i: MSB in bits 31..16, LSB in bits 15..0
+static inline int pixelIndex(uint32_t lo, int i) {
+    return (((lo >> (16 + i)) & 1) << 1) | ((lo >> i) & 1);
+}
+
+static inline void setColor(unsigned char* out, int r, int g, int b) {
+    out[0] = clamp255(r);
+    out[1] = clamp255(g);
+    out[2] = clamp255(b);
+    out[3] = 255;
+}
+
+bool EtcDecoder::canDecode(GLenum internal_format) {
+    switch (internal_format) {
+    case GL_ETC1_RGB8_OES:
+    case GL_COMPRESSED_RGB8_ETC2:
+    case GL_COMPRESSED_SRGB8_ETC2:
+    case GL_COMPRESSED_RGBA8_ETC2_EAC:
+    case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void EtcDecoder::decodeColorBlock(const unsigned char* block,
+        unsigned char rgba[16][4]) {
+    uint32_t hi = readBE32(block);
+    uint32_t lo = readBE32(block + 4);
+
+    if ((hi & 2) == 0) {
+        // individual: two 444 base colors
+        int base[2][3] = { { extend4(block[0] >> 4), extend4(block[1] >> 4),
+                extend4(block[2] >> 4) }, { extend4(block[0] & 0xF), extend4(
+                block[1] & 0xF), extend4(block[2] & 0xF) } };
+        bool flip = hi & 1;
+        const int* table[2] = { ETC_MODIFIERS[(hi >> 5) & 7],
+                ETC_MODIFIERS[(hi >> 2) & 7] };
+        for (int i = 0; i < 16; ++i) {
+            int x = i / 4, y = i % 4;
+            int sub = flip ? (y >= 2) : (x >= 2);
+            int m = table[sub][pixelIndex(lo, i)];
+            setColor(rgba[i], base[sub][0] + m, base[sub][1] + m,
+                    base[sub][2] + m);
+        }
+        return;
+    }
+
+    // differential: a 555 color and a signed 333 delta
+    int r = block[0] >> 3, g = block[1] >> 3, b = block[2] >> 3;
+    int dr = (block[0] & 7) - ((block[0] & 4) << 1);
+    int dg = (block[1] & 7) - ((block[1] & 4) << 1);
+    int db = (block[2] & 7) - ((block[2] & 4) << 1);
+
+    if (r + dr < 0 || r + dr > 31) {
+        // ETC2 T mode
+        int c0[3] = { extend4((((hi >> 27) & 3) << 2) | ((hi >> 24) & 3)),
+                extend4((hi >> 20) & 0xF), extend4((hi >> 16) & 0xF) };
+        int c1[3] = { extend4((hi >> 12) & 0xF), extend4((hi >> 8) & 0xF),
+                extend4((hi >> 4) & 0xF) };
+        int d = ETC_DISTANCES[(((hi >> 2) & 3) << 1) | (hi & 1)];
+        int paint[4][3] = { { c0[0], c0[1], c0[2] }, { c1[0] + d, c1[1] + d,
+                c1[2] + d }, { c1[0], c1[1], c1[2] }, { c1[0] - d, c1[1] - d,
+                c1[2] - d } };
+        for (int i = 0; i < 16; ++i) {
+            const int* p = paint[pixelIndex(lo, i)];
+            setColor(rgba[i], p[0], p[1], p[2]);
+        }
+    } else if (g + dg < 0 || g + dg > 31) {
+        // ETC2 H mode
+        int r0 = (hi >> 27) & 0xF;
+        int g0 = (((hi >> 24) & 7) << 1) | ((hi >> 20) & 1);
+        int b0 = (((hi >> 19) & 1) << 3) | ((hi >> 15) & 7);
+        int r1 = (hi >> 11) & 0xF, g1 = (hi >> 7) & 0xF, b1 = (hi >> 3) & 0xF;
+        int order = ((r0 << 8) | (g0 << 4) | b0) >= ((r1 << 8) | (g1 << 4) | b1);
+        int d = ETC_DISTANCES[(hi & 4) | ((hi & 1) << 1) | order];
+        int c0[3] = { extend4(r0), extend4(g0), extend4(b0) };
+        int c1[3] = { extend4(r1), extend4(g1), extend4(b1) };
+        int paint[4][3] = { { c0[0] + d, c0[1] + d, c0[2] + d }, { c0[0] - d,
+                c0[1] - d, c0[2] - d }, { c1[0] + d, c1[1] + d, c1[2] + d }, {
+                c1[0] - d, c1[1] - d, c1[2] - d } };
+        for (int i = 0; i < 16; ++i) {
+            const int* p = paint[pixelIndex(lo, i)];
+            setColor(rgba[i], p[0], p[1], p[2]);
+        }
+    } else if (b + db < 0 || b + db > 31) {
+        // ETC2 planar mode: origin, horizontal and vertical colors
+        int ro = extend6((hi >> 25) & 0x3F);
+        int go = extend7((((hi >> 24) & 1) << 6) | ((hi >> 17) & 0x3F));
+        int bo = extend6((((hi >> 16) & 1) << 5) | (((hi >> 11) & 3) << 3)
+                | ((hi >> 7) & 7));
+        int rh = extend6((((hi >> 2) & 0x1F) << 1) | (hi & 1));
+        int gh = extend7((lo >> 25) & 0x7F);
+        int bh = extend6((lo >> 19) & 0x3F);
+        int rv = extend6((lo >> 13) & 0x3F);
+        int gv = extend7((lo >> 6) & 0x7F);
+        int bv = extend6(lo & 0x3F);
+        for (int i = 0; i < 16; ++i) {
+            int x = i / 4, y = i % 4;
+            setColor(rgba[i],
+                    (x * (rh - ro) + y * (rv - ro) + 4 * ro + 2) >> 2,
+                    (x * (gh - go) + y * (gv - go) + 4 * go + 2) >> 2,
+                    (x * (bh - bo) + y * (bv - bo) + 4 * bo + 2) >> 2);
+        }
+    } else {
+        int base[2][3] = { { extend5(r), extend5(g), extend5(b) }, { extend5(
+                r + dr), extend5(g + dg), extend5(b + db) } };
+        bool flip = hi & 1;
+        const int* table[2] = { ETC_MODIFIERS[(hi >> 5) & 7],
+                ETC_MODIFIERS[(hi >> 2) & 7] };
+        for (int i = 0; i < 16; ++i) {
+            int x = i / 4, y = i % 4;
+            int sub = flip ? (y >= 2) : (x >= 2);
+            int m = table[sub][pixelIndex(lo, i)];
+            setColor(rgba[i], base[sub][0] + m, base[sub][1] + m,
+                    base[sub][2] + m);
+        }
+    }
+}
+
+void EtcDecoder::decodeAlphaBlock(const unsigned char* block,
+        unsigned char rgba[16][4]) {
+    int base = block[0];
+    int multiplier = block[1] >> 4;
+    const int* table = EAC_MODIFIERS[block[1] & 0xF];
+    uint64_t indices = 0;
+    for (int i = 2; i < 8; ++i) {
+        indices = (indices << 8) | block[i];
+    }
+    for (int i = 0; i < 16; ++i) {
+        int index = (indices >> (45 - 3 * i)) & 7;
+        rgba[i][3] = clamp255(base + table[index] * multiplier);
+    }
+}
+
+bool EtcDecoder::decode(GLenum internal_format, const unsigned char* data,
+        size_t size, int width, int height, unsigned char* rgba) {
+    bool alpha = internal_format == GL_COMPRESSED_RGBA8_ETC2_EAC
+            || internal_format == GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC;
+    size_t block_size = alpha ? 16 : 8;
+    int blocks_x = (width + 3) / 4;
+    int blocks_y = (height + 3) / 4;
+    if (size < block_size * blocks_x * blocks_y) {
+        return false;
+    }
+
+    unsigned char pixels[16][4];
+    for (int by = 0; by < blocks_y; ++by) {
+        for (int bx = 0; bx < blocks_x; ++bx) {
+            const unsigned char* block = data
+                    + (by * blocks_x + bx) * block_size;
+            // EAC alpha comes first, then the color
+            decodeColorBlock(alpha ? block + 8 : block, pixels);
+            if (alpha) {
+                decodeAlphaBlock(block, pixels);
+            }
+            for (int i = 0; i < 16; ++i) {
+                int x = bx * 4 + i / 4, y = by * 4 + i % 4;
+                if (x < width && y < height) {
+                    memcpy(rgba + (y * width + x) * 4, pixels[i], 4);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+}
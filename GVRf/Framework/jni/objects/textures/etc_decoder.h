@@ -13,49 +13,37 @@
  * limitations under the License.
  */
 
-
 /***************************************************************************
- * Renders a texture without light.
+ * Decodes ETC1, ETC2 and EAC blocks to RGBA, for GPUs without them.
  ***************************************************************************/
 
-#ifndef UNLIT_SHADER_H_
-#define UNLIT_SHADER_H_
+#ifndef ETC_DECODER_H_
+#define ETC_DECODER_H_
 
-#include <memory>
+#include <stddef.h>
 
 #include "GLES3/gl3.h"
-#include "glm/glm.hpp"
-#include "glm/gtc/type_ptr.hpp"
-
-#include "objects/recyclable_object.h"
 
 namespace gvr {
-class GLProgram;
-class RenderData;
 
-class UnlitShader: public RecyclableObject {
+class EtcDecoder {
 public:
-    UnlitShader();
-    ~UnlitShader();
-    void recycle();
-    void render(const glm::mat4& mvp_matrix, RenderData* render_data);
+    // whether decode() handles internal_format
+    static bool canDecode(GLenum internal_format);
 
-private:
-    UnlitShader(const UnlitShader& unlit_shader);
-    UnlitShader(UnlitShader&& unlit_shader);
-    UnlitShader& operator=(const UnlitShader& unlit_shader);
-    UnlitShader& operator=(UnlitShader&& unlit_shader);
+    /*
+     * Decode a width x height image of internal_format blocks into
+     * width * height RGBA pixels; false if the data is too short.
+     */
+    static bool decode(GLenum internal_format, const unsigned char* data,
+            size_t size, int width, int height, unsigned char* rgba);
 
 private:
-    GLProgram* program_;
-    GLuint a_position_;
-    GLuint a_tex_coord_;
-    GLuint u_mvp_;
-    GLuint u_texture_;
-    GLuint u_color_;
-    GLuint u_opacity_;
+    static void decodeColorBlock(const unsigned char* block,
+            unsigned char rgba[16][4]);
+    static void decodeAlphaBlock(const unsigned char* block,
+            unsigned char rgba[16][4]);
 };
 
 }
-
 #endif
@@ -0,0 +1,92 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Textures generated from float point arrays
+ ***************************************************************************/
+
+#include "float_texture.h"
+
+#include <string.h>
+
+namespace gvr {
+
+FloatTexture::FloatTexture(bool half_float) :
+        Texture(new GLTexture(TARGET)), half_float_(half_float), storage_(
+                half_float ? GL_RG16F : GL_RG32F, GL_RG,
+                half_float ? GL_HALF_FLOAT : GL_FLOAT,
+                half_float ? 2 * sizeof(uint16_t) : 2 * sizeof(float)), half_data_() {
+}
+
+bool FloatTexture::update(int width, int height, const float* data) {
+    bool updated;
+    if (!half_float_) {
+        updated = storage_.update(gl_texture_->id(), width, height, data,
+                false);
+    } else {
+        size_t count = 2 * width * height;
+        half_data_.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            half_data_[i] = toHalf(data[i]);
+        }
+        updated = storage_.update(gl_texture_->id(), width, height,
+                &half_data_[0], false);
+    }
+    set_gpu_size(storage_.size());
+    return updated;
+}
+
+uint16_t FloatTexture::toHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t exponent = (bits >> 23) & 0xff;
+    uint32_t mantissa = bits & 0x7fffff;
+
+    if (exponent == 0xff) {
+        // infinity stays infinity, NaN stays a quiet NaN
+        return sign | 0x7c00 | (mantissa != 0 ? 0x200 : 0);
+    }
+
+    int half_exponent = int(exponent) - 127 + 15;
+    if (half_exponent >= 0x1f) {
+        return sign | 0x7c00;
+    }
+    if (half_exponent <= 0) {
+        // denormal, or zero if even rounding cannot reach the smallest one
+        if (half_exponent < -10) {
+            return sign;
+        }
+        mantissa |= 0x800000;
+        int shift = 14 - half_exponent;
+        uint32_t half_mantissa = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half_mantissa & 1))) {
+            ++half_mantissa;
+        }
+        return sign | half_mantissa;
+    }
+
+    uint32_t half = (uint32_t(half_exponent) << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1fff;
+    // a carry out of the mantissa correctly bumps the exponent
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+        ++half;
+    }
+    return sign | half;
+}
+
+}
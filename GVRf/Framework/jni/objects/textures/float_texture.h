@@ -20,27 +20,36 @@
 #ifndef FLOAT_TEXTURE_H_
 #define FLOAT_TEXTURE_H_
 
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+#include "gl/gl_texture_storage.h"
 #include "objects/textures/texture.h"
 #include "util/gvr_log.h"
 
 namespace gvr {
 class FloatTexture: public Texture {
 public:
-    explicit FloatTexture() :
-            Texture(new GLTexture(TARGET)) {
-    }
+    /*
+     * Two channels per texel; half_float stores them as GL_RG16F, at half
+     * the memory and precision of GL_RG32F.
+     */
+    explicit FloatTexture(bool half_float = false);
 
-    bool update(int width, int height, float* data) {
-        glBindTexture(GL_TEXTURE_2D, gl_texture_->id());
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32F, width, height, 0,
-                GL_RG, GL_FLOAT, data);
-        return (glGetError() == 0) ? 1 : 0;
-    }
+    /*
+     * Replace the texture with width x height float pairs. The first update
+     * sizes the texture for good; see GLTextureStorage.
+     */
+    bool update(int width, int height, const float* data);
 
     GLenum getTarget() const {
         return TARGET;
     }
 
+    // IEEE 754 binary16, rounded to nearest even
+    static uint16_t toHalf(float value);
+
 private:
     FloatTexture(const FloatTexture& float_texture);
     FloatTexture(FloatTexture&& float_texture);
@@ -49,6 +58,10 @@ private:
 
 private:
     static const GLenum TARGET = GL_TEXTURE_2D;
+    bool half_float_;
+    GLTextureStorage storage_;
+    // conversion space kept between updates
+    std::vector<uint16_t> half_data_;
 };
 
 }
@@ -24,7 +24,7 @@ namespace gvr {
 extern "C" {
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeFloatTexture_ctor(JNIEnv * env,
-        jobject obj);
+        jobject obj, jboolean half_float);
 JNIEXPORT jboolean JNICALL
 Java_org_gearvrf_NativeFloatTexture_update(JNIEnv * env,
         jobject obj, jlong jtexture, jint width, jint height, jfloatArray jdata);
@@ -33,8 +33,8 @@ Java_org_gearvrf_NativeFloatTexture_update(JNIEnv * env,
 
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeFloatTexture_ctor(JNIEnv * env,
-    jobject obj) {
-return reinterpret_cast<jlong>(new FloatTexture());
+    jobject obj, jboolean half_float) {
+return reinterpret_cast<jlong>(new FloatTexture(half_float));
 }
 
 JNIEXPORT jboolean JNICALL
@@ -43,7 +43,8 @@ Java_org_gearvrf_NativeFloatTexture_update(JNIEnv * env,
     FloatTexture* texture = reinterpret_cast<FloatTexture*>(jtexture);
     jfloat* data = env->GetFloatArrayElements(jdata, 0);
     jboolean result = texture->update(width, height, data);
-    env->ReleaseFloatArrayElements(jdata, data, 0);
+    // only read, so nothing to copy back
+    env->ReleaseFloatArrayElements(jdata, data, JNI_ABORT);
     return result;
 }
 
@@ -0,0 +1,395 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * A KTX 1 or KTX 2 texture container, mapped rather than read.
+ ***************************************************************************/
+
+#include "ktx_file.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "util/gvr_log.h"
+
+#ifndef GL_ETC1_RGB8_OES
+#define GL_ETC1_RGB8_OES 0x8D64
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+#ifndef GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR 0x93D0
+#endif
+
+namespace gvr {
+
+static const unsigned char KTX1_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ',
+        '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+static const unsigned char KTX2_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ',
+        '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+static const size_t KTX1_HEADER_SIZE = 64;
+static const size_t KTX2_HEADER_SIZE = 80;
+static const size_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 24;
+static const uint32_t KTX1_ENDIANNESS = 0x04030201;
+
+// the 14 ASTC footprints, in GL (and Vulkan) enum order
+static const int ASTC_FOOTPRINTS[14][2] = { { 4, 4 }, { 5, 4 }, { 5, 5 }, {
+        6, 5 }, { 6, 6 }, { 8, 5 }, { 8, 6 }, { 8, 8 }, { 10, 5 }, { 10, 6 }, {
+        10, 8 }, { 10, 10 }, { 12, 10 }, { 12, 12 } };
+
+// VkFormat values of the ETC2, EAC and ASTC LDR formats
+static const uint32_t VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK = 147;
+static const uint32_t VK_FORMAT_EAC_R11G11_SNORM_BLOCK = 156;
+static const uint32_t VK_FORMAT_ASTC_4x4_UNORM_BLOCK = 157;
+static const uint32_t VK_FORMAT_ASTC_12x12_SRGB_BLOCK = 184;
+
+static uint32_t read32(const unsigned char* p, bool swap) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return swap ? __builtin_bswap32(value) : value;
+}
+
+static uint64_t read64(const unsigned char* p) {
+    uint64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static size_t align4(size_t offset) {
+    return (offset + 3) & ~size_t(3);
+}
+
+// 0 when the format's block layout is unknown here
+static size_t compressedSize(GLenum format, int width, int height) {
+    int block_width = 4, block_height = 4;
+    size_t block_size;
+    if (format == GL_ETC1_RGB8_OES) {
+        block_size = 8;
+    } else if (format >= GL_COMPRESSED_R11_EAC
+            && format <= GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC) {
+        switch (format) {
+        case GL_COMPRESSED_RG11_EAC:
+        case GL_COMPRESSED_SIGNED_RG11_EAC:
+        case GL_COMPRESSED_RGBA8_ETC2_EAC:
+        case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+            block_size = 16;
+            break;
+        default:
+            block_size = 8;
+            break;
+        }
+    } else if ((format >= GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+            && format < GL_COMPRESSED_RGBA_ASTC_4x4_KHR + 14)
+            || (format >= GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR
+                    && format < GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR + 14)) {
+        const int* footprint = ASTC_FOOTPRINTS[(format
+                - GL_COMPRESSED_RGBA_ASTC_4x4_KHR) & 0xF];
+        block_width = footprint[0];
+        block_height = footprint[1];
+        block_size = 16;
+    } else {
+        return 0;
+    }
+    return block_size * ((width + block_width - 1) / block_width)
+            * ((height + block_height - 1) / block_height);
+}
+
+static GLenum formatFromVulkan(uint32_t vk_format) {
+    if (vk_format >= VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+            && vk_format <= VK_FORMAT_EAC_R11G11_SNORM_BLOCK) {
+        // VkFormat orders these RGB8, RGB8A1, RGBA8, R11, RG11 with UNORM
+        // before SRGB (or SNORM); GL orders them R11, RG11, RGB8, RGB8A1,
+        // RGBA8
+        static const GLenum ETC_FORMATS[10] = { GL_COMPRESSED_RGB8_ETC2,
+                GL_COMPRESSED_SRGB8_ETC2,
+                GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2,
+                GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2,
+                GL_COMPRESSED_RGBA8_ETC2_EAC,
+                GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC, GL_COMPRESSED_R11_EAC,
+                GL_COMPRESSED_SIGNED_R11_EAC, GL_COMPRESSED_RG11_EAC,
+                GL_COMPRESSED_SIGNED_RG11_EAC };
+        return ETC_FORMATS[vk_format - VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK];
+    }
+    if (vk_format >= VK_FORMAT_ASTC_4x4_UNORM_BLOCK
+            && vk_format <= VK_FORMAT_ASTC_12x12_SRGB_BLOCK) {
+        uint32_t index = vk_format - VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+        return ((index & 1) ?
+                GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR :
+                GL_COMPRESSED_RGBA_ASTC_4x4_KHR) + index / 2;
+    }
+    return 0;
+}
+
+KtxFile::KtxFile() :
+        mapping_(MAP_FAILED), mapping_size_(0), asset_(0), data_(0), size_(
+                0), internal_format_(0), width_(0), height_(0), levels_(0), faces_(
+                0), images_() {
+}
+
+KtxFile::~KtxFile() {
+    close();
+}
+
+void KtxFile::close() {
+    if (mapping_ != MAP_FAILED) {
+        munmap(mapping_, mapping_size_);
+        mapping_ = MAP_FAILED;
+    }
+#ifdef __ANDROID__
+    if (asset_ != 0) {
+        AAsset_close(asset_);
+        asset_ = 0;
+    }
+#endif
+    data_ = 0;
+    size_ = 0;
+    images_.clear();
+}
+
+bool KtxFile::open(const char* path) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        LOGE("KtxFile: cannot open %s", path);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        LOGE("KtxFile: cannot stat %s", path);
+        ::close(fd);
+        return false;
+    }
+    mapping_size_ = st.st_size;
+    mapping_ = mmap(0, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+        LOGE("KtxFile: cannot map %s", path);
+        return false;
+    }
+    // start reading the pages in now, not when the GL thread touches them
+    madvise(mapping_, mapping_size_, MADV_WILLNEED);
+    data_ = static_cast<const unsigned char*>(mapping_);
+    size_ = mapping_size_;
+    return parse(path);
+}
+
+#ifdef __ANDROID__
+bool KtxFile::open(AAssetManager* manager, const char* path) {
+    close();
+    asset_ = AAssetManager_open(manager, path, AASSET_MODE_BUFFER);
+    if (asset_ == 0) {
+        LOGE("KtxFile: cannot open asset %s", path);
+        return false;
+    }
+    data_ = static_cast<const unsigned char*>(AAsset_getBuffer(asset_));
+    size_ = AAsset_getLength(asset_);
+    if (data_ == 0) {
+        LOGE("KtxFile: cannot map asset %s", path);
+        close();
+        return false;
+    }
+    return parse(path);
+}
+#endif
+
+bool KtxFile::parse(const char* path) {
+    bool parsed;
+    if (size_ >= sizeof(KTX1_IDENTIFIER)
+            && memcmp(data_, KTX1_IDENTIFIER, sizeof(KTX1_IDENTIFIER)) == 0) {
+        parsed = parseKtx1(path);
+    } else if (size_ >= sizeof(KTX2_IDENTIFIER)
+            && memcmp(data_, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) == 0) {
+        parsed = parseKtx2(path);
+    } else {
+        // not an error: the caller tries its other loaders
+        parsed = false;
+    }
+    if (!parsed) {
+        close();
+    }
+    return parsed;
+}
+
+bool KtxFile::checkHeader(const char* path) {
+    if (width_ <= 0 || height_ <= 0) {
+        LOGE("KtxFile: %s is not a 2D texture", path);
+        return false;
+    }
+    if (faces_ != 1 && faces_ != 6) {
+        LOGE("KtxFile: %s has %d faces", path, faces_);
+        return false;
+    }
+    int max_levels = 1;
+    while ((width_ >> max_levels) > 0 || (height_ >> max_levels) > 0) {
+        ++max_levels;
+    }
+    if (levels_ > max_levels) {
+        LOGE("KtxFile: %s has %d levels; %dx%d has at most %d", path, levels_,
+                width_, height_, max_levels);
+        return false;
+    }
+    return true;
+}
+
+bool KtxFile::addImage(const char* path, int level, int face, size_t offset,
+        size_t size) {
+    Image image;
+    image.level = level;
+    image.face = face;
+    image.width = width_ >> level > 0 ? width_ >> level : 1;
+    image.height = height_ >> level > 0 ? height_ >> level : 1;
+    size_t expected = compressedSize(internal_format_, image.width,
+            image.height);
+    if (size == 0 || (expected != 0 && size < expected)) {
+        LOGE("KtxFile: %s level %d face %d has %zu bytes", path, level, face,
+                size);
+        return false;
+    }
+    if (offset > size_ || size > size_ - offset) {
+        LOGE("KtxFile: %s is truncated at level %d face %d", path, level,
+                face);
+        return false;
+    }
+    image.data = data_ + offset;
+    image.size = expected != 0 ? expected : size;
+    images_.push_back(image);
+    return true;
+}
+
+bool KtxFile::parseKtx1(const char* path) {
+    if (size_ < KTX1_HEADER_SIZE) {
+        LOGE("KtxFile: %s is truncated", path);
+        return false;
+    }
+    const unsigned char* header = data_ + sizeof(KTX1_IDENTIFIER);
+    uint32_t endianness = read32(header, false);
+    bool swap = endianness != KTX1_ENDIANNESS;
+    if (swap && endianness != __builtin_bswap32(KTX1_ENDIANNESS)) {
+        LOGE("KtxFile: %s has a bad endianness field", path);
+        return false;
+    }
+    uint32_t gl_type = read32(header + 4, swap);
+    internal_format_ = read32(header + 16, swap);
+    width_ = read32(header + 24, swap);
+    height_ = read32(header + 28, swap);
+    uint32_t depth = read32(header + 32, swap);
+    uint32_t array_elements = read32(header + 36, swap);
+    faces_ = read32(header + 40, swap);
+    levels_ = read32(header + 44, swap);
+    uint32_t key_value_bytes = read32(header + 48, swap);
+
+    if (gl_type != 0) {
+        LOGE("KtxFile: %s is not compressed", path);
+        return false;
+    }
+    if (depth > 1 || array_elements != 0) {
+        LOGE("KtxFile: %s is a 3D or array texture", path);
+        return false;
+    }
+    // 0 asks for generated mipmaps, which compressed formats cannot have
+    if (levels_ == 0) {
+        levels_ = 1;
+    }
+    if (!checkHeader(path)) {
+        return false;
+    }
+
+    size_t offset = KTX1_HEADER_SIZE + key_value_bytes;
+    for (int level = 0; level < levels_; ++level) {
+        if (offset > size_ || size_ - offset < 4) {
+            LOGE("KtxFile: %s is truncated at level %d", path, level);
+            return false;
+        }
+        // for a cubemap, the size of each face
+        size_t image_size = read32(data_ + offset, swap);
+        offset += 4;
+        for (int face = 0; face < faces_; ++face) {
+            if (!addImage(path, level, face, offset, image_size)) {
+                return false;
+            }
+            offset = align4(offset + image_size);
+        }
+    }
+    return true;
+}
+
+bool KtxFile::parseKtx2(const char* path) {
+    if (size_ < KTX2_HEADER_SIZE) {
+        LOGE("KtxFile: %s is truncated", path);
+        return false;
+    }
+    const unsigned char* header = data_ + sizeof(KTX2_IDENTIFIER);
+    uint32_t vk_format = read32(header, false);
+    width_ = read32(header + 8, false);
+    height_ = read32(header + 12, false);
+    uint32_t depth = read32(header + 16, false);
+    uint32_t layers = read32(header + 20, false);
+    faces_ = read32(header + 24, false);
+    levels_ = read32(header + 28, false);
+    uint32_t supercompression = read32(header + 32, false);
+
+    internal_format_ = formatFromVulkan(vk_format);
+    if (internal_format_ == 0) {
+        LOGE("KtxFile: %s has unsupported VkFormat %u", path, vk_format);
+        return false;
+    }
+    if (supercompression != 0) {
+        LOGE("KtxFile: %s is supercompressed", path);
+        return false;
+    }
+    if (depth != 0 || layers != 0) {
+        LOGE("KtxFile: %s is a 3D or array texture", path);
+        return false;
+    }
+    if (levels_ == 0) {
+        levels_ = 1;
+    }
+    if (!checkHeader(path)) {
+        return false;
+    }
+    if ((size_ - KTX2_HEADER_SIZE) / KTX2_LEVEL_INDEX_ENTRY_SIZE
+            < size_t(levels_)) {
+        LOGE("KtxFile: %s has a truncated level index", path);
+        return false;
+    }
+
+    // the index lists level 0 first, though the data stores it last
+    for (int level = 0; level < levels_; ++level) {
+        const unsigned char* entry = data_ + KTX2_HEADER_SIZE
+                + level * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+        uint64_t offset = read64(entry);
+        uint64_t length = read64(entry + 8);
+        if (offset > size_ || length > size_ - offset) {
+            LOGE("KtxFile: %s is truncated at level %d", path, level);
+            return false;
+        }
+        size_t face_size = length / faces_;
+        for (int face = 0; face < faces_; ++face) {
+            if (!addImage(path, level, face, offset + face * face_size,
+                    face_size)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,122 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * A KTX 1 or KTX 2 texture container, mapped rather than read.
+ ***************************************************************************/
+
+#ifndef KTX_FILE_H_
+#define KTX_FILE_H_
+
+#include <stddef.h>
+#include <vector>
+
+#ifdef __ANDROID__
+#include "android/asset_manager.h"
+#else
+// host tools (Tools/texcook) only open files
+struct AAsset;
+struct AAssetManager;
+#endif
+#include "GLES3/gl3.h"
+
+namespace gvr {
+
+/*
+ * open() maps the file (or the asset's buffer, which is mapped too when the
+ * asset is stored uncompressed in the APK) and checks the header and every
+ * image's bounds, so it can run on a loader thread. images() then point
+ * straight into the mapping, for glCompressedTexImage2D().
+ *
+ * Only block-compressed, non-array 2D textures and cubemaps are accepted;
+ * KTX 2 files must not be supercompressed.
+ */
+class KtxFile {
+public:
+    struct Image {
+        int level;
+        int face;
+        int width;
+        int height;
+        const unsigned char* data;
+        size_t size;
+    };
+
+    KtxFile();
+    ~KtxFile();
+
+    bool open(const char* path);
+    bool open(AAssetManager* manager, const char* path);
+
+    GLenum internal_format() const {
+        return internal_format_;
+    }
+
+    // GL_TEXTURE_2D or GL_TEXTURE_CUBE_MAP
+    GLenum target() const {
+        return faces_ == 6 ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
+    }
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    int levels() const {
+        return levels_;
+    }
+
+    int faces() const {
+        return faces_;
+    }
+
+    // level-major, faces in GL_TEXTURE_CUBE_MAP_POSITIVE_X order
+    const std::vector<Image>& images() const {
+        return images_;
+    }
+
+private:
+    KtxFile(const KtxFile& ktx_file);
+    KtxFile(KtxFile&& ktx_file);
+    KtxFile& operator=(const KtxFile& ktx_file);
+    KtxFile& operator=(KtxFile&& ktx_file);
+
+    bool parse(const char* path);
+    bool parseKtx1(const char* path);
+    bool parseKtx2(const char* path);
+    bool checkHeader(const char* path);
+    bool addImage(const char* path, int level, int face, size_t offset,
+            size_t size);
+    void close();
+
+private:
+    void* mapping_;
+    size_t mapping_size_;
+    AAsset* asset_;
+    const unsigned char* data_;
+    size_t size_;
+    GLenum internal_format_;
+    int width_;
+    int height_;
+    int levels_;
+    int faces_;
+    std::vector<Image> images_;
+};
+
+}
+#endif
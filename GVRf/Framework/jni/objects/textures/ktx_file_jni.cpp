@@ -0,0 +1,94 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "ktx_file.h"
+
+#include "android/asset_manager_jni.h"
+#include "util/gvr_jni.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_asynchronous_NativeKtxFile_openFile(JNIEnv * env,
+        jobject obj, jstring path);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_asynchronous_NativeKtxFile_openAsset(JNIEnv * env,
+        jobject obj, jobject asset_manager, jstring path);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_asynchronous_NativeKtxFile_getTarget(JNIEnv * env,
+        jobject obj, jlong jktx_file);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_asynchronous_NativeKtxFile_getLevels(JNIEnv * env,
+        jobject obj, jlong jktx_file);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_asynchronous_NativeKtxFile_close(JNIEnv * env,
+        jobject obj, jlong jktx_file);
+}
+;
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_asynchronous_NativeKtxFile_openFile(JNIEnv * env,
+        jobject obj, jstring path) {
+    const char* native_path = env->GetStringUTFChars(path, 0);
+    KtxFile* ktx_file = new KtxFile();
+    bool opened = ktx_file->open(native_path);
+    env->ReleaseStringUTFChars(path, native_path);
+    if (!opened) {
+        delete ktx_file;
+        return 0;
+    }
+    return reinterpret_cast<jlong>(ktx_file);
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_asynchronous_NativeKtxFile_openAsset(JNIEnv * env,
+        jobject obj, jobject asset_manager, jstring path) {
+    const char* native_path = env->GetStringUTFChars(path, 0);
+    AAssetManager* mgr = AAssetManager_fromJava(env, asset_manager);
+    KtxFile* ktx_file = new KtxFile();
+    bool opened = ktx_file->open(mgr, native_path);
+    env->ReleaseStringUTFChars(path, native_path);
+    if (!opened) {
+        delete ktx_file;
+        return 0;
+    }
+    return reinterpret_cast<jlong>(ktx_file);
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_asynchronous_NativeKtxFile_getTarget(JNIEnv * env,
+        jobject obj, jlong jktx_file) {
+    KtxFile* ktx_file = reinterpret_cast<KtxFile*>(jktx_file);
+    return ktx_file->target();
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_asynchronous_NativeKtxFile_getLevels(JNIEnv * env,
+        jobject obj, jlong jktx_file) {
+    KtxFile* ktx_file = reinterpret_cast<KtxFile*>(jktx_file);
+    return ktx_file->levels();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_asynchronous_NativeKtxFile_close(JNIEnv * env,
+        jobject obj, jlong jktx_file) {
+    delete reinterpret_cast<KtxFile*>(jktx_file);
+}
+
+}
@@ -0,0 +1,172 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Decodes PNG images on a pool of worker threads.
+ ***************************************************************************/
+
+#include "png_decode_pool.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+
+#include "png_loader.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+
+PngDecodePool png_decode_pool;
+
+PngDecodePool::PngDecodePool(int threads) :
+        thread_count_(threads), threads_(), queue_(), busy_(0), quit_(false) {
+    pthread_mutex_init(&mutex_, 0);
+    pthread_cond_init(&work_cond_, 0);
+    pthread_cond_init(&idle_cond_, 0);
+    if (thread_count_ <= 0) {
+        thread_count_ = std::max(1L, sysconf(_SC_NPROCESSORS_ONLN) - 1);
+    }
+}
+
+PngDecodePool::~PngDecodePool() {
+    pthread_mutex_lock(&mutex_);
+    quit_ = true;
+    pthread_cond_broadcast(&work_cond_);
+    pthread_mutex_unlock(&mutex_);
+    for (auto it = threads_.begin(); it != threads_.end(); ++it) {
+        pthread_join(*it, 0);
+    }
+    pthread_cond_destroy(&idle_cond_);
+    pthread_cond_destroy(&work_cond_);
+    pthread_mutex_destroy(&mutex_);
+}
+
+void PngDecodePool::decode(AAsset* asset, const Options& options,
+        const Allocator& allocator, const Callback& callback) {
+    Job* job = new Job();
+    job->asset = asset;
+    job->options = options;
+    job->allocator = allocator;
+    job->callback = callback;
+    submit(job);
+}
+
+void PngDecodePool::decode(std::vector<unsigned char>& png,
+        const Options& options, const Allocator& allocator,
+        const Callback& callback) {
+    Job* job = new Job();
+    job->asset = 0;
+    job->png.swap(png);
+    job->options = options;
+    job->allocator = allocator;
+    job->callback = callback;
+    submit(job);
+}
+
+void PngDecodePool::wait() {
+    pthread_mutex_lock(&mutex_);
+    while (!queue_.empty() || busy_ > 0) {
+        pthread_cond_wait(&idle_cond_, &mutex_);
+    }
+    pthread_mutex_unlock(&mutex_);
+}
+
+unsigned char* PngDecodePool::mallocAllocator(int width, int height,
+        size_t& stride) {
+    stride = width * 4;
+    return static_cast<unsigned char*>(malloc(stride * height));
+}
+
+void PngDecodePool::submit(Job* job) {
+    pthread_mutex_lock(&mutex_);
+    // started with the first image, so a pool never used costs nothing
+    while (static_cast<int>(threads_.size()) < thread_count_) {
+        pthread_t thread;
+        if (pthread_create(&thread, 0, threadMain, this) != 0) {
+            LOGE("PngDecodePool: pthread_create() failed");
+            break;
+        }
+        threads_.push_back(thread);
+    }
+    if (threads_.empty()) {
+        pthread_mutex_unlock(&mutex_);
+        run(job);
+        return;
+    }
+    queue_.push_back(job);
+    pthread_cond_signal(&work_cond_);
+    pthread_mutex_unlock(&mutex_);
+}
+
+void* PngDecodePool::threadMain(void* pool) {
+    static_cast<PngDecodePool*>(pool)->run();
+    return 0;
+}
+
+void PngDecodePool::run() {
+    pthread_mutex_lock(&mutex_);
+    while (true) {
+        while (!quit_ && queue_.empty()) {
+            pthread_cond_wait(&work_cond_, &mutex_);
+        }
+        if (queue_.empty()) {
+            break;
+        }
+        Job* job = queue_.front();
+        queue_.pop_front();
+        ++busy_;
+        pthread_mutex_unlock(&mutex_);
+
+        run(job);
+
+        pthread_mutex_lock(&mutex_);
+        --busy_;
+        if (queue_.empty() && busy_ == 0) {
+            pthread_cond_broadcast(&idle_cond_);
+        }
+    }
+    pthread_mutex_unlock(&mutex_);
+}
+
+void PngDecodePool::run(Job* job) {
+    PngLoader loader;
+    loader.setPremultiplyAlpha(job->options.premultiply_alpha);
+    loader.setGamma(job->options.screen_gamma);
+
+    bool begun =
+            job->asset != 0 ?
+                    loader.begin(job->asset) :
+                    loader.begin(job->png.data(), job->png.size());
+    int width = loader.pOutImage.width;
+    int height = loader.pOutImage.height;
+    unsigned char* pixels = 0;
+    size_t stride = 0;
+    bool decoded = false;
+    if (begun) {
+        pixels = job->allocator(width, height, stride);
+        decoded = pixels != 0 && loader.decode(pixels, stride);
+    } else {
+        LOGE("PNG decoder failed");
+    }
+    loader.end();
+    if (job->asset != 0) {
+        AAsset_close(job->asset);
+    }
+
+    job->callback(decoded, width, height, pixels, stride);
+    delete job;
+}
+
+}
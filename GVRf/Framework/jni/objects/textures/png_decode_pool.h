@@ -0,0 +1,108 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Decodes PNG images on a pool of worker threads.
+ ***************************************************************************/
+
+#ifndef PNG_DECODE_POOL_H_
+#define PNG_DECODE_POOL_H_
+
+#include <deque>
+#include <functional>
+#include <vector>
+#include <pthread.h>
+
+#include "android/asset_manager.h"
+
+namespace gvr {
+
+/*
+ * Each image is decoded by one worker with PngLoader, into memory the
+ * allocator returns once the size is known: a malloc()ed buffer, a slice of
+ * a mapped pixel buffer, or anything else that stays valid until the
+ * callback. Both run on the worker.
+ */
+class PngDecodePool {
+public:
+    // RGBA rows of stride bytes for width x height pixels, 0 to skip
+    typedef std::function<
+            unsigned char*(int width, int height, size_t& stride)> Allocator;
+    // pixels is what the allocator returned, or 0 if decoding failed early
+    typedef std::function<
+            void(bool decoded, int width, int height, unsigned char* pixels,
+                    size_t stride)> Callback;
+
+    struct Options {
+        Options() :
+                premultiply_alpha(false), screen_gamma(0.0f) {
+        }
+
+        bool premultiply_alpha;
+        // see PngLoader::setGamma()
+        float screen_gamma;
+    };
+
+    // threads 0 picks one per core but the one the GL thread runs on
+    explicit PngDecodePool(int threads = 0);
+    ~PngDecodePool();
+
+    // decode and close asset
+    void decode(AAsset* asset, const Options& options,
+            const Allocator& allocator, const Callback& callback);
+    // decode a PNG file held in memory
+    void decode(std::vector<unsigned char>& png, const Options& options,
+            const Allocator& allocator, const Callback& callback);
+
+    // block until every image queued so far is done
+    void wait();
+
+    static unsigned char* mallocAllocator(int width, int height,
+            size_t& stride);
+
+private:
+    PngDecodePool(const PngDecodePool& png_decode_pool);
+    PngDecodePool(PngDecodePool&& png_decode_pool);
+    PngDecodePool& operator=(const PngDecodePool& png_decode_pool);
+    PngDecodePool& operator=(PngDecodePool&& png_decode_pool);
+
+    struct Job {
+        AAsset* asset;
+        std::vector<unsigned char> png;
+        Options options;
+        Allocator allocator;
+        Callback callback;
+    };
+
+    void submit(Job* job);
+    static void* threadMain(void* pool);
+    void run();
+    static void run(Job* job);
+
+private:
+    pthread_mutex_t mutex_;
+    pthread_cond_t work_cond_;
+    pthread_cond_t idle_cond_;
+    int thread_count_;
+    std::vector<pthread_t> threads_;
+    std::deque<Job*> queue_;
+    int busy_;
+    bool quit_;
+};
+
+extern PngDecodePool png_decode_pool;
+}
+
+#endif
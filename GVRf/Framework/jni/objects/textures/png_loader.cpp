@@ -19,9 +19,16 @@
  ***************************************************************************/
 #include "png_loader.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "util/gvr_log.h"
 #include <pngconf.h>
 
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #if PNG_LIBPNG_VER >= 10400 && PNG_LIBPNG_VER <= 10502 \
     && defined(PNG_PEDANTIC_WARNINGS_SUPPORTED)
 
@@ -35,220 +42,192 @@
 #endif
 #endif
 
-#define FAST_SCAN_LINE(data, bpl, y) (data + (y) * bpl)
-
-static void iod_read_fn(png_structp png_ptr, png_bytep data,
-        png_size_t length) {
-    AAsset* asset = (AAsset *) png_get_io_ptr(png_ptr);
-    AAsset_read(asset, data, length);
-}
-
-static void setup_image(PngLoader::ImageData &image, png_structp png_ptr,
-        png_infop info_ptr, float screen_gamma = 0.0) {
-    if (screen_gamma != 0.0
-            && png_get_valid(png_ptr, info_ptr, PNG_INFO_gAMA)) {
-        double file_gamma;
-        png_get_gAMA(png_ptr, info_ptr, &file_gamma);
-        png_set_gamma(png_ptr, screen_gamma, file_gamma);
-    }
-
-    png_uint_32 width;
-    png_uint_32 height;
-    int bit_depth;
-    int color_type;
-    png_bytep trans_alpha = 0;
-    png_color_16p trans_color_p = 0;
-    int num_trans;
-    png_colorp palette = 0;
-    int num_palette;
-    int interlace_method;
-    png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type,
-            &interlace_method, 0, 0);
-    png_set_interlace_handling(png_ptr);
-
-    if (color_type == PNG_COLOR_TYPE_GRAY) {
-        // Black & White or 8-bit grayscale
-        if (bit_depth == 1 && png_get_channels(png_ptr, info_ptr) == 1) {
-            png_set_invert_mono(png_ptr);
-            png_read_update_info(png_ptr, info_ptr);
-
-            image.width = width;
-            image.height = height;
-            image.bits = (unsigned char*) malloc(
-                    width * height * sizeof(unsigned char));
-            image.format = PngLoader::GrayFormat;
-
-        } else if (bit_depth == 16
-                && png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS)) {
-            png_set_expand(png_ptr);
-            png_set_strip_16(png_ptr);
-            png_set_gray_to_rgb(png_ptr);
-
-            image.width = width;
-            image.height = height;
-            image.bits = (unsigned char*) malloc(
-                    width * height * 4 * sizeof(unsigned char));
-            image.format = PngLoader::RGBAFormat;
-
-            png_read_update_info(png_ptr, info_ptr);
-        } else {
-
-            LOGE("PNG Format not supported");
-
+/*
+ * c * a / 255, rounded, for every color channel of a row of RGBA pixels:
+ * with t = c * a + 128, (t + (t >> 8)) >> 8 is exact for 8-bit values.
+ */
+static void premultiply_row(unsigned char *row, int width) {
+    int x = 0;
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+    const uint16x8_t half = vdupq_n_u16(128);
+    for (; x + 8 <= width; x += 8) {
+        uint8x8x4_t p = vld4_u8(row + x * 4);
+        for (int c = 0; c < 3; ++c) {
+            uint16x8_t t = vaddq_u16(vmull_u8(p.val[c], p.val[3]), half);
+            p.val[c] = vaddhn_u16(t, vshrq_n_u16(t, 8));
         }
-    } else if (color_type == PNG_COLOR_TYPE_PALETTE
-            && png_get_PLTE(png_ptr, info_ptr, &palette, &num_palette)
-            && num_palette <= 256) {
-        // 1-bit and 8-bit color
-        if (bit_depth != 1)
-            png_set_packing(png_ptr);
-        png_read_update_info(png_ptr, info_ptr);
-        png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth,
-                &color_type, 0, 0, 0);
-        PngLoader::ImageFormat format;
-        if (bit_depth == 1) {
-            format = PngLoader::GrayFormat;
-
-            image.width = width;
-            image.height = height;
-            image.bits = (unsigned char*) malloc(
-                    width * height * sizeof(unsigned char));
-            image.format = PngLoader::GrayFormat;
-        } else {
-            LOGE("PNG Format Indexed8 not supported");
+        vst4_u8(row + x * 4, p);
+    }
+#endif
+    for (; x < width; ++x) {
+        unsigned char *p = row + x * 4;
+        unsigned int a = p[3];
+        for (int c = 0; c < 3; ++c) {
+            unsigned int t = p[c] * a + 128;
+            p[c] = (t + (t >> 8)) >> 8;
         }
+    }
+}
 
-    } else {
-        // 32-bit
-        if (bit_depth == 16)
-            png_set_strip_16(png_ptr);
-
-        png_set_expand(png_ptr);
-
-        if (color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
-            png_set_gray_to_rgb(png_ptr);
-
-        // Format_ARGB32;
-        PngLoader::ImageFormat format = PngLoader::RGBAFormat;
-        // Only add filler if no alpha, or we can get 5 channel data.
-        if (!(color_type & PNG_COLOR_MASK_ALPHA)
-                && !png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS)) {
+static void gvrf_png_warning(png_structp, png_const_charp message) {
+    LOGE("libpng warning: %s", message);
+}
 
-            png_set_filler(png_ptr, 0xff,
-#ifdef QX_PLATFORM_MACOSX
-                    PNG_FILLER_BEFORE
+void PngLoader::readAsset(png_structp png_ptr, png_bytep out,
+        png_size_t length) {
+#ifdef __ANDROID__
+    PngLoader *loader = (PngLoader *) png_get_io_ptr(png_ptr);
+    if (AAsset_read(loader->pFileDescriptor, out, length) != (int) length) {
+        png_error(png_ptr, "truncated asset");
+    }
 #else
-                    PNG_FILLER_AFTER
+    png_error(png_ptr, "no assets on the host");
 #endif
-                    );
-            // We want 4 bytes, but it isn't an alpha channel (XRGB32)
-            image.width = width;
-            image.height = height;
-            image.bits = (unsigned char*) malloc(
-                    width * height * 4 * sizeof(unsigned char));
-            image.format = PngLoader::RGBAFormat;
-
-            return;
-        }
-
-        image.width = width;
-        image.height = height;
-        image.bits = (unsigned char*) malloc(
-                width * height * 4 * sizeof(unsigned char));
-        image.format = PngLoader::RGBAFormat;
+}
 
-        png_read_update_info(png_ptr, info_ptr);
+void PngLoader::readMemory(png_structp png_ptr, png_bytep out,
+        png_size_t length) {
+    PngLoader *loader = (PngLoader *) png_get_io_ptr(png_ptr);
+    if (length > loader->data_size - loader->data_offset) {
+        png_error(png_ptr, "truncated data");
     }
+    memcpy(out, loader->data + loader->data_offset, length);
+    loader->data_offset += length;
+}
 
+bool PngLoader::begin(AAsset *file) {
+    pFileDescriptor = file;
+    data = 0;
+    return begin();
 }
 
-static void gvrf_png_warning(png_structp, png_const_charp message) {
-    LOGE("libpng warning: %s", message);
+bool PngLoader::begin(const void *memory, size_t size) {
+    pFileDescriptor = NULL;
+    data = static_cast<const unsigned char *>(memory);
+    data_size = size;
+    data_offset = 0;
+    return begin();
 }
 
-void PngLoader::loadFromAsset(AAsset *file) {
-    pFileDescriptor = file;
+bool PngLoader::begin() {
+    end();
     pOutImage.bits = NULL;
 
     png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, 0, 0, 0);
     if (!png_ptr)
-        return;
+        return false;
 
     png_set_error_fn(png_ptr, 0, 0, gvrf_png_warning);
 
     info_ptr = png_create_info_struct(png_ptr);
-    if (!info_ptr) {
-        png_destroy_read_struct(&png_ptr, 0, 0);
-        png_ptr = 0;
-        return;
-    }
-
     end_info = png_create_info_struct(png_ptr);
-    if (!end_info) {
-        png_destroy_read_struct(&png_ptr, &info_ptr, 0);
-        png_ptr = 0;
-        return;
+    if (!info_ptr || !end_info) {
+        end();
+        return false;
     }
 
     if (setjmp(png_jmpbuf(png_ptr))) {
-        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
-        png_ptr = 0;
-        return;
+        end();
+        return false;
     }
 
-    png_set_read_fn(png_ptr, file, iod_read_fn);
+    png_set_read_fn(png_ptr, this,
+            pFileDescriptor != NULL ? readAsset : readMemory);
     png_read_info(png_ptr, info_ptr);
 
-    if (setjmp(png_jmpbuf(png_ptr))) {
-        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
-        png_ptr = 0;
-        amp.deallocate();
-        return;
-    }
-
-    setup_image(pOutImage, png_ptr, info_ptr, gamma);
-
-    if (pOutImage.bits == NULL) {
-        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
-        png_ptr = 0;
-        amp.deallocate();
-        return;
+    if (gamma != 0.0 && png_get_valid(png_ptr, info_ptr, PNG_INFO_gAMA)) {
+        double file_gamma;
+        png_get_gAMA(png_ptr, info_ptr, &file_gamma);
+        png_set_gamma(png_ptr, gamma, file_gamma);
     }
 
     png_uint_32 width;
     png_uint_32 height;
     int bit_depth;
     int color_type;
-    png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, 0,
-            0, 0);
-    unsigned char *data = pOutImage.bits;
-    int bpp = 0;
-    switch (pOutImage.format) {
-    case GrayFormat:
-        bpp = 1;
-        break;
-    case RGBFormat:
-        bpp = 3;
-        break;
-    case RGBAFormat:
-        bpp = 4;
-        break;
-    default:
-        break;
-    }
-    int bpl = bpp * pOutImage.width;
-    amp.row_pointers = new png_bytep[height];
+    png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type,
+            0, 0, 0);
+
+    has_alpha = (color_type & PNG_COLOR_MASK_ALPHA)
+            || png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
+
+    // palette to RGB, gray below 8 bits to 8, tRNS to an alpha channel
+    png_set_expand(png_ptr);
+    if (bit_depth == 16)
+        png_set_strip_16(png_ptr);
+    if (!(color_type & PNG_COLOR_MASK_COLOR))
+        png_set_gray_to_rgb(png_ptr);
+    if (!has_alpha)
+        png_set_filler(png_ptr, 0xff, PNG_FILLER_AFTER);
+    passes = png_set_interlace_handling(png_ptr);
+    png_read_update_info(png_ptr, info_ptr);
+
+    pOutImage.width = width;
+    pOutImage.height = height;
+    pOutImage.format = RGBAFormat;
+    return true;
+}
 
-    for (uint y = 0; y < height; y++)
-        amp.row_pointers[y] = data + y * bpl;
+bool PngLoader::decode(unsigned char *pixels, size_t stride) {
+    if (!png_ptr)
+        return false;
 
-    png_read_image(png_ptr, amp.row_pointers);
-    amp.deallocate();
+    if (setjmp(png_jmpbuf(png_ptr))) {
+        end();
+        return false;
+    }
+
+    int height = pOutImage.height;
+    bool premultiply = premultiply_alpha && has_alpha;
+    if (passes == 1) {
+        // row by row, so each row is premultiplied while in cache
+        for (int y = 0; y < height; y++) {
+            png_read_row(png_ptr, pixels + y * stride, 0);
+            if (premultiply)
+                premultiply_row(pixels + y * stride, pOutImage.width);
+        }
+    } else {
+        amp.row_pointers = new png_bytep[height];
+        for (int y = 0; y < height; y++)
+            amp.row_pointers[y] = pixels + y * stride;
+        png_read_image(png_ptr, amp.row_pointers);
+        amp.deallocate();
+        if (premultiply) {
+            for (int y = 0; y < height; y++)
+                premultiply_row(pixels + y * stride, pOutImage.width);
+        }
+    }
 
     png_read_end(png_ptr, end_info);
+    end();
+    return true;
+}
 
-    png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
-    png_ptr = 0;
+void PngLoader::end() {
+    if (png_ptr) {
+        png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+        png_ptr = 0;
+        info_ptr = 0;
+        end_info = 0;
+    }
     amp.deallocate();
 }
 
+void PngLoader::loadFromAsset(AAsset *file) {
+    if (!begin(file))
+        return;
+
+    size_t stride = pOutImage.width * 4;
+    unsigned char *bits = (unsigned char*) malloc(stride * pOutImage.height);
+    if (bits == NULL) {
+        LOGE("PngLoader: out of memory for %dx%d", pOutImage.width,
+                pOutImage.height);
+        end();
+        return;
+    }
+    if (!decode(bits, stride)) {
+        free(bits);
+        return;
+    }
+    pOutImage.bits = bits;
+}
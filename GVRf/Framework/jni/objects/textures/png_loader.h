@@ -17,22 +17,68 @@
 /***************************************************************************
  * The PNG loader
  ***************************************************************************/
+
 #ifndef PNG_LOADER_H_
 #define PNG_LOADER_H_
 
+#include <stddef.h>
+
+#ifdef __ANDROID__
 #include "android/asset_manager_jni.h"
+#else
+// host tools only decode from memory
+struct AAsset;
+#endif
 #include <png.h>
 
+/*
+ * Every PNG color type and bit depth is decoded to 8-bit RGBA: palettes and
+ * gray are expanded, 16-bit channels are stripped, and a missing alpha
+ * channel is filled with 0xff.
+ *
+ * loadFromAsset() decodes into a malloc()ed buffer left in pOutImage.bits.
+ * To decode into memory the caller owns instead, call begin(), read the
+ * size from pOutImage, then decode().
+ */
 class PngLoader {
 public:
 
     PngLoader() :
-            gamma(0.0), png_ptr(0), info_ptr(0), end_info(0), pFileDescriptor(
-                    NULL) {
+            gamma(0.0), premultiply_alpha(false), has_alpha(false), passes(
+                    1), png_ptr(0), info_ptr(0), end_info(0), pFileDescriptor(
+                    NULL), data(0), data_size(0), data_offset(0) {
+        pOutImage.bits = NULL;
+        pOutImage.width = 0;
+        pOutImage.height = 0;
+        pOutImage.format = RGBAFormat;
+    }
+
+    ~PngLoader() {
+        end();
     }
 
     void loadFromAsset(AAsset *file);
 
+    // read the header; the image can then be decoded with decode()
+    bool begin(AAsset *file);
+    bool begin(const void *memory, size_t size);
+
+    // decode the image begun into rows of stride bytes, at least width * 4
+    bool decode(unsigned char *pixels, size_t stride);
+
+    // release the decoder; decode() does so too
+    void end();
+
+    // display gamma to correct the file's gAMA chunk to, 0 for none
+    void setGamma(float screen_gamma) {
+        gamma = screen_gamma;
+    }
+
+    // multiply the color channels by alpha while decoding
+    void setPremultiplyAlpha(bool premultiply) {
+        premultiply_alpha = premultiply;
+    }
+
     enum ImageFormat {
         GrayFormat, RGBFormat, RGBAFormat
     };
@@ -46,8 +92,18 @@ public:
     ImageData pOutImage;
 
 private:
+    bool begin();
+    static void readAsset(png_structp png_ptr, png_bytep out,
+            png_size_t length);
+    static void readMemory(png_structp png_ptr, png_bytep out,
+            png_size_t length);
 
     float gamma;
+    bool premultiply_alpha;
+    // whether the image has alpha to premultiply
+    bool has_alpha;
+    // 7 for an interlaced image, which is decoded whole
+    int passes;
 
     png_struct *png_ptr;
     png_info *info_ptr;
@@ -55,29 +111,22 @@ private:
 
     struct AllocatedMemoryPointers {
         AllocatedMemoryPointers() :
-                row_pointers(0), accRow(0), inRow(0), outRow(0) {
+                row_pointers(0) {
         }
         void deallocate() {
             delete[] row_pointers;
             row_pointers = 0;
-            delete[] accRow;
-            accRow = 0;
-            delete[] inRow;
-            inRow = 0;
-            delete[] outRow;
-            outRow = 0;
         }
 
         png_byte **row_pointers;
-        unsigned int *accRow;
-        png_byte *inRow;
-        unsigned char *outRow;
     };
 
     AllocatedMemoryPointers amp;
 
     AAsset * pFileDescriptor;
-
+    const unsigned char *data;
+    size_t data_size;
+    size_t data_offset;
 };
 
 #endif
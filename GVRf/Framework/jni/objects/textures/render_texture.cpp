@@ -24,7 +24,7 @@
 
 namespace gvr {
 RenderTexture::RenderTexture(int width, int height) :
-        Texture(new GLTexture(TARGET)), width_(width), height_(height), sample_count_(
+        Texture(new GLTexture(TARGET), GpuMemory::RENDER_TARGET), width_(width), height_(height), sample_count_(
                 0), gl_render_buffer_(new GLRenderBuffer()), gl_frame_buffer_(
                 new GLFrameBuffer()) {
     glBindTexture(TARGET, gl_texture_->id());
@@ -43,10 +43,13 @@ RenderTexture::RenderTexture(int width, int height) :
 
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
             GL_RENDERBUFFER, gl_render_buffer_->id());
+
+    // RGBA color and 16 bit depth
+    set_gpu_size(width * height * 6);
 }
 
 RenderTexture::RenderTexture(int width, int height, int sample_count) :
-        Texture(new GLTexture(TARGET)), width_(width), height_(height), sample_count_(
+        Texture(new GLTexture(TARGET), GpuMemory::RENDER_TARGET), width_(width), height_(height), sample_count_(
                 sample_count), gl_render_buffer_(new GLRenderBuffer()), gl_frame_buffer_(
                 new GLFrameBuffer()) {
     glBindTexture(TARGET, gl_texture_->id());
@@ -66,6 +69,9 @@ RenderTexture::RenderTexture(int width, int height, int sample_count) :
 
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
             GL_RENDERBUFFER, gl_render_buffer_->id());
+
+    // the resolved color, and a depth buffer per sample
+    set_gpu_size(width * height * (4 + 2 * sample_count));
 }
 
 }
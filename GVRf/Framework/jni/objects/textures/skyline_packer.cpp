@@ -0,0 +1,100 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Skyline bottom-left rectangle packing, for texture atlases.
+ ***************************************************************************/
+
+#include "skyline_packer.h"
+
+#include <limits.h>
+
+namespace gvr {
+
+SkylinePacker::SkylinePacker(int width, int height) :
+        width_(width), height_(height), used_area_(0), skyline_() {
+    Segment floor = { 0, 0, width };
+    skyline_.push_back(floor);
+}
+
+int SkylinePacker::fit(size_t index, int width, int height) const {
+    if (skyline_[index].x + width > width_) {
+        return -1;
+    }
+    int y = 0;
+    int remaining = width;
+    for (size_t i = index; remaining > 0; ++i) {
+        y = skyline_[i].y > y ? skyline_[i].y : y;
+        if (y + height > height_) {
+            return -1;
+        }
+        remaining -= skyline_[i].width;
+    }
+    return y;
+}
+
+bool SkylinePacker::insert(int width, int height, int* x, int* y) {
+    int best_index = -1, best_top = INT_MAX, best_width = INT_MAX, best_y = 0;
+    for (size_t i = 0; i < skyline_.size(); ++i) {
+        int top = fit(i, width, height);
+        if (top < 0) {
+            continue;
+        }
+        top += height;
+        if (top < best_top
+                || (top == best_top && skyline_[i].width < best_width)) {
+            best_index = i;
+            best_top = top;
+            best_width = skyline_[i].width;
+            best_y = top - height;
+        }
+    }
+    if (best_index < 0) {
+        return false;
+    }
+
+    Segment placed = { skyline_[best_index].x, best_top, width };
+    skyline_.insert(skyline_.begin() + best_index, placed);
+    // trim or drop the segments the new one covers
+    int right = placed.x + placed.width;
+    for (size_t i = best_index + 1; i < skyline_.size();) {
+        if (skyline_[i].x >= right) {
+            break;
+        }
+        int covered = right - skyline_[i].x;
+        if (covered >= skyline_[i].width) {
+            skyline_.erase(skyline_.begin() + i);
+        } else {
+            skyline_[i].x += covered;
+            skyline_[i].width -= covered;
+            break;
+        }
+    }
+    for (size_t i = 0; i + 1 < skyline_.size();) {
+        if (skyline_[i].y == skyline_[i + 1].y) {
+            skyline_[i].width += skyline_[i + 1].width;
+            skyline_.erase(skyline_.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+
+    *x = placed.x;
+    *y = best_y;
+    used_area_ += static_cast<long long>(width) * height;
+    return true;
+}
+
+}
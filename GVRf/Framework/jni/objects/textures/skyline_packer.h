@@ -0,0 +1,64 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Skyline bottom-left rectangle packing, for texture atlases.
+ ***************************************************************************/
+
+#ifndef SKYLINE_PACKER_H_
+#define SKYLINE_PACKER_H_
+
+#include <vector>
+
+namespace gvr {
+
+/*
+ * Keeps the top edge of everything placed so far as a list of horizontal
+ * segments, and puts each rectangle where its top ends lowest. Space left
+ * under an overhang is not reused, which costs a little density for O(n)
+ * inserts in the number of segments.
+ */
+class SkylinePacker {
+public:
+    SkylinePacker(int width, int height);
+
+    // false if the rectangle does not fit
+    bool insert(int width, int height, int* x, int* y);
+
+    // fraction of the area covered so far
+    float occupancy() const {
+        return static_cast<float>(used_area_) / (width_ * height_);
+    }
+
+private:
+    struct Segment {
+        int x;
+        int y;
+        int width;
+    };
+
+    // the y a rectangle starting at segment index would rest at; -1 if it
+    // does not fit there
+    int fit(size_t index, int width, int height) const;
+
+private:
+    int width_;
+    int height_;
+    long long used_area_;
+    std::vector<Segment> skyline_;
+};
+
+}
+#endif
@@ -0,0 +1,223 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Texture whose mip levels are made resident as they are needed.
+ ***************************************************************************/
+
+#include "streamed_texture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "engine/memory/texture_streamer.h"
+
+namespace gvr {
+
+const GLenum StreamedTexture::TARGET;
+const int StreamedTexture::RESIDENT_SIZE;
+
+StreamedTexture::StreamedTexture(JNIEnv* env, jobject bitmap) :
+        Texture(new GLTexture(TARGET), GpuMemory::TEXTURE, this), levels_(), coarse_base_(
+                0), resident_base_(0), wanted_level_(
+                0), last_used_(0) {
+    AndroidBitmapInfo info;
+    void *pixels;
+    int ret;
+    if (bitmap == NULL) {
+        std::string error =
+                "new StreamedTexture() failed! Input bitmap is NULL.";
+        throw error;
+    }
+    if ((ret = AndroidBitmap_getInfo(env, bitmap, &info)) < 0) {
+        std::string error = "AndroidBitmap_getInfo () failed! error = "
+                + std::to_string(ret);
+        throw error;
+    }
+    if (info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) {
+        std::string error = "new StreamedTexture() failed! Only RGBA_8888 bitmaps are supported.";
+        throw error;
+    }
+    if ((ret = AndroidBitmap_lockPixels(env, bitmap, &pixels)) < 0) {
+        std::string error = "AndroidBitmap_lockPixels () failed! error = "
+                + std::to_string(ret);
+        throw error;
+    }
+    if (info.stride == info.width * 4) {
+        initialize(info.width, info.height,
+                static_cast<const unsigned char*>(pixels));
+    } else {
+        std::vector<unsigned char> packed(info.width * info.height * 4);
+        for (unsigned int y = 0; y < info.height; ++y) {
+            memcpy(&packed[y * info.width * 4],
+                    static_cast<const unsigned char*>(pixels) + y * info.stride,
+                    info.width * 4);
+        }
+        initialize(info.width, info.height, packed.data());
+    }
+    AndroidBitmap_unlockPixels(env, bitmap);
+}
+
+StreamedTexture::StreamedTexture(int width, int height,
+        const unsigned char* pixels) :
+        Texture(new GLTexture(TARGET), GpuMemory::TEXTURE, this), levels_(), coarse_base_(
+                0), resident_base_(0), wanted_level_(
+                0), last_used_(0) {
+    initialize(width, height, pixels);
+}
+
+StreamedTexture::~StreamedTexture() {
+    gpu_allocation_.release();
+    texture_streamer.remove(this);
+}
+
+void StreamedTexture::initialize(int width, int height,
+        const unsigned char* pixels) {
+    Level level;
+    level.width = width;
+    level.height = height;
+    level.pixels.assign(pixels, pixels + width * height * 4);
+    levels_.push_back(level);
+
+    // 2x2 box filter; an odd row or column is folded into the last texel
+    while (width > 1 || height > 1) {
+        const Level& src = levels_.back();
+        Level dst;
+        dst.width = std::max(width / 2, 1);
+        dst.height = std::max(height / 2, 1);
+        dst.pixels.resize(dst.width * dst.height * 4);
+        for (int y = 0; y < dst.height; ++y) {
+            int y0 = std::min(y * 2, src.height - 1);
+            int y1 = std::min(y * 2 + 1, src.height - 1);
+            for (int x = 0; x < dst.width; ++x) {
+                int x0 = std::min(x * 2, src.width - 1);
+                int x1 = std::min(x * 2 + 1, src.width - 1);
+                const unsigned char* p00 = &src.pixels[(y0 * src.width + x0) * 4];
+                const unsigned char* p01 = &src.pixels[(y0 * src.width + x1) * 4];
+                const unsigned char* p10 = &src.pixels[(y1 * src.width + x0) * 4];
+                const unsigned char* p11 = &src.pixels[(y1 * src.width + x1) * 4];
+                unsigned char* out = &dst.pixels[(y * dst.width + x) * 4];
+                for (int c = 0; c < 4; ++c) {
+                    out[c] = (p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4;
+                }
+            }
+        }
+        width = dst.width;
+        height = dst.height;
+        levels_.push_back(dst);
+    }
+
+    int count = levels_.size();
+    glBindTexture(TARGET, gl_texture_->id());
+    glTexParameteri(TARGET, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+#if _GVRF_USE_GLES3_
+    glTexParameteri(TARGET, GL_TEXTURE_MAX_LEVEL, count - 1);
+
+    // start from the small levels; the streamer raises detail on demand
+    resident_base_ = count - 1;
+    for (int i = count - 1; i > 0; --i) {
+        if (levels_[i - 1].width > RESIDENT_SIZE
+                || levels_[i - 1].height > RESIDENT_SIZE) {
+            break;
+        }
+        resident_base_ = i - 1;
+    }
+    for (int i = count - 1; i >= resident_base_; --i) {
+        uploadLevel(i);
+    }
+    glTexParameteri(TARGET, GL_TEXTURE_BASE_LEVEL, resident_base_);
+    glBindTexture(TARGET, 0);
+    coarse_base_ = resident_base_;
+    set_gpu_size(residentBytes());
+
+    wanted_level_ = count - 1;
+    texture_streamer.add(this);
+#else
+    // without BASE_LEVEL an incomplete chain cannot be sampled, so the
+    // whole chain stays resident and the streamer never sees it
+    resident_base_ = 0;
+    for (int i = 0; i < count; ++i) {
+        uploadLevel(i);
+    }
+    glBindTexture(TARGET, 0);
+    set_gpu_size(residentBytes());
+
+    wanted_level_ = 0;
+#endif
+}
+
+void StreamedTexture::uploadLevel(int level) const {
+    glTexImage2D(TARGET, level, GL_RGBA, levels_[level].width,
+            levels_[level].height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+            levels_[level].pixels.data());
+}
+
+void StreamedTexture::requestDetail(float uv_per_pixel) {
+    int level = 0;
+    if (uv_per_pixel > 0.0f) {
+        // texels of level 0 per screen pixel, one level per doubling
+        float texels = uv_per_pixel
+                * std::max(levels_[0].width, levels_[0].height);
+        if (texels > 1.0f) {
+            level = std::min(static_cast<int>(std::floor(std::log2(texels))),
+                    static_cast<int>(levels_.size()) - 1);
+        }
+    }
+    wanted_level_ = std::min(wanted_level_, level);
+    last_used_ = texture_streamer.frame();
+}
+
+size_t StreamedTexture::residentBytes() const {
+    size_t bytes = 0;
+    for (int i = resident_base_; i < static_cast<int>(levels_.size()); ++i) {
+        bytes += levels_[i].pixels.size();
+    }
+    return bytes;
+}
+
+void StreamedTexture::makeResident(int base) {
+#if _GVRF_USE_GLES3_
+    base = std::max(0, std::min(base, static_cast<int>(levels_.size()) - 1));
+    if (base == resident_base_) {
+        return;
+    }
+    glBindTexture(TARGET, gl_texture_->id());
+    if (base < resident_base_) {
+        for (int i = resident_base_ - 1; i >= base; --i) {
+            uploadLevel(i);
+        }
+        glTexParameteri(TARGET, GL_TEXTURE_BASE_LEVEL, base);
+    } else {
+        // stop sampling the levels before giving their storage back
+        glTexParameteri(TARGET, GL_TEXTURE_BASE_LEVEL, base);
+        for (int i = resident_base_; i < base; ++i) {
+            glTexImage2D(TARGET, i, GL_RGBA, 0, 0, 0, GL_RGBA,
+                    GL_UNSIGNED_BYTE, 0);
+        }
+    }
+    glBindTexture(TARGET, 0);
+    resident_base_ = base;
+    set_gpu_size(residentBytes());
+#endif
+}
+
+void StreamedTexture::evict() {
+    if (resident_base_ < coarse_base_) {
+        makeResident(coarse_base_);
+    }
+}
+
+}
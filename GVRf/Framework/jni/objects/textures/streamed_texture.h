@@ -0,0 +1,114 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Texture whose mip levels are made resident as they are needed.
+ ***************************************************************************/
+
+#ifndef STREAMED_TEXTURE_H_
+#define STREAMED_TEXTURE_H_
+
+#include <string>
+#include <vector>
+
+#include <android/bitmap.h>
+
+#include "objects/textures/texture.h"
+#include "util/gvr_gl.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+
+/*
+ * Keeps the whole mip chain in memory and only the levels from
+ * resident_base() down to the smallest on the GPU; TextureStreamer decides
+ * how far that goes. Level 0 is the full-size image. Over the GpuMemory
+ * budget, a texture not drawn lately drops back to its smallest levels.
+ */
+class StreamedTexture: public Texture, public GpuMemory::Evictable {
+public:
+    explicit StreamedTexture(JNIEnv* env, jobject bitmap);
+    explicit StreamedTexture(int width, int height,
+            const unsigned char* pixels);
+    ~StreamedTexture();
+
+    GLenum getTarget() const {
+        return TARGET;
+    }
+
+    void requestDetail(float uv_per_pixel);
+
+    int level_count() const {
+        return levels_.size();
+    }
+
+    int resident_base() const {
+        return resident_base_;
+    }
+
+    // finest level asked for since the last clearRequest()
+    int wanted_level() const {
+        return wanted_level_;
+    }
+
+    unsigned int last_used() const {
+        return last_used_;
+    }
+
+    size_t levelBytes(int level) const {
+        return levels_[level].pixels.size();
+    }
+
+    size_t residentBytes() const;
+
+    void clearRequest() {
+        wanted_level_ = levels_.size() - 1;
+    }
+
+    // Uploads or frees levels so that base is the finest one; GL thread.
+    void makeResident(int base);
+
+    void evict();
+
+private:
+    StreamedTexture(const StreamedTexture& streamed_texture);
+    StreamedTexture(StreamedTexture&& streamed_texture);
+    StreamedTexture& operator=(const StreamedTexture& streamed_texture);
+    StreamedTexture& operator=(StreamedTexture&& streamed_texture);
+
+    void initialize(int width, int height, const unsigned char* pixels);
+    void uploadLevel(int level) const;
+
+private:
+    static const GLenum TARGET = GL_TEXTURE_2D;
+    // the coarsest levels up to this size are always resident
+    static const int RESIDENT_SIZE = 64;
+
+    struct Level {
+        int width;
+        int height;
+        std::vector<unsigned char> pixels;
+    };
+
+    std::vector<Level> levels_;
+    // finest of the levels that are always resident
+    int coarse_base_;
+    int resident_base_;
+    int wanted_level_;
+    unsigned int last_used_;
+};
+
+}
+#endif
@@ -0,0 +1,119 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "streamed_texture.h"
+#include "png_loader.h"
+#include "engine/memory/texture_streamer.h"
+#include "util/gvr_jni.h"
+#include "util/gvr_java_stack_trace.h"
+#include "android/asset_manager_jni.h"
+
+#include <stdlib.h>
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeStreamedTexture_bitmapConstructor(JNIEnv * env,
+        jobject obj, jobject bitmap);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeStreamedTexture_fileConstructor(JNIEnv * env,
+        jobject obj, jobject asset_manager, jstring filename);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeStreamedTexture_setMemoryBudget(JNIEnv * env,
+        jobject obj, jlong bytes);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeStreamedTexture_getMemoryBudget(JNIEnv * env,
+        jobject obj);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeStreamedTexture_getResidentBytes(JNIEnv * env,
+        jobject obj);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeStreamedTexture_update(JNIEnv * env, jobject obj);
+}
+;
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeStreamedTexture_bitmapConstructor(JNIEnv * env,
+        jobject obj, jobject bitmap) {
+    try {
+        return reinterpret_cast<jlong>(new StreamedTexture(env, bitmap));
+    } catch (const std::string &err) {
+        printJavaCallStack(env, err);
+        throw err;
+    }
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeStreamedTexture_fileConstructor(JNIEnv * env,
+        jobject obj, jobject asset_manager, jstring filename) {
+    const char* native_string = env->GetStringUTFChars(filename, 0);
+    AAssetManager* mgr = AAssetManager_fromJava(env, asset_manager);
+    AAsset* asset = AAssetManager_open(mgr, native_string, AASSET_MODE_UNKNOWN);
+    env->ReleaseStringUTFChars(filename, native_string);
+    if (NULL == asset) {
+        LOGE("_ASSET_NOT_FOUND_");
+        return 0;
+    }
+
+    PngLoader loader;
+    loader.loadFromAsset(asset);
+    AAsset_close(asset);
+
+    if (loader.pOutImage.bits == NULL) {
+        LOGE("PNG decoder failed");
+        return 0;
+    }
+
+    if (loader.pOutImage.format != PngLoader::RGBAFormat) {
+        LOGE("Only RGBA format supported");
+        free(loader.pOutImage.bits);
+        return 0;
+    }
+
+    // the texture keeps its own copy of every level
+    StreamedTexture* texture = new StreamedTexture(loader.pOutImage.width,
+            loader.pOutImage.height, loader.pOutImage.bits);
+    free(loader.pOutImage.bits);
+    return reinterpret_cast<jlong>(texture);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeStreamedTexture_setMemoryBudget(JNIEnv * env,
+        jobject obj, jlong bytes) {
+    texture_streamer.setBudget(bytes);
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeStreamedTexture_getMemoryBudget(JNIEnv * env,
+        jobject obj) {
+    return texture_streamer.budget();
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeStreamedTexture_getResidentBytes(JNIEnv * env,
+        jobject obj) {
+    return texture_streamer.residentBytes();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeStreamedTexture_update(JNIEnv * env, jobject obj) {
+    texture_streamer.update();
+}
+
+}
@@ -21,6 +21,10 @@
 #ifndef TEXTURE_H_
 #define TEXTURE_H_
 
+#include <atomic>
+
+#include "engine/memory/gpu_memory.h"
+#include "engine/memory/texture_uploader.h"
 #include "gl/gl_texture.h"
 #include "objects/recyclable_object.h"
 
@@ -33,6 +37,11 @@ public:
     }
 
     virtual void recycle() {
+        if (upload_pending()) {
+            texture_uploader.cancel(this);
+            set_upload_pending(false);
+        }
+        gpu_allocation_.release();
         if (gl_texture_ != 0) {
             delete gl_texture_;
             gl_texture_ = 0;
@@ -44,18 +53,59 @@ public:
             // must be recycled already. The caller will handle error.
             return 0;
         }
+        if (upload_pending()) {
+            // still being filled by TextureUploader; draw as untextured
+            return 0;
+        }
+        gpu_allocation_.touch();
         return gl_texture_->id();
     }
 
+    // acquire: once it reads false, the uploaded images are visible
+    bool upload_pending() const {
+        return upload_pending_.load(std::memory_order_acquire);
+    }
+
+    void set_upload_pending(bool upload_pending) {
+        upload_pending_.store(upload_pending, std::memory_order_release);
+    }
+
     virtual GLenum getTarget() const = 0;
 
+    // what the texture's images take on the GPU, in bytes; see GpuMemory
+    size_t gpu_size() const {
+        return gpu_allocation_.bytes();
+    }
+
+    void set_gpu_size(size_t bytes) {
+        gpu_allocation_.resize(bytes);
+    }
+
+    // level0 bytes with the mip chain below it
+    static size_t mipChainSize(size_t level0) {
+        return level0 + level0 / 3;
+    }
+
+    /*
+     * Called while culling with the texture coordinate change per screen
+     * pixel the texture is drawn at; 0 asks for full detail. Only streamed
+     * textures use it.
+     */
+    virtual void requestDetail(float uv_per_pixel) {
+    }
+
 protected:
-    Texture(GLTexture* gl_texture) :
-            RecyclableObject() {
+    Texture(GLTexture* gl_texture, GpuMemory::Category category =
+            GpuMemory::TEXTURE, GpuMemory::Evictable* evictable = 0) :
+            RecyclableObject(), upload_pending_(false), gpu_allocation_(
+                    category, evictable) {
         gl_texture_ = gl_texture;
     }
 
     const GLTexture* gl_texture_;
+    // set by TextureUploader from the upload until its fence signals
+    std::atomic<bool> upload_pending_;
+    GpuAllocation gpu_allocation_;
 
 private:
     Texture(const Texture& texture);
@@ -0,0 +1,159 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Packs many small bitmaps into shared texture pages, so the sprites and
+ * props drawn with them share texture state.
+ ***************************************************************************/
+
+#include "texture_atlas.h"
+
+#include <string.h>
+#include <string>
+
+#include "util/gvr_gl.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+
+AtlasPage::AtlasPage(int size, int levels) :
+        Texture(new GLTexture(GL_TEXTURE_2D)) {
+    glBindTexture(GL_TEXTURE_2D, gl_texture_->id());
+#if _GVRF_USE_GLES3_
+    glTexStorage2D(GL_TEXTURE_2D, levels, GL_RGBA8, size, size);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    if (levels > 1) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                GL_LINEAR_MIPMAP_LINEAR);
+    }
+#else
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size, size, 0, GL_RGBA,
+            GL_UNSIGNED_BYTE, 0);
+#endif
+    glBindTexture(GL_TEXTURE_2D, 0);
+    size_t bytes = 0;
+    for (int level = 0; level < levels; ++level) {
+        bytes += (size >> level) * (size >> level) * 4;
+    }
+    set_gpu_size(bytes);
+}
+
+TextureAtlas::TextureAtlas(int page_size, int gutter) :
+        page_size_(page_size), gutter_(0), levels_(1), pages_(), packers_(), dirty_(), cell_() {
+    if (gutter > 0) {
+        gutter_ = 1;
+        while (gutter_ < gutter) {
+            gutter_ <<= 1;
+        }
+    }
+#if _GVRF_USE_GLES3_
+    for (int g = gutter_; g > 1; g >>= 1) {
+        ++levels_;
+    }
+#endif
+}
+
+int TextureAtlas::add(JNIEnv* env, jobject bitmap, int* x, int* y) {
+    AndroidBitmapInfo info;
+    void* pixels;
+    int ret;
+    if ((ret = AndroidBitmap_getInfo(env, bitmap, &info)) < 0) {
+        std::string error = "AndroidBitmap_getInfo () failed! error = "
+                + std::to_string(ret);
+        throw error;
+    }
+    if (info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) {
+        std::string error =
+                "TextureAtlas::add() failed! Only RGBA_8888 bitmaps are supported.";
+        throw error;
+    }
+
+    int width = info.width;
+    int height = info.height;
+
+    // the cell, aligned to the gutter so mip texels stay inside it
+    int align = gutter_ > 0 ? gutter_ : 1;
+    int cell_width = (width + 2 * gutter_ + align - 1) / align * align;
+    int cell_height = (height + 2 * gutter_ + align - 1) / align * align;
+    if (cell_width > page_size_ || cell_height > page_size_) {
+        std::string error = "TextureAtlas::add() failed! "
+                + std::to_string(width) + "x" + std::to_string(height)
+                + " does not fit a page.";
+        throw error;
+    }
+
+    size_t page = 0;
+    int cell_x, cell_y;
+    while (page < packers_.size()
+            && !packers_[page].insert(cell_width, cell_height, &cell_x,
+                    &cell_y)) {
+        ++page;
+    }
+    if (page == packers_.size()) {
+        pages_.push_back(new AtlasPage(page_size_, levels_));
+        packers_.push_back(SkylinePacker(page_size_, page_size_));
+        dirty_.push_back(false);
+        packers_.back().insert(cell_width, cell_height, &cell_x, &cell_y);
+    }
+
+    if ((ret = AndroidBitmap_lockPixels(env, bitmap, &pixels)) < 0) {
+        std::string error = "AndroidBitmap_lockPixels () failed! error = "
+                + std::to_string(ret);
+        throw error;
+    }
+    // the image with its edge texels repeated out to the cell's border
+    cell_.resize(cell_width * cell_height * 4);
+    for (int row = 0; row < cell_height; ++row) {
+        int source_row = row - gutter_;
+        source_row = source_row < 0 ? 0 :
+                (source_row >= height ? height - 1 : source_row);
+        const unsigned char* source = static_cast<const unsigned char*>(pixels)
+                + source_row * info.stride;
+        unsigned char* out = &cell_[row * cell_width * 4];
+        for (int column = 0; column < cell_width; ++column, out += 4) {
+            int source_column = column - gutter_;
+            source_column = source_column < 0 ? 0 :
+                    (source_column >= width ? width - 1 : source_column);
+            memcpy(out, source + source_column * 4, 4);
+        }
+    }
+    AndroidBitmap_unlockPixels(env, bitmap);
+
+    glBindTexture(GL_TEXTURE_2D, pages_[page]->getId());
+    glTexSubImage2D(GL_TEXTURE_2D, 0, cell_x, cell_y, cell_width, cell_height,
+            GL_RGBA, GL_UNSIGNED_BYTE, cell_.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    dirty_[page] = true;
+
+    *x = cell_x + gutter_;
+    *y = cell_y + gutter_;
+    return page;
+}
+
+void TextureAtlas::generateMipmaps() {
+    if (levels_ == 1) {
+        return;
+    }
+    for (size_t i = 0; i < pages_.size(); ++i) {
+        if (dirty_[i]) {
+            glBindTexture(GL_TEXTURE_2D, pages_[i]->getId());
+            glGenerateMipmap(GL_TEXTURE_2D);
+            dirty_[i] = false;
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+}
@@ -0,0 +1,108 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Packs many small bitmaps into shared texture pages, so the sprites and
+ * props drawn with them share texture state.
+ ***************************************************************************/
+
+#ifndef TEXTURE_ATLAS_H_
+#define TEXTURE_ATLAS_H_
+
+#include <vector>
+
+#include <android/bitmap.h>
+
+#include "objects/hybrid_object.h"
+#include "objects/textures/skyline_packer.h"
+#include "objects/textures/texture.h"
+
+namespace gvr {
+
+// one RGBA page of a TextureAtlas
+class AtlasPage: public Texture {
+public:
+    AtlasPage(int size, int levels);
+
+    GLenum getTarget() const {
+        return GL_TEXTURE_2D;
+    }
+
+private:
+    AtlasPage(const AtlasPage& atlas_page);
+    AtlasPage(AtlasPage&& atlas_page);
+    AtlasPage& operator=(const AtlasPage& atlas_page);
+    AtlasPage& operator=(AtlasPage&& atlas_page);
+};
+
+/*
+ * Each image is surrounded by a gutter of its own edge texels, and its
+ * cell is aligned to the gutter size (rounded up to a power of two). The
+ * pages keep log2(gutter) mip levels, each texel of which still falls
+ * inside a single cell, so filtering never bleeds a neighbour in. Without
+ * GLES3 there is no GL_TEXTURE_MAX_LEVEL to stop the chain at, and pages
+ * have no mipmaps.
+ *
+ * The pages are owned by their Java wrappers, which GVRTextureAtlas keeps.
+ */
+class TextureAtlas: public HybridObject {
+public:
+    TextureAtlas(int page_size, int gutter);
+
+    /*
+     * Copy an RGBA_8888 bitmap into the first page it fits on, starting a
+     * page if none has room. Returns the page index, and the position of
+     * the image (inside its gutter) in x and y.
+     */
+    int add(JNIEnv* env, jobject bitmap, int* x, int* y);
+
+    // mipmaps of the pages added to since the last call
+    void generateMipmaps();
+
+    int page_count() const {
+        return pages_.size();
+    }
+
+    AtlasPage* page(int index) const {
+        return pages_[index];
+    }
+
+    int page_size() const {
+        return page_size_;
+    }
+
+    int gutter() const {
+        return gutter_;
+    }
+
+private:
+    TextureAtlas(const TextureAtlas& texture_atlas);
+    TextureAtlas(TextureAtlas&& texture_atlas);
+    TextureAtlas& operator=(const TextureAtlas& texture_atlas);
+    TextureAtlas& operator=(TextureAtlas&& texture_atlas);
+
+private:
+    int page_size_;
+    int gutter_;
+    int levels_;
+    std::vector<AtlasPage*> pages_;
+    std::vector<SkylinePacker> packers_;
+    std::vector<bool> dirty_;
+    // the image and its gutter, staged for glTexSubImage2D()
+    std::vector<unsigned char> cell_;
+};
+
+}
+#endif
@@ -0,0 +1,78 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "texture_atlas.h"
+
+#include "util/gvr_jni.h"
+#include "util/gvr_java_stack_trace.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeTextureAtlas_ctor(JNIEnv * env, jobject obj,
+        jint page_size, jint gutter);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeTextureAtlas_add(JNIEnv * env, jobject obj,
+        jlong jtexture_atlas, jobject bitmap, jintArray jposition);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeTextureAtlas_getPage(JNIEnv * env, jobject obj,
+        jlong jtexture_atlas, jint index);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTextureAtlas_generateMipmaps(JNIEnv * env,
+        jobject obj, jlong jtexture_atlas);
+}
+;
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeTextureAtlas_ctor(JNIEnv * env, jobject obj,
+        jint page_size, jint gutter) {
+    return reinterpret_cast<jlong>(new TextureAtlas(page_size, gutter));
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeTextureAtlas_add(JNIEnv * env, jobject obj,
+        jlong jtexture_atlas, jobject bitmap, jintArray jposition) {
+    TextureAtlas* texture_atlas = reinterpret_cast<TextureAtlas*>(jtexture_atlas);
+    try {
+        int x, y;
+        int page = texture_atlas->add(env, bitmap, &x, &y);
+        jint position[2] = { x, y };
+        env->SetIntArrayRegion(jposition, 0, 2, position);
+        return page;
+    } catch (const std::string &err) {
+        printJavaCallStack(env, err);
+        throw err;
+    }
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeTextureAtlas_getPage(JNIEnv * env, jobject obj,
+        jlong jtexture_atlas, jint index) {
+    TextureAtlas* texture_atlas = reinterpret_cast<TextureAtlas*>(jtexture_atlas);
+    return reinterpret_cast<jlong>(texture_atlas->page(index));
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTextureAtlas_generateMipmaps(JNIEnv * env,
+        jobject obj, jlong jtexture_atlas) {
+    TextureAtlas* texture_atlas = reinterpret_cast<TextureAtlas*>(jtexture_atlas);
+    texture_atlas->generateMipmaps();
+}
+
+}
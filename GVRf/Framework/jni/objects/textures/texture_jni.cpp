@@ -34,6 +34,8 @@ JNIEXPORT jint JNICALL
 Java_org_gearvrf_NativeTexture_getId(JNIEnv * env, jobject obj,
         jlong jtexture) {
     Texture* texture = reinterpret_cast<Texture*>(jtexture);
+    // whoever asks for the name is about to use it
+    texture_uploader.finish(texture);
     return texture->getId();
 }
 
@@ -96,7 +96,8 @@ static const char FRAGMENT_SHADER[] =
 
 CubemapReflectionShader::CubemapReflectionShader() :
         program_(0), a_position_(0), a_normal_(0), u_mv_(0), u_mv_it_(0), u_mvp_(
-                0), u_view_i_(0), u_texture_(0), u_color_(0), u_opacity_(0) {
+                0), u_view_i_(0), u_texture_(0), u_color_(0), u_opacity_(0), material_version_(
+                0) {
     program_ = new GLProgram(VERTEX_SHADER, FRAGMENT_SHADER);
     a_position_ = glGetAttribLocation(program_->id(), "a_position");
     a_normal_ = glGetAttribLocation(program_->id(), "a_normal");
@@ -124,9 +125,9 @@ void CubemapReflectionShader::render(const glm::mat4& mv_matrix,
         const glm::mat4& mv_it_matrix, const glm::mat4& view_invers_matrix,
         const glm::mat4& mvp_matrix, RenderData* render_data) {
     Mesh* mesh = render_data->mesh();
-    Texture* texture = render_data->material()->getTexture("main_texture");
-    glm::vec3 color = render_data->material()->getVec3("color");
-    float opacity = render_data->material()->getFloat("opacity");
+    Texture* texture = render_data->material()->getTexture(NAME_MAIN_TEXTURE);
+    glm::vec3 color = render_data->material()->getVec3(NAME_COLOR);
+    float opacity = render_data->material()->getFloat(NAME_OPACITY);
 
     if (texture->getTarget() != GL_TEXTURE_CUBE_MAP) {
         std::string error =
@@ -149,12 +150,14 @@ void CubemapReflectionShader::render(const glm::mat4& mv_matrix,
     glActiveTexture (GL_TEXTURE0);
     glBindTexture(texture->getTarget(), texture->getId());
     glUniform1i(u_texture_, 0);
-    glUniform3f(u_color_, color.r, color.g, color.b);
-    glUniform1f(u_opacity_, opacity);
+    if (render_data->material()->version() != material_version_) {
+        glUniform3f(u_color_, color.r, color.g, color.b);
+        glUniform1f(u_opacity_, opacity);
+        material_version_ = render_data->material()->version();
+    }
 
     glBindVertexArray(mesh->getVAOId(Material::CUBEMAP_REFLECTION_SHADER));
-    glDrawElements(GL_TRIANGLES, mesh->triangles().size(), GL_UNSIGNED_SHORT,
-            0);
+    render_data->drawElements(GL_TRIANGLES, 0);
     glBindVertexArray(0);
 #else
     glUseProgram(program_->id());
@@ -180,8 +183,7 @@ void CubemapReflectionShader::render(const glm::mat4& mv_matrix,
 
     glUniform1f(u_opacity_, opacity);
 
-    glDrawElements(GL_TRIANGLES, mesh->triangles().size(), GL_UNSIGNED_SHORT,
-            mesh->triangles().data());
+    render_data->drawElements(GL_TRIANGLES, mesh->triangles().data());
 #endif
 
     checkGlError("CubemapReflectionShader::render");
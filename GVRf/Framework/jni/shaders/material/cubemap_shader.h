@@ -54,6 +54,8 @@ private:
     GLuint u_texture_;
     GLuint u_color_;
     GLuint u_opacity_;
+    // material version color and opacity were last set from
+    unsigned int material_version_;
 };
 
 }
@@ -24,19 +24,84 @@
 #include "objects/mesh.h"
 #include "objects/textures/texture.h"
 #include "objects/components/render_data.h"
+#include "shaders/material/material_uniform_block.h"
+#include "shaders/material/transform_uniforms.h"
 #include "util/gvr_gl.h"
+#include "util/gvr_name_registry.h"
 
 namespace gvr {
 CustomShader::CustomShader(std::string vertex_shader,
         std::string fragment_shader) :
-        program_(0), a_position_(0), a_normal_(0), a_tex_coord_(0), u_mvp_(0), u_right_(
-                0), texture_keys_(), attribute_float_keys_(), attribute_vec2_keys_(), attribute_vec3_keys_(), attribute_vec4_keys_(), uniform_float_keys_(), uniform_vec2_keys_(), uniform_vec3_keys_(), uniform_vec4_keys_(), uniform_mat4_keys_() {
-    program_ = new GLProgram(vertex_shader.c_str(), fragment_shader.c_str());
+        program_(0), finished_(false), linked_(false), pending_keys_(), a_position_(0), a_normal_(0), a_tex_coord_(0), u_mvp_(0), u_right_(
+                0), material_block_(0), material_version_(0), uses_transform_block_(false), texture_keys_(), attribute_float_keys_(), attribute_vec2_keys_(), attribute_vec3_keys_(), attribute_vec4_keys_(), uniform_float_keys_(), uniform_vec2_keys_(), uniform_vec3_keys_(), uniform_vec4_keys_(), uniform_mat4_keys_() {
+    program_ = new GLProgram(vertex_shader.c_str(), fragment_shader.c_str(),
+            true);
+    poll(false);
+}
+
+bool CustomShader::poll(bool wait) {
+    if (finished_ || program_ == 0) {
+        return true;
+    }
+    if (!program_->poll(wait)) {
+        return false;
+    }
+    finished_ = true;
+    linked_ = program_->id() != 0;
+    if (linked_) {
+        initialize();
+    } else {
+        LOGE("CustomShader::poll() : program failed to link");
+    }
+    pending_keys_.clear();
+    return true;
+}
+
+bool CustomShader::needsWait() const {
+    return !finished_ && program_ != 0 && program_->needsWait();
+}
+
+void CustomShader::initialize() {
     a_position_ = glGetAttribLocation(program_->id(), "a_position");
     a_normal_ = glGetAttribLocation(program_->id(), "a_normal");
     a_tex_coord_ = glGetAttribLocation(program_->id(), "a_tex_coord");
     u_mvp_ = glGetUniformLocation(program_->id(), "u_mvp");
     u_right_ = glGetUniformLocation(program_->id(), "u_right");
+#if _GVRF_USE_GLES3_
+    material_block_ = MaterialUniformBlock::create(program_->id());
+
+    // the Frame and Transform blocks are streamed by the renderer
+    GLuint frame_block = glGetUniformBlockIndex(program_->id(),
+            FrameUniforms::blockName());
+    if (frame_block != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program_->id(), frame_block,
+                FrameUniforms::BINDING_POINT);
+    }
+    GLuint transform_block = glGetUniformBlockIndex(program_->id(),
+            TransformUniforms::blockName());
+    if (transform_block != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program_->id(), transform_block,
+                TransformUniforms::BINDING_POINT);
+        uses_transform_block_ = true;
+    }
+#endif
+
+    std::vector<PendingKey> pending_keys;
+    pending_keys.swap(pending_keys_);
+    for (auto it = pending_keys.begin(); it != pending_keys.end(); ++it) {
+        (this->*(it->add_key))(it->variable_name, it->key);
+    }
+}
+
+bool CustomShader::deferKey(
+        void (CustomShader::*add_key)(std::string, std::string),
+        const std::string& variable_name, const std::string& key) {
+    if (finished_) {
+        return false;
+    }
+    PendingKey pending_key = { add_key, variable_name, key };
+    pending_keys_.push_back(pending_key);
+    return true;
 }
 
 CustomShader::~CustomShader() {
@@ -48,65 +113,127 @@ CustomShader::~CustomShader() {
 void CustomShader::recycle() {
     delete program_;
     program_ = 0;
+    delete material_block_;
+    material_block_ = 0;
 }
 
 void CustomShader::addTextureKey(std::string variable_name, std::string key) {
+    if (deferKey(&CustomShader::addTextureKey, variable_name, key)) {
+        return;
+    }
     int location = glGetUniformLocation(program_->id(), variable_name.c_str());
-    texture_keys_[location] = key;
+    texture_keys_[location] = NameRegistry::intern(key);
 }
 
 void CustomShader::addAttributeFloatKey(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomShader::addAttributeFloatKey, variable_name, key)) {
+        return;
+    }
     int location = glGetAttribLocation(program_->id(), variable_name.c_str());
-    attribute_float_keys_[location] = key;
+    attribute_float_keys_[location] = NameRegistry::intern(key);
 }
 
 void CustomShader::addAttributeVec2Key(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomShader::addAttributeVec2Key, variable_name, key)) {
+        return;
+    }
     int location = glGetAttribLocation(program_->id(), variable_name.c_str());
-    attribute_vec2_keys_[location] = key;
+    attribute_vec2_keys_[location] = NameRegistry::intern(key);
 }
 
 void CustomShader::addAttributeVec3Key(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomShader::addAttributeVec3Key, variable_name, key)) {
+        return;
+    }
     int location = glGetAttribLocation(program_->id(), variable_name.c_str());
-    attribute_vec3_keys_[location] = key;
+    attribute_vec3_keys_[location] = NameRegistry::intern(key);
 }
 
 void CustomShader::addAttributeVec4Key(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomShader::addAttributeVec4Key, variable_name, key)) {
+        return;
+    }
     int location = glGetAttribLocation(program_->id(), variable_name.c_str());
-    attribute_vec4_keys_[location] = key;
+    attribute_vec4_keys_[location] = NameRegistry::intern(key);
 }
 
 void CustomShader::addUniformFloatKey(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomShader::addUniformFloatKey, variable_name, key)) {
+        return;
+    }
+    int handle = NameRegistry::intern(key);
+    if (material_block_ != 0
+            && material_block_->addKey(variable_name, handle)) {
+        return;
+    }
     int location = glGetUniformLocation(program_->id(), variable_name.c_str());
-    uniform_float_keys_[location] = key;
+    uniform_float_keys_[location] = handle;
+    material_version_ = 0;
 }
 
 void CustomShader::addUniformVec2Key(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomShader::addUniformVec2Key, variable_name, key)) {
+        return;
+    }
+    int handle = NameRegistry::intern(key);
+    if (material_block_ != 0
+            && material_block_->addKey(variable_name, handle)) {
+        return;
+    }
     int location = glGetUniformLocation(program_->id(), variable_name.c_str());
-    uniform_vec2_keys_[location] = key;
+    uniform_vec2_keys_[location] = handle;
+    material_version_ = 0;
 }
 
 void CustomShader::addUniformVec3Key(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomShader::addUniformVec3Key, variable_name, key)) {
+        return;
+    }
+    int handle = NameRegistry::intern(key);
+    if (material_block_ != 0
+            && material_block_->addKey(variable_name, handle)) {
+        return;
+    }
     int location = glGetUniformLocation(program_->id(), variable_name.c_str());
-    uniform_vec3_keys_[location] = key;
+    uniform_vec3_keys_[location] = handle;
+    material_version_ = 0;
 }
 
 void CustomShader::addUniformVec4Key(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomShader::addUniformVec4Key, variable_name, key)) {
+        return;
+    }
+    int handle = NameRegistry::intern(key);
+    if (material_block_ != 0
+            && material_block_->addKey(variable_name, handle)) {
+        return;
+    }
     int location = glGetUniformLocation(program_->id(), variable_name.c_str());
-    uniform_vec4_keys_[location] = key;
+    uniform_vec4_keys_[location] = handle;
+    material_version_ = 0;
 }
 
 void CustomShader::addUniformMat4Key(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomShader::addUniformMat4Key, variable_name, key)) {
+        return;
+    }
+    int handle = NameRegistry::intern(key);
+    if (material_block_ != 0
+            && material_block_->addKey(variable_name, handle)) {
+        return;
+    }
     int location = glGetUniformLocation(program_->id(), variable_name.c_str());
-    uniform_mat4_keys_[location] = key;
+    uniform_mat4_keys_[location] = handle;
+    material_version_ = 0;
 }
 
 void CustomShader::render(const glm::mat4& mvp_matrix, RenderData* render_data,
@@ -151,9 +278,43 @@ void CustomShader::render(const glm::mat4& mvp_matrix, RenderData* render_data,
     mesh->generateVAO(render_data->material()->shader_type());  // setup VAO
 
     ///////////// uniform /////////
-    for (auto it = uniform_float_keys_.begin(); it != uniform_float_keys_.end();
-            ++it) {
-        glUniform1f(it->first, render_data->material()->getFloat(it->second));
+    Material* material = render_data->material();
+    if (material_block_ != 0) {
+        material_block_->bind(material);
+    }
+
+    // uniforms keep their values in the program, so they only need setting
+    // when a different material, or a changed one, comes along
+    if (material->version() != material_version_) {
+        for (auto it = uniform_float_keys_.begin();
+                it != uniform_float_keys_.end(); ++it) {
+            glUniform1f(it->first, material->getFloat(it->second));
+        }
+
+        for (auto it = uniform_vec2_keys_.begin();
+                it != uniform_vec2_keys_.end(); ++it) {
+            glm::vec2 v = material->getVec2(it->second);
+            glUniform2f(it->first, v.x, v.y);
+        }
+
+        for (auto it = uniform_vec3_keys_.begin();
+                it != uniform_vec3_keys_.end(); ++it) {
+            glm::vec3 v = material->getVec3(it->second);
+            glUniform3f(it->first, v.x, v.y, v.z);
+        }
+
+        for (auto it = uniform_vec4_keys_.begin();
+                it != uniform_vec4_keys_.end(); ++it) {
+            glm::vec4 v = material->getVec4(it->second);
+            glUniform4f(it->first, v.x, v.y, v.z, v.w);
+        }
+
+        for (auto it = uniform_mat4_keys_.begin();
+                it != uniform_mat4_keys_.end(); ++it) {
+            glm::mat4 m = material->getMat4(it->second);
+            glUniformMatrix4fv(it->first, 1, GL_FALSE, glm::value_ptr(m));
+        }
+        material_version_ = material->version();
     }
 
     if (u_mvp_ != -1) {
@@ -171,33 +332,8 @@ void CustomShader::render(const glm::mat4& mvp_matrix, RenderData* render_data,
         glUniform1i(it->first, texture_index++);
     }
 
-    for (auto it = uniform_vec2_keys_.begin(); it != uniform_vec2_keys_.end();
-            ++it) {
-        glm::vec2 v = render_data->material()->getVec2(it->second);
-        glUniform2f(it->first, v.x, v.y);
-    }
-
-    for (auto it = uniform_vec3_keys_.begin(); it != uniform_vec3_keys_.end();
-            ++it) {
-        glm::vec3 v = render_data->material()->getVec3(it->second);
-        glUniform3f(it->first, v.x, v.y, v.z);
-    }
-
-    for (auto it = uniform_vec4_keys_.begin(); it != uniform_vec4_keys_.end();
-            ++it) {
-        glm::vec4 v = render_data->material()->getVec4(it->second);
-        glUniform4f(it->first, v.x, v.y, v.z, v.w);
-    }
-
-    for (auto it = uniform_mat4_keys_.begin(); it != uniform_mat4_keys_.end();
-            ++it) {
-        glm::mat4 m = render_data->material()->getMat4(it->second);
-        glUniformMatrix4fv(it->first, 1, GL_FALSE, glm::value_ptr(m));
-    }
-
     glBindVertexArray(mesh->getVAOId(render_data->material()->shader_type()));
-    glDrawElements(GL_TRIANGLES, mesh->triangles().size(), GL_UNSIGNED_SHORT,
-            0);
+    render_data->drawElements(GL_TRIANGLES, 0);
     glBindVertexArray(0);
 #else
     glUseProgram(program_->id());
@@ -295,8 +431,7 @@ void CustomShader::render(const glm::mat4& mvp_matrix, RenderData* render_data,
         glUniformMatrix4fv(it->first, 1, GL_FALSE, glm::value_ptr(m));
     }
 
-    glDrawElements(GL_TRIANGLES, mesh->triangles().size(), GL_UNSIGNED_SHORT,
-            mesh->triangles().data());
+    render_data->drawElements(GL_TRIANGLES, mesh->triangles().data());
 #endif
 
     checkGlError("CustomShader::render");
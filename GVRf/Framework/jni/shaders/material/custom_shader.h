@@ -24,6 +24,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "GLES3/gl3.h"
 #include "glm/glm.hpp"
@@ -35,6 +36,7 @@
 namespace gvr {
 
 class GLProgram;
+class MaterialUniformBlock;
 class RenderData;
 
 class CustomShader: public RecyclableObject {
@@ -56,29 +58,73 @@ public:
     void render(const glm::mat4& mvp_matrix, RenderData* render_data, bool right);
     static int getGLTexture(int n);
 
+    /*
+     * Whether the program finished linking, successfully or not; see
+     * GLProgram::poll(). Keys added before are applied then.
+     */
+    bool poll(bool wait);
+
+    // see GLProgram::needsWait()
+    bool needsWait() const;
+
+    // linked and usable for drawing
+    bool ready() const {
+        return program_ != 0 && linked_;
+    }
+
+    // done, but compiling or linking failed
+    bool failed() const {
+        return program_ != 0 && finished_ && !linked_;
+    }
+
+    // whether the program declares the Transform block
+    bool uses_transform_block() const {
+        return uses_transform_block_;
+    }
+
 private:
     CustomShader(const CustomShader& custom_shader);
     CustomShader(CustomShader&& custom_shader);
     CustomShader& operator=(const CustomShader& custom_shader);
     CustomShader& operator=(CustomShader&& custom_shader);
 
+    void initialize();
+    // queue a key for the linked program; false once it is linked
+    bool deferKey(void (CustomShader::*add_key)(std::string, std::string),
+            const std::string& variable_name, const std::string& key);
+
 private:
+    struct PendingKey {
+        void (CustomShader::*add_key)(std::string, std::string);
+        std::string variable_name;
+        std::string key;
+    };
+
     GLProgram* program_;
+    bool finished_;
+    bool linked_;
+    std::vector<PendingKey> pending_keys_;
     GLuint a_position_;
     GLuint a_normal_;
     GLuint a_tex_coord_;
     GLuint u_mvp_;
     GLuint u_right_;
-    std::map<int, std::string> texture_keys_;
-    std::map<int, std::string> attribute_float_keys_;
-    std::map<int, std::string> attribute_vec2_keys_;
-    std::map<int, std::string> attribute_vec3_keys_;
-    std::map<int, std::string> attribute_vec4_keys_;
-    std::map<int, std::string> uniform_float_keys_;
-    std::map<int, std::string> uniform_vec2_keys_;
-    std::map<int, std::string> uniform_vec3_keys_;
-    std::map<int, std::string> uniform_vec4_keys_;
-    std::map<int, std::string> uniform_mat4_keys_;
+    // members of the program's Material block, 0 without one
+    MaterialUniformBlock* material_block_;
+    // material version the plain uniforms were last set from
+    unsigned int material_version_;
+    bool uses_transform_block_;
+    // uniform or attribute location to NameRegistry handle
+    std::map<int, int> texture_keys_;
+    std::map<int, int> attribute_float_keys_;
+    std::map<int, int> attribute_vec2_keys_;
+    std::map<int, int> attribute_vec3_keys_;
+    std::map<int, int> attribute_vec4_keys_;
+    std::map<int, int> uniform_float_keys_;
+    std::map<int, int> uniform_vec2_keys_;
+    std::map<int, int> uniform_vec3_keys_;
+    std::map<int, int> uniform_vec4_keys_;
+    std::map<int, int> uniform_mat4_keys_;
 };
 
 }
@@ -75,8 +75,7 @@ void ErrorShader::render(const glm::mat4& mvp_matrix, RenderData* render_data) {
     glUniform4f(u_color_, r, g, b, a);
 
     glBindVertexArray(mesh->getVAOId(render_data->material()->shader_type()));
-    glDrawElements(GL_TRIANGLES, mesh->triangles().size(), GL_UNSIGNED_SHORT,
-            0);
+    render_data->drawElements(GL_TRIANGLES, 0);
     glBindVertexArray(0);
 #else
     glUseProgram(program_->id());
@@ -89,8 +88,7 @@ void ErrorShader::render(const glm::mat4& mvp_matrix, RenderData* render_data) {
 
     glUniform4f(u_color_, r, g, b, a);
 
-    glDrawElements(GL_TRIANGLES, mesh->triangles().size(), GL_UNSIGNED_SHORT,
-            mesh->triangles().data());
+    render_data->drawElements(GL_TRIANGLES, mesh->triangles().data());
 #endif
     checkGlError("ErrorShader::render");
 }
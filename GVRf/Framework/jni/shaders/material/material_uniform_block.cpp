@@ -0,0 +1,163 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Packs material values into a GLES3 uniform buffer laid out like the
+ * program's "Material" uniform block.
+ ***************************************************************************/
+
+#include "material_uniform_block.h"
+
+#include <cstring>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/type_ptr.hpp"
+
+#include "engine/memory/gl_name_pool.h"
+#include "objects/material.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+
+const char MaterialUniformBlock::BLOCK_NAME[] = "Material";
+const GLuint MaterialUniformBlock::BINDING_POINT;
+
+MaterialUniformBlock* MaterialUniformBlock::create(GLuint program) {
+    GLuint block_index = glGetUniformBlockIndex(program, BLOCK_NAME);
+    if (block_index == GL_INVALID_INDEX) {
+        return 0;
+    }
+    GLint size = 0;
+    glGetActiveUniformBlockiv(program, block_index,
+            GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+    return new MaterialUniformBlock(program, block_index, size);
+}
+
+MaterialUniformBlock::MaterialUniformBlock(GLuint program, GLuint block_index,
+        GLint size) :
+        program_(program), block_index_(block_index), layout_id_(0), revision_(
+                0), data_(size), members_() {
+    // buffers are created on the GL thread only
+    static int next_layout_id = 0;
+    layout_id_ = ++next_layout_id;
+    glUniformBlockBinding(program_, block_index_, BINDING_POINT);
+}
+
+bool MaterialUniformBlock::addKey(const std::string& variable_name,
+        int key) {
+    const char* name = variable_name.c_str();
+    GLuint index = GL_INVALID_INDEX;
+    glGetUniformIndices(program_, 1, &name, &index);
+    if (index == GL_INVALID_INDEX) {
+        return false;
+    }
+    GLint block_index = -1;
+    glGetActiveUniformsiv(program_, 1, &index, GL_UNIFORM_BLOCK_INDEX,
+            &block_index);
+    if (block_index != static_cast<GLint>(block_index_)) {
+        return false;
+    }
+
+    Member member;
+    GLint type = 0;
+    member.key = key;
+    glGetActiveUniformsiv(program_, 1, &index, GL_UNIFORM_TYPE, &type);
+    glGetActiveUniformsiv(program_, 1, &index, GL_UNIFORM_OFFSET,
+            &member.offset);
+    glGetActiveUniformsiv(program_, 1, &index, GL_UNIFORM_MATRIX_STRIDE,
+            &member.matrix_stride);
+    member.type = type;
+
+    switch (member.type) {
+    case GL_FLOAT:
+    case GL_FLOAT_VEC2:
+    case GL_FLOAT_VEC3:
+    case GL_FLOAT_VEC4:
+    case GL_FLOAT_MAT4:
+        members_.push_back(member);
+        break;
+    default:
+        LOGE("MaterialUniformBlock::addKey() : %s has an unsupported type",
+                name);
+        break;
+    }
+    // buffers packed without this member are stale now
+    ++revision_;
+    return true;
+}
+
+void MaterialUniformBlock::pack(Material* material) {
+    unsigned char* data = data_.data();
+    for (auto it = members_.begin(); it != members_.end(); ++it) {
+        unsigned char* destination = data + it->offset;
+        switch (it->type) {
+        case GL_FLOAT: {
+            float value = material->getFloat(it->key);
+            memcpy(destination, &value, sizeof(value));
+            break;
+        }
+        case GL_FLOAT_VEC2: {
+            glm::vec2 value = material->getVec2(it->key);
+            memcpy(destination, glm::value_ptr(value), sizeof(value));
+            break;
+        }
+        case GL_FLOAT_VEC3: {
+            glm::vec3 value = material->getVec3(it->key);
+            memcpy(destination, glm::value_ptr(value), sizeof(value));
+            break;
+        }
+        case GL_FLOAT_VEC4: {
+            glm::vec4 value = material->getVec4(it->key);
+            memcpy(destination, glm::value_ptr(value), sizeof(value));
+            break;
+        }
+        case GL_FLOAT_MAT4: {
+            glm::mat4 value = material->getMat4(it->key);
+            for (int column = 0; column < 4; ++column) {
+                memcpy(destination + column * it->matrix_stride,
+                        glm::value_ptr(value[column]), sizeof(glm::vec4));
+            }
+            break;
+        }
+        }
+    }
+}
+
+void MaterialUniformBlock::bind(Material* material) {
+    Material::UniformBuffer& buffer = material->uniform_buffer(layout_id_);
+    if (buffer.version != material->version()
+            || buffer.revision != revision_) {
+        pack(material);
+        if (buffer.id == 0) {
+            buffer.id = gl_name_pool.createBuffer(GL_UNIFORM_BUFFER,
+                    data_.size(), data_.data(), GL_DYNAMIC_DRAW,
+                    &buffer.capacity);
+        } else if (static_cast<GLsizeiptr>(data_.size()) > buffer.capacity) {
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer.id);
+            glBufferData(GL_UNIFORM_BUFFER, data_.size(), data_.data(),
+                    GL_DYNAMIC_DRAW);
+            buffer.capacity = data_.size();
+        } else {
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer.id);
+            glBufferSubData(GL_UNIFORM_BUFFER, 0, data_.size(), data_.data());
+        }
+        buffer.version = material->version();
+        buffer.revision = revision_;
+    }
+    glBindBufferRange(GL_UNIFORM_BUFFER, BINDING_POINT, buffer.id, 0,
+            data_.size());
+}
+
+}
@@ -0,0 +1,82 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Packs material values into a GLES3 uniform buffer laid out like the
+ * program's "Material" uniform block.
+ ***************************************************************************/
+
+#ifndef MATERIAL_UNIFORM_BLOCK_H_
+#define MATERIAL_UNIFORM_BLOCK_H_
+
+#include <string>
+#include <vector>
+
+#include "GLES3/gl3.h"
+
+namespace gvr {
+class Material;
+
+class MaterialUniformBlock {
+public:
+    // the block a shader declares for its material values, e.g.
+    // layout(std140) uniform Material { vec3 u_color; float u_opacity; };
+    static const char BLOCK_NAME[];
+    static const GLuint BINDING_POINT = 0;
+
+    // 0 if the program has no material block
+    static MaterialUniformBlock* create(GLuint program);
+
+    /*
+     * Fill the block member variable_name from the material value key.
+     * Returns false if the member is not in the block, in which case the
+     * caller sets it as a plain uniform.
+     */
+    bool addKey(const std::string& variable_name, int key);
+
+    /*
+     * Bind the material's buffer for this layout, packing and uploading it
+     * first only if the material changed since the last upload.
+     */
+    void bind(Material* material);
+
+private:
+    struct Member {
+        int key;
+        GLenum type;
+        GLint offset;
+        GLint matrix_stride;
+    };
+
+    MaterialUniformBlock(GLuint program, GLuint block_index, GLint size);
+
+    void pack(Material* material);
+
+    MaterialUniformBlock(const MaterialUniformBlock& block);
+    MaterialUniformBlock(MaterialUniformBlock&& block);
+    MaterialUniformBlock& operator=(const MaterialUniformBlock& block);
+    MaterialUniformBlock& operator=(MaterialUniformBlock&& block);
+
+private:
+    GLuint program_;
+    GLuint block_index_;
+    int layout_id_;
+    int revision_;
+    std::vector<unsigned char> data_;
+    std::vector<Member> members_;
+};
+
+}
+#endif
@@ -0,0 +1,64 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Matrices the renderer streams to shaders through uniform blocks.
+ ***************************************************************************/
+
+#ifndef TRANSFORM_UNIFORMS_H_
+#define TRANSFORM_UNIFORMS_H_
+
+#include "GLES3/gl3.h"
+#include "glm/glm.hpp"
+
+namespace gvr {
+
+/*
+ * Written once per eye. A GLSL ES 3.00 shader reads it by declaring
+ * layout(std140) uniform Frame { mat4 u_view; mat4 u_projection;
+ *         mat4 u_view_i; };
+ */
+struct FrameUniforms {
+    static const char* blockName() {
+        return "Frame";
+    }
+    static const GLuint BINDING_POINT = 1;
+
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 view_inverse;
+};
+
+/*
+ * Written for each object drawn, in one pass after culling. A GLSL ES 3.00
+ * shader reads it by declaring
+ * layout(std140) uniform Transform { mat4 u_model; mat4 u_mv; mat4 u_mvp;
+ *         mat4 u_mv_it; };
+ * u_mv_it is only filled for the reflection and custom shaders.
+ */
+struct TransformUniforms {
+    static const char* blockName() {
+        return "Transform";
+    }
+    static const GLuint BINDING_POINT = 2;
+
+    glm::mat4 model;
+    glm::mat4 mv;
+    glm::mat4 mvp;
+    glm::mat4 mv_inverse_transpose;
+};
+
+}
+#endif
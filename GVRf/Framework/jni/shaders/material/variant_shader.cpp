@@ -0,0 +1,265 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Renders a texture without light, in every variant of the stock unlit
+ * and OES shaders.
+ ***************************************************************************/
+
+#include "variant_shader.h"
+
+#include <string>
+
+#include "gl/gl_program.h"
+#include "objects/material.h"
+#include "objects/mesh.h"
+#include "objects/components/render_data.h"
+#include "objects/textures/texture.h"
+#include "util/gvr_gl.h"
+
+namespace gvr {
+static const char VERTEX_SHADER[] = "attribute vec4 a_position;\n"
+        "attribute vec4 a_tex_coord;\n"
+        "uniform mat4 u_mvp;\n"
+        "#if defined(HORIZONTAL_STEREO) || defined(VERTICAL_STEREO)\n"
+        "uniform int u_right;\n"
+        "#endif\n"
+        "#ifdef UV_TRANSFORM\n"
+        "uniform vec4 u_uv_transform;\n"
+        "#endif\n"
+        "varying vec2 v_tex_coord;\n"
+        "void main() {\n"
+        "#if defined(HORIZONTAL_STEREO)\n"
+        "  vec2 tex_coord = vec2(0.5 * (a_tex_coord.x + float(u_right)), a_tex_coord.y);\n"
+        "#elif defined(VERTICAL_STEREO)\n"
+        "  vec2 tex_coord = vec2(a_tex_coord.x, 0.5 * (a_tex_coord.y + float(u_right)));\n"
+        "#else\n"
+        "  vec2 tex_coord = a_tex_coord.xy;\n"
+        "#endif\n"
+        "#ifdef UV_TRANSFORM\n"
+        "  v_tex_coord = tex_coord * u_uv_transform.xy + u_uv_transform.zw;\n"
+        "#else\n"
+        "  v_tex_coord = tex_coord;\n"
+        "#endif\n"
+        "  gl_Position = u_mvp * a_position;\n"
+        "}\n";
+
+static const char FRAGMENT_SHADER[] = "#ifdef OES\n"
+        "#extension GL_OES_EGL_image_external : require\n"
+        "#endif\n"
+        "precision highp float;\n"
+        "#ifdef OES\n"
+        "uniform samplerExternalOES u_texture;\n"
+        "#else\n"
+        "uniform sampler2D u_texture;\n"
+        "#endif\n"
+        "#ifdef TINT\n"
+        "uniform vec3 u_color;\n"
+        "uniform float u_opacity;\n"
+        "#endif\n"
+        "varying vec2 v_tex_coord;\n"
+        "void main()\n"
+        "{\n"
+        "  vec4 color = texture2D(u_texture, v_tex_coord);\n"
+        "#ifdef TINT\n"
+        "  gl_FragColor = vec4(color.rgb * u_color * u_opacity, color.a * u_opacity);\n"
+        "#else\n"
+        "  gl_FragColor = color;\n"
+        "#endif\n"
+        "}\n";
+
+static const char* KEYWORD_NAMES[] = { "OES", "HORIZONTAL_STEREO",
+        "VERTICAL_STEREO", "TINT", "UV_TRANSFORM" };
+static const int KEYWORD_COUNT = sizeof(KEYWORD_NAMES)
+        / sizeof(KEYWORD_NAMES[0]);
+
+static const char* ATTRIBUTE_NAMES[] = { "a_position", "a_tex_coord" };
+
+const GLuint VariantShader::POSITION_LOCATION;
+const GLuint VariantShader::TEX_COORD_LOCATION;
+
+VariantShader::VariantShader() :
+        variants_() {
+}
+
+VariantShader::~VariantShader() {
+    recycle();
+}
+
+void VariantShader::recycle() {
+    for (auto it = variants_.begin(); it != variants_.end(); ++it) {
+        delete it->second.program;
+    }
+    variants_.clear();
+}
+
+bool VariantShader::handles(int shader_type) {
+    return shader_type >= Material::UNLIT_SHADER
+            && shader_type <= Material::OES_VERTICAL_STEREO_SHADER;
+}
+
+unsigned int VariantShader::keywords(Material* material) {
+    unsigned int keywords = 0;
+    switch (material->shader_type()) {
+    case Material::UNLIT_HORIZONTAL_STEREO_SHADER:
+        keywords = HORIZONTAL_STEREO;
+        break;
+    case Material::UNLIT_VERTICAL_STEREO_SHADER:
+        keywords = VERTICAL_STEREO;
+        break;
+    case Material::OES_SHADER:
+        keywords = OES;
+        break;
+    case Material::OES_HORIZONTAL_STEREO_SHADER:
+        keywords = OES | HORIZONTAL_STEREO;
+        break;
+    case Material::OES_VERTICAL_STEREO_SHADER:
+        keywords = OES | VERTICAL_STEREO;
+        break;
+    default:
+        break;
+    }
+    if (material->getVec3(NAME_COLOR) != glm::vec3(1.0f, 1.0f, 1.0f)
+            || material->getFloat(NAME_OPACITY) != 1.0f) {
+        keywords |= TINT;
+    }
+    const glm::vec4* uv_transform = material->findVec4(NAME_UV_TRANSFORM);
+    if (uv_transform != 0
+            && *uv_transform != glm::vec4(1.0f, 1.0f, 0.0f, 0.0f)) {
+        keywords |= UV_TRANSFORM;
+    }
+    return keywords;
+}
+
+VariantShader::Variant& VariantShader::variant(unsigned int keywords) {
+    auto it = variants_.find(keywords);
+    if (it != variants_.end()) {
+        return it->second;
+    }
+
+    std::string defines;
+    for (int i = 0; i < KEYWORD_COUNT; ++i) {
+        if (keywords & (1u << i)) {
+            defines += std::string("#define ") + KEYWORD_NAMES[i] + "\n";
+        }
+    }
+    std::string vertex_shader = defines + VERTEX_SHADER;
+    std::string fragment_shader = defines + FRAGMENT_SHADER;
+
+    Variant& variant = variants_[keywords];
+    variant.program = new GLProgram(vertex_shader.c_str(),
+            fragment_shader.c_str(), ATTRIBUTE_NAMES,
+            sizeof(ATTRIBUTE_NAMES) / sizeof(ATTRIBUTE_NAMES[0]));
+    GLuint id = variant.program->id();
+    variant.u_mvp = glGetUniformLocation(id, "u_mvp");
+    variant.u_texture = glGetUniformLocation(id, "u_texture");
+    variant.u_color = glGetUniformLocation(id, "u_color");
+    variant.u_opacity = glGetUniformLocation(id, "u_opacity");
+    variant.u_right = glGetUniformLocation(id, "u_right");
+    variant.u_uv_transform = glGetUniformLocation(id, "u_uv_transform");
+    variant.material_version = 0;
+    return variant;
+}
+
+void VariantShader::render(const glm::mat4& mvp_matrix,
+        RenderData* render_data, unsigned int keywords, bool right) {
+    Mesh* mesh = render_data->mesh();
+    Material* material = render_data->material();
+    Texture* texture = material->getTexture(NAME_MAIN_TEXTURE);
+
+    GLenum target = (keywords & OES) ? GL_TEXTURE_EXTERNAL_OES : GL_TEXTURE_2D;
+    if (texture->getTarget() != target) {
+        std::string error = "VariantShader::render : texture with wrong target";
+        throw error;
+    }
+
+    if (texture->getId() == 0) {
+        std::string error = "VariantShader::render : texture with invalid Id";
+        throw error;
+    }
+
+    Variant& variant = this->variant(keywords);
+
+#if _GVRF_USE_GLES3_
+    mesh->setVertexLoc(POSITION_LOCATION);
+    mesh->setTexCoordLoc(TEX_COORD_LOCATION);
+    mesh->generateVAO(Material::UNLIT_SHADER);
+
+    glUseProgram(variant.program->id());
+
+    glUniformMatrix4fv(variant.u_mvp, 1, GL_FALSE, glm::value_ptr(mvp_matrix));
+    glActiveTexture (GL_TEXTURE0);
+    glBindTexture(texture->getTarget(), texture->getId());
+    glUniform1i(variant.u_texture, 0);
+    if ((keywords & (TINT | UV_TRANSFORM))
+            && material->version() != variant.material_version) {
+        if (keywords & TINT) {
+            glm::vec3 color = material->getVec3(NAME_COLOR);
+            glUniform3f(variant.u_color, color.r, color.g, color.b);
+            glUniform1f(variant.u_opacity, material->getFloat(NAME_OPACITY));
+        }
+        if (keywords & UV_TRANSFORM) {
+            glUniform4fv(variant.u_uv_transform, 1,
+                    glm::value_ptr(material->getVec4(NAME_UV_TRANSFORM)));
+        }
+        variant.material_version = material->version();
+    }
+    if (keywords & (HORIZONTAL_STEREO | VERTICAL_STEREO)) {
+        glUniform1i(variant.u_right, right ? 1 : 0);
+    }
+
+    glBindVertexArray(mesh->getVAOId(Material::UNLIT_SHADER));
+    render_data->drawElements(render_data->draw_mode(), 0);
+    glBindVertexArray(0);
+#else
+    glUseProgram(variant.program->id());
+
+    glVertexAttribPointer(POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, 0,
+            mesh->vertices().data());
+    glEnableVertexAttribArray(POSITION_LOCATION);
+
+    glVertexAttribPointer(TEX_COORD_LOCATION, 2, GL_FLOAT, GL_FALSE, 0,
+            mesh->tex_coords().data());
+    glEnableVertexAttribArray(TEX_COORD_LOCATION);
+
+    glUniformMatrix4fv(variant.u_mvp, 1, GL_FALSE, glm::value_ptr(mvp_matrix));
+
+    glActiveTexture (GL_TEXTURE0);
+    glBindTexture(texture->getTarget(), texture->getId());
+    glUniform1i(variant.u_texture, 0);
+
+    if (keywords & TINT) {
+        glm::vec3 color = material->getVec3(NAME_COLOR);
+        glUniform3f(variant.u_color, color.r, color.g, color.b);
+        glUniform1f(variant.u_opacity, material->getFloat(NAME_OPACITY));
+    }
+
+    if (keywords & UV_TRANSFORM) {
+        glUniform4fv(variant.u_uv_transform, 1,
+                glm::value_ptr(material->getVec4(NAME_UV_TRANSFORM)));
+    }
+
+    if (keywords & (HORIZONTAL_STEREO | VERTICAL_STEREO)) {
+        glUniform1i(variant.u_right, right ? 1 : 0);
+    }
+
+    render_data->drawElements(render_data->draw_mode(),
+            mesh->triangles().data());
+#endif
+
+    checkGlError("VariantShader::render");
+}
+
+}
@@ -0,0 +1,103 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Renders a texture without light, in every variant of the stock unlit
+ * and OES shaders.
+ ***************************************************************************/
+
+#ifndef VARIANT_SHADER_H_
+#define VARIANT_SHADER_H_
+
+#include <map>
+
+#include "GLES3/gl3.h"
+#include "glm/glm.hpp"
+#include "glm/gtc/type_ptr.hpp"
+
+#include "objects/recyclable_object.h"
+
+namespace gvr {
+class GLProgram;
+class Material;
+class RenderData;
+
+/*
+ * One shader source with feature keywords, each one a #define in the
+ * program built for it. A program is compiled the first time a
+ * combination is drawn, and kept by keyword mask.
+ */
+class VariantShader: public RecyclableObject {
+public:
+    enum Keyword {
+        // the main texture is a samplerExternalOES
+        OES = 1 << 0,
+        // each eye sees one half of the texture, side by side
+        HORIZONTAL_STEREO = 1 << 1,
+        // each eye sees one half of the texture, top and bottom
+        VERTICAL_STEREO = 1 << 2,
+        // multiplied by u_color and u_opacity; left out while those are
+        // white and opaque
+        TINT = 1 << 3,
+        // texture coordinates scaled by the material's uv_transform.xy and
+        // offset by its .zw, to address one region of an atlas page
+        UV_TRANSFORM = 1 << 4
+    };
+
+    VariantShader();
+    ~VariantShader();
+    void recycle();
+
+    // whether materials of this shader type are drawn by this shader
+    static bool handles(int shader_type);
+
+    // the keywords a material needs
+    static unsigned int keywords(Material* material);
+
+    void render(const glm::mat4& mvp_matrix, RenderData* render_data,
+            unsigned int keywords, bool right);
+
+private:
+    VariantShader(const VariantShader& variant_shader);
+    VariantShader(VariantShader&& variant_shader);
+    VariantShader& operator=(const VariantShader& variant_shader);
+    VariantShader& operator=(VariantShader&& variant_shader);
+
+private:
+    struct Variant {
+        GLProgram* program;
+        GLint u_mvp;
+        GLint u_texture;
+        GLint u_color;
+        GLint u_opacity;
+        GLint u_right;
+        GLint u_uv_transform;
+        // material version the material uniforms were last set from
+        unsigned int material_version;
+    };
+
+    Variant& variant(unsigned int keywords);
+
+private:
+    // every variant binds its attributes to these locations, so a mesh
+    // needs only one VAO for all of them
+    static const GLuint POSITION_LOCATION = 0;
+    static const GLuint TEX_COORD_LOCATION = 1;
+    std::map<unsigned int, Variant> variants_;
+};
+
+}
+
+#endif
@@ -20,6 +20,9 @@
 #ifndef POST_EFFECT_SHADER_MANAGER_H_
 #define POST_EFFECT_SHADER_MANAGER_H_
 
+#include <list>
+
+#include "gl/gl_program.h"
 #include "objects/hybrid_object.h"
 #include "shaders/posteffect/color_blend_post_effect_shader.h"
 #include "shaders/posteffect/horizontal_flip_post_effect_shader.h"
@@ -31,7 +34,7 @@ class PostEffectShaderManager: public HybridObject {
 public:
     PostEffectShaderManager() :
             HybridObject(), color_blend_post_effect_shader_(), horizontal_flip_post_effect_shader_(), latest_custom_shader_id_(
-                    INITIAL_CUSTOM_SHADER_INDEX), custom_post_effect_shaders_(), quad_vertices_(), quad_uvs_(), quad_triangles_() {
+                    INITIAL_CUSTOM_SHADER_INDEX), custom_post_effect_shaders_(), pending_custom_post_effect_shaders_(), quad_vertices_(), quad_uvs_(), quad_triangles_() {
         quad_vertices_.push_back(glm::vec3(-1.0f, -1.0f, 0.0f));
         quad_vertices_.push_back(glm::vec3(-1.0f, 1.0f, 0.0f));
         quad_vertices_.push_back(glm::vec3(1.0f, -1.0f, 0.0f));
@@ -78,9 +81,28 @@ public:
         CustomPostEffectShader* custom_post_effect_shader =
                 new CustomPostEffectShader(vertex_shader, fragment_shader);
         custom_post_effect_shaders_[id] = custom_post_effect_shader;
+        if (!custom_post_effect_shader->poll(false)) {
+            pending_custom_post_effect_shaders_.push_back(
+                    custom_post_effect_shader);
+        }
         return id;
     }
 
+    // see ShaderManager::update()
+    void update() {
+        bool waited = false;
+        for (auto it = pending_custom_post_effect_shaders_.begin();
+                it != pending_custom_post_effect_shaders_.end();) {
+            bool wait = !waited && (*it)->needsWait();
+            waited = waited || wait;
+            if ((*it)->poll(wait)) {
+                it = pending_custom_post_effect_shaders_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
     CustomPostEffectShader* getCustomPostEffectShader(int id) {
         auto it = custom_post_effect_shaders_.find(id);
         if (it != custom_post_effect_shaders_.end()) {
@@ -119,6 +141,7 @@ private:
     HorizontalFlipPostEffectShader* horizontal_flip_post_effect_shader_;
     int latest_custom_shader_id_;
     std::map<int, CustomPostEffectShader*> custom_post_effect_shaders_;
+    std::list<CustomPostEffectShader*> pending_custom_post_effect_shaders_;
     std::vector<glm::vec3> quad_vertices_;
     std::vector<glm::vec2> quad_uvs_;
     std::vector<unsigned short> quad_triangles_;
@@ -34,6 +34,9 @@ Java_org_gearvrf_NativePostEffectShaderManager_addCustomPostEffectShader(
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativePostEffectShaderManager_getCustomPostEffectShader(
         JNIEnv * env, jobject obj, jlong jpost_effect_shader_manager, jint id);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativePostEffectShaderManager_getCustomPostEffectShaderStatus(
+        JNIEnv * env, jobject obj, jlong jpost_effect_shader_manager, jint id);
 
 JNIEXPORT void JNICALL
 Java_org_gearvrf_NativePostEffectShaderManager_delete(
@@ -81,6 +84,22 @@ Java_org_gearvrf_NativePostEffectShaderManager_getCustomPostEffectShader(
     }
 }
 
+// 0 while compiling, 1 when linked and -1 when that failed
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativePostEffectShaderManager_getCustomPostEffectShaderStatus(
+        JNIEnv * env, jobject obj, jlong jpost_effect_shader_manager, jint id) {
+    PostEffectShaderManager* post_effect_shader_manager =
+            reinterpret_cast<PostEffectShaderManager*>(jpost_effect_shader_manager);
+    try {
+        CustomPostEffectShader* custom_post_effect_shader =
+                post_effect_shader_manager->getCustomPostEffectShader(id);
+        return custom_post_effect_shader->ready() ?
+                1 : custom_post_effect_shader->failed() ? -1 : 0;
+    } catch (char const *c) {
+        return -1;
+    }
+}
+
 JNIEXPORT void JNICALL
 Java_org_gearvrf_NativePostEffectShaderManager_delete(
         JNIEnv * env, jobject obj, jlong jpost_effect_shader_manager) {
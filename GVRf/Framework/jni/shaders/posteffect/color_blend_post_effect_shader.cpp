@@ -25,6 +25,7 @@
 #include "objects/textures/render_texture.h"
 #include "util/gvr_gl.h"
 #include "engine/memory/gl_delete.h"
+#include "engine/memory/gl_name_pool.h"
 
 namespace gvr {
 static const char VERTEX_SHADER[] = "attribute vec4 a_position;\n"
@@ -57,6 +58,10 @@ ColorBlendPostEffectShader::ColorBlendPostEffectShader() :
     u_color_ = glGetUniformLocation(program_->id(), "u_color");
     u_factor_ = glGetUniformLocation(program_->id(), "u_factor");
     vaoID_ = 0;
+    for (int i = 0; i < VBO_COUNT; ++i) {
+        vboIDs_[i] = 0;
+        vboCapacities_[i] = 0;
+    }
 }
 
 ColorBlendPostEffectShader::~ColorBlendPostEffectShader() {
@@ -67,6 +72,13 @@ ColorBlendPostEffectShader::~ColorBlendPostEffectShader() {
     	gl_delete.queueVertexArray(vaoID_);
     	vaoID_ = 0;
     }
+    for (int i = 0; i < VBO_COUNT; ++i) {
+        if (vboIDs_[i] != 0) {
+            gl_delete.queueBuffer(vboIDs_[i], GL_STATIC_DRAW,
+                    vboCapacities_[i]);
+            vboIDs_[i] = 0;
+        }
+    }
 }
 
 void ColorBlendPostEffectShader::recycle() {
@@ -79,39 +91,31 @@ void ColorBlendPostEffectShader::render(
         PostEffectData* post_effect_data,
         std::vector<glm::vec3>& vertices, std::vector<glm::vec2>& tex_coords,
         std::vector<unsigned short>& triangles) {
-    float r = post_effect_data->getFloat("r");
-    float g = post_effect_data->getFloat("g");
-    float b = post_effect_data->getFloat("b");
-    float factor = post_effect_data->getFloat("factor");
+    float r = post_effect_data->getFloat(NAME_R);
+    float g = post_effect_data->getFloat(NAME_G);
+    float b = post_effect_data->getFloat(NAME_B);
+    float factor = post_effect_data->getFloat(NAME_FACTOR);
 
     glUseProgram(program_->id());
 
 #if _GVRF_USE_GLES3_
-    GLuint tmpID;
-
     if(vaoID_ == 0)
     {
-        glGenVertexArrays(1, &vaoID_);
+        vaoID_ = gl_name_pool.genVertexArray();
         glBindVertexArray(vaoID_);
 
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short)*triangles.size(), &triangles[0], GL_STATIC_DRAW);
+        vboIDs_[0] = gl_name_pool.createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short)*triangles.size(), &triangles[0], GL_STATIC_DRAW, &vboCapacities_[0]);
 
         if (vertices.size())
         {
-            glGenBuffers(1, &tmpID);
-            glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec3)*vertices.size(), &vertices[0], GL_STATIC_DRAW);
+            vboIDs_[1] = gl_name_pool.createBuffer(GL_ARRAY_BUFFER, sizeof(glm::vec3)*vertices.size(), &vertices[0], GL_STATIC_DRAW, &vboCapacities_[1]);
             glEnableVertexAttribArray(a_position_);
             glVertexAttribPointer(a_position_, 3, GL_FLOAT, 0, 0, 0);
         }
 
         if (tex_coords.size())
         {
-            glGenBuffers(1, &tmpID);
-            glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*tex_coords.size(), &tex_coords[0], GL_STATIC_DRAW);
+            vboIDs_[2] = gl_name_pool.createBuffer(GL_ARRAY_BUFFER, sizeof(glm::vec2)*tex_coords.size(), &tex_coords[0], GL_STATIC_DRAW, &vboCapacities_[2]);
             glEnableVertexAttribArray(a_tex_coord_);
             glVertexAttribPointer(a_tex_coord_, 2, GL_FLOAT, 0, 0, 0);
         }
@@ -65,6 +65,10 @@ private:
 
     // add vertex array object
     GLuint vaoID_;
+    // triangles, vertices and texture coordinates
+    static const int VBO_COUNT = 3;
+    GLuint vboIDs_[VBO_COUNT];
+    GLsizeiptr vboCapacities_[VBO_COUNT];
 };
 
 }
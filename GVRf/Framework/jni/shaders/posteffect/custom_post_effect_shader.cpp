@@ -25,14 +25,48 @@
 #include "objects/components/render_data.h"
 #include "objects/textures/render_texture.h"
 #include "util/gvr_gl.h"
+#include "util/gvr_name_registry.h"
 #include "engine/memory/gl_delete.h"
+#include "engine/memory/gl_name_pool.h"
 
 
 namespace gvr {
 CustomPostEffectShader::CustomPostEffectShader(std::string vertex_shader,
         std::string fragment_shader) :
-        program_(0), a_position_(0), a_tex_coord_(0), u_texture_(0), texture_keys_(), float_keys_(), vec2_keys_(), vec3_keys_(), vec4_keys_(), mat4_keys_() {
-    program_ = new GLProgram(vertex_shader.c_str(), fragment_shader.c_str());
+        program_(0), finished_(false), linked_(false), pending_keys_(), a_position_(0), a_tex_coord_(0), u_texture_(0), texture_keys_(), float_keys_(), vec2_keys_(), vec3_keys_(), vec4_keys_(), mat4_keys_() {
+    program_ = new GLProgram(vertex_shader.c_str(), fragment_shader.c_str(),
+            true);
+    vaoID_ = 0;
+    for (int i = 0; i < VBO_COUNT; ++i) {
+        vboIDs_[i] = 0;
+        vboCapacities_[i] = 0;
+    }
+    poll(false);
+}
+
+bool CustomPostEffectShader::poll(bool wait) {
+    if (finished_ || program_ == 0) {
+        return true;
+    }
+    if (!program_->poll(wait)) {
+        return false;
+    }
+    finished_ = true;
+    linked_ = program_->id() != 0;
+    if (linked_) {
+        initialize();
+    } else {
+        LOGE("CustomPostEffectShader::poll() : program failed to link");
+    }
+    pending_keys_.clear();
+    return true;
+}
+
+bool CustomPostEffectShader::needsWait() const {
+    return !finished_ && program_ != 0 && program_->needsWait();
+}
+
+void CustomPostEffectShader::initialize() {
     a_position_ = glGetAttribLocation(program_->id(), "a_position");
     checkGlError("glGetAttribLocation");
     a_tex_coord_ = glGetAttribLocation(program_->id(), "a_tex_coord");
@@ -44,8 +78,22 @@ CustomPostEffectShader::CustomPostEffectShader(std::string vertex_shader,
     u_right_eye_ = glGetUniformLocation(program_->id(), "u_right_eye");
     checkGlError("glGetUniformLocation");
 
-    vaoID_ = 0;
+    std::vector<PendingKey> pending_keys;
+    pending_keys.swap(pending_keys_);
+    for (auto it = pending_keys.begin(); it != pending_keys.end(); ++it) {
+        (this->*(it->add_key))(it->variable_name, it->key);
+    }
+}
 
+bool CustomPostEffectShader::deferKey(
+        void (CustomPostEffectShader::*add_key)(std::string, std::string),
+        const std::string& variable_name, const std::string& key) {
+    if (finished_) {
+        return false;
+    }
+    PendingKey pending_key = { add_key, variable_name, key };
+    pending_keys_.push_back(pending_key);
+    return true;
 }
 
 CustomPostEffectShader::~CustomPostEffectShader() {
@@ -57,6 +105,13 @@ CustomPostEffectShader::~CustomPostEffectShader() {
     	gl_delete.queueVertexArray(vaoID_);
     	vaoID_ = 0;
     }
+    for (int i = 0; i < VBO_COUNT; ++i) {
+        if (vboIDs_[i] != 0) {
+            gl_delete.queueBuffer(vboIDs_[i], GL_STATIC_DRAW,
+                    vboCapacities_[i]);
+            vboIDs_[i] = 0;
+        }
+    }
 }
 
 void CustomPostEffectShader::recycle() {
@@ -66,37 +121,55 @@ void CustomPostEffectShader::recycle() {
 
 void CustomPostEffectShader::addTextureKey(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomPostEffectShader::addTextureKey, variable_name, key)) {
+        return;
+    }
     int location = glGetUniformLocation(program_->id(), variable_name.c_str());
-    texture_keys_[location] = key;
+    texture_keys_[location] = NameRegistry::intern(key);
 }
 
 void CustomPostEffectShader::addFloatKey(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomPostEffectShader::addFloatKey, variable_name, key)) {
+        return;
+    }
     int location = glGetUniformLocation(program_->id(), variable_name.c_str());
-    float_keys_[location] = key;
+    float_keys_[location] = NameRegistry::intern(key);
 }
 void CustomPostEffectShader::addVec2Key(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomPostEffectShader::addVec2Key, variable_name, key)) {
+        return;
+    }
     int location = glGetUniformLocation(program_->id(), variable_name.c_str());
-    vec2_keys_[location] = key;
+    vec2_keys_[location] = NameRegistry::intern(key);
 }
 
 void CustomPostEffectShader::addVec3Key(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomPostEffectShader::addVec3Key, variable_name, key)) {
+        return;
+    }
     int location = glGetUniformLocation(program_->id(), variable_name.c_str());
-    vec3_keys_[location] = key;
+    vec3_keys_[location] = NameRegistry::intern(key);
 }
 
 void CustomPostEffectShader::addVec4Key(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomPostEffectShader::addVec4Key, variable_name, key)) {
+        return;
+    }
     int location = glGetUniformLocation(program_->id(), variable_name.c_str());
-    vec4_keys_[location] = key;
+    vec4_keys_[location] = NameRegistry::intern(key);
 }
 
 void CustomPostEffectShader::addMat4Key(std::string variable_name,
         std::string key) {
+    if (deferKey(&CustomPostEffectShader::addMat4Key, variable_name, key)) {
+        return;
+    }
     int location = glGetUniformLocation(program_->id(), variable_name.c_str());
-    mat4_keys_[location] = key;
+    mat4_keys_[location] = NameRegistry::intern(key);
 }
 
 void CustomPostEffectShader::render(Camera* camera,
@@ -107,31 +180,23 @@ void CustomPostEffectShader::render(Camera* camera,
     glUseProgram(program_->id());
 
 #if _GVRF_USE_GLES3_
-    GLuint tmpID;
-
     if(vaoID_ == 0)
     {
-        glGenVertexArrays(1, &vaoID_);
+        vaoID_ = gl_name_pool.genVertexArray();
         glBindVertexArray(vaoID_);
 
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short)*triangles.size(), &triangles[0], GL_STATIC_DRAW);
+        vboIDs_[0] = gl_name_pool.createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short)*triangles.size(), &triangles[0], GL_STATIC_DRAW, &vboCapacities_[0]);
 
         if (vertices.size())
         {
-            glGenBuffers(1, &tmpID);
-            glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec3)*vertices.size(), &vertices[0], GL_STATIC_DRAW);
+            vboIDs_[1] = gl_name_pool.createBuffer(GL_ARRAY_BUFFER, sizeof(glm::vec3)*vertices.size(), &vertices[0], GL_STATIC_DRAW, &vboCapacities_[1]);
             glEnableVertexAttribArray(a_position_);
             glVertexAttribPointer(a_position_, 3, GL_FLOAT, 0, 0, 0);
         }
 
         if (tex_coords.size())
         {
-            glGenBuffers(1, &tmpID);
-            glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*tex_coords.size(), &tex_coords[0], GL_STATIC_DRAW);
+            vboIDs_[2] = gl_name_pool.createBuffer(GL_ARRAY_BUFFER, sizeof(glm::vec2)*tex_coords.size(), &tex_coords[0], GL_STATIC_DRAW, &vboCapacities_[2]);
             glEnableVertexAttribArray(a_tex_coord_);
             glVertexAttribPointer(a_tex_coord_, 2, GL_FLOAT, 0, 0, 0);
         }
@@ -57,6 +57,24 @@ public:
             std::vector<unsigned short>& triangles);
     static int getGLTexture(int n);
 
+    /*
+     * Whether the program finished linking, successfully or not; see
+     * GLProgram::poll(). Keys added before are applied then.
+     */
+    bool poll(bool wait);
+
+    // see GLProgram::needsWait()
+    bool needsWait() const;
+
+    // linked and usable for drawing
+    bool ready() const {
+        return program_ != 0 && linked_;
+    }
+
+    // done, but compiling or linking failed
+    bool failed() const {
+        return program_ != 0 && finished_ && !linked_;
+    }
 
 private:
     CustomPostEffectShader(
@@ -67,22 +85,42 @@ private:
     CustomPostEffectShader& operator=(
             CustomPostEffectShader&& custom_post_effect_shader);
 
+    void initialize();
+    // queue a key for the linked program; false once it is linked
+    bool deferKey(
+            void (CustomPostEffectShader::*add_key)(std::string, std::string),
+            const std::string& variable_name, const std::string& key);
+
 private:
+    struct PendingKey {
+        void (CustomPostEffectShader::*add_key)(std::string, std::string);
+        std::string variable_name;
+        std::string key;
+    };
+
     GLProgram* program_;
+    bool finished_;
+    bool linked_;
+    std::vector<PendingKey> pending_keys_;
     GLuint a_position_;
     GLuint a_tex_coord_;
     GLuint u_texture_;
     GLuint u_projection_matrix_;
     GLuint u_right_eye_;
-    std::map<int, std::string> texture_keys_;
-    std::map<int, std::string> float_keys_;
-    std::map<int, std::string> vec2_keys_;
-    std::map<int, std::string> vec3_keys_;
-    std::map<int, std::string> vec4_keys_;
-    std::map<int, std::string> mat4_keys_;
+    // uniform or attribute location to NameRegistry handle
+    std::map<int, int> texture_keys_;
+    std::map<int, int> float_keys_;
+    std::map<int, int> vec2_keys_;
+    std::map<int, int> vec3_keys_;
+    std::map<int, int> vec4_keys_;
+    std::map<int, int> mat4_keys_;
 
     // add vertex array object
     GLuint vaoID_;
+    // triangles, vertices and texture coordinates
+    static const int VBO_COUNT = 3;
+    GLuint vboIDs_[VBO_COUNT];
+    GLsizeiptr vboCapacities_[VBO_COUNT];
 };
 
 }
@@ -25,6 +25,7 @@
 #include "objects/textures/render_texture.h"
 #include "util/gvr_gl.h"
 #include "engine/memory/gl_delete.h"
+#include "engine/memory/gl_name_pool.h"
 
 namespace gvr {
 static const char VERTEX_SHADER[] = "attribute vec4 a_position;\n"
@@ -49,6 +50,10 @@ HorizontalFlipPostEffectShader::HorizontalFlipPostEffectShader() :
     a_tex_coord_ = glGetAttribLocation(program_->id(), "a_tex_coord");
     u_texture_ = glGetUniformLocation(program_->id(), "u_texture");
     vaoID_ = 0;
+    for (int i = 0; i < VBO_COUNT; ++i) {
+        vboIDs_[i] = 0;
+        vboCapacities_[i] = 0;
+    }
 }
 
 HorizontalFlipPostEffectShader::~HorizontalFlipPostEffectShader() {
@@ -59,6 +64,13 @@ HorizontalFlipPostEffectShader::~HorizontalFlipPostEffectShader() {
     	gl_delete.queueVertexArray(vaoID_);
     	vaoID_ = 0;
     }
+    for (int i = 0; i < VBO_COUNT; ++i) {
+        if (vboIDs_[i] != 0) {
+            gl_delete.queueBuffer(vboIDs_[i], GL_STATIC_DRAW,
+                    vboCapacities_[i]);
+            vboIDs_[i] = 0;
+        }
+    }
 }
 
 void HorizontalFlipPostEffectShader::recycle() {
@@ -74,31 +86,23 @@ void HorizontalFlipPostEffectShader::render(
     glUseProgram(program_->id());
 
 #if _GVRF_USE_GLES3_
-    GLuint tmpID;
-
     if(vaoID_ == 0)
     {
-        glGenVertexArrays(1, &vaoID_);
+        vaoID_ = gl_name_pool.genVertexArray();
         glBindVertexArray(vaoID_);
 
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short)*triangles.size(), &triangles[0], GL_STATIC_DRAW);
+        vboIDs_[0] = gl_name_pool.createBuffer(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short)*triangles.size(), &triangles[0], GL_STATIC_DRAW, &vboCapacities_[0]);
 
         if (vertices.size())
         {
-            glGenBuffers(1, &tmpID);
-            glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec3)*vertices.size(), &vertices[0], GL_STATIC_DRAW);
+            vboIDs_[1] = gl_name_pool.createBuffer(GL_ARRAY_BUFFER, sizeof(glm::vec3)*vertices.size(), &vertices[0], GL_STATIC_DRAW, &vboCapacities_[1]);
             glEnableVertexAttribArray(a_position_);
             glVertexAttribPointer(a_position_, 3, GL_FLOAT, 0, 0, 0);
         }
 
         if (tex_coords.size())
         {
-            glGenBuffers(1, &tmpID);
-            glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*tex_coords.size(), &tex_coords[0], GL_STATIC_DRAW);
+            vboIDs_[2] = gl_name_pool.createBuffer(GL_ARRAY_BUFFER, sizeof(glm::vec2)*tex_coords.size(), &tex_coords[0], GL_STATIC_DRAW, &vboCapacities_[2]);
             glEnableVertexAttribArray(a_tex_coord_);
             glVertexAttribPointer(a_tex_coord_, 2, GL_FLOAT, 0, 0, 0);
         }
@@ -62,6 +62,10 @@ private:
     GLuint u_texture_;
     // add vertex array object
     GLuint vaoID_;
+    // triangles, vertices and texture coordinates
+    static const int VBO_COUNT = 3;
+    GLuint vboIDs_[VBO_COUNT];
+    GLsizeiptr vboCapacities_[VBO_COUNT];
 };
 }
 #endif
@@ -20,16 +20,15 @@
 #ifndef SHADER_MANAGER_H_
 #define SHADER_MANAGER_H_
 
+#include <list>
+
+#include "engine/renderer/uniform_ring_buffer.h"
+#include "gl/gl_program.h"
 #include "objects/hybrid_object.h"
 #include "shaders/material/bounding_box_shader.h"
 #include "shaders/material/custom_shader.h"
 #include "shaders/material/error_shader.h"
-#include "shaders/material/oes_horizontal_stereo_shader.h"
-#include "shaders/material/oes_shader.h"
-#include "shaders/material/oes_vertical_stereo_shader.h"
-#include "shaders/material/unlit_horizontal_stereo_shader.h"
-#include "shaders/material/unlit_shader.h"
-#include "shaders/material/unlit_vertical_stereo_shader.h"
+#include "shaders/material/variant_shader.h"
 #include "shaders/material/cubemap_shader.h"
 #include "shaders/material/cubemap_reflection_shader.h"
 #include "util/gvr_log.h"
@@ -38,26 +37,23 @@ namespace gvr {
 class ShaderManager: public HybridObject {
 public:
     ShaderManager() :
-            HybridObject(), unlit_shader_(), bounding_box_shader_(), unlit_horizontal_stereo_shader_(), unlit_vertical_stereo_shader_(), oes_shader_(), oes_horizontal_stereo_shader_(), oes_vertical_stereo_shader_(), cubemap_shader_(), cubemap_reflection_shader_(), error_shader_(), latest_custom_shader_id_(
-                    INITIAL_CUSTOM_SHADER_INDEX), custom_shaders_() {
+            HybridObject(), variant_shader_(), bounding_box_shader_(), cubemap_shader_(), cubemap_reflection_shader_(), error_shader_(), uniform_ring_buffer_(), latest_custom_shader_id_(
+                    INITIAL_CUSTOM_SHADER_INDEX), custom_shaders_(), pending_custom_shaders_() {
     }
     ~ShaderManager() {
-        delete unlit_shader_;
-        delete unlit_horizontal_stereo_shader_;
-        delete unlit_vertical_stereo_shader_;
-        delete oes_shader_;
-        delete oes_horizontal_stereo_shader_;
-        delete oes_vertical_stereo_shader_;
+        delete variant_shader_;
         delete cubemap_shader_;
         delete cubemap_reflection_shader_;
         delete error_shader_;
+        delete uniform_ring_buffer_;
         // We don't delete the custom shaders, as their Java owner-objects will do that for us.
     }
-    UnlitShader* getUnlitShader() {
-        if (!unlit_shader_) {
-            unlit_shader_ = new UnlitShader();
+    // the unlit and OES shader types
+    VariantShader* getVariantShader() {
+        if (!variant_shader_) {
+            variant_shader_ = new VariantShader();
         }
-        return unlit_shader_;
+        return variant_shader_;
     }
     BoundingBoxShader* getBoundingBoxShader() {
         if (!bounding_box_shader_) {
@@ -65,36 +61,6 @@ public:
         }
         return bounding_box_shader_;
     }
-    UnlitHorizontalStereoShader* getUnlitHorizontalStereoShader() {
-        if (!unlit_horizontal_stereo_shader_) {
-            unlit_horizontal_stereo_shader_ = new UnlitHorizontalStereoShader();
-        }
-        return unlit_horizontal_stereo_shader_;
-    }
-    UnlitVerticalStereoShader* getUnlitVerticalStereoShader() {
-        if (!unlit_vertical_stereo_shader_) {
-            unlit_vertical_stereo_shader_ = new UnlitVerticalStereoShader();
-        }
-        return unlit_vertical_stereo_shader_;
-    }
-    OESShader* getOESShader() {
-        if (!oes_shader_) {
-            oes_shader_ = new OESShader();
-        }
-        return oes_shader_;
-    }
-    OESHorizontalStereoShader* getOESHorizontalStereoShader() {
-        if (!oes_horizontal_stereo_shader_) {
-            oes_horizontal_stereo_shader_ = new OESHorizontalStereoShader();
-        }
-        return oes_horizontal_stereo_shader_;
-    }
-    OESVerticalStereoShader* getOESVerticalStereoShader() {
-        if (!oes_vertical_stereo_shader_) {
-            oes_vertical_stereo_shader_ = new OESVerticalStereoShader();
-        }
-        return oes_vertical_stereo_shader_;
-    }
     CubemapShader* getCubemapShader() {
         if (!cubemap_shader_) {
             cubemap_shader_ = new CubemapShader();
@@ -113,14 +79,42 @@ public:
         }
         return error_shader_;
     }
+    // per frame and per object matrices for the uniform block shaders
+    UniformRingBuffer* getUniformRingBuffer() {
+        if (!uniform_ring_buffer_) {
+            uniform_ring_buffer_ = new UniformRingBuffer();
+        }
+        return uniform_ring_buffer_;
+    }
     int addCustomShader(std::string vertex_shader,
             std::string fragment_shader) {
         int id = latest_custom_shader_id_++;
         CustomShader* custom_shader(
                 new CustomShader(vertex_shader, fragment_shader));
         custom_shaders_[id] = custom_shader;
+        if (!custom_shader->poll(false)) {
+            pending_custom_shaders_.push_back(custom_shader);
+        }
         return id;
     }
+    /*
+     * Finish custom shaders whose programs are done linking. Programs
+     * linked on the GL thread by a driver that cannot tell are waited for,
+     * one per call instead of all at once.
+     */
+    void update() {
+        bool waited = false;
+        for (auto it = pending_custom_shaders_.begin();
+                it != pending_custom_shaders_.end();) {
+            bool wait = !waited && (*it)->needsWait();
+            waited = waited || wait;
+            if ((*it)->poll(wait)) {
+                it = pending_custom_shaders_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
     CustomShader* getCustomShader(int id) {
         auto it = custom_shaders_.find(id);
         if (it != custom_shaders_.end()) {
@@ -139,18 +133,15 @@ private:
 
 private:
     static const int INITIAL_CUSTOM_SHADER_INDEX = 1000;
-    UnlitShader* unlit_shader_;
+    VariantShader* variant_shader_;
     BoundingBoxShader* bounding_box_shader_;
-    UnlitHorizontalStereoShader* unlit_horizontal_stereo_shader_;
-    UnlitVerticalStereoShader* unlit_vertical_stereo_shader_;
-    OESShader* oes_shader_;
-    OESHorizontalStereoShader* oes_horizontal_stereo_shader_;
-    OESVerticalStereoShader* oes_vertical_stereo_shader_;
     CubemapShader* cubemap_shader_;
     CubemapReflectionShader* cubemap_reflection_shader_;
     ErrorShader* error_shader_;
+    UniformRingBuffer* uniform_ring_buffer_;
     int latest_custom_shader_id_;
     std::map<int, CustomShader*> custom_shaders_;
+    std::list<CustomShader*> pending_custom_shaders_;
 };
 
 }
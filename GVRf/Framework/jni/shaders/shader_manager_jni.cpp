@@ -20,6 +20,7 @@
 
 #include "shader_manager.h"
 
+#include "gl/program_cache.h"
 #include "util/gvr_jni.h"
 
 namespace gvr {
@@ -34,6 +35,12 @@ Java_org_gearvrf_NativeShaderManager_addCustomShader(
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeShaderManager_getCustomShader(
         JNIEnv * env, jobject obj, jlong jshader_manager, jint id);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeShaderManager_getCustomShaderStatus(
+        JNIEnv * env, jobject obj, jlong jshader_manager, jint id);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeShaderManager_setProgramCacheDir(
+        JNIEnv * env, jobject obj, jstring cache_dir);
 }
 
 JNIEXPORT jlong JNICALL
@@ -73,4 +80,26 @@ Java_org_gearvrf_NativeShaderManager_getCustomShader(
     }
 }
 
+// 0 while compiling, 1 when linked and -1 when that failed
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeShaderManager_getCustomShaderStatus(
+        JNIEnv * env, jobject obj, jlong jshader_manager, jint id) {
+    ShaderManager* shader_manager =
+            reinterpret_cast<ShaderManager*>(jshader_manager);
+    try {
+        CustomShader* custom_shader = shader_manager->getCustomShader(id);
+        return custom_shader->ready() ? 1 : custom_shader->failed() ? -1 : 0;
+    } catch (char const *e) {
+        return -1;
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeShaderManager_setProgramCacheDir(
+        JNIEnv * env, jobject obj, jstring cache_dir) {
+    const char* native_cache_dir = env->GetStringUTFChars(cache_dir, 0);
+    ProgramCache::setDirectory(native_cache_dir);
+    env->ReleaseStringUTFChars(cache_dir, native_cache_dir);
+}
+
 }
@@ -21,6 +21,7 @@
 #ifndef LOG_H_
 #define LOG_H_
 
+#ifdef __ANDROID__
 #include <android/log.h>
 
 #define  LOG_TAG    "gvrf"
@@ -29,5 +30,15 @@
 #define  LOGI(...)  __android_log_print(ANDROID_LOG_INFO,LOG_TAG,__VA_ARGS__)
 #define  LOGW(...)  __android_log_print(ANDROID_LOG_WARN,LOG_TAG,__VA_ARGS__)
 #define  LOGE(...)  __android_log_print(ANDROID_LOG_ERROR,LOG_TAG,__VA_ARGS__)
+#else
+// host tools built from engine sources (Tools/texcook) log to stderr
+#include <stdio.h>
+
+#define  LOGV(...)  ((void) 0)
+#define  LOGD(...)  ((void) 0)
+#define  LOGI(...)  (fprintf(stderr, __VA_ARGS__), fputc('\n', stderr))
+#define  LOGW(...)  (fprintf(stderr, __VA_ARGS__), fputc('\n', stderr))
+#define  LOGE(...)  (fprintf(stderr, __VA_ARGS__), fputc('\n', stderr))
+#endif
 
 #endif
@@ -0,0 +1,86 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Interns attribute and uniform names into integer handles.
+ ***************************************************************************/
+
+#include "gvr_name_registry.h"
+
+#include <unordered_map>
+#include <pthread.h>
+
+namespace gvr {
+
+namespace {
+
+struct Names {
+    Names() {
+        pthread_mutex_init(&mutex, 0);
+        const char* stock_names[NUM_STOCK_NAMES] = { "main_texture", "color",
+                "opacity", "r", "g", "b", "factor", "pivot", "distance",
+                "uv_transform" };
+        for (int i = 0; i < NUM_STOCK_NAMES; ++i) {
+            handles[stock_names[i]] = i;
+            names.push_back(stock_names[i]);
+        }
+    }
+
+    ~Names() {
+        pthread_mutex_destroy(&mutex);
+    }
+
+    pthread_mutex_t mutex;
+    std::unordered_map<std::string, int> handles;
+    std::vector<std::string> names;
+};
+
+Names& registry() {
+    static Names names;
+    return names;
+}
+
+}
+
+int NameRegistry::intern(const std::string& name) {
+    Names& registry_names = registry();
+    pthread_mutex_lock(&registry_names.mutex);
+    auto it = registry_names.handles.find(name);
+    int handle;
+    if (it != registry_names.handles.end()) {
+        handle = it->second;
+    } else {
+        handle = registry_names.names.size();
+        registry_names.handles[name] = handle;
+        registry_names.names.push_back(name);
+    }
+    pthread_mutex_unlock(&registry_names.mutex);
+    return handle;
+}
+
+std::string NameRegistry::name(int handle) {
+    Names& registry_names = registry();
+    pthread_mutex_lock(&registry_names.mutex);
+    std::string name;
+    if (handle >= 0
+            && static_cast<size_t>(handle) < registry_names.names.size()) {
+        name = registry_names.names[handle];
+    }
+    pthread_mutex_unlock(&registry_names.mutex);
+    return name;
+}
+
+}
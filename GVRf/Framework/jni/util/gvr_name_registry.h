@@ -0,0 +1,114 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Interns the names of material, post effect and mesh attributes into small
+ * integer handles, so lookups on the render thread are array accesses
+ * instead of string compares.
+ ***************************************************************************/
+
+#ifndef GVR_NAME_REGISTRY_H_
+#define GVR_NAME_REGISTRY_H_
+
+#include <string>
+#include <vector>
+
+namespace gvr {
+
+/*
+ * Names used by the stock shaders. They are interned first, in this order,
+ * so their handles are known at compile time.
+ */
+enum StockName {
+    NAME_MAIN_TEXTURE = 0,
+    NAME_COLOR,
+    NAME_OPACITY,
+    NAME_R,
+    NAME_G,
+    NAME_B,
+    NAME_FACTOR,
+    NAME_PIVOT,
+    NAME_DISTANCE,
+    NAME_UV_TRANSFORM,
+    NUM_STOCK_NAMES
+};
+
+class NameRegistry {
+public:
+    // Returns the handle of name, registering it on first use. Thread safe.
+    static int intern(const std::string& name);
+
+    // The name a handle was interned from, for error messages.
+    static std::string name(int handle);
+
+private:
+    NameRegistry();
+};
+
+/*
+ * Storage for values keyed by name handle: a flat vector indexed by the
+ * handle, with a flag telling which slots have been set.
+ */
+template<class T>
+class HandleMap {
+public:
+    HandleMap() :
+            values_(), present_() {
+    }
+
+    T* find(int handle) {
+        if (handle >= 0 && static_cast<size_t>(handle) < present_.size()
+                && present_[handle]) {
+            return &values_[handle];
+        }
+        return 0;
+    }
+
+    const T* find(int handle) const {
+        if (handle >= 0 && static_cast<size_t>(handle) < present_.size()
+                && present_[handle]) {
+            return &values_[handle];
+        }
+        return 0;
+    }
+
+    T& operator[](int handle) {
+        if (static_cast<size_t>(handle) >= present_.size()) {
+            values_.resize(handle + 1);
+            present_.resize(handle + 1, false);
+        }
+        present_[handle] = true;
+        return values_[handle];
+    }
+
+    // one past the largest handle that may be present, for iterating
+    int capacity() const {
+        return present_.size();
+    }
+
+    void clear() {
+        values_.clear();
+        present_.clear();
+    }
+
+private:
+    std::vector<T> values_;
+    std::vector<bool> present_;
+};
+
+}
+
+#endif
@@ -174,6 +174,27 @@ public class GVRAndroidResource {
         return stream;
     }
 
+    /**
+     * The path this resource was opened from, for loaders that map the file
+     * natively instead of reading the stream.
+     * 
+     * @return The file path, or {@code null} if this is not a file resource.
+     */
+    public final String getFilePath() {
+        return filePath;
+    }
+
+    /**
+     * The asset this resource was opened from, for loaders that map the asset
+     * natively instead of reading the stream.
+     * 
+     * @return The asset-relative file name, or {@code null} if this is not an
+     *         asset resource.
+     */
+    public final String getAssetPath() {
+        return assetPath;
+    }
+
     /*
      * TODO Should we somehow expose the CLOSED state? Return null or throw an
      * exception from getStream()? Or is it enough for the calling code to fail,
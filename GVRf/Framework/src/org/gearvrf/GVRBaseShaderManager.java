@@ -19,6 +19,9 @@ package org.gearvrf;
 import java.io.File;
 import java.io.IOException;
 import java.io.InputStream;
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.Map;
 
 import org.gearvrf.utility.TextFile;
 
@@ -28,10 +31,60 @@ import android.content.res.Resources;
 public abstract class GVRBaseShaderManager<MAP, ID> extends GVRHybridObject
         implements GVRShaderManagers<MAP, ID> {
 
+    /** Values of {@link #getShaderStatus(Object)} */
+    protected static final int SHADER_COMPILING = 0;
+    protected static final int SHADER_LINKED = 1;
+    protected static final int SHADER_FAILED = -1;
+
+    private final Map<ID, GVRShaderCompileListener<ID>> mCompileListeners = new HashMap<ID, GVRShaderCompileListener<ID>>();
+
+    private final GVRDrawFrameListener mCompilePoller = new GVRDrawFrameListener() {
+        @Override
+        public void onDrawFrame(float frameTime) {
+            pollCompileListeners();
+        }
+    };
+
     protected GVRBaseShaderManager(GVRContext gvrContext, long pointer) {
         super(gvrContext, pointer);
     }
 
+    @Override
+    public ID addShader(String vertexShader, String fragmentShader,
+            GVRShaderCompileListener<ID> listener) {
+        ID id = addShader(vertexShader, fragmentShader);
+        if (id != null && listener != null) {
+            if (mCompileListeners.isEmpty()) {
+                getGVRContext().registerDrawFrameListener(mCompilePoller);
+            }
+            mCompileListeners.put(id, listener);
+        }
+        return id;
+    }
+
+    /**
+     * @return {@link #SHADER_COMPILING}, {@link #SHADER_LINKED} or
+     *         {@link #SHADER_FAILED}
+     */
+    protected abstract int getShaderStatus(ID id);
+
+    private void pollCompileListeners() {
+        Iterator<Map.Entry<ID, GVRShaderCompileListener<ID>>> it = mCompileListeners
+                .entrySet().iterator();
+        while (it.hasNext()) {
+            Map.Entry<ID, GVRShaderCompileListener<ID>> entry = it.next();
+            int status = getShaderStatus(entry.getKey());
+            if (status != SHADER_COMPILING) {
+                it.remove();
+                entry.getValue().onShaderCompiled(entry.getKey(),
+                        status == SHADER_LINKED);
+            }
+        }
+        if (mCompileListeners.isEmpty()) {
+            getGVRContext().unregisterDrawFrameListener(mCompilePoller);
+        }
+    }
+
     @Override
     public ID addShader(String pathPrefix, String vertexShader_asset,
             String fragmentShader_asset) {
@@ -26,14 +26,23 @@ public class GVRBitmapTexture extends GVRTexture {
     /**
      * Constructs a texture using a pre-existing {@link Bitmap}.
      * 
+     * An {@link Config#ARGB_8888} bitmap is copied and uploaded on a
+     * background thread: the texture draws as untextured for a frame or two,
+     * and the bitmap can be recycled as soon as this returns. Other bitmaps
+     * are uploaded right away.
+     * 
      * @param gvrContext
      *            Current {@link GVRContext}
      * @param bitmap
      *            A non-null {@link Bitmap} instance.
      */
     public GVRBitmapTexture(GVRContext gvrContext, Bitmap bitmap) {
-        super(gvrContext, NativeBaseTexture.bareConstructor());
-        update(bitmap);
+        super(gvrContext, bitmap.getConfig() == Config.ARGB_8888 ?
+                NativeBaseTexture.bitmapConstructor(bitmap) :
+                NativeBaseTexture.bareConstructor());
+        if (bitmap.getConfig() != Config.ARGB_8888) {
+            update(bitmap);
+        }
     }
 
     /**
@@ -44,7 +53,8 @@ public class GVRBitmapTexture extends GVRTexture {
      * {@code .png} file; it does not create an Android {@link Bitmap}. It may
      * thus be slightly faster than loading a {@link Bitmap} and creating a
      * texture with {@link #GVRBitmapTexture(GVRContext, Bitmap)}, and it should
-     * reduce memory pressure, a bit.
+     * reduce memory pressure, a bit. The image is uploaded on a background
+     * thread.
      * 
      * @param gvrContext
      *            Current {@link GVRContext}
@@ -115,12 +125,42 @@ public class GVRBitmapTexture extends GVRTexture {
      */
     public boolean update(int width, int height, byte[] grayscaleData)
             throws IllegalArgumentException {
+        return update(width, height, grayscaleData, true);
+    }
+
+    /**
+     * Copy new luminance data to a grayscale texture, optionally without
+     * regenerating its mipmaps.
+     * 
+     * The first update fixes the texture's size, and whether it has mipmaps
+     * at all; later updates only copy pixels into that storage, so they are
+     * much cheaper than creating a new texture. Skipping mipmap generation
+     * saves more, for textures updated every frame and never minified much.
+     * 
+     * @param width
+     *            Texture width, in pixels
+     * @param height
+     *            Texture height, in pixels
+     * @param grayscaleData
+     *            {@code width * height} bytes of gray scale data
+     * @param generateMipmaps
+     *            Whether to regenerate the mipmaps from the new data
+     * @return {@code true} if the update succeeded, and {@code false} if it
+     *         failed, notably because {@code width} or {@code height} differ
+     *         from the first update's.
+     * @throws IllegalArgumentException
+     *             If {@code width} or {@code height} is {@literal <= 0,} or if
+     *             {@code grayScaleData} is {@code null}, or if
+     *             {@code grayscaleData.length < height * width}
+     */
+    public boolean update(int width, int height, byte[] grayscaleData,
+            boolean generateMipmaps) throws IllegalArgumentException {
         if (width <= 0 || height <= 0 || grayscaleData == null
                 || grayscaleData.length < height * width) {
             throw new IllegalArgumentException();
         }
         return NativeBaseTexture.update(getNative(), width, height,
-                grayscaleData);
+                grayscaleData, generateMipmaps);
     }
 
     /**
@@ -140,7 +180,8 @@ public class GVRBitmapTexture extends GVRTexture {
      *         parameter has the exact same size and {@linkplain Config bit
      *         depth} as the original bitmap. In particular, you can't update a
      *         grayscale texture with 'normal' {@linkplain Config#ARGB_8888
-     *         32-bit} data!
+     *         32-bit} data! Nor can you update one filled by
+     *         {@link #update(int, int, byte[])}, whose storage is immutable.
      * 
      * @since 1.6.3
      */
@@ -155,8 +196,10 @@ class NativeBaseTexture {
     static native long fileConstructor(AssetManager assetManager,
             String filename);
 
+    static native long bitmapConstructor(Bitmap bitmap);
+
     static native long bareConstructor();
 
     static native boolean update(long pointer, int width, int height,
-            byte[] grayscaleData);
+            byte[] grayscaleData, boolean generateMipmaps);
 }
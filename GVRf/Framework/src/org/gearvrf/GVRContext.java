@@ -164,6 +164,10 @@ public abstract class GVRContext {
      * better because it moves most of the work to a background thread, doing as
      * little as possible on the GL thread.
      * 
+     * The first import of a file is stored in a binary cache in the
+     * application's cache directory; loading the same file again, even after
+     * a restart, reads that cache instead of parsing the model.
+     * 
      * @param androidResource
      *            Basically, a stream containing a 3D model. The
      *            {@link GVRAndroidResource} class has six constructors to
@@ -176,10 +180,10 @@ public abstract class GVRContext {
     public GVRMesh loadMesh(GVRAndroidResource androidResource) {
         GVRMesh mesh = sMeshCache.get(androidResource);
         if (mesh == null) {
-            GVRAssimpImporter assimpImporter = GVRImporter
-                    .readFileFromResources(this, androidResource);
-            mesh = assimpImporter.getMesh(0);
-            sMeshCache.put(androidResource, mesh);
+            mesh = GVRImporter.loadMesh(this, androidResource);
+            if (mesh != null) {
+                sMeshCache.put(androidResource, mesh);
+            }
         }
         return mesh;
     }
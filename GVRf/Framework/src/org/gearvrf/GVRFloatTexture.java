@@ -45,7 +45,34 @@ public class GVRFloatTexture extends GVRTexture {
      */
     public GVRFloatTexture(GVRContext gvrContext, int width, int height,
             float[] data) throws IllegalArgumentException {
-        super(gvrContext, NativeFloatTexture.ctor());
+        this(gvrContext, width, height, data, false);
+    }
+
+    /**
+     * Create a float-point texture, optionally at half precision.
+     * 
+     * A half-float texture takes half the memory and upload bandwidth; its
+     * values keep about three significant decimal digits, and range up to
+     * 65504.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param width
+     *            Texture width, in pixels
+     * @param height
+     *            Texture height, in pixels
+     * @param data
+     *            A linear array of float pairs.
+     * @param halfFloat
+     *            Whether to store 16-bit instead of 32-bit floats
+     * @throws IllegalArgumentException
+     *             If {@code width} or {@code height} is {@literal <= 0,} or if
+     *             {@code data} is {@code null}, or if
+     *             {@code data.length < height * width * 2}
+     */
+    public GVRFloatTexture(GVRContext gvrContext, int width, int height,
+            float[] data, boolean halfFloat) throws IllegalArgumentException {
+        super(gvrContext, NativeFloatTexture.ctor(halfFloat));
         update(width, height, data);
     }
 
@@ -86,7 +113,7 @@ public class GVRFloatTexture extends GVRTexture {
 }
 
 class NativeFloatTexture {
-    static native long ctor();
+    static native long ctor(boolean halfFloat);
 
     static native boolean update(long pointer, int width, int height,
             float[] data);
@@ -0,0 +1,116 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+/**
+ * How much GPU memory the framework's textures, render targets and meshes
+ * use, and an optional budget for it.
+ * 
+ * <p>
+ * The sizes are estimates from what the framework asks OpenGL for; the
+ * driver may round them up, and memory allocated by your own GL calls is not
+ * counted. Over the {@linkplain #setBudget(long) budget}, the resources not
+ * drawn for the longest time give back what they can recreate on their
+ * next use: {@linkplain GVRStreamedTexture streamed textures} drop to their
+ * smallest levels and {@linkplain GVRMesh meshes} free their vertex
+ * buffers, keeping the vertex data to upload again. Other textures and
+ * render targets are counted, but never evicted.
+ */
+public final class GVRGpuMemory {
+    /** {@link GVRTexture} images, except render targets. */
+    public static final int TEXTURES = 0;
+    /** {@link GVRRenderTexture} color and depth buffers. */
+    public static final int RENDER_TARGETS = 1;
+    /** {@link GVRMesh} vertex and index buffers. */
+    public static final int MESHES = 2;
+
+    private GVRGpuMemory() {
+    }
+
+    /**
+     * @param category
+     *            {@link #TEXTURES}, {@link #RENDER_TARGETS} or
+     *            {@link #MESHES}
+     * @return The GPU memory used by that category, in bytes.
+     */
+    public static long getUsage(int category) {
+        return NativeGpuMemory.getUsage(category);
+    }
+
+    /**
+     * @return The GPU memory used by all categories, in bytes.
+     */
+    public static long getTotal() {
+        return NativeGpuMemory.getTotal();
+    }
+
+    /**
+     * Sets the GPU memory budget. It is checked once per frame, after the
+     * {@linkplain GVRStreamedTexture#setMemoryBudget(long) budget of
+     * streamed textures}; resources drawn in the last two frames are
+     * never evicted, so the budget can be exceeded.
+     * 
+     * @param bytes
+     *            The budget, in bytes; 0, the default, for none.
+     */
+    public static void setBudget(long bytes) {
+        NativeGpuMemory.setBudget(bytes);
+    }
+
+    /**
+     * @return The current budget, in bytes; 0 if there is none.
+     */
+    public static long getBudget() {
+        return NativeGpuMemory.getBudget();
+    }
+
+    /**
+     * Limits how many OpenGL objects are deleted per frame.
+     * 
+     * <p>
+     * The objects of garbage collected textures, meshes and the like are
+     * deleted on the GL thread, once the GPU has finished the frame that may
+     * still use them. Dropping a big scene can free thousands at once; with a
+     * budget, their deletion is spread over several frames.
+     * 
+     * @param count
+     *            The most objects to delete per frame; 0, the default, for
+     *            no limit.
+     */
+    public static void setDeletionBudget(int count) {
+        NativeGLDelete.setBudget(count);
+    }
+
+    /**
+     * @return The most OpenGL objects deleted per frame; 0 if there is no
+     *         limit.
+     */
+    public static int getDeletionBudget() {
+        return NativeGLDelete.getBudget();
+    }
+}
+
+class NativeGpuMemory {
+    static native long getUsage(int category);
+
+    static native long getTotal();
+
+    static native void setBudget(long bytes);
+
+    static native long getBudget();
+
+    static native void update();
+}
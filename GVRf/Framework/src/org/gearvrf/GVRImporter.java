@@ -78,6 +78,39 @@ class GVRImporter {
         }
     }
 
+    /**
+     * Loads the first mesh of a 3D model, from the application's mesh cache
+     * if the same file was imported before. A first import goes through
+     * Assimp and stores the result in the cache, so later launches skip the
+     * parsing.
+     * 
+     * @param gvrContext
+     *            Context to import file from.
+     * @param resource
+     *            Stream containing the 3D model.
+     * @return The mesh, or {@code null} if the model cannot be read.
+     */
+    static GVRMesh loadMesh(GVRContext gvrContext, GVRAndroidResource resource) {
+        try {
+            byte[] bytes;
+            InputStream stream = resource.getStream();
+            try {
+                bytes = new byte[stream.available()];
+                stream.read(bytes);
+            } finally {
+                resource.closeStream();
+            }
+            String cacheDir = gvrContext.getContext().getCacheDir()
+                    .getAbsolutePath();
+            long nativeValue = NativeImporter.loadMesh(bytes, cacheDir);
+            return nativeValue == 0 ? null : new GVRMesh(gvrContext,
+                    nativeValue);
+        } catch (IOException e) {
+            e.printStackTrace();
+            return null;
+        }
+    }
+
     /**
      * Imports a 3D model from a file on the device's SD card. The application
      * must have read permission for the directory containing the file.
@@ -105,4 +138,6 @@ class NativeImporter {
     static native long readFileFromSDCard(String filename);
 
     static native long readFromByteArray(byte[] bytes);
+
+    static native long loadMesh(byte[] bytes, String cacheDir);
 }
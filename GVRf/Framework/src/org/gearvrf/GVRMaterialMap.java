@@ -26,6 +26,15 @@ package org.gearvrf;
  * not necessarily the same as the names of the attributes and uniforms in the
  * shader program: the methods of this class let you map names from materials to
  * programs.
+ *
+ * <p>
+ * A GLSL ES 3.00 program can gather its material uniforms in a uniform block
+ * named {@code Material}, e.g.
+ * {@code layout(std140) uniform Material { vec3 u_color; float u_opacity; };}
+ * Uniforms mapped into that block are packed into a uniform buffer per
+ * material, which is re-uploaded only after the material changes. Other
+ * uniforms are set only when the material drawn differs from the previous
+ * one.
  */
 public class GVRMaterialMap extends GVRHybridObject implements GVRShaderMaps {
     GVRMaterialMap(GVRContext gvrContext, long ptr) {
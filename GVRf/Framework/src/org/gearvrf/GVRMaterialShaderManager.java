@@ -49,6 +49,11 @@ public class GVRMaterialShaderManager extends
         return materialMaps.get(id);
     }
 
+    @Override
+    protected int getShaderStatus(GVRCustomMaterialShaderId id) {
+        return NativeShaderManager.getCustomShaderStatus(getNative(), id.ID);
+    }
+
     @SuppressWarnings("resource")
     private GVRMaterialMap retrieveShaderMap(GVRCustomMaterialShaderId id) {
         long ptr = NativeShaderManager.getCustomShader(getNative(), id.ID);
@@ -63,4 +68,8 @@ class NativeShaderManager {
             String fragmentShader);
 
     static native long getCustomShader(long shaderManager, int id);
+
+    static native int getCustomShaderStatus(long shaderManager, int id);
+
+    static native void setProgramCacheDir(String cacheDir);
 }
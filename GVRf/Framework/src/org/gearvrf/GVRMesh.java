@@ -17,14 +17,54 @@ package org.gearvrf;
 
 import static org.gearvrf.utility.Assert.*;
 
+import java.nio.Buffer;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.CharBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+import java.nio.ShortBuffer;
+
 import org.gearvrf.utility.Exceptions;
 
 /**
  * This is one of the key GVRF classes: It holds GL meshes.
  * 
  * A GL mesh is a net of triangles that define an object's surface geometry.
+ * 
+ * <p>
+ * Besides the array setters, each attribute can be written through a
+ * {@linkplain #mapVertices(int) mapped buffer}: a direct buffer over the
+ * native storage, so large generated meshes are filled in place without a
+ * Java array and without copies. A mapped buffer must not be used after the
+ * matching {@code unmap} call, after the attribute is set or mapped again, or
+ * after the mesh is gone.
  */
 public class GVRMesh extends GVRHybridObject {
+    /**
+     * How often the mesh data is expected to change; see
+     * {@link GVRMesh#setUsageHint(int)}.
+     */
+    public abstract static class GVRUsageHint {
+        /**
+         * The default: the data is set once and drawn many times. Any change
+         * re-uploads the whole attribute.
+         */
+        public static final int STATIC = 0;
+        /**
+         * The data changes now and then, often only in part. Only the
+         * modified range of an attribute is uploaded.
+         */
+        public static final int DYNAMIC = 1;
+        /**
+         * The data changes about every frame. Each change gives the GPU a
+         * fresh buffer, so rendering never waits on the previous frame.
+         */
+        public static final int STREAM = 2;
+    }
+
+    private static final int BOUNDING_VOLUME_SIZE = 10;
+
     public GVRMesh(GVRContext gvrContext) {
         super(gvrContext, NativeMesh.ctor());
     }
@@ -47,6 +87,14 @@ public class GVRMesh extends GVRHybridObject {
         return NativeMesh.getVertices(getNative());
     }
 
+    /**
+     * @return The number of vertices, without copying them like
+     *         {@link #getVertices()}.
+     */
+    public int getVertexCount() {
+        return NativeMesh.getVertexCount(getNative());
+    }
+
     /**
      * Sets the 3D vertices of the mesh. Each vertex is represented as a packed
      * {@code float} triplet:
@@ -271,6 +319,336 @@ public class GVRMesh extends GVRHybridObject {
                 NativeMesh.getBoundingBox(getNative()));
     }
 
+    /**
+     * Get the bounds of the mesh, in mesh coordinates, as the packed array
+     * <p>
+     * <code>{ minX, minY, minZ, maxX, maxY, maxZ, centerX, centerY, centerZ, radius }</code>
+     * <p>
+     * describing the axis aligned bounding box and the bounding sphere. They
+     * are computed on demand and whenever the vertices change.
+     * 
+     * @return Array with the packed bounding volume.
+     */
+    public float[] getBoundingVolume() {
+        return NativeMesh.getBoundingVolume(getNative());
+    }
+
+    /**
+     * Sets the bounds of the mesh, in the format returned by
+     * {@link #getBoundingVolume()}. Storing the bounds with a model saves
+     * scanning all its vertices when it is loaded again. The bounds are
+     * recomputed if the vertices change later.
+     * 
+     * @param boundingVolume
+     *            Array containing the packed bounding volume.
+     */
+    public void setBoundingVolume(float[] boundingVolume) {
+        checkArrayLength("boundingVolume", boundingVolume,
+                BOUNDING_VOLUME_SIZE);
+        NativeMesh.setBoundingVolume(getNative(), boundingVolume);
+    }
+
+    /**
+     * Tell the renderer how often this mesh will be modified, so it can pick
+     * the cheapest way to get the changes to the GPU.
+     * 
+     * @param usageHint
+     *            One of the {@link GVRUsageHint} constants.
+     */
+    public void setUsageHint(int usageHint) {
+        if (usageHint < GVRUsageHint.STATIC
+                || usageHint > GVRUsageHint.STREAM) {
+            throw Exceptions.IllegalArgument("Invalid usage hint %d",
+                    usageHint);
+        }
+        NativeMesh.setUsageHint(getNative(), usageHint);
+    }
+
+    /**
+     * Overwrite part of the vertex data. Unlike
+     * {@link #setVertices(float[])}, only the modified vertices are sent to
+     * the GPU when the mesh uses {@link GVRUsageHint#DYNAMIC}.
+     * 
+     * @param firstVertex
+     *            Index of the first vertex to replace.
+     * @param vertices
+     *            Packed {@code float} triplets; the range must lie inside the
+     *            current vertex array.
+     */
+    public void updateVertices(int firstVertex, float[] vertices) {
+        checkValidUpdate("vertices", firstVertex, vertices, 3);
+        NativeMesh.updateVertices(getNative(), firstVertex, vertices);
+    }
+
+    /**
+     * Overwrite part of the normal data, starting at normal
+     * {@code firstNormal}. See {@link #updateVertices(int, float[])}.
+     */
+    public void updateNormals(int firstNormal, float[] normals) {
+        checkValidUpdate("normals", firstNormal, normals, 3);
+        NativeMesh.updateNormals(getNative(), firstNormal, normals);
+    }
+
+    /**
+     * Overwrite part of the texture coordinates, starting at coordinate pair
+     * {@code firstTexCoord}. See {@link #updateVertices(int, float[])}.
+     */
+    public void updateTexCoords(int firstTexCoord, float[] texCoords) {
+        checkValidUpdate("texCoords", firstTexCoord, texCoords, 2);
+        NativeMesh.updateTexCoords(getNative(), firstTexCoord, texCoords);
+    }
+
+    /**
+     * Split the mesh into clusters of neighboring triangles that the renderer
+     * culls one by one against the view frustum and, for meshes drawn with
+     * {@linkplain GVRRenderData#setCullTest(boolean) back face culling}, by
+     * facing. Worth it for large meshes of which only a part is usually in
+     * view, like terrain or building shells.
+     * 
+     * This reorders the triangles; calling {@link #setTriangles(char[])}
+     * afterwards removes the clusters again.
+     * 
+     * @param maxTriangles
+     *            The largest number of triangles in a cluster, usually 64 to
+     *            256.
+     */
+    public void buildClusters(int maxTriangles) {
+        if (maxTriangles <= 0) {
+            throw Exceptions.IllegalArgument(
+                    "maxTriangles should be positive, is %d", maxTriangles);
+        }
+        NativeMesh.buildClusters(getNative(), maxTriangles);
+    }
+
+    /**
+     * Go back to culling the mesh as a whole.
+     */
+    public void clearClusters() {
+        NativeMesh.clearClusters(getNative());
+    }
+
+    /**
+     * @return The number of clusters made by {@link #buildClusters(int)}, 0 if
+     *         the mesh is not clustered.
+     */
+    public int getClusterCount() {
+        return NativeMesh.getClusterCount(getNative());
+    }
+
+    /**
+     * Resize the vertex array to {@code vertexCount} vertices and get a
+     * buffer over it to write packed {@code float} triplets to. Vertices that
+     * fit keep their values, so mapping {@link #getVertexCount()} vertices
+     * reads or edits the current data. Nothing reaches the GPU before
+     * {@link #unmapVertices()}.
+     * 
+     * @param vertexCount
+     *            The new number of vertices.
+     * @return A buffer over the native vertex data.
+     */
+    public FloatBuffer mapVertices(int vertexCount) {
+        checkValidCount("vertexCount", vertexCount);
+        return asNative(NativeMesh.mapVertices(getNative(), vertexCount))
+                .asFloatBuffer();
+    }
+
+    /**
+     * Publish the data written through {@link #mapVertices(int)}; the bounds
+     * are recomputed and the vertices uploaded before the next draw.
+     */
+    public void unmapVertices() {
+        NativeMesh.unmapVertices(getNative());
+    }
+
+    /**
+     * Sets the 3D vertices of the mesh from a direct buffer, the same way as
+     * {@link #setVertices(float[])}. Data from the start of the buffer to its
+     * limit is copied once; a buffer from {@link #mapVertices(int)} is taken
+     * as it is.
+     * 
+     * @param vertices
+     *            Direct buffer containing the packed vertex data.
+     */
+    public void setVertices(FloatBuffer vertices) {
+        checkValidBuffer("vertices", vertices, 3);
+        NativeMesh.setVerticesBuffer(getNative(), vertices,
+                vertices.limit() / 3);
+    }
+
+    /**
+     * Map the normals, which are {@code float} triplets. See
+     * {@link #mapVertices(int)}.
+     */
+    public FloatBuffer mapNormals(int normalCount) {
+        checkValidCount("normalCount", normalCount);
+        return asNative(NativeMesh.mapNormals(getNative(), normalCount))
+                .asFloatBuffer();
+    }
+
+    /**
+     * Publish the data written through {@link #mapNormals(int)}.
+     */
+    public void unmapNormals() {
+        NativeMesh.unmapNormals(getNative());
+    }
+
+    /**
+     * Sets the normals from a direct buffer. See
+     * {@link #setVertices(FloatBuffer)}.
+     */
+    public void setNormals(FloatBuffer normals) {
+        checkValidBuffer("normals", normals, 3);
+        NativeMesh.setNormalsBuffer(getNative(), normals,
+                normals.limit() / 3);
+    }
+
+    /**
+     * Map the texture coordinates, which are {@code float} pairs. See
+     * {@link #mapVertices(int)}.
+     */
+    public FloatBuffer mapTexCoords(int texCoordCount) {
+        checkValidCount("texCoordCount", texCoordCount);
+        return asNative(NativeMesh.mapTexCoords(getNative(), texCoordCount))
+                .asFloatBuffer();
+    }
+
+    /**
+     * Publish the data written through {@link #mapTexCoords(int)}.
+     */
+    public void unmapTexCoords() {
+        NativeMesh.unmapTexCoords(getNative());
+    }
+
+    /**
+     * Sets the texture coordinates from a direct buffer. See
+     * {@link #setVertices(FloatBuffer)}.
+     */
+    public void setTexCoords(FloatBuffer texCoords) {
+        checkValidBuffer("texCoords", texCoords, 2);
+        NativeMesh.setTexCoordsBuffer(getNative(), texCoords,
+                texCoords.limit() / 2);
+    }
+
+    /**
+     * Map the triangle indices; {@code indexCount} is three times the number
+     * of triangles. See {@link #mapVertices(int)}.
+     */
+    public CharBuffer mapTriangles(int indexCount) {
+        checkValidCount("indexCount", indexCount);
+        if (indexCount % 3 != 0) {
+            throw Exceptions.IllegalArgument(
+                    "indexCount should be a multiple of 3, is %d", indexCount);
+        }
+        return asNative(NativeMesh.mapTriangles(getNative(), indexCount))
+                .asCharBuffer();
+    }
+
+    /**
+     * Publish the data written through {@link #mapTriangles(int)}.
+     */
+    public void unmapTriangles() {
+        NativeMesh.unmapTriangles(getNative());
+    }
+
+    /**
+     * Sets the triangle indices from a direct buffer. See
+     * {@link #setVertices(FloatBuffer)}.
+     */
+    public void setTriangles(CharBuffer triangles) {
+        checkValidBuffer("triangles", triangles, 3);
+        NativeMesh.setTrianglesBuffer(getNative(), triangles,
+                triangles.limit());
+    }
+
+    /**
+     * Map the {@code float} scalars bound to the shader attribute
+     * {@code key}, creating it if needed. See {@link #mapVertices(int)}.
+     */
+    public FloatBuffer mapFloatVector(String key, int count) {
+        checkStringNotNullOrEmpty("key", key);
+        checkValidCount("count", count);
+        return asNative(NativeMesh.mapFloatVector(getNative(), key, count))
+                .asFloatBuffer();
+    }
+
+    /**
+     * Publish the data written through {@link #mapFloatVector(String, int)}.
+     */
+    public void unmapFloatVector(String key) {
+        checkStringNotNullOrEmpty("key", key);
+        NativeMesh.unmapFloatVector(getNative(), key);
+    }
+
+    /**
+     * Bind {@code float} scalars from a direct buffer to the shader attribute
+     * {@code key}. See {@link #setVertices(FloatBuffer)}.
+     */
+    public void setFloatVector(String key, FloatBuffer floatVector) {
+        checkStringNotNullOrEmpty("key", key);
+        checkValidBuffer("floatVector", floatVector, 1);
+        checkVectorLengthWithVertices("floatVector", floatVector.limit(), 1);
+        NativeMesh.setFloatVectorBuffer(getNative(), key, floatVector,
+                floatVector.limit());
+    }
+
+    private static ByteBuffer asNative(ByteBuffer buffer) {
+        return buffer.order(ByteOrder.nativeOrder());
+    }
+
+    private void checkValidCount(String parameterName, int count) {
+        if (count < 0) {
+            throw Exceptions.IllegalArgument("%s should not be negative, is %d",
+                    parameterName, count);
+        }
+    }
+
+    private void checkValidBuffer(String parameterName, Buffer buffer,
+            int expectedComponents) {
+        checkNotNull(parameterName, buffer);
+        if (!buffer.isDirect()) {
+            throw Exceptions.IllegalArgument("%s should be a direct buffer",
+                    parameterName);
+        }
+        ByteOrder order = bufferOrder(buffer);
+        if (order != null && order != ByteOrder.nativeOrder()) {
+            throw Exceptions.IllegalArgument(
+                    "%s should be in native byte order, is %s", parameterName,
+                    order);
+        }
+        if (buffer.limit() % expectedComponents != 0) {
+            throw Exceptions.IllegalArgument(
+                    "The length of %s should be a multiple of %d, is %d",
+                    parameterName, expectedComponents, buffer.limit());
+        }
+    }
+
+    /*
+     * The native side reads typed views as raw memory, so a view over a
+     * big-endian ByteBuffer would come through byte-swapped.
+     */
+    private static ByteOrder bufferOrder(Buffer buffer) {
+        if (buffer instanceof FloatBuffer) {
+            return ((FloatBuffer) buffer).order();
+        } else if (buffer instanceof IntBuffer) {
+            return ((IntBuffer) buffer).order();
+        } else if (buffer instanceof ShortBuffer) {
+            return ((ShortBuffer) buffer).order();
+        } else if (buffer instanceof CharBuffer) {
+            return ((CharBuffer) buffer).order();
+        }
+        return null;
+    }
+
+    private void checkValidUpdate(String parameterName, int first,
+            float[] data, int expectedComponents) {
+        if (first < 0) {
+            throw Exceptions.IllegalArgument(
+                    "The first element of %s should not be negative.",
+                    parameterName);
+        }
+        checkDivisibleDataLength(parameterName, data, expectedComponents);
+    }
+
     private void checkValidFloatVector(String keyName, String key,
             String vectorName, float[] vector, int expectedComponents) {
         checkStringNotNullOrEmpty(keyName, key);
@@ -286,7 +664,7 @@ public class GVRMesh extends GVRHybridObject {
 
     private void checkVectorLengthWithVertices(String parameterName,
             int dataLength, int expectedComponents) {
-        int verticesNumber = getVertices().length / 3;
+        int verticesNumber = getVertexCount();
         int numberOfElements = dataLength / expectedComponents;
         if (dataLength / expectedComponents != verticesNumber) {
             throw Exceptions
@@ -334,4 +712,59 @@ class NativeMesh {
     static native void setVec4Vector(long mesh, String key, float[] vec4Vector);
 
     static native long getBoundingBox(long mesh);
+
+    static native float[] getBoundingVolume(long mesh);
+
+    static native void setBoundingVolume(long mesh, float[] boundingVolume);
+
+    static native void setUsageHint(long mesh, int usageHint);
+
+    static native void updateVertices(long mesh, int first, float[] vertices);
+
+    static native void updateNormals(long mesh, int first, float[] normals);
+
+    static native void updateTexCoords(long mesh, int first, float[] texCoords);
+
+    static native void buildClusters(long mesh, int maxTriangles);
+
+    static native void clearClusters(long mesh);
+
+    static native int getClusterCount(long mesh);
+
+    static native int getVertexCount(long mesh);
+
+    static native ByteBuffer mapVertices(long mesh, int count);
+
+    static native void unmapVertices(long mesh);
+
+    static native void setVerticesBuffer(long mesh, FloatBuffer vertices,
+            int count);
+
+    static native ByteBuffer mapNormals(long mesh, int count);
+
+    static native void unmapNormals(long mesh);
+
+    static native void setNormalsBuffer(long mesh, FloatBuffer normals,
+            int count);
+
+    static native ByteBuffer mapTexCoords(long mesh, int count);
+
+    static native void unmapTexCoords(long mesh);
+
+    static native void setTexCoordsBuffer(long mesh, FloatBuffer texCoords,
+            int count);
+
+    static native ByteBuffer mapTriangles(long mesh, int count);
+
+    static native void unmapTriangles(long mesh);
+
+    static native void setTrianglesBuffer(long mesh, CharBuffer triangles,
+            int count);
+
+    static native ByteBuffer mapFloatVector(long mesh, String key, int count);
+
+    static native void unmapFloatVector(long mesh, String key);
+
+    static native void setFloatVectorBuffer(long mesh, String key,
+            FloatBuffer floatVector, int count);
 }
@@ -0,0 +1,116 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+import static org.gearvrf.utility.Assert.*;
+
+import org.gearvrf.utility.Exceptions;
+
+/**
+ * Compresses {@link GVRMesh meshes} for shipping as assets.
+ * 
+ * Positions, texture coordinates and normals are quantized, predicted from
+ * their neighbors and entropy coded together with the triangle indices;
+ * a typical mesh shrinks to a third of its raw size or less. Compressed
+ * files placed in {@code assets} load through
+ * {@link GVRContext#loadMesh(GVRAndroidResource)} like any other model.
+ * 
+ * The codec is lossy: attributes are rounded to the given number of bits and
+ * vertices are renumbered. The triangle order is kept.
+ */
+public final class GVRMeshCodec {
+    private GVRMeshCodec() {
+    }
+
+    public static final int DEFAULT_POSITION_BITS = 14;
+    public static final int DEFAULT_TEX_COORD_BITS = 12;
+    public static final int DEFAULT_NORMAL_BITS = 10;
+
+    /**
+     * Compress a mesh with the default precision.
+     * 
+     * @param mesh
+     *            The mesh to compress.
+     * @return The compressed mesh.
+     */
+    public static byte[] encode(GVRMesh mesh) {
+        return encode(mesh, DEFAULT_POSITION_BITS, DEFAULT_TEX_COORD_BITS,
+                DEFAULT_NORMAL_BITS);
+    }
+
+    /**
+     * Compress a mesh.
+     * 
+     * @param mesh
+     *            The mesh to compress.
+     * @param positionBits
+     *            Bits per position component, across the mesh's bounding
+     *            box; 1 to 24.
+     * @param texCoordBits
+     *            Bits per texture coordinate component; 1 to 24.
+     * @param normalBits
+     *            Bits per component of the octahedral normal encoding; 1 to
+     *            24.
+     * @return The compressed mesh.
+     */
+    public static byte[] encode(GVRMesh mesh, int positionBits,
+            int texCoordBits, int normalBits) {
+        checkNotNull("mesh", mesh);
+        checkBits("positionBits", positionBits);
+        checkBits("texCoordBits", texCoordBits);
+        checkBits("normalBits", normalBits);
+        return NativeMeshCodec.encode(mesh.getNative(), positionBits,
+                texCoordBits, normalBits);
+    }
+
+    /**
+     * Decompress several meshes, using all CPU cores.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param data
+     *            The compressed meshes, as returned by
+     *            {@link #encode(GVRMesh)}.
+     * @return The meshes, with {@code null} for any that could not be
+     *         decoded.
+     */
+    public static GVRMesh[] decode(GVRContext gvrContext, byte[][] data) {
+        checkNotNull("data", data);
+        long[] nativeMeshes = NativeMeshCodec.decode(data, Runtime
+                .getRuntime().availableProcessors());
+        GVRMesh[] meshes = new GVRMesh[nativeMeshes.length];
+        for (int i = 0; i < nativeMeshes.length; ++i) {
+            meshes[i] = nativeMeshes[i] == 0 ? null : new GVRMesh(gvrContext,
+                    nativeMeshes[i]);
+        }
+        return meshes;
+    }
+
+    private static void checkBits(String parameterName, int bits) {
+        if (bits < 1 || bits > 24) {
+            throw Exceptions.IllegalArgument(
+                    "%s should be between 1 and 24, is %d", parameterName,
+                    bits);
+        }
+    }
+}
+
+class NativeMeshCodec {
+    static native byte[] encode(long mesh, int positionBits, int texCoordBits,
+            int normalBits);
+
+    static native long[] decode(byte[][] data, int threadCount);
+}
@@ -0,0 +1,101 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+import static org.gearvrf.utility.Assert.*;
+
+/**
+ * Generates reduced versions of a {@link GVRMesh mesh}, for use as levels of
+ * detail.
+ * 
+ * The simplifier collapses the edges that change the shape least (quadric
+ * error metrics). Open borders and texture seams are kept in place, so a
+ * simplified mesh still lines up with its neighbors and its texture.
+ * Simplification is slow compared to rendering: run it on a background
+ * thread, or offline.
+ */
+public final class GVRMeshSimplifier {
+    private GVRMeshSimplifier() {
+    }
+
+    /** One simplified level of a mesh. */
+    public static final class GVRLodLevel {
+        private final GVRMesh mMesh;
+        private final float mGeometricError;
+
+        GVRLodLevel(GVRMesh mesh, float geometricError) {
+            mMesh = mesh;
+            mGeometricError = geometricError;
+        }
+
+        /** The simplified mesh. */
+        public GVRMesh getMesh() {
+            return mMesh;
+        }
+
+        /**
+         * How far, in mesh units, the simplified surface may lie from the
+         * original one. Projected to the screen, this tells when the level
+         * is indistinguishable from the full mesh.
+         */
+        public float getGeometricError() {
+            return mGeometricError;
+        }
+    }
+
+    /**
+     * Generate levels of detail for several meshes, using all CPU cores.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param meshes
+     *            The meshes to simplify.
+     * @param triangleRatios
+     *            Size of each level as a fraction of the source triangle
+     *            count, e.g. {@code { 0.5f, 0.25f, 0.1f }}.
+     * @return {@code levels[i][j]} is level {@code j} of {@code meshes[i]}.
+     */
+    public static GVRLodLevel[][] generateLods(GVRContext gvrContext,
+            GVRMesh[] meshes, float[] triangleRatios) {
+        checkNotNull("meshes", meshes);
+        checkNotNull("triangleRatios", triangleRatios);
+
+        long[] nativeMeshes = new long[meshes.length];
+        for (int i = 0; i < meshes.length; ++i) {
+            nativeMeshes[i] = meshes[i].getNative();
+        }
+        float[] errors = new float[meshes.length * triangleRatios.length];
+        long[] nativeLevels = NativeMeshSimplifier.generateLods(nativeMeshes,
+                triangleRatios, Runtime.getRuntime().availableProcessors(),
+                errors);
+
+        GVRLodLevel[][] levels = new GVRLodLevel[meshes.length][];
+        for (int i = 0; i < meshes.length; ++i) {
+            levels[i] = new GVRLodLevel[triangleRatios.length];
+            for (int j = 0; j < triangleRatios.length; ++j) {
+                int index = i * triangleRatios.length + j;
+                levels[i][j] = new GVRLodLevel(new GVRMesh(gvrContext,
+                        nativeLevels[index]), errors[index]);
+            }
+        }
+        return levels;
+    }
+}
+
+class NativeMeshSimplifier {
+    static native long[] generateLods(long[] meshes, float[] triangleRatios,
+            int threadCount, float[] errors);
+}
@@ -52,6 +52,12 @@ public class GVRPostEffectShaderManager extends
         return posteffects.get(id);
     }
 
+    @Override
+    protected int getShaderStatus(GVRCustomPostEffectShaderId id) {
+        return NativePostEffectShaderManager.getCustomPostEffectShaderStatus(
+                getNative(), id.ID);
+    }
+
     @SuppressWarnings("resource")
     private GVRPostEffectMap retrieveShaderMap(GVRCustomPostEffectShaderId id) {
         long ptr = NativePostEffectShaderManager.getCustomPostEffectShader(
@@ -71,4 +77,7 @@ class NativePostEffectShaderManager {
 
     static native long getCustomPostEffectShader(long postEffectShaderManager,
             int id);
+
+    static native int getCustomPostEffectShaderStatus(
+            long postEffectShaderManager, int id);
 }
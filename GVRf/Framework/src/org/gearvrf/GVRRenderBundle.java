@@ -29,6 +29,12 @@ class GVRRenderBundle {
     GVRRenderBundle(GVRContext gvrContext, GVRLensInfo data) {
         mGVRContext = gvrContext;
         mData = data;
+        /*
+         * Linked shader programs are kept in the files dir, so shaders are
+         * only compiled on the first launch and after driver updates.
+         */
+        NativeShaderManager.setProgramCacheDir(gvrContext.getContext()
+                .getFilesDir().getAbsolutePath() + "/programs");
         mMaterialShaderManager = new GVRMaterialShaderManager(gvrContext);
         mPostEffectShaderManager = new GVRPostEffectShaderManager(gvrContext);
 
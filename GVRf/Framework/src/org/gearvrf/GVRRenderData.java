@@ -15,12 +15,15 @@
 
 package org.gearvrf;
 
+import java.util.ArrayList;
+import java.util.List;
 import java.util.concurrent.ExecutionException;
 import java.util.concurrent.Future;
 import java.util.concurrent.TimeUnit;
 import java.util.concurrent.TimeoutException;
 
 import static android.opengl.GLES30.*;
+import org.gearvrf.utility.Exceptions;
 import org.gearvrf.utility.Threads;
 
 /**
@@ -34,6 +37,7 @@ public class GVRRenderData extends GVRComponent {
 
     private GVRMesh mMesh;
     private GVRMaterial mMaterial;
+    private final List<GVRMesh> mLods = new ArrayList<GVRMesh>();
 
     /** Just for {@link #getMeshEyePointee()} */
     private Future<GVRMesh> mFutureMesh;
@@ -84,6 +88,25 @@ public class GVRRenderData extends GVRComponent {
         public static final int Right = 0x2;
     }
 
+    /**
+     * What the thresholds passed to {@link GVRRenderData#addLod(GVRMesh, float)
+     * addLod()} mean.
+     */
+    public abstract static class GVRLodMode {
+        /**
+         * The threshold is the level's geometric error, in mesh units, as
+         * returned by {@link GVRMeshSimplifier}. The level is used once that
+         * error projects to fewer pixels than
+         * {@link GVRScene#setLodErrorPixels(float)} allows.
+         */
+        public static final int SCREEN_ERROR = 0;
+        /**
+         * The threshold is the camera distance from which on the level is
+         * used.
+         */
+        public static final int DISTANCE = 1;
+    }
+
     /**
      * Constructor.
      * 
@@ -119,6 +142,60 @@ public class GVRRenderData extends GVRComponent {
         NativeRenderData.setMesh(getNative(), mesh.getNative());
     }
 
+    /**
+     * Add a level to the level of detail set. Once a set is present, the
+     * renderer draws one of its meshes instead of the one passed to
+     * {@link #setMesh(GVRMesh)}, picking it each frame from the object's size
+     * on screen. Add the full detail mesh too, with a threshold of 0.
+     * 
+     * @param mesh
+     *            The mesh of the level.
+     * @param threshold
+     *            The level's geometric error or switch distance, depending on
+     *            the {@linkplain #setLodMode(int) mode}.
+     */
+    public void addLod(GVRMesh mesh, float threshold) {
+        if (threshold < 0.0f) {
+            throw Exceptions.IllegalArgument("threshold must not be negative");
+        }
+        synchronized (mLods) {
+            mLods.add(mesh);
+        }
+        NativeRenderData.addLod(getNative(), mesh.getNative(), threshold);
+    }
+
+    /**
+     * Remove the level of detail set, so {@link #getMesh()} is drawn again.
+     */
+    public void clearLods() {
+        synchronized (mLods) {
+            mLods.clear();
+        }
+        NativeRenderData.clearLods(getNative());
+    }
+
+    /**
+     * Set how the thresholds of the level of detail set are interpreted.
+     * 
+     * @param lodMode
+     *            One of the {@link GVRLodMode} constants. The default is
+     *            {@link GVRLodMode#SCREEN_ERROR}.
+     */
+    public void setLodMode(int lodMode) {
+        if (lodMode != GVRLodMode.SCREEN_ERROR
+                && lodMode != GVRLodMode.DISTANCE) {
+            throw Exceptions.IllegalArgument("Invalid LOD mode %d", lodMode);
+        }
+        NativeRenderData.setLodMode(getNative(), lodMode);
+    }
+
+    /**
+     * @return The index of the level of detail drawn last, 0 being the finest.
+     */
+    public int getLodLevel() {
+        return NativeRenderData.getLodLevel(getNative());
+    }
+
     /**
      * Asynchronously set the {@link GVRMesh mesh} to be rendered.
      * 
@@ -432,6 +509,14 @@ class NativeRenderData {
 
     static native void setMesh(long renderData, long mesh);
 
+    static native void addLod(long renderData, long mesh, float threshold);
+
+    static native void clearLods(long renderData);
+
+    static native void setLodMode(long renderData, int lodMode);
+
+    static native int getLodLevel(long renderData);
+
     static native void setMaterial(long renderData, long material);
 
     static native int getRenderMask(long renderData);
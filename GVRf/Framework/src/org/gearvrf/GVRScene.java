@@ -20,6 +20,7 @@ import java.util.Collections;
 import java.util.List;
 
 import org.gearvrf.GVRRenderData.GVRRenderMaskBit;
+import org.gearvrf.utility.Exceptions;
 import org.gearvrf.utility.Log;
 import org.gearvrf.debug.GVRConsole;
 
@@ -154,6 +155,66 @@ public class GVRScene extends GVRHybridObject {
         NativeScene.setOcclusionQuery(getNative(), flag);
     }
 
+    /**
+     * Sets the level of detail bias for the {@link GVRScene}. Values above 1
+     * select coarser levels of detail, values below 1 finer ones.
+     * 
+     * @param bias
+     *            Multiplier applied to every object's camera distance when
+     *            its level of detail is picked. The default is 1.
+     */
+    public void setLodBias(float bias) {
+        if (bias <= 0.0f) {
+            throw Exceptions.IllegalArgument("bias must be positive");
+        }
+        NativeScene.setLodBias(getNative(), bias);
+    }
+
+    /**
+     * Sets how many pixels of geometric error a level of detail may show
+     * before a finer level is used.
+     * 
+     * @param pixels
+     *            Largest screen-space error, in pixels. The default is 1.
+     */
+    public void setLodErrorPixels(float pixels) {
+        if (pixels <= 0.0f) {
+            throw Exceptions.IllegalArgument("pixels must be positive");
+        }
+        NativeScene.setLodErrorPixels(getNative(), pixels);
+    }
+
+    /**
+     * Sets how far past a switch point an object has to move before its
+     * level of detail changes, so objects at a boundary do not pop back and
+     * forth.
+     * 
+     * @param hysteresis
+     *            Fraction of the switch distance, in [0, 1). The default is
+     *            0.1.
+     */
+    public void setLodHysteresis(float hysteresis) {
+        if (hysteresis < 0.0f || hysteresis >= 1.0f) {
+            throw Exceptions.IllegalArgument("hysteresis must be in [0, 1)");
+        }
+        NativeScene.setLodHysteresis(getNative(), hysteresis);
+    }
+
+    /**
+     * Skips objects whose bounds cover fewer pixels on screen than the given
+     * size. Requires {@linkplain #setFrustumCulling(boolean) frustum culling}.
+     * 
+     * @param pixels
+     *            Smallest projected diameter, in pixels, that is still drawn;
+     *            0 (the default) disables small feature culling.
+     */
+    public void setSmallFeatureCulling(float pixels) {
+        if (pixels < 0.0f) {
+            throw Exceptions.IllegalArgument("pixels must not be negative");
+        }
+        NativeScene.setSmallFeatureCulling(getNative(), pixels);
+    }
+
     private GVRConsole mStatsConsole = null;
     private boolean mStatsEnabled = false;
     private boolean pendingStats = false;
@@ -209,9 +270,13 @@ public class GVRScene extends GVRHybridObject {
         if(mStatsEnabled) {
             int numberDrawCalls = NativeScene.getNumberDrawCalls(getNative());
             int numberTriangles = NativeScene.getNumberTriangles(getNative());
+            int namePoolHits = NativeScene.getNamePoolHits(getNative());
+            int namePoolMisses = NativeScene.getNamePoolMisses(getNative());
 
             mStatsConsole.writeLine("Draw Calls: %d", numberDrawCalls);
             mStatsConsole.writeLine(" Triangles: %d", numberTriangles);
+            mStatsConsole.writeLine("  GL Names: %d reused, %d new",
+                    namePoolHits, namePoolMisses);
         }
     }
 }
@@ -229,7 +294,17 @@ class NativeScene {
 
     static native void setMainCameraRig(long scene, long cameraRig);
 
+    static native void setLodBias(long scene, float bias);
+
+    static native void setLodErrorPixels(long scene, float pixels);
+
+    static native void setLodHysteresis(long scene, float hysteresis);
+
+    static native void setSmallFeatureCulling(long scene, float pixels);
+
     public static native void resetStats(long scene);
     public static native int getNumberDrawCalls(long scene);
     public static native int getNumberTriangles(long scene);
+    public static native int getNamePoolHits(long scene);
+    public static native int getNamePoolMisses(long scene);
 }
@@ -0,0 +1,43 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+/**
+ * Implement this interface to learn when a custom shader is ready.
+ * 
+ * Custom shaders are compiled and linked without stalling the GL thread:
+ * scene objects using a material shader are not drawn until its program has
+ * linked, and a post effect waits for its program the first time it runs.
+ * Pass a listener to
+ * {@link GVRShaderManagers#addShader(String, String, GVRShaderCompileListener)}
+ * to be called back, on the GL thread, once that happened.
+ * 
+ * @param <ID>
+ *            {@link GVRCustomMaterialShaderId} or
+ *            {@link GVRCustomPostEffectShaderId}
+ */
+public interface GVRShaderCompileListener<ID> {
+    /**
+     * Called once the shader's program is done linking.
+     * 
+     * @param id
+     *            The id {@code addShader()} returned.
+     * @param linked
+     *            {@code false} if the shader failed to compile or link; the
+     *            GL log has the details.
+     */
+    public void onShaderCompiled(ID id, boolean linked);
+}
@@ -77,6 +77,27 @@ public interface GVRShaderManagers<MAP, ID> {
      */
     public ID addShader(String vertexShader, String fragmentShader);
 
+    /**
+     * Builds a shader program from the supplied vertex and fragment shader
+     * code, and reports when it can be used.
+     * 
+     * Compiling and linking do not stall rendering; {@code listener} is
+     * called on the GL thread once the program linked, or failed to.
+     * 
+     * @param vertexShader
+     *            GLSL source code for a vertex shader.
+     * @param fragmentShader
+     *            GLSL source code for a fragment shader.
+     * @param listener
+     *            Called once the program is done linking. May be
+     *            {@code null}.
+     * @return An opaque type that you can pass to {@link #getShaderMap(Object)
+     *         getShaderMap(ID)}, or to the {@link GVRMaterial} and
+     *         {@link GVRPostEffect} constructors and {@code setShader} methods.
+     */
+    public ID addShader(String vertexShader, String fragmentShader,
+            GVRShaderCompileListener<ID> listener);
+
     /**
      * Builds a shader program from the supplied vertex and fragment shader
      * code.
@@ -0,0 +1,104 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+import android.content.res.AssetManager;
+import android.graphics.Bitmap;
+
+/**
+ * Bitmap-based texture whose detail follows how it is seen.
+ * 
+ * <p>
+ * The whole mip chain is built when the texture is created, but only the
+ * levels that are needed are kept in GPU memory: each frame, a texture used
+ * as the {@code main_texture} of a visible object asks for the level its
+ * on-screen size calls for, and finer levels are uploaded as it comes closer.
+ * When the textures together exceed the {@linkplain #setMemoryBudget(long)
+ * memory budget}, the finest levels of the least recently seen textures are
+ * released first.
+ * 
+ * <p>
+ * Devices without OpenGL ES 3.0 keep the whole chain resident.
+ */
+public class GVRStreamedTexture extends GVRTexture {
+    /**
+     * Constructs a streamed texture from a pre-existing {@link Bitmap}.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param bitmap
+     *            A non-null {@link android.graphics.Bitmap.Config#ARGB_8888}
+     *            {@link Bitmap}; it can be recycled afterwards.
+     */
+    public GVRStreamedTexture(GVRContext gvrContext, Bitmap bitmap) {
+        super(gvrContext, NativeStreamedTexture.bitmapConstructor(bitmap));
+    }
+
+    /**
+     * Constructs a streamed texture from a PNG file in (or under) the
+     * {@code assets} directory.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param pngAssetFilename
+     *            The name of a {@code .png} file, relative to the assets
+     *            directory.
+     */
+    public GVRStreamedTexture(GVRContext gvrContext, String pngAssetFilename) {
+        super(gvrContext, NativeStreamedTexture.fileConstructor(gvrContext
+                .getContext().getAssets(), pngAssetFilename));
+    }
+
+    /**
+     * Set how much GPU memory all streamed textures together may use.
+     * 
+     * @param bytes
+     *            The budget, in bytes. The smallest levels of each texture
+     *            stay resident even over budget.
+     */
+    public static void setMemoryBudget(long bytes) {
+        NativeStreamedTexture.setMemoryBudget(bytes);
+    }
+
+    /**
+     * @return The current budget, in bytes.
+     */
+    public static long getMemoryBudget() {
+        return NativeStreamedTexture.getMemoryBudget();
+    }
+
+    /**
+     * @return The GPU memory streamed textures use now, in bytes.
+     */
+    public static long getResidentBytes() {
+        return NativeStreamedTexture.getResidentBytes();
+    }
+}
+
+class NativeStreamedTexture {
+    static native long bitmapConstructor(Bitmap bitmap);
+
+    static native long fileConstructor(AssetManager assetManager,
+            String filename);
+
+    static native void setMemoryBudget(long bytes);
+
+    static native long getMemoryBudget();
+
+    static native long getResidentBytes();
+
+    static native void update();
+}
@@ -24,6 +24,9 @@ public class GVRTexture extends GVRHybridObject {
     /**
      * Get the ID generated by {@code glGenTextures()}.
      * 
+     * If the texture is still being uploaded in the background, this waits
+     * for the upload to finish. Call it on the GL thread.
+     * 
      * @return The GL ID of the texture.
      */
     public int getId() {
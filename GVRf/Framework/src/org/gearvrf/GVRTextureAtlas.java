@@ -0,0 +1,199 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+import java.util.ArrayList;
+import java.util.List;
+
+import android.graphics.Bitmap;
+import android.graphics.Bitmap.Config;
+
+/**
+ * Packs many small bitmaps into a few shared texture pages.
+ * 
+ * Every sprite or prop with its own {@link GVRBitmapTexture} needs its own
+ * texture state, so no two of them can be drawn together. Put their bitmaps
+ * in an atlas instead, and {@linkplain Region#applyTo(GVRMaterial) apply}
+ * each {@link Region} to its material: the stock unlit shaders then read the
+ * region through the material's {@code uv_transform}, meshes keep their 0 to
+ * 1 texture coordinates, and the renderer draws materials that share a page
+ * one after another.
+ * 
+ * Images are packed with a skyline packer, and surrounded by a gutter of
+ * repeated edge texels so that mipmapping and bilinear filtering do not
+ * bleed neighbours in. Pages have as many mip levels as the gutter allows -
+ * none without GLES3.
+ * 
+ * Like other textures, an atlas must be created and added to on the GL
+ * thread.
+ */
+public class GVRTextureAtlas extends GVRHybridObject {
+    /** Default page width and height, in pixels */
+    public static final int DEFAULT_PAGE_SIZE = 2048;
+    /** Default gutter, in pixels: enough for two mip levels */
+    public static final int DEFAULT_GUTTER = 4;
+
+    private final int mPageSize;
+    private final int mGutter;
+    // the native pages are owned by these wrappers
+    private final List<GVRTexture> mPages = new ArrayList<GVRTexture>();
+
+    /**
+     * A bitmap's place in an atlas.
+     */
+    public static class Region {
+        private final GVRTexture mPage;
+        private final float[] mUvTransform;
+
+        Region(GVRTexture page, float[] uvTransform) {
+            mPage = page;
+            mUvTransform = uvTransform;
+        }
+
+        /** The atlas page the bitmap was copied to */
+        public GVRTexture getTexture() {
+            return mPage;
+        }
+
+        /**
+         * The scale (x and y) and offset (z and w) that map 0 to 1 texture
+         * coordinates onto this region of its page.
+         */
+        public float[] getUvTransform() {
+            return mUvTransform.clone();
+        }
+
+        /**
+         * Make the page {@code material}'s main texture, and set its
+         * {@code uv_transform} to this region.
+         */
+        public void applyTo(GVRMaterial material) {
+            material.setMainTexture(mPage);
+            material.setVec4(UV_TRANSFORM, mUvTransform[0], mUvTransform[1],
+                    mUvTransform[2], mUvTransform[3]);
+        }
+    }
+
+    /**
+     * The {@link GVRMaterial} vec4 key the stock unlit shaders read the
+     * texture coordinate transform from.
+     */
+    public static final String UV_TRANSFORM = "uv_transform";
+
+    /**
+     * Constructs an atlas of {@link #DEFAULT_PAGE_SIZE} pages with a
+     * {@link #DEFAULT_GUTTER}.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     */
+    public GVRTextureAtlas(GVRContext gvrContext) {
+        this(gvrContext, DEFAULT_PAGE_SIZE, DEFAULT_GUTTER);
+    }
+
+    /**
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param pageSize
+     *            Page width and height, in pixels
+     * @param gutter
+     *            Border of repeated edge texels around each image, in
+     *            pixels; rounded up to a power of two. 0 disables
+     *            mipmapping.
+     */
+    public GVRTextureAtlas(GVRContext gvrContext, int pageSize, int gutter) {
+        super(gvrContext, NativeTextureAtlas.ctor(pageSize, gutter));
+        mPageSize = pageSize;
+        int rounded = gutter > 0 ? 1 : 0;
+        while (rounded < gutter) {
+            rounded <<= 1;
+        }
+        mGutter = rounded;
+    }
+
+    /**
+     * Copy one bitmap into the atlas.
+     * 
+     * @param bitmap
+     *            An {@link Config#ARGB_8888} bitmap no larger than a page,
+     *            less its gutter. It can be recycled as soon as this returns.
+     * @return Where the bitmap went.
+     */
+    public Region add(Bitmap bitmap) {
+        return add(new Bitmap[] { bitmap })[0];
+    }
+
+    /**
+     * Copy several bitmaps into the atlas. Pages are mipmapped once, after
+     * all of them.
+     * 
+     * @param bitmaps
+     *            {@link Config#ARGB_8888} bitmaps no larger than a page, less
+     *            its gutter
+     * @return Where each bitmap went.
+     * @throws IllegalArgumentException
+     *             If a bitmap is not {@link Config#ARGB_8888} or does not fit
+     *             a page.
+     */
+    public Region[] add(Bitmap... bitmaps) {
+        int limit = mPageSize - 2 * mGutter;
+        for (Bitmap bitmap : bitmaps) {
+            if (bitmap.getConfig() != Config.ARGB_8888) {
+                throw new IllegalArgumentException(
+                        "Only ARGB_8888 bitmaps can be added to an atlas");
+            }
+            if (bitmap.getWidth() > limit || bitmap.getHeight() > limit) {
+                throw new IllegalArgumentException(String.format(
+                        "A %dx%d bitmap does not fit a %d page with a %d gutter",
+                        bitmap.getWidth(), bitmap.getHeight(), mPageSize,
+                        mGutter));
+            }
+        }
+
+        Region[] regions = new Region[bitmaps.length];
+        int[] position = new int[2];
+        for (int i = 0; i < bitmaps.length; ++i) {
+            int page = NativeTextureAtlas.add(getNative(), bitmaps[i],
+                    position);
+            while (mPages.size() <= page) {
+                mPages.add(new GVRTexture(getGVRContext(), NativeTextureAtlas
+                        .getPage(getNative(), mPages.size())));
+            }
+            float size = mPageSize;
+            regions[i] = new Region(mPages.get(page), new float[] {
+                    bitmaps[i].getWidth() / size,
+                    bitmaps[i].getHeight() / size, position[0] / size,
+                    position[1] / size });
+        }
+        NativeTextureAtlas.generateMipmaps(getNative());
+        return regions;
+    }
+
+    /** The number of pages started so far */
+    public int getPageCount() {
+        return mPages.size();
+    }
+}
+
+class NativeTextureAtlas {
+    static native long ctor(int pageSize, int gutter);
+
+    static native int add(long textureAtlas, Bitmap bitmap, int[] position);
+
+    static native long getPage(long textureAtlas, int index);
+
+    static native void generateMipmaps(long textureAtlas);
+}
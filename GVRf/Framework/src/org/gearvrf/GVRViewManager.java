@@ -713,6 +713,10 @@ class GVRViewManager extends GVRContext implements RotationSensorListener {
         }
 
         NativeGLDelete.processQueues();
+        // move streamed textures toward what the last frame asked for
+        NativeStreamedTexture.update();
+        // what was not drawn lately gives way while over the memory budget
+        NativeGpuMemory.update();
         
         return currentTime;
     }
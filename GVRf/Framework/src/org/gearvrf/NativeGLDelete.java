@@ -2,4 +2,8 @@ package org.gearvrf;
 
 class NativeGLDelete {
     static native void processQueues();
+
+    static native void setBudget(int budget);
+
+    static native int getBudget();
 }
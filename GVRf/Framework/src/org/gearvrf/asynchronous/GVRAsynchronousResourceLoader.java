@@ -17,6 +17,7 @@ package org.gearvrf.asynchronous;
 
 import java.io.FileDescriptor;
 import java.io.FileInputStream;
+import java.io.IOException;
 import java.io.InputStream;
 import java.util.Map;
 import java.util.concurrent.CancellationException;
@@ -140,6 +141,24 @@ public class GVRAsynchronousResourceLoader {
                 @Override
                 public void run() {
                     try {
+                        // KTX files and assets are mapped natively, and
+                        // uploaded from the mapping
+                        final long ktxFile = GVRCompressedTexture.openKtx(
+                                gvrContext, resource);
+                        if (ktxFile != 0) {
+                            resource.closeStream();
+                            gvrContext.runOnGlThread(new Runnable() {
+
+                                @Override
+                                public void run() {
+                                    loadKtxTexture(gvrContext, textureCache,
+                                            callback, resource, quality,
+                                            ktxFile);
+                                }
+                            });
+                            return;
+                        }
+
                         final CompressedTexture compressedTexture = CompressedTexture
                                 .load(resource.getStream(), false);
                         resource.closeStream();
@@ -164,6 +183,33 @@ public class GVRAsynchronousResourceLoader {
         }
     }
 
+    // on the GL thread
+    private static void loadKtxTexture(GVRContext gvrContext,
+            ResourceCache<GVRTexture> textureCache,
+            CompressedTextureCallback callback, GVRAndroidResource resource,
+            int quality, long ktxFile) {
+        GVRTexture texture = null;
+        try {
+            long ptr = NativeCompressedTexture.ktxConstructor(ktxFile);
+            if (ptr != 0) {
+                texture = new GVRCompressedTexture(gvrContext, ptr,
+                        NativeKtxFile.getTarget(ktxFile),
+                        NativeKtxFile.getLevels(ktxFile), quality);
+            }
+        } finally {
+            NativeKtxFile.close(ktxFile);
+        }
+        if (texture == null) {
+            callback.failed(new IOException(
+                    "Texture format not supported by this GPU"), resource);
+            return;
+        }
+        if (textureCache != null) {
+            textureCache.put(resource, texture);
+        }
+        callback.loaded(texture, resource);
+    }
+
     /**
      * Load a bitmap texture asynchronously.
      * 
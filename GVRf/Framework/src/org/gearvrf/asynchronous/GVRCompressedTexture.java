@@ -17,6 +17,9 @@ package org.gearvrf.asynchronous;
 
 import static android.opengl.GLES20.*;
 
+import android.content.res.AssetManager;
+
+import org.gearvrf.GVRAndroidResource;
 import org.gearvrf.GVRContext;
 import org.gearvrf.GVRTexture;
 import org.gearvrf.utility.Log;
@@ -59,10 +62,14 @@ public class GVRCompressedTexture extends GVRTexture {
      */
     public final int mQuality;
 
+    /** GL_TEXTURE_2D, or GL_TEXTURE_CUBE_MAP for a KTX cubemap */
+    private final int mTarget;
+
     GVRCompressedTexture(GVRContext gvrContext, int internalFormat, int width,
             int height, int imageSize, byte[] data, int levels, int quality) {
         super(gvrContext, NativeCompressedTexture.normalConstructor(GL_TARGET,
                 internalFormat, width, height, imageSize, data));
+        mTarget = GL_TARGET;
         mLevels = levels;
         mQuality = GVRCompressedTexture.clamp(quality);
 
@@ -72,23 +79,59 @@ public class GVRCompressedTexture extends GVRTexture {
     GVRCompressedTexture(GVRContext gvrContext, int target, int levels,
             int quality) {
         super(gvrContext, NativeCompressedTexture.mipmappedConstructor(target));
+        mTarget = target;
+        mLevels = levels;
+        mQuality = GVRCompressedTexture.clamp(quality);
+
+        updateMinification();
+    }
+
+    /**
+     * Wrap a texture made by {@link NativeCompressedTexture#ktxConstructor}.
+     */
+    GVRCompressedTexture(GVRContext gvrContext, long ptr, int target,
+            int levels, int quality) {
+        super(gvrContext, ptr);
+        mTarget = target;
         mLevels = levels;
         mQuality = GVRCompressedTexture.clamp(quality);
 
         updateMinification();
     }
 
+    /**
+     * Map and validate a KTX file or asset natively, off the GL thread.
+     * 
+     * @return A {@code NativeKtxFile} handle, to be passed to
+     *         {@link NativeCompressedTexture#ktxConstructor(long)} on the GL
+     *         thread and then {@linkplain NativeKtxFile#close(long) closed};
+     *         or 0, if {@code resource} is neither a file nor an asset, or is
+     *         not a KTX container this loader handles.
+     */
+    static long openKtx(GVRContext gvrContext, GVRAndroidResource resource) {
+        String filePath = resource.getFilePath();
+        if (filePath != null) {
+            return NativeKtxFile.openFile(filePath);
+        }
+        String assetPath = resource.getAssetPath();
+        if (assetPath != null) {
+            return NativeKtxFile.openAsset(gvrContext.getContext()
+                    .getAssets(), assetPath);
+        }
+        return 0;
+    }
+
     private void updateMinification() {
         boolean rebound = true; // in 2 out of 3 branches ...
         if (mLevels > 1) {
             rebind();
-            glTexParameteri(GL_TARGET, GL_TEXTURE_MIN_FILTER,
+            glTexParameteri(mTarget, GL_TEXTURE_MIN_FILTER,
                     selectMipMapMinification(mQuality));
         } else if (mQuality == QUALITY) {
             Log.d(TAG, "quality == %s, GL_TEXTURE_MIN_FILTER = %s", "QUALITY",
                     "GL_LINEAR");
             rebind();
-            glTexParameteri(GL_TARGET, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(mTarget, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         } else {
             rebound = false;
         }
@@ -118,11 +161,11 @@ public class GVRCompressedTexture extends GVRTexture {
     }
 
     protected void rebind() {
-        glBindTexture(GL_TARGET, getId());
+        glBindTexture(mTarget, getId());
     }
 
     protected void unbind() {
-        glBindTexture(GL_TARGET, 0);
+        glBindTexture(mTarget, 0);
     }
 
     /*
@@ -154,4 +197,19 @@ class NativeCompressedTexture {
             int width, int height, int imageSize, byte[] data);
 
     static native long mipmappedConstructor(int target);
+
+    /** Uploads every level and face; 0 if the GPU cannot use the format */
+    static native long ktxConstructor(long ktxFile);
+}
+
+class NativeKtxFile {
+    static native long openFile(String path);
+
+    static native long openAsset(AssetManager assetManager, String path);
+
+    static native int getTarget(long ktxFile);
+
+    static native int getLevels(long ktxFile);
+
+    static native void close(long ktxFile);
 }
\ No newline at end of file
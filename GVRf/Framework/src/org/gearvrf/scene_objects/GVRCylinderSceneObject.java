@@ -15,6 +15,9 @@
 
 package org.gearvrf.scene_objects;
 
+import java.nio.CharBuffer;
+import java.nio.FloatBuffer;
+
 import org.apache.commons.math3.geometry.euclidean.threed.Vector3D;
 import org.gearvrf.GVRSceneObject;
 import org.gearvrf.GVRRenderData;
@@ -33,10 +36,10 @@ public class GVRCylinderSceneObject extends GVRSceneObject {
     private static final float TOP_RADIUS = 0.5f;
     private static final float HEIGHT = 1.0f;
 
-    private float[] vertices;
-    private float[] normals;
-    private float[] texCoords;
-    private char[] indices;
+    private FloatBuffer vertices;
+    private FloatBuffer normals;
+    private FloatBuffer texCoords;
+    private CharBuffer indices;
     private int vertexCount = 0;
     private int texCoordCount = 0;
     private char indexCount = 0;
@@ -52,14 +55,9 @@ public class GVRCylinderSceneObject extends GVRSceneObject {
     public GVRCylinderSceneObject(GVRContext gvrContext) {
         super(gvrContext);
 
-        generateCylinder(BASE_RADIUS, TOP_RADIUS, HEIGHT, STACK_NUMBER,
-                SLICE_NUMBER);
-
         GVRMesh mesh = new GVRMesh(gvrContext);
-        mesh.setVertices(vertices);
-        mesh.setNormals(normals);
-        mesh.setTexCoords(texCoords);
-        mesh.setTriangles(indices);
+        generateCylinder(mesh, BASE_RADIUS, TOP_RADIUS, HEIGHT, STACK_NUMBER,
+                SLICE_NUMBER);
 
         GVRRenderData renderData = new GVRRenderData(gvrContext);
         attachRenderData(renderData);
@@ -100,22 +98,17 @@ public class GVRCylinderSceneObject extends GVRSceneObject {
                             + bottomRadius + ", topRadius=" + topRadius);
         }
 
-        generateCylinder(bottomRadius, topRadius, height, stackNumber,
-                sliceNumber);
-
         GVRMesh mesh = new GVRMesh(gvrContext);
-        mesh.setVertices(vertices);
-        mesh.setNormals(normals);
-        mesh.setTexCoords(texCoords);
-        mesh.setTriangles(indices);
+        generateCylinder(mesh, bottomRadius, topRadius, height, stackNumber,
+                sliceNumber);
 
         GVRRenderData renderData = new GVRRenderData(gvrContext);
         attachRenderData(renderData);
         renderData.setMesh(mesh);
     }
 
-    private void generateCylinder(float bottomRadius, float topRadius,
-            float height, int stackNumber, int sliceNumber) {
+    private void generateCylinder(GVRMesh mesh, float bottomRadius,
+            float topRadius, float height, int stackNumber, int sliceNumber) {
 
         int capNumber = 2;
         if (bottomRadius == 0) {
@@ -133,10 +126,11 @@ public class GVRCylinderSceneObject extends GVRSceneObject {
                 + (6 * sliceNumber * stackNumber);
         float halfHeight = height / 2.0f;
 
-        vertices = new float[3 * vertexNumber];
-        normals = new float[3 * vertexNumber];
-        texCoords = new float[2 * triangleNumber];
-        indices = new char[triangleNumber];
+        // fill the native mesh data in place
+        vertices = mesh.mapVertices(vertexNumber);
+        normals = mesh.mapNormals(vertexNumber);
+        texCoords = mesh.mapTexCoords(triangleNumber);
+        indices = mesh.mapTriangles(triangleNumber);
 
         // top cap
         // 3 * numSlices
@@ -154,6 +148,12 @@ public class GVRCylinderSceneObject extends GVRSceneObject {
             createCap(bottomRadius, -halfHeight, sliceNumber, -1.0f);
         }
 
+        mesh.unmapVertices();
+        mesh.unmapNormals();
+        mesh.unmapTexCoords();
+        mesh.unmapTriangles();
+        vertices = normals = texCoords = null;
+        indices = null;
     }
 
     private void createCap(float radius, float height, int sliceNumber,
@@ -172,43 +172,43 @@ public class GVRCylinderSceneObject extends GVRSceneObject {
             float s1 = 1.0f - ((float) (slice + 1) / sliceNumber);
             float s2 = (s0 + s1) / 2.0f;
 
-            vertices[vertexCount + 0] = x0;
-            vertices[vertexCount + 1] = y;
-            vertices[vertexCount + 2] = z0;
-            vertices[vertexCount + 3] = x1;
-            vertices[vertexCount + 4] = y;
-            vertices[vertexCount + 5] = z1;
-            vertices[vertexCount + 6] = 0.0f;
-            vertices[vertexCount + 7] = y;
-            vertices[vertexCount + 8] = 0.0f;
-
-            normals[vertexCount + 0] = 0.0f;
-            normals[vertexCount + 1] = normalDirection;
-            normals[vertexCount + 2] = 0.0f;
-            normals[vertexCount + 3] = 0.0f;
-            normals[vertexCount + 4] = normalDirection;
-            normals[vertexCount + 5] = 0.0f;
-            normals[vertexCount + 6] = 0.0f;
-            normals[vertexCount + 7] = normalDirection;
-            normals[vertexCount + 8] = 0.0f;
-
-            texCoords[texCoordCount + 0] = s0;
-            texCoords[texCoordCount + 1] = 0.0f;
-
-            texCoords[texCoordCount + 2] = s1;
-            texCoords[texCoordCount + 3] = 0.0f;
-
-            texCoords[texCoordCount + 4] = s2;
-            texCoords[texCoordCount + 5] = 1.0f;
+            vertices.put(vertexCount + 0, x0);
+            vertices.put(vertexCount + 1, y);
+            vertices.put(vertexCount + 2, z0);
+            vertices.put(vertexCount + 3, x1);
+            vertices.put(vertexCount + 4, y);
+            vertices.put(vertexCount + 5, z1);
+            vertices.put(vertexCount + 6, 0.0f);
+            vertices.put(vertexCount + 7, y);
+            vertices.put(vertexCount + 8, 0.0f);
+
+            normals.put(vertexCount + 0, 0.0f);
+            normals.put(vertexCount + 1, normalDirection);
+            normals.put(vertexCount + 2, 0.0f);
+            normals.put(vertexCount + 3, 0.0f);
+            normals.put(vertexCount + 4, normalDirection);
+            normals.put(vertexCount + 5, 0.0f);
+            normals.put(vertexCount + 6, 0.0f);
+            normals.put(vertexCount + 7, normalDirection);
+            normals.put(vertexCount + 8, 0.0f);
+
+            texCoords.put(texCoordCount + 0, s0);
+            texCoords.put(texCoordCount + 1, 0.0f);
+
+            texCoords.put(texCoordCount + 2, s1);
+            texCoords.put(texCoordCount + 3, 0.0f);
+
+            texCoords.put(texCoordCount + 4, s2);
+            texCoords.put(texCoordCount + 5, 1.0f);
 
             if (normalDirection > 0) {
-                indices[indexCount + 0] = (char) (triangleCount + 1);
-                indices[indexCount + 1] = (char) (triangleCount + 0);
-                indices[indexCount + 2] = (char) (triangleCount + 2);
+                indices.put(indexCount + 0, (char) (triangleCount + 1));
+                indices.put(indexCount + 1, (char) (triangleCount + 0));
+                indices.put(indexCount + 2, (char) (triangleCount + 2));
             } else {
-                indices[indexCount + 0] = (char) (triangleCount + 0);
-                indices[indexCount + 1] = (char) (triangleCount + 1);
-                indices[indexCount + 2] = (char) (triangleCount + 2);
+                indices.put(indexCount + 0, (char) (triangleCount + 0));
+                indices.put(indexCount + 1, (char) (triangleCount + 1));
+                indices.put(indexCount + 2, (char) (triangleCount + 2));
             }
 
             vertexCount += 9;
@@ -261,21 +261,21 @@ public class GVRCylinderSceneObject extends GVRSceneObject {
                 float s0 = slicePercentage0;
                 float s1 = slicePercentage1;
 
-                vertices[vertexCount + 0] = x0;
-                vertices[vertexCount + 1] = y0;
-                vertices[vertexCount + 2] = z0;
+                vertices.put(vertexCount + 0, x0);
+                vertices.put(vertexCount + 1, y0);
+                vertices.put(vertexCount + 2, z0);
 
-                vertices[vertexCount + 3] = x1;
-                vertices[vertexCount + 4] = y0;
-                vertices[vertexCount + 5] = z1;
+                vertices.put(vertexCount + 3, x1);
+                vertices.put(vertexCount + 4, y0);
+                vertices.put(vertexCount + 5, z1);
 
-                vertices[vertexCount + 6] = x2;
-                vertices[vertexCount + 7] = y1;
-                vertices[vertexCount + 8] = z2;
+                vertices.put(vertexCount + 6, x2);
+                vertices.put(vertexCount + 7, y1);
+                vertices.put(vertexCount + 8, z2);
 
-                vertices[vertexCount + 9] = x3;
-                vertices[vertexCount + 10] = y1;
-                vertices[vertexCount + 11] = z3;
+                vertices.put(vertexCount + 9, x3);
+                vertices.put(vertexCount + 10, y1);
+                vertices.put(vertexCount + 11, z3);
 
                 // calculate normal
                 Vector3D v1 = new Vector3D(x1 - x0, 0, z1 - z0);
@@ -285,38 +285,38 @@ public class GVRCylinderSceneObject extends GVRSceneObject {
                 nx = (float) v3.getX();
                 ny = (float) v3.getY();
                 nz = (float) v3.getZ();
-                normals[vertexCount + 0] = nx;
-                normals[vertexCount + 1] = ny;
-                normals[vertexCount + 2] = nz;
-                normals[vertexCount + 3] = nx;
-                normals[vertexCount + 4] = ny;
-                normals[vertexCount + 5] = nz;
-                normals[vertexCount + 6] = nx;
-                normals[vertexCount + 7] = ny;
-                normals[vertexCount + 8] = nz;
-                normals[vertexCount + 9] = nx;
-                normals[vertexCount + 10] = ny;
-                normals[vertexCount + 11] = nz;
-
-                texCoords[texCoordCount + 0] = s0;
-                texCoords[texCoordCount + 1] = t0;
-
-                texCoords[texCoordCount + 2] = s1;
-                texCoords[texCoordCount + 3] = t0;
-
-                texCoords[texCoordCount + 4] = s0;
-                texCoords[texCoordCount + 5] = t1;
-
-                texCoords[texCoordCount + 6] = s1;
-                texCoords[texCoordCount + 7] = t1;
-
-                indices[indexCount + 0] = (char) (triangleCount + 0); // 0
-                indices[indexCount + 1] = (char) (triangleCount + 1); // 1
-                indices[indexCount + 2] = (char) (triangleCount + 2); // 2
-
-                indices[indexCount + 3] = (char) (triangleCount + 2); // 2
-                indices[indexCount + 4] = (char) (triangleCount + 1); // 1
-                indices[indexCount + 5] = (char) (triangleCount + 3); // 3
+                normals.put(vertexCount + 0, nx);
+                normals.put(vertexCount + 1, ny);
+                normals.put(vertexCount + 2, nz);
+                normals.put(vertexCount + 3, nx);
+                normals.put(vertexCount + 4, ny);
+                normals.put(vertexCount + 5, nz);
+                normals.put(vertexCount + 6, nx);
+                normals.put(vertexCount + 7, ny);
+                normals.put(vertexCount + 8, nz);
+                normals.put(vertexCount + 9, nx);
+                normals.put(vertexCount + 10, ny);
+                normals.put(vertexCount + 11, nz);
+
+                texCoords.put(texCoordCount + 0, s0);
+                texCoords.put(texCoordCount + 1, t0);
+
+                texCoords.put(texCoordCount + 2, s1);
+                texCoords.put(texCoordCount + 3, t0);
+
+                texCoords.put(texCoordCount + 4, s0);
+                texCoords.put(texCoordCount + 5, t1);
+
+                texCoords.put(texCoordCount + 6, s1);
+                texCoords.put(texCoordCount + 7, t1);
+
+                indices.put(indexCount + 0, (char) (triangleCount + 0)); // 0
+                indices.put(indexCount + 1, (char) (triangleCount + 1)); // 1
+                indices.put(indexCount + 2, (char) (triangleCount + 2)); // 2
+
+                indices.put(indexCount + 3, (char) (triangleCount + 2)); // 2
+                indices.put(indexCount + 4, (char) (triangleCount + 1)); // 1
+                indices.put(indexCount + 5, (char) (triangleCount + 3)); // 3
 
                 vertexCount += 12;
                 texCoordCount += 8;
@@ -333,12 +333,12 @@ public class GVRCylinderSceneObject extends GVRSceneObject {
                 nx = (float) v3.getX();
                 ny = (float) v3.getY();
                 nz = (float) v3.getZ();
-                normals[i + 3] = nx;
-                normals[i + 4] = ny;
-                normals[i + 5] = nz;
-                normals[i + 12] = nx;
-                normals[i + 13] = ny;
-                normals[i + 14] = nz;
+                normals.put(i + 3, nx);
+                normals.put(i + 4, ny);
+                normals.put(i + 5, nz);
+                normals.put(i + 12, nx);
+                normals.put(i + 13, ny);
+                normals.put(i + 14, nz);
 
                 v1 = new Vector3D(normals[i + 9], normals[i + 10],
                         normals[i + 11]);
@@ -348,12 +348,12 @@ public class GVRCylinderSceneObject extends GVRSceneObject {
                 nx = (float) v3.getX();
                 ny = (float) v3.getY();
                 nz = (float) v3.getZ();
-                normals[i + 9] = nx;
-                normals[i + 10] = ny;
-                normals[i + 11] = nz;
-                normals[i + 18] = nx;
-                normals[i + 19] = ny;
-                normals[i + 20] = nz;
+                normals.put(i + 9, nx);
+                normals.put(i + 10, ny);
+                normals.put(i + 11, nz);
+                normals.put(i + 18, nx);
+                normals.put(i + 19, ny);
+                normals.put(i + 20, nz);
             }
             int i1 = vertexCount - 12;
             Vector3D v1 = new Vector3D(normals[i1 + 3], normals[i1 + 4],
@@ -365,12 +365,12 @@ public class GVRCylinderSceneObject extends GVRSceneObject {
             nx = (float) v3.getX();
             ny = (float) v3.getY();
             nz = (float) v3.getZ();
-            normals[i1 + 3] = nx;
-            normals[i1 + 4] = ny;
-            normals[i1 + 5] = nz;
-            normals[i2 + 0] = nx;
-            normals[i2 + 1] = ny;
-            normals[i2 + 2] = nz;
+            normals.put(i1 + 3, nx);
+            normals.put(i1 + 4, ny);
+            normals.put(i1 + 5, nz);
+            normals.put(i2 + 0, nx);
+            normals.put(i2 + 1, ny);
+            normals.put(i2 + 2, nz);
 
             v1 = new Vector3D(normals[i1 + 9], normals[i1 + 10],
                     normals[i1 + 11]);
@@ -379,12 +379,12 @@ public class GVRCylinderSceneObject extends GVRSceneObject {
             nx = (float) v3.getX();
             ny = (float) v3.getY();
             nz = (float) v3.getZ();
-            normals[i1 + 9] = nx;
-            normals[i1 + 10] = ny;
-            normals[i1 + 11] = nz;
-            normals[i2 + 6] = nx;
-            normals[i2 + 7] = ny;
-            normals[i2 + 8] = nz;
+            normals.put(i1 + 9, nx);
+            normals.put(i1 + 10, ny);
+            normals.put(i1 + 11, nz);
+            normals.put(i2 + 6, nx);
+            normals.put(i2 + 7, ny);
+            normals.put(i2 + 8, nz);
         }
     }
 }
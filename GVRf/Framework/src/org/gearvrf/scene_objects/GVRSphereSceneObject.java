@@ -15,6 +15,9 @@
 
 package org.gearvrf.scene_objects;
 
+import java.nio.CharBuffer;
+import java.nio.FloatBuffer;
+
 import org.gearvrf.GVRSceneObject;
 import org.gearvrf.GVRRenderData;
 import org.gearvrf.GVRContext;
@@ -29,10 +32,10 @@ public class GVRSphereSceneObject extends GVRSceneObject {
     private static final int STACK_NUMBER = 18;
     private static final int SLICE_NUMBER = 36;
 
-    private float[] vertices;
-    private float[] normals;
-    private float[] texCoords;
-    private char[] indices;
+    private FloatBuffer vertices;
+    private FloatBuffer normals;
+    private FloatBuffer texCoords;
+    private CharBuffer indices;
 
     private int vertexCount = 0;
     private int texCoordCount = 0;
@@ -49,30 +52,27 @@ public class GVRSphereSceneObject extends GVRSceneObject {
     public GVRSphereSceneObject(GVRContext gvrContext) {
         super(gvrContext);
 
-        generateSphere(STACK_NUMBER, SLICE_NUMBER);
-
         GVRMesh mesh = new GVRMesh(gvrContext);
-        mesh.setVertices(vertices);
-        mesh.setNormals(normals);
-        mesh.setTexCoords(texCoords);
-        mesh.setTriangles(indices);
+        generateSphere(mesh, STACK_NUMBER, SLICE_NUMBER);
 
         GVRRenderData renderData = new GVRRenderData(gvrContext);
         attachRenderData(renderData);
         renderData.setMesh(mesh);
     }
 
-    private void generateSphere(int stackNumber, int sliceNumber) {
+    private void generateSphere(GVRMesh mesh, int stackNumber,
+            int sliceNumber) {
         int capVertexNumber = 3 * sliceNumber;
         int bodyVertexNumber = 4 * sliceNumber * stackNumber;
         int vertexNumber = (2 * capVertexNumber) + bodyVertexNumber;
         int triangleNumber = (2 * capVertexNumber)
                 + (6 * sliceNumber * stackNumber);
 
-        vertices = new float[3 * vertexNumber];
-        normals = new float[3 * vertexNumber];
-        texCoords = new float[2 * vertexNumber];
-        indices = new char[triangleNumber];
+        // fill the native mesh data in place
+        vertices = mesh.mapVertices(vertexNumber);
+        normals = mesh.mapNormals(vertexNumber);
+        texCoords = mesh.mapTexCoords(vertexNumber);
+        indices = mesh.mapTriangles(triangleNumber);
 
         // bottom cap
         createCap(0, stackNumber, sliceNumber, false);
@@ -82,6 +82,13 @@ public class GVRSphereSceneObject extends GVRSceneObject {
 
         // top cap
         createCap(stackNumber, stackNumber, sliceNumber, true);
+
+        mesh.unmapVertices();
+        mesh.unmapNormals();
+        mesh.unmapTexCoords();
+        mesh.unmapTriangles();
+        vertices = normals = texCoords = null;
+        indices = null;
     }
 
     private void createCap(int stack, int stackNumber, int sliceNumber,
@@ -133,45 +140,45 @@ public class GVRSphereSceneObject extends GVRSceneObject {
             float y2 = (float) (sinTheta2 * sinPhi1);
             float z2 = (float) cosTheta2;
 
-            vertices[vertexCount + 0] = x0;
-            vertices[vertexCount + 1] = y0;
-            vertices[vertexCount + 2] = z0;
+            vertices.put(vertexCount + 0, x0);
+            vertices.put(vertexCount + 1, y0);
+            vertices.put(vertexCount + 2, z0);
 
-            vertices[vertexCount + 3] = x1;
-            vertices[vertexCount + 4] = y1;
-            vertices[vertexCount + 5] = z1;
+            vertices.put(vertexCount + 3, x1);
+            vertices.put(vertexCount + 4, y1);
+            vertices.put(vertexCount + 5, z1);
 
-            vertices[vertexCount + 6] = x2;
-            vertices[vertexCount + 7] = y2;
-            vertices[vertexCount + 8] = z2;
+            vertices.put(vertexCount + 6, x2);
+            vertices.put(vertexCount + 7, y2);
+            vertices.put(vertexCount + 8, z2);
 
-            normals[vertexCount + 0] = x0;
-            normals[vertexCount + 1] = y0;
-            normals[vertexCount + 2] = z0;
+            normals.put(vertexCount + 0, x0);
+            normals.put(vertexCount + 1, y0);
+            normals.put(vertexCount + 2, z0);
 
-            normals[vertexCount + 3] = x1;
-            normals[vertexCount + 4] = y1;
-            normals[vertexCount + 5] = z1;
+            normals.put(vertexCount + 3, x1);
+            normals.put(vertexCount + 4, y1);
+            normals.put(vertexCount + 5, z1);
 
-            normals[vertexCount + 6] = x2;
-            normals[vertexCount + 7] = y2;
-            normals[vertexCount + 8] = z2;
+            normals.put(vertexCount + 6, x2);
+            normals.put(vertexCount + 7, y2);
+            normals.put(vertexCount + 8, z2);
 
-            texCoords[texCoordCount + 0] = s0;
-            texCoords[texCoordCount + 1] = t0;
-            texCoords[texCoordCount + 2] = s1;
-            texCoords[texCoordCount + 3] = t0;
-            texCoords[texCoordCount + 4] = s2;
-            texCoords[texCoordCount + 5] = t1;
+            texCoords.put(texCoordCount + 0, s0);
+            texCoords.put(texCoordCount + 1, t0);
+            texCoords.put(texCoordCount + 2, s1);
+            texCoords.put(texCoordCount + 3, t0);
+            texCoords.put(texCoordCount + 4, s2);
+            texCoords.put(texCoordCount + 5, t1);
 
             if (top) {
-                indices[indexCount + 0] = (char) (triangleCount + 1);
-                indices[indexCount + 1] = (char) (triangleCount + 0);
-                indices[indexCount + 2] = (char) (triangleCount + 2);
+                indices.put(indexCount + 0, (char) (triangleCount + 1));
+                indices.put(indexCount + 1, (char) (triangleCount + 0));
+                indices.put(indexCount + 2, (char) (triangleCount + 2));
             } else {
-                indices[indexCount + 0] = (char) (triangleCount + 0);
-                indices[indexCount + 1] = (char) (triangleCount + 1);
-                indices[indexCount + 2] = (char) (triangleCount + 2);
+                indices.put(indexCount + 0, (char) (triangleCount + 0));
+                indices.put(indexCount + 1, (char) (triangleCount + 1));
+                indices.put(indexCount + 2, (char) (triangleCount + 2));
             }
 
             vertexCount += 9;
@@ -227,55 +234,55 @@ public class GVRSphereSceneObject extends GVRSceneObject {
                 float y3 = (float) (sinTheta2 * sinPhi2);
                 float z3 = (float) cosTheta2;
 
-                vertices[vertexCount + 0] = x0;
-                vertices[vertexCount + 1] = y0;
-                vertices[vertexCount + 2] = z0;
+                vertices.put(vertexCount + 0, x0);
+                vertices.put(vertexCount + 1, y0);
+                vertices.put(vertexCount + 2, z0);
 
-                vertices[vertexCount + 3] = x1;
-                vertices[vertexCount + 4] = y1;
-                vertices[vertexCount + 5] = z1;
+                vertices.put(vertexCount + 3, x1);
+                vertices.put(vertexCount + 4, y1);
+                vertices.put(vertexCount + 5, z1);
 
-                vertices[vertexCount + 6] = x2;
-                vertices[vertexCount + 7] = y2;
-                vertices[vertexCount + 8] = z2;
+                vertices.put(vertexCount + 6, x2);
+                vertices.put(vertexCount + 7, y2);
+                vertices.put(vertexCount + 8, z2);
 
-                vertices[vertexCount + 9] = x3;
-                vertices[vertexCount + 10] = y3;
-                vertices[vertexCount + 11] = z3;
+                vertices.put(vertexCount + 9, x3);
+                vertices.put(vertexCount + 10, y3);
+                vertices.put(vertexCount + 11, z3);
 
-                normals[vertexCount + 0] = x0;
-                normals[vertexCount + 1] = y0;
-                normals[vertexCount + 2] = z0;
+                normals.put(vertexCount + 0, x0);
+                normals.put(vertexCount + 1, y0);
+                normals.put(vertexCount + 2, z0);
 
-                normals[vertexCount + 3] = x1;
-                normals[vertexCount + 4] = y1;
-                normals[vertexCount + 5] = z1;
+                normals.put(vertexCount + 3, x1);
+                normals.put(vertexCount + 4, y1);
+                normals.put(vertexCount + 5, z1);
 
-                normals[vertexCount + 6] = x2;
-                normals[vertexCount + 7] = y2;
-                normals[vertexCount + 8] = z2;
+                normals.put(vertexCount + 6, x2);
+                normals.put(vertexCount + 7, y2);
+                normals.put(vertexCount + 8, z2);
 
-                normals[vertexCount + 9] = x3;
-                normals[vertexCount + 10] = y3;
-                normals[vertexCount + 11] = z3;
+                normals.put(vertexCount + 9, x3);
+                normals.put(vertexCount + 10, y3);
+                normals.put(vertexCount + 11, z3);
 
-                texCoords[texCoordCount + 0] = s0;
-                texCoords[texCoordCount + 1] = t0;
-                texCoords[texCoordCount + 2] = s1;
-                texCoords[texCoordCount + 3] = t0;
-                texCoords[texCoordCount + 4] = s0;
-                texCoords[texCoordCount + 5] = t1;
-                texCoords[texCoordCount + 6] = s1;
-                texCoords[texCoordCount + 7] = t1;
+                texCoords.put(texCoordCount + 0, s0);
+                texCoords.put(texCoordCount + 1, t0);
+                texCoords.put(texCoordCount + 2, s1);
+                texCoords.put(texCoordCount + 3, t0);
+                texCoords.put(texCoordCount + 4, s0);
+                texCoords.put(texCoordCount + 5, t1);
+                texCoords.put(texCoordCount + 6, s1);
+                texCoords.put(texCoordCount + 7, t1);
 
                 // 0, 1, 2
                 // 2, 1, 3
-                indices[indexCount + 0] = (char) (triangleCount + 0);
-                indices[indexCount + 1] = (char) (triangleCount + 2);
-                indices[indexCount + 2] = (char) (triangleCount + 1);
-                indices[indexCount + 3] = (char) (triangleCount + 2);
-                indices[indexCount + 4] = (char) (triangleCount + 3);
-                indices[indexCount + 5] = (char) (triangleCount + 1);
+                indices.put(indexCount + 0, (char) (triangleCount + 0));
+                indices.put(indexCount + 1, (char) (triangleCount + 2));
+                indices.put(indexCount + 2, (char) (triangleCount + 1));
+                indices.put(indexCount + 3, (char) (triangleCount + 2));
+                indices.put(indexCount + 4, (char) (triangleCount + 3));
+                indices.put(indexCount + 5, (char) (triangleCount + 1));
 
                 vertexCount += 12;
                 texCoordCount += 8;
@@ -0,0 +1,156 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Helpers shared by the host tests: OBJ loading and checks.
+ ***************************************************************************/
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "glm/glm.hpp"
+
+#include "objects/mesh.h"
+
+// counts failures instead of stopping, so one run reports all of them
+extern int g_failures;
+
+#define CHECK(condition, ...) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed: ", __FILE__, __LINE__, \
+                    #condition); \
+            fprintf(stderr, __VA_ARGS__); \
+            fputc('\n', stderr); \
+            ++g_failures; \
+        } \
+    } while (0)
+
+/*
+ * Load a triangulated OBJ the way the importer sees it: corners sharing a
+ * position and texture coordinate become one vertex, so texture seams
+ * stay split, and normals are averaged over the corners joined. Returns 0
+ * if the file cannot be read.
+ */
+inline gvr::Mesh* loadObj(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == 0) {
+        return 0;
+    }
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> tex_coords;
+    std::vector<glm::vec3> normals;
+    std::map<std::pair<int, int>, int> vertex_ids;
+    std::vector<glm::vec3> vertices;
+    std::vector<glm::vec2> vertex_tex_coords;
+    std::vector<glm::vec3> vertex_normals;
+    std::vector<unsigned short> triangles;
+
+    char line[512];
+    while (fgets(line, sizeof(line), file) != 0) {
+        glm::vec3 v;
+        if (sscanf(line, "v %f %f %f", &v.x, &v.y, &v.z) == 3) {
+            positions.push_back(v);
+        } else if (sscanf(line, "vt %f %f", &v.x, &v.y) == 2) {
+            tex_coords.push_back(glm::vec2(v));
+        } else if (sscanf(line, "vn %f %f %f", &v.x, &v.y, &v.z) == 3) {
+            normals.push_back(v);
+        } else if (strncmp(line, "f ", 2) == 0) {
+            char* corner = strtok(line + 2, " \t\r\n");
+            for (int k = 0; k < 3 && corner != 0; ++k) {
+                int p = 0, t = 0, n = 0;
+                if (sscanf(corner, "%d/%d/%d", &p, &t, &n) != 3) {
+                    sscanf(corner, "%d//%d", &p, &n);
+                }
+                std::pair<int, int> key(p - 1, t - 1);
+                auto it = vertex_ids.find(key);
+                if (it == vertex_ids.end()) {
+                    it = vertex_ids.insert(
+                            std::make_pair(key, int(vertices.size()))).first;
+                    vertices.push_back(positions[p - 1]);
+                    vertex_tex_coords.push_back(
+                            t > 0 ? tex_coords[t - 1] : glm::vec2(0.0f));
+                    vertex_normals.push_back(glm::vec3(0.0f));
+                }
+                if (n > 0) {
+                    vertex_normals[it->second] += normals[n - 1];
+                }
+                triangles.push_back(it->second);
+                corner = strtok(0, " \t\r\n");
+            }
+        }
+    }
+    fclose(file);
+
+    for (size_t i = 0; i < vertex_normals.size(); ++i) {
+        float length = glm::length(vertex_normals[i]);
+        if (length > 0.0f) {
+            vertex_normals[i] /= length;
+        }
+    }
+
+    gvr::Mesh* mesh = new gvr::Mesh();
+    mesh->set_vertices(std::move(vertices));
+    mesh->set_normals(std::move(vertex_normals));
+    mesh->set_tex_coords(std::move(vertex_tex_coords));
+    mesh->set_triangles(std::move(triangles));
+    return mesh;
+}
+
+// distance from p to the closest point of triangle abc
+inline float pointTriangleDistance(const glm::vec3& p, const glm::vec3& a,
+        const glm::vec3& b, const glm::vec3& c) {
+    // Ericson, Real-Time Collision Detection, 5.1.5
+    glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+    float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        return glm::length(ap);
+    }
+    glm::vec3 bp = p - b;
+    float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) {
+        return glm::length(bp);
+    }
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return glm::length(ap - ab * (d1 / (d1 - d3)));
+    }
+    glm::vec3 cp = p - c;
+    float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) {
+        return glm::length(cp);
+    }
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return glm::length(ap - ac * (d2 / (d2 - d6)));
+    }
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return glm::length(bp - (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+    }
+    float denominator = 1.0f / (va + vb + vc);
+    float v = vb * denominator, w = vc * denominator;
+    return glm::length(ap - ab * v - ac * w);
+}
+
+#endif
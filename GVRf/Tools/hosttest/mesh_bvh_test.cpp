@@ -0,0 +1,210 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Host test of MeshBVH: random rays against an OBJ model (bunny.obj) must
+ * hit what testing every triangle hits, also with lists changed since the
+ * build.
+ ***************************************************************************/
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "objects/mesh_bvh.h"
+
+#include "host_test.h"
+
+using namespace gvr;
+
+int g_failures = 0;
+
+namespace {
+
+const int RAY_COUNT = 18000;
+
+// a fixed generator keeps runs repeatable
+struct Random {
+    explicit Random(uint32_t seed) :
+            state(seed) {
+    }
+
+    // uniform in [0, 1)
+    float next() {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / 16777216.0f;
+    }
+
+    glm::vec3 inside(const glm::vec3& low, const glm::vec3& high) {
+        return glm::vec3(low.x + (high.x - low.x) * next(),
+                low.y + (high.y - low.y) * next(),
+                low.z + (high.z - low.z) * next());
+    }
+
+    uint32_t state;
+};
+
+// the same test MeshBVH makes, on every triangle with valid indices
+bool bruteForce(const std::vector<glm::vec3>& vertices,
+        const std::vector<unsigned short>& triangles, const glm::vec3& origin,
+        const glm::vec3& direction, float& distance) {
+    const float EPSILON = 0.00001f;
+    distance = std::numeric_limits<float>::infinity();
+    for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+        if (triangles[i] >= vertices.size()
+                || triangles[i + 1] >= vertices.size()
+                || triangles[i + 2] >= vertices.size()) {
+            continue;
+        }
+        const glm::vec3& a = vertices[triangles[i]];
+        glm::vec3 e1 = vertices[triangles[i + 1]] - a;
+        glm::vec3 e2 = vertices[triangles[i + 2]] - a;
+        glm::vec3 p = glm::cross(direction, e2);
+        float det = glm::dot(e1, p);
+        if (det > -EPSILON && det < EPSILON) {
+            continue;
+        }
+        float inv_det = 1.0f / det;
+        glm::vec3 s = origin - a;
+        float u = glm::dot(s, p) * inv_det;
+        if (u < 0.0f || u > 1.0f) {
+            continue;
+        }
+        glm::vec3 q = glm::cross(s, e1);
+        float v = glm::dot(direction, q) * inv_det;
+        if (v < 0.0f || u + v > 1.0f) {
+            continue;
+        }
+        float t = glm::dot(e2, q) * inv_det;
+        if (t > EPSILON && t < distance) {
+            distance = t;
+        }
+    }
+    return distance < std::numeric_limits<float>::infinity();
+}
+
+/*
+ * Rays from around and inside the bounds towards points inside them, a
+ * tenth of them along an axis. Returns the number of hits.
+ */
+int checkRays(const MeshBVH& bvh, const std::vector<glm::vec3>& vertices,
+        const std::vector<unsigned short>& triangles, const char* name) {
+    glm::vec3 low(vertices[0]), high(low);
+    for (auto it = vertices.begin(); it != vertices.end(); ++it) {
+        low = glm::min(low, *it);
+        high = glm::max(high, *it);
+    }
+    glm::vec3 margin = (high - low) * 0.5f;
+
+    Random random(12345);
+    int hits = 0;
+    int mismatches = 0;
+    for (int i = 0; i < RAY_COUNT; ++i) {
+        glm::vec3 origin = random.inside(low - margin, high + margin);
+        glm::vec3 direction = random.inside(low, high) - origin;
+        if (i % 10 == 0) {
+            int axis = i / 10 % 3;
+            float along = direction[axis];
+            direction = glm::vec3(0.0f);
+            direction[axis] = along < 0.0f ? -1.0f : 1.0f;
+        }
+        if (glm::length(direction) == 0.0f) {
+            continue;
+        }
+
+        float expected = 0.0f;
+        bool expected_hit = bruteForce(vertices, triangles, origin, direction,
+                expected);
+        float distance = -1.0f;
+        glm::vec3 hit;
+        bool found = bvh.intersect(vertices, triangles, origin, direction,
+                distance, hit);
+        if (found != expected_hit
+                || (found
+                        && std::fabs(distance - expected)
+                                > 1e-5f * std::max(1.0f, expected))) {
+            if (mismatches++ < 10) {
+                CHECK(false, "%s ray %d: %s at %g, expected %s at %g", name,
+                        i, found ? "hit" : "miss", distance,
+                        expected_hit ? "hit" : "miss", expected);
+            }
+            continue;
+        }
+        if (found) {
+            ++hits;
+            glm::vec3 point = origin + distance * direction;
+            CHECK(glm::length(hit - point)
+                    <= 1e-4f * std::max(1.0f, glm::length(point)),
+                    "%s ray %d: hit point off the ray", name, i);
+        }
+    }
+    CHECK(mismatches == 0, "%s: %d of %d rays disagree", name, mismatches,
+            RAY_COUNT);
+    printf("%s: %d of %d rays hit\n", name, hits, RAY_COUNT);
+    return hits;
+}
+
+void checkMesh(const Mesh& mesh) {
+    MeshBVH bvh;
+    bvh.build(mesh.vertices(), mesh.triangles());
+    CHECK(!bvh.empty(), "no hierarchy built");
+    int hits = checkRays(bvh, mesh.vertices(), mesh.triangles(), "bunny");
+    CHECK(hits > RAY_COUNT / 10, "only %d rays hit", hits);
+
+    // triangles with out of range indices are left out of the build
+    std::vector<unsigned short> broken(mesh.triangles());
+    for (size_t i = 0; i < broken.size(); i += 30) {
+        broken[i] = mesh.vertices().size();
+    }
+    MeshBVH broken_bvh;
+    broken_bvh.build(mesh.vertices(), broken);
+    checkRays(broken_bvh, mesh.vertices(), broken, "bad indices");
+
+    // a pick between resizing the lists and the rebuild sees the old
+    // hierarchy; it must stay inside the new lists
+    std::vector<unsigned short> fewer(mesh.triangles().begin(),
+            mesh.triangles().begin() + mesh.triangles().size() / 2 + 1);
+    checkRays(bvh, mesh.vertices(), fewer, "fewer triangles");
+    std::vector<glm::vec3> fewer_vertices(mesh.vertices().begin(),
+            mesh.vertices().begin() + mesh.vertices().size() / 2);
+    checkRays(bvh, fewer_vertices, mesh.triangles(), "fewer vertices");
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s bunny.obj\n", argv[0]);
+        return 2;
+    }
+    Mesh* mesh = loadObj(argv[1]);
+    if (mesh == 0) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 2;
+    }
+
+    checkMesh(*mesh);
+    delete mesh;
+
+    if (g_failures > 0) {
+        printf("%d checks failed\n", g_failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
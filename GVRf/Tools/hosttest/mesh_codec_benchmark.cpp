@@ -0,0 +1,122 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Host benchmark of MeshCodec decoding: bunny.obj as loaded (vertices
+ * shared across triangles) and with every corner its own vertex, decoded
+ * on one thread and spread over every core.
+ ***************************************************************************/
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <stdio.h>
+
+#include "engine/importer/mesh_codec.h"
+
+#include "host_test.h"
+
+using namespace gvr;
+
+int g_failures = 0;
+
+namespace {
+
+// bytes the decoded mesh takes as plain arrays
+size_t rawSize(const Mesh& mesh) {
+    return mesh.vertices().size() * sizeof(glm::vec3)
+            + mesh.normals().size() * sizeof(glm::vec3)
+            + mesh.tex_coords().size() * sizeof(glm::vec2)
+            + mesh.triangles().size() * sizeof(unsigned short);
+}
+
+Mesh* unweld(const Mesh& mesh) {
+    std::vector<glm::vec3> vertices, normals;
+    std::vector<glm::vec2> tex_coords;
+    std::vector<unsigned short> triangles;
+    for (size_t i = 0; i < mesh.triangles().size(); ++i) {
+        unsigned short index = mesh.triangles()[i];
+        triangles.push_back(vertices.size());
+        vertices.push_back(mesh.vertices()[index]);
+        normals.push_back(mesh.normals()[index]);
+        tex_coords.push_back(mesh.tex_coords()[index]);
+    }
+    Mesh* result = new Mesh();
+    result->set_vertices(std::move(vertices));
+    result->set_normals(std::move(normals));
+    result->set_tex_coords(std::move(tex_coords));
+    result->set_triangles(std::move(triangles));
+    return result;
+}
+
+double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+}
+
+void benchmark(const char* name, const Mesh& mesh) {
+    std::vector<unsigned char> data = MeshCodec::encode(mesh);
+    size_t raw = rawSize(mesh);
+
+    // repeat for at least a second
+    int runs = 0;
+    auto start = std::chrono::steady_clock::now();
+    do {
+        delete MeshCodec::decode(data.data(), data.size());
+        ++runs;
+    } while (seconds(start) < 1.0);
+    double single = raw * runs / seconds(start) / 1e6;
+
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<const void*> batch(threads * 8, data.data());
+    std::vector<size_t> sizes(batch.size(), data.size());
+    runs = 0;
+    start = std::chrono::steady_clock::now();
+    do {
+        std::vector<Mesh*> meshes = MeshCodec::decode(batch, sizes, threads);
+        for (auto it = meshes.begin(); it != meshes.end(); ++it) {
+            delete *it;
+        }
+        runs += batch.size();
+    } while (seconds(start) < 1.0);
+    double parallel = raw * runs / seconds(start) / 1e6;
+
+    printf("%s: %zu vertices, %zu KB raw, %zu KB encoded, decode %.0f MB/s, "
+            "%.0f MB/s on %d threads\n", name, mesh.vertices().size(),
+            raw / 1024, data.size() / 1024, single, parallel, threads);
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s bunny.obj\n", argv[0]);
+        return 2;
+    }
+    Mesh* mesh = loadObj(argv[1]);
+    if (mesh == 0) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 2;
+    }
+    Mesh* unwelded = unweld(*mesh);
+
+    benchmark("shared", *mesh);
+    benchmark("unwelded", *unwelded);
+
+    delete unwelded;
+    delete mesh;
+    return 0;
+}
@@ -0,0 +1,188 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Host test of MeshCodec: round trips an OBJ model (bunny.obj) and feeds
+ * the decoder corrupted copies of it.
+ ***************************************************************************/
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "engine/importer/mesh_codec.h"
+
+#include "host_test.h"
+
+using namespace gvr;
+
+int g_failures = 0;
+
+namespace {
+
+// largest difference between two components after quantizing to bits over
+// the given extent
+float step(float extent, int bits) {
+    return extent / ((1 << bits) - 1);
+}
+
+void checkRoundTrip(const Mesh& source) {
+    std::vector<unsigned char> data = MeshCodec::encode(source);
+    Mesh* mesh = MeshCodec::decode(data.data(), data.size());
+    CHECK(mesh != 0, "decode returned no mesh");
+    if (mesh == 0) {
+        return;
+    }
+    printf("round trip: %zu vertices, %zu indices in %zu bytes\n",
+            source.vertices().size(), source.triangles().size(), data.size());
+
+    CHECK(mesh->vertices().size() == source.vertices().size(),
+            "%zu vertices decoded, %zu encoded", mesh->vertices().size(),
+            source.vertices().size());
+    CHECK(mesh->triangles().size() == source.triangles().size(),
+            "%zu indices decoded, %zu encoded", mesh->triangles().size(),
+            source.triangles().size());
+    CHECK(mesh->normals().size() == mesh->vertices().size()
+            && mesh->tex_coords().size() == mesh->vertices().size(),
+            "attributes missing after decode");
+    if (mesh->triangles().size() != source.triangles().size()
+            || mesh->normals().size() != mesh->vertices().size()
+            || mesh->tex_coords().size() != mesh->vertices().size()) {
+        delete mesh;
+        return;
+    }
+
+    glm::vec3 low(source.vertices()[0]), high(low);
+    for (auto it = source.vertices().begin(); it != source.vertices().end();
+            ++it) {
+        low = glm::min(low, *it);
+        high = glm::max(high, *it);
+    }
+    glm::vec2 uv_low(source.tex_coords()[0]), uv_high(uv_low);
+    for (auto it = source.tex_coords().begin();
+            it != source.tex_coords().end(); ++it) {
+        uv_low = glm::min(uv_low, *it);
+        uv_high = glm::max(uv_high, *it);
+    }
+
+    // vertices are renumbered, so compare corner by corner
+    float max_position = 0.0f, max_tex_coord = 0.0f, min_normal_dot = 1.0f;
+    for (size_t i = 0; i < source.triangles().size(); ++i) {
+        unsigned short a = source.triangles()[i];
+        unsigned short b = mesh->triangles()[i];
+        CHECK(b < mesh->vertices().size(), "index %zu out of range", i);
+        if (b >= mesh->vertices().size()) {
+            break;
+        }
+        glm::vec3 d = glm::abs(source.vertices()[a] - mesh->vertices()[b]);
+        glm::vec2 t = glm::abs(source.tex_coords()[a] - mesh->tex_coords()[b]);
+        for (int k = 0; k < 3; ++k) {
+            max_position = std::max(max_position,
+                    d[k] / step(high[k] - low[k],
+                            MeshCodec::DEFAULT_POSITION_BITS));
+        }
+        for (int k = 0; k < 2; ++k) {
+            max_tex_coord = std::max(max_tex_coord,
+                    t[k] / step(uv_high[k] - uv_low[k],
+                            MeshCodec::DEFAULT_TEX_COORD_BITS));
+        }
+        min_normal_dot = std::min(min_normal_dot,
+                glm::dot(source.normals()[a], mesh->normals()[b]));
+    }
+    // half a step from rounding, a little more from float arithmetic
+    CHECK(max_position <= 0.51f, "positions off by %g steps", max_position);
+    CHECK(max_tex_coord <= 0.51f, "texture coordinates off by %g steps",
+            max_tex_coord);
+    CHECK(min_normal_dot > 0.999f, "normals off by acos(%g)",
+            min_normal_dot);
+    delete mesh;
+}
+
+// decode must return a mesh or throw its error string, nothing else
+bool decodes(const std::vector<unsigned char>& data) {
+    try {
+        Mesh* mesh = MeshCodec::decode(data.data(), data.size());
+        delete mesh;
+        return true;
+    } catch (std::string error) {
+        return false;
+    }
+}
+
+void checkCorruption(const Mesh& source) {
+    std::vector<unsigned char> data = MeshCodec::encode(source);
+
+    int rejected = 0;
+    for (size_t size = 0; size < data.size(); size += 97) {
+        std::vector<unsigned char> truncated(data.begin(),
+                data.begin() + size);
+        CHECK(!decodes(truncated), "%zu of %zu bytes decoded", size,
+                data.size());
+    }
+
+    // the first stream's length follows the 4 byte magic, version, counts,
+    // flags and 3 bit counts
+    const size_t stream_length = 4 + 4 * 4 + 3;
+    std::vector<unsigned char> huge(data);
+    memset(&huge[stream_length], 0xff, 4);
+    CHECK(!decodes(huge), "a 4G symbol stream decoded");
+    huge = data;
+    memset(&huge[12], 0xff, 4);
+    CHECK(!decodes(huge), "4G indices decoded");
+
+    // flip bits all over; a fixed generator keeps runs repeatable
+    uint32_t state = 12345;
+    const int FLIPS = 20000;
+    for (int i = 0; i < FLIPS; ++i) {
+        state = state * 1664525u + 1013904223u;
+        size_t byte = (state >> 8) % data.size();
+        int bit = state >> 29;
+        std::vector<unsigned char> flipped(data);
+        flipped[byte] ^= 1 << bit;
+        if (!decodes(flipped)) {
+            ++rejected;
+        }
+    }
+    printf("corruption: %d of %d bit flips rejected\n", rejected, FLIPS);
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s bunny.obj\n", argv[0]);
+        return 2;
+    }
+    Mesh* source = loadObj(argv[1]);
+    if (source == 0) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 2;
+    }
+
+    checkRoundTrip(*source);
+    checkCorruption(*source);
+    delete source;
+
+    if (g_failures > 0) {
+        printf("%d checks failed\n", g_failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,252 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Host test of MeshSimplifier: simplifies an OBJ model (bunny.obj) and
+ * checks every level against the source.
+ ***************************************************************************/
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include <stdio.h>
+
+#include "engine/lod/mesh_simplifier.h"
+
+#include "host_test.h"
+
+using namespace gvr;
+
+int g_failures = 0;
+
+namespace {
+
+typedef std::tuple<float, float, float> Point;
+
+Point point(const glm::vec3& v) {
+    return Point(v.x, v.y, v.z);
+}
+
+// positions of the vertices on edges that only one triangle uses
+std::set<Point> borderPositions(const Mesh& mesh) {
+    const std::vector<unsigned short>& triangles = mesh.triangles();
+    std::map<std::pair<int, int>, int> edge_faces;
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+        for (int e = 0; e < 3; ++e) {
+            int a = triangles[i + e], b = triangles[i + (e + 1) % 3];
+            ++edge_faces[std::make_pair(std::min(a, b), std::max(a, b))];
+        }
+    }
+    std::set<Point> positions;
+    for (auto it = edge_faces.begin(); it != edge_faces.end(); ++it) {
+        if (it->second == 1) {
+            positions.insert(point(mesh.vertices()[it->first.first]));
+            positions.insert(point(mesh.vertices()[it->first.second]));
+        }
+    }
+    return positions;
+}
+
+// number of vertices at each position
+std::map<Point, int> positionCounts(const Mesh& mesh) {
+    std::map<Point, int> counts;
+    for (auto it = mesh.vertices().begin(); it != mesh.vertices().end();
+            ++it) {
+        ++counts[point(*it)];
+    }
+    return counts;
+}
+
+/*
+ * Largest distance from points spread over the triangles of from to the
+ * closest triangle of to, by brute force.
+ */
+float maxDeviation(const Mesh& from, const Mesh& to) {
+    const int STEPS = 3;
+    const std::vector<glm::vec3>& from_vertices = from.vertices();
+    const std::vector<unsigned short>& from_triangles = from.triangles();
+    const std::vector<glm::vec3>& to_vertices = to.vertices();
+    const std::vector<unsigned short>& to_triangles = to.triangles();
+
+    float max_distance = 0.0f;
+    for (size_t i = 0; i < from_triangles.size(); i += 3) {
+        const glm::vec3& a = from_vertices[from_triangles[i]];
+        const glm::vec3& b = from_vertices[from_triangles[i + 1]];
+        const glm::vec3& c = from_vertices[from_triangles[i + 2]];
+        for (int u = 0; u <= STEPS; ++u) {
+            for (int v = 0; u + v <= STEPS; ++v) {
+                glm::vec3 p = a + (b - a) * (float(u) / STEPS)
+                        + (c - a) * (float(v) / STEPS);
+                float distance = 1e30f;
+                for (size_t j = 0; j < to_triangles.size(); j += 3) {
+                    distance = std::min(distance,
+                            pointTriangleDistance(p,
+                                    to_vertices[to_triangles[j]],
+                                    to_vertices[to_triangles[j + 1]],
+                                    to_vertices[to_triangles[j + 2]]));
+                }
+                max_distance = std::max(max_distance, distance);
+            }
+        }
+    }
+    return max_distance;
+}
+
+void checkLevel(const Mesh& source, const LodLevel& level, float ratio) {
+    CHECK(level.mesh != 0, "ratio %g has no mesh", ratio);
+    if (level.mesh == 0) {
+        return;
+    }
+    const Mesh& mesh = *level.mesh;
+    const std::vector<unsigned short>& triangles = mesh.triangles();
+    size_t source_count = source.triangles().size() / 3;
+    size_t target = static_cast<size_t>(source_count * ratio);
+    size_t count = triangles.size() / 3;
+
+    CHECK(triangles.size() % 3 == 0, "ratio %g: %zu indices", ratio,
+            triangles.size());
+    CHECK(mesh.normals().size() == mesh.vertices().size()
+            && mesh.tex_coords().size() == mesh.vertices().size(),
+            "ratio %g: attribute counts differ", ratio);
+    for (size_t i = 0; i + 2 < triangles.size(); i += 3) {
+        unsigned short a = triangles[i], b = triangles[i + 1], c =
+                triangles[i + 2];
+        CHECK(a < mesh.vertices().size() && b < mesh.vertices().size()
+                && c < mesh.vertices().size(),
+                "ratio %g: triangle %zu indexes past %zu vertices", ratio,
+                i / 3, mesh.vertices().size());
+        CHECK(a != b && b != c && a != c, "ratio %g: triangle %zu degenerate",
+                ratio, i / 3);
+    }
+
+    // each collapse removes two triangles, or one on a border
+    CHECK(count <= target && count + 2 >= target,
+            "ratio %g: %zu triangles for a target of %zu", ratio, count,
+            target);
+
+    // vertices keep their position and texture coordinates
+    std::set<std::tuple<float, float, float, float, float> > source_vertices;
+    for (size_t i = 0; i < source.vertices().size(); ++i) {
+        const glm::vec3& p = source.vertices()[i];
+        const glm::vec2& t = source.tex_coords()[i];
+        source_vertices.insert(std::make_tuple(p.x, p.y, p.z, t.x, t.y));
+    }
+    for (size_t i = 0; i < mesh.vertices().size(); ++i) {
+        const glm::vec3& p = mesh.vertices()[i];
+        const glm::vec2& t = mesh.tex_coords()[i];
+        CHECK(source_vertices.count(std::make_tuple(p.x, p.y, p.z, t.x, t.y)),
+                "ratio %g: vertex %zu is not a source vertex", ratio, i);
+    }
+
+    // seams stay split at the same place
+    std::map<Point, int> source_counts = positionCounts(source);
+    std::map<Point, int> counts = positionCounts(mesh);
+    for (auto it = source_counts.begin(); it != source_counts.end(); ++it) {
+        if (it->second > 1) {
+            CHECK(counts[it->first] == it->second,
+                    "ratio %g: seam at (%g, %g, %g) has %d of %d vertices",
+                    ratio, std::get<0>(it->first), std::get<1>(it->first),
+                    std::get<2>(it->first), counts[it->first], it->second);
+        }
+    }
+
+    // borders only lose vertices along themselves
+    std::set<Point> source_border = borderPositions(source);
+    std::set<Point> border = borderPositions(mesh);
+    CHECK(border.empty() == source_border.empty(),
+            "ratio %g: %zu border vertices, %zu in the source", ratio,
+            border.size(), source_border.size());
+    for (auto it = border.begin(); it != border.end(); ++it) {
+        CHECK(source_border.count(*it),
+                "ratio %g: border vertex (%g, %g, %g) was not on a border",
+                ratio, std::get<0>(*it), std::get<1>(*it), std::get<2>(*it));
+    }
+
+    float deviation = std::max(maxDeviation(source, mesh),
+            maxDeviation(mesh, source));
+    printf("ratio %g: %zu triangles, geometric error %g, measured %g\n",
+            ratio, count, level.geometric_error, deviation);
+    // the bound is exact where the deviation peaks at a vertex; allow for
+    // the two distance routines rounding differently
+    CHECK(level.geometric_error >= deviation * (1.0f - 1e-5f),
+            "ratio %g: geometric error %g below the measured %g", ratio,
+            level.geometric_error, deviation);
+}
+
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s bunny.obj\n", argv[0]);
+        return 2;
+    }
+    Mesh* source = loadObj(argv[1]);
+    if (source == 0) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 2;
+    }
+    printf("%s: %zu vertices, %zu triangles\n", argv[1],
+            source->vertices().size(), source->triangles().size() / 3);
+
+    std::vector<float> ratios;
+    ratios.push_back(0.5f);
+    ratios.push_back(0.25f);
+    ratios.push_back(0.1f);
+
+    std::vector<LodLevel> levels = MeshSimplifier::generateLods(*source,
+            ratios);
+    CHECK(levels.size() == ratios.size(), "%zu levels for %zu ratios",
+            levels.size(), ratios.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        checkLevel(*source, levels[i], ratios[i]);
+        if (i > 0) {
+            CHECK(levels[i].geometric_error >= levels[i - 1].geometric_error,
+                    "error shrinks from ratio %g to %g", ratios[i - 1],
+                    ratios[i]);
+        }
+    }
+
+    // the threaded overload gives the same levels
+    std::vector<const Mesh*> meshes(3, source);
+    std::vector<std::vector<LodLevel> > results = MeshSimplifier::generateLods(
+            meshes, ratios, 2);
+    CHECK(results.size() == meshes.size(), "%zu results for %zu meshes",
+            results.size(), meshes.size());
+    for (size_t m = 0; m < results.size(); ++m) {
+        for (size_t i = 0; i < results[m].size() && i < levels.size(); ++i) {
+            CHECK(results[m][i].mesh->triangles()
+                    == levels[i].mesh->triangles()
+                    && results[m][i].geometric_error
+                            == levels[i].geometric_error,
+                    "mesh %zu ratio %g differs when threaded", m, ratios[i]);
+            delete results[m][i].mesh;
+        }
+    }
+
+    for (size_t i = 0; i < levels.size(); ++i) {
+        delete levels[i].mesh;
+    }
+    delete source;
+
+    if (g_failures > 0) {
+        printf("%d checks failed\n", g_failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
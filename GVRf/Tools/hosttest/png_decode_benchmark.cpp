@@ -0,0 +1,199 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Host benchmark of PNG decoding: synthetic 2048x2048 RGBA, palette with
+ * tRNS and 16-bit gray images, decoded from memory with PngLoader with
+ * and without premultiplied alpha, then batches of them on PngDecodePool.
+ ***************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "objects/textures/png_decode_pool.h"
+#include "objects/textures/png_loader.h"
+
+using namespace gvr;
+
+namespace {
+
+const int SIZE = 2048;
+const int POOL_IMAGES = 8;
+
+struct Image {
+    const char* name;
+    std::vector<unsigned char> png;
+};
+
+double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+}
+
+void appendData(png_structp png_ptr, png_bytep data, png_size_t length) {
+    std::vector<unsigned char>* png =
+            static_cast<std::vector<unsigned char>*>(png_get_io_ptr(png_ptr));
+    png->insert(png->end(), data, data + length);
+}
+
+void flushData(png_structp png_ptr) {
+}
+
+/*
+ * Gradients with a little noise, so the files compress about like real
+ * textures do; a fixed generator keeps runs comparable.
+ */
+unsigned char sample(int x, int y, int channel, uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<unsigned char>(x * (channel + 1) + y * (3 - channel)
+            + (state >> 29));
+}
+
+std::vector<unsigned char> encode(int color_type, int bit_depth) {
+    std::vector<unsigned char> png;
+    png_structp png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, 0,
+            0, 0);
+    png_infop info_ptr = png_create_info_struct(png_ptr);
+    if (setjmp(png_jmpbuf(png_ptr))) {
+        png_destroy_write_struct(&png_ptr, &info_ptr);
+        png.clear();
+        return png;
+    }
+    png_set_write_fn(png_ptr, &png, appendData, flushData);
+    png_set_IHDR(png_ptr, info_ptr, SIZE, SIZE, bit_depth, color_type,
+            PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
+            PNG_FILTER_TYPE_DEFAULT);
+
+    int channels = 1;
+    if (color_type == PNG_COLOR_TYPE_PALETTE) {
+        png_color palette[256];
+        png_byte alpha[256];
+        for (int i = 0; i < 256; ++i) {
+            palette[i].red = i;
+            palette[i].green = 255 - i;
+            palette[i].blue = i * 7;
+            alpha[i] = i * 3;
+        }
+        png_set_PLTE(png_ptr, info_ptr, palette, 256);
+        png_set_tRNS(png_ptr, info_ptr, alpha, 256, 0);
+    } else if (color_type == PNG_COLOR_TYPE_RGB_ALPHA) {
+        channels = 4;
+    }
+    png_write_info(png_ptr, info_ptr);
+
+    int bytes = channels * bit_depth / 8;
+    std::vector<unsigned char> row(SIZE * bytes);
+    uint32_t state = 12345;
+    for (int y = 0; y < SIZE; ++y) {
+        for (int x = 0; x < SIZE; ++x) {
+            for (int c = 0; c < bytes; ++c) {
+                row[x * bytes + c] = sample(x, y, c % 4, state);
+            }
+        }
+        png_write_row(png_ptr, row.data());
+    }
+    png_write_end(png_ptr, info_ptr);
+    png_destroy_write_struct(&png_ptr, &info_ptr);
+    return png;
+}
+
+// one image at a time on this thread, into the same buffer
+double decodeLoop(const Image& image, bool premultiply) {
+    std::vector<unsigned char> pixels(SIZE * SIZE * 4);
+    int runs = 0;
+    auto start = std::chrono::steady_clock::now();
+    do {
+        PngLoader loader;
+        loader.setPremultiplyAlpha(premultiply);
+        if (!loader.begin(image.png.data(), image.png.size())
+                || loader.pOutImage.width != SIZE
+                || !loader.decode(pixels.data(), SIZE * 4)) {
+            fprintf(stderr, "%s: decoding failed\n", image.name);
+            return 0.0;
+        }
+        ++runs;
+    } while (seconds(start) < 1.0);
+    return seconds(start) / runs;
+}
+
+// POOL_IMAGES copies at once into malloc()ed buffers
+double decodePool(const Image& image, int threads) {
+    PngDecodePool pool(threads);
+    PngDecodePool::Options options;
+    options.premultiply_alpha = true;
+    int decoded = 0;
+    int runs = 0;
+    auto start = std::chrono::steady_clock::now();
+    do {
+        for (int i = 0; i < POOL_IMAGES; ++i) {
+            std::vector<unsigned char> png(image.png);
+            pool.decode(png, options, PngDecodePool::mallocAllocator,
+                    [&decoded](bool ok, int width, int height,
+                            unsigned char* pixels, size_t stride) {
+                        if (ok) {
+                            __sync_fetch_and_add(&decoded, 1);
+                        }
+                        free(pixels);
+                    });
+        }
+        pool.wait();
+        runs += POOL_IMAGES;
+    } while (seconds(start) < 1.0);
+    if (decoded != runs) {
+        fprintf(stderr, "%s: %d of %d pool decodes failed\n", image.name,
+                runs - decoded, runs);
+    }
+    return seconds(start) / runs;
+}
+
+}
+
+int main(int argc, char** argv) {
+    Image images[] = { { "RGBA 8-bit", encode(PNG_COLOR_TYPE_RGB_ALPHA, 8) },
+            { "palette + tRNS", encode(PNG_COLOR_TYPE_PALETTE, 8) },
+            { "gray 16-bit", encode(PNG_COLOR_TYPE_GRAY, 16) } };
+    const double megapixels = SIZE * SIZE / 1e6;
+
+    for (size_t i = 0; i < sizeof(images) / sizeof(images[0]); ++i) {
+        const Image& image = images[i];
+        if (image.png.empty()) {
+            fprintf(stderr, "%s: encoding failed\n", image.name);
+            return 1;
+        }
+        double plain = decodeLoop(image, false);
+        double premultiplied = decodeLoop(image, true);
+        if (plain == 0.0 || premultiplied == 0.0) {
+            return 1;
+        }
+        printf("%-15s %5zu KB: %4.0f ms %4.0f Mpix/s, premultiplied "
+                "%4.0f ms %4.0f Mpix/s\n", image.name, image.png.size() / 1024,
+                plain * 1e3, megapixels / plain, premultiplied * 1e3,
+                megapixels / premultiplied);
+    }
+
+    const int thread_counts[] = { 1, 2, 4 };
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(int); ++i) {
+        double time = decodePool(images[0], thread_counts[i]);
+        printf("pool, %d %s images on %d threads: %4.0f Mpix/s\n",
+                POOL_IMAGES, images[0].name, thread_counts[i],
+                megapixels / time);
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Host stand-in for the engine's Mesh: only the CPU side vertex data, so
+ * code that builds or reads meshes compiles without GL.
+ ***************************************************************************/
+
+#ifndef MESH_H_
+#define MESH_H_
+
+#include <utility>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace gvr {
+
+class Mesh {
+public:
+    const std::vector<glm::vec3>& vertices() const {
+        return vertices_;
+    }
+
+    void set_vertices(std::vector<glm::vec3>&& vertices) {
+        vertices_ = std::move(vertices);
+    }
+
+    const std::vector<glm::vec3>& normals() const {
+        return normals_;
+    }
+
+    void set_normals(std::vector<glm::vec3>&& normals) {
+        normals_ = std::move(normals);
+    }
+
+    const std::vector<glm::vec2>& tex_coords() const {
+        return tex_coords_;
+    }
+
+    void set_tex_coords(std::vector<glm::vec2>&& tex_coords) {
+        tex_coords_ = std::move(tex_coords);
+    }
+
+    const std::vector<unsigned short>& triangles() const {
+        return triangles_;
+    }
+
+    void set_triangles(std::vector<unsigned short>&& triangles) {
+        triangles_ = std::move(triangles);
+    }
+
+private:
+    std::vector<glm::vec3> vertices_;
+    std::vector<glm::vec3> normals_;
+    std::vector<glm::vec2> tex_coords_;
+    std::vector<unsigned short> triangles_;
+};
+
+}
+#endif
@@ -0,0 +1,118 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * ASTC encoding for the texture cooker, through ARM's astcenc.
+ ***************************************************************************/
+
+#include "astc_encoder.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ktx_writer.h"
+
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+#ifndef GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR 0x93D0
+#endif
+
+namespace gvr {
+
+// in GL enum order
+static const char* const ASTC_FOOTPRINTS[14] = { "4x4", "5x4", "5x5", "6x5",
+        "6x6", "8x5", "8x6", "8x8", "10x5", "10x6", "10x8", "10x10", "12x10",
+        "12x12" };
+
+static const size_t ASTC_HEADER_SIZE = 16;
+static const unsigned int ASTC_MAGIC = 0x5CA1AB13;
+
+static std::string astcenc_command = "astcenc";
+
+GLenum AstcEncoder::internalFormat(const std::string& block, bool srgb) {
+    for (int i = 0; i < 14; ++i) {
+        if (block == ASTC_FOOTPRINTS[i]) {
+            return (srgb ?
+                    GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR :
+                    GL_COMPRESSED_RGBA_ASTC_4x4_KHR) + i;
+        }
+    }
+    return 0;
+}
+
+void AstcEncoder::setCommand(const std::string& command) {
+    astcenc_command = command;
+}
+
+static bool readFile(const std::string& path,
+        std::vector<unsigned char>& contents) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL) {
+        return false;
+    }
+    unsigned char buffer[65536];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        contents.insert(contents.end(), buffer, buffer + count);
+    }
+    fclose(file);
+    return true;
+}
+
+std::vector<unsigned char> AstcEncoder::encode(const RgbaImage& image,
+        const std::string& block, bool srgb, const std::string& quality) {
+    std::vector<unsigned char> blocks;
+    const char* tmp = getenv("TMPDIR");
+    std::string dir = std::string(tmp != NULL ? tmp : "/tmp")
+            + "/texcook.XXXXXX";
+    if (mkdtemp(&dir[0]) == NULL) {
+        fprintf(stderr, "texcook: cannot create %s\n", dir.c_str());
+        return blocks;
+    }
+    std::string input = dir + "/level.ktx";
+    std::string output = dir + "/level.astc";
+
+    std::vector<std::vector<unsigned char> > level(1, image.pixels);
+    std::string command = astcenc_command + (srgb ? " -cs '" : " -cl '")
+            + input + "' '" + output + "' " + block + " -" + quality
+            + " -silent";
+    std::vector<unsigned char> astc;
+    if (!writeKtx(input, GL_RGBA8, image.width, image.height, level)) {
+        fprintf(stderr, "texcook: cannot write %s\n", input.c_str());
+    } else if (system(command.c_str()) != 0) {
+        fprintf(stderr, "texcook: '%s' failed\n", command.c_str());
+    } else if (!readFile(output, astc) || astc.size() < ASTC_HEADER_SIZE) {
+        fprintf(stderr, "texcook: astcenc wrote no %s\n", output.c_str());
+    } else {
+        unsigned int magic;
+        memcpy(&magic, astc.data(), sizeof(magic));
+        if (magic == ASTC_MAGIC) {
+            blocks.assign(astc.begin() + ASTC_HEADER_SIZE, astc.end());
+        } else {
+            fprintf(stderr, "texcook: %s is not an .astc file\n",
+                    output.c_str());
+        }
+    }
+    unlink(input.c_str());
+    unlink(output.c_str());
+    rmdir(dir.c_str());
+    return blocks;
+}
+
+}
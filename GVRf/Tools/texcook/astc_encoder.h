@@ -13,51 +13,38 @@
  * limitations under the License.
  */
 
-
 /***************************************************************************
- * Renders a GL_TEXTURE_EXTERNAL_OES texture.
+ * ASTC encoding for the texture cooker, through ARM's astcenc.
  ***************************************************************************/
 
-#ifndef OES_SHADER_H_
-#define OES_SHADER_H_
+#ifndef ASTC_ENCODER_H_
+#define ASTC_ENCODER_H_
 
-#include <memory>
+#include <string>
+#include <vector>
 
-#define __gl2_h_
 #include "GLES3/gl3.h"
-#include <GLES2/gl2ext.h>
-#include "glm/glm.hpp"
-#include "glm/gtc/type_ptr.hpp"
 
-#include "objects/recyclable_object.h"
+#include "mip_chain.h"
 
 namespace gvr {
-class GLProgram;
-class RenderData;
 
-class OESShader: public RecyclableObject {
+/*
+ * Runs the astcenc executable (https://github.com/ARM-software/astc-encoder,
+ * found on the PATH unless set with setCommand()) on each level; writing a
+ * competitive ASTC encoder is out of this tool's scope.
+ */
+class AstcEncoder {
 public:
-    OESShader();
-    ~OESShader();
-    void recycle();
-    void render(const glm::mat4& mvp_matrix, RenderData* render_data);
-
-private:
-    OESShader(const OESShader& oes_shader);
-    OESShader(OESShader&& oes_shader);
-    OESShader& operator=(const OESShader& oes_shader);
-    OESShader& operator=(OESShader&& oes_shader);
-
-private:
-    GLProgram* program_;
-    GLuint a_position_;
-    GLuint a_tex_coord_;
-    GLuint u_mvp_;
-    GLuint u_texture_;
-    GLuint u_color_;
-    GLuint u_opacity_;
+    // block is a 2D footprint such as "6x6"; 0 if unknown
+    static GLenum internalFormat(const std::string& block, bool srgb);
+
+    static void setCommand(const std::string& command);
+
+    // empty on failure
+    static std::vector<unsigned char> encode(const RgbaImage& image,
+            const std::string& block, bool srgb, const std::string& quality);
 };
 
 }
-
 #endif
@@ -0,0 +1,319 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * ETC2 RGB8 and RGBA8 (EAC alpha) block encoder for the texture cooker.
+ ***************************************************************************/
+
+#include "etc_encoder.h"
+
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+
+#include "objects/textures/etc_decoder.h"
+
+namespace gvr {
+
+// pixels are numbered down the columns, as in EtcDecoder: i = x * 4 + y
+
+static const int ETC_MODIFIERS[8][4] = { { 2, 8, -2, -8 },
+        { 5, 17, -5, -17 }, { 9, 29, -9, -29 }, { 13, 42, -13, -42 }, { 18,
+                60, -18, -60 }, { 24, 80, -24, -80 }, { 33, 106, -33, -106 }, {
+                47, 183, -47, -183 } };
+
+static const int EAC_MODIFIERS[16][8] = { { -3, -6, -9, -15, 2, 5, 8, 14 }, {
+        -3, -7, -10, -13, 2, 6, 9, 12 }, { -2, -5, -8, -13, 1, 4, 7, 12 }, {
+        -2, -4, -6, -13, 1, 3, 5, 12 }, { -3, -6, -8, -12, 2, 5, 7, 11 }, {
+        -3, -7, -9, -11, 2, 6, 8, 10 }, { -4, -7, -8, -11, 3, 6, 7, 10 }, {
+        -3, -5, -8, -11, 2, 4, 7, 10 }, { -2, -6, -8, -10, 1, 5, 7, 9 }, { -2,
+        -5, -8, -10, 1, 4, 7, 9 }, { -2, -4, -8, -10, 1, 3, 7, 9 }, { -2, -5,
+        -7, -10, 1, 4, 6, 9 }, { -3, -4, -7, -10, 2, 3, 6, 9 }, { -1, -2, -3,
+        -10, 0, 1, 2, 9 }, { -4, -6, -8, -9, 3, 5, 7, 8 }, { -3, -5, -7, -9,
+        2, 4, 6, 8 } };
+
+static inline int clamp255(int value) {
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+static inline int quantize(float value, int max) {
+    int q = static_cast<int>(value * max / 255.0f + 0.5f);
+    return q < 0 ? 0 : (q > max ? max : q);
+}
+
+static inline void writeBE32(unsigned char* p, unsigned int value) {
+    p[0] = value >> 24;
+    p[1] = value >> 16;
+    p[2] = value >> 8;
+    p[3] = value;
+}
+
+static int blockError(const unsigned char block[8],
+        const unsigned char rgba[16][4]) {
+    unsigned char decoded[16 * 4];
+    EtcDecoder::decode(GL_COMPRESSED_RGB8_ETC2, block, 8, 4, 4, decoded);
+    int error = 0;
+    for (int i = 0; i < 16; ++i) {
+        // decoded is row-major, rgba is column-major
+        const unsigned char* d = decoded + ((i % 4) * 4 + i / 4) * 4;
+        for (int c = 0; c < 3; ++c) {
+            int e = d[c] - rgba[i][c];
+            error += e * e;
+        }
+    }
+    return error;
+}
+
+/*
+ * The best table and per-pixel modifiers for the pixels of one subblock
+ * around base; returns the error, and ORs the indices into lo.
+ */
+static int fitSubblock(const unsigned char rgba[16][4], const int* pixels,
+        const int base[3], int* table, unsigned int* lo) {
+    int best_error = INT_MAX;
+    unsigned int best_bits = 0;
+    for (int t = 0; t < 8; ++t) {
+        int error = 0;
+        unsigned int bits = 0;
+        for (int p = 0; p < 8 && error < best_error; ++p) {
+            int i = pixels[p];
+            int best_pixel_error = INT_MAX, best_index = 0;
+            for (int index = 0; index < 4; ++index) {
+                int m = ETC_MODIFIERS[t][index];
+                int pixel_error = 0;
+                for (int c = 0; c < 3; ++c) {
+                    int e = clamp255(base[c] + m) - rgba[i][c];
+                    pixel_error += e * e;
+                }
+                if (pixel_error < best_pixel_error) {
+                    best_pixel_error = pixel_error;
+                    best_index = index;
+                }
+            }
+            error += best_pixel_error;
+            bits |= ((best_index >> 1) << (16 + i)) | ((best_index & 1) << i);
+        }
+        if (error < best_error) {
+            best_error = error;
+            best_bits = bits;
+            *table = t;
+        }
+    }
+    *lo |= best_bits;
+    return best_error;
+}
+
+// individual and differential modes, for both flips
+static int encodeEtc1(const unsigned char rgba[16][4], unsigned char* out) {
+    int best_error = INT_MAX;
+    for (int flip = 0; flip < 2; ++flip) {
+        int pixels[2][8];
+        float average[2][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+        int count[2] = { 0, 0 };
+        for (int i = 0; i < 16; ++i) {
+            int x = i / 4, y = i % 4;
+            int sub = flip ? (y >= 2) : (x >= 2);
+            pixels[sub][count[sub]++] = i;
+            for (int c = 0; c < 3; ++c) {
+                average[sub][c] += rgba[i][c] / 8.0f;
+            }
+        }
+
+        for (int differential = 0; differential < 2; ++differential) {
+            int q[2][3], base[2][3];
+            int max = differential ? 31 : 15;
+            bool valid = true;
+            for (int c = 0; c < 3; ++c) {
+                q[0][c] = quantize(average[0][c], max);
+                q[1][c] = quantize(average[1][c], max);
+                if (differential) {
+                    int delta = q[1][c] - q[0][c];
+                    valid = valid && delta >= -4 && delta <= 3;
+                    base[0][c] = (q[0][c] << 3) | (q[0][c] >> 2);
+                    base[1][c] = (q[1][c] << 3) | (q[1][c] >> 2);
+                } else {
+                    base[0][c] = q[0][c] * 17;
+                    base[1][c] = q[1][c] * 17;
+                }
+            }
+            if (!valid) {
+                continue;
+            }
+
+            int table[2];
+            unsigned int lo = 0;
+            int error = fitSubblock(rgba, pixels[0], base[0], &table[0], &lo)
+                    + fitSubblock(rgba, pixels[1], base[1], &table[1], &lo);
+            if (error >= best_error) {
+                continue;
+            }
+            best_error = error;
+            for (int c = 0; c < 3; ++c) {
+                out[c] = differential ?
+                        (q[0][c] << 3) | ((q[1][c] - q[0][c]) & 7) :
+                        (q[0][c] << 4) | q[1][c];
+            }
+            out[3] = (table[0] << 5) | (table[1] << 2) | (differential << 1)
+                    | flip;
+            writeBE32(out + 4, lo);
+        }
+    }
+    return best_error;
+}
+
+// least-squares color planes, with the mode selected by overflowing blue
+static void encodePlanar(const unsigned char rgba[16][4], unsigned char* out) {
+    int o[3], h[3], v[3];
+    for (int c = 0; c < 3; ++c) {
+        float sum = 0.0f, sum_x = 0.0f, sum_y = 0.0f;
+        for (int i = 0; i < 16; ++i) {
+            float x = i / 4 - 1.5f, y = i % 4 - 1.5f;
+            sum += rgba[i][c];
+            sum_x += x * rgba[i][c];
+            sum_y += y * rgba[i][c];
+        }
+        // c(x, y) = origin + x * dx + y * dy
+        float dx = sum_x / 20.0f, dy = sum_y / 20.0f;
+        float origin = sum / 16.0f - 1.5f * dx - 1.5f * dy;
+        int max = c == 1 ? 127 : 63;
+        o[c] = quantize(origin, max);
+        h[c] = quantize(origin + 4.0f * dx, max);
+        v[c] = quantize(origin + 4.0f * dy, max);
+    }
+
+    unsigned int hi = (o[0] << 25) | ((o[1] >> 6) << 24)
+            | ((o[1] & 0x3F) << 17) | ((o[2] >> 5) << 16)
+            | (((o[2] >> 3) & 3) << 11) | ((o[2] & 7) << 7)
+            | ((h[0] >> 1) << 2) | (1 << 1) | (h[0] & 1);
+    unsigned int lo = (h[1] << 25) | (h[2] << 19) | (v[0] << 13)
+            | (v[1] << 6) | v[2];
+
+    // red and green must not overflow: set bits 63 and 55 as needed
+    int r = (hi >> 27) & 0x1F, dr = ((hi >> 24) & 7) - (((hi >> 24) & 4) << 1);
+    if (r + dr < 0) {
+        hi |= 1u << 31;
+    }
+    int g = (hi >> 19) & 0x1F, dg = ((hi >> 16) & 7) - (((hi >> 16) & 4) << 1);
+    if (g + dg < 0) {
+        hi |= 1u << 23;
+    }
+    // blue must: either negative through bit 42, or past 31 through 47..45
+    int b = (hi >> 11) & 3, db = (hi >> 8) & 3;
+    if (b + db - 4 < 0) {
+        hi |= 1u << 10;
+    } else {
+        hi |= 7u << 13;
+    }
+
+    writeBE32(out, hi);
+    writeBE32(out + 4, lo);
+}
+
+void EtcEncoder::encodeColorBlock(const unsigned char rgba[16][4],
+        unsigned char* block) {
+    int error = encodeEtc1(rgba, block);
+    if (error == 0) {
+        return;
+    }
+    unsigned char planar[8];
+    encodePlanar(rgba, planar);
+    if (blockError(planar, rgba) < blockError(block, rgba)) {
+        memcpy(block, planar, 8);
+    }
+}
+
+void EtcEncoder::encodeAlphaBlock(const unsigned char rgba[16][4],
+        unsigned char* block) {
+    int low = 255, high = 0;
+    for (int i = 0; i < 16; ++i) {
+        low = rgba[i][3] < low ? rgba[i][3] : low;
+        high = rgba[i][3] > high ? rgba[i][3] : high;
+    }
+
+    int best_error = INT_MAX;
+    for (int t = 0; t < 16 && best_error > 0; ++t) {
+        const int* table = EAC_MODIFIERS[t];
+        int span = table[7] - table[3];
+        int guess = (high - low + span / 2) / span;
+        for (int multiplier = guess - 1; multiplier <= guess + 1;
+                ++multiplier) {
+            if (multiplier < 1 || multiplier > 15) {
+                continue;
+            }
+            // put the range's center on the center of the table
+            int center = (low + high + 1) / 2
+                    - (table[7] + table[3]) * multiplier / 2;
+            for (int base = center - 2; base <= center + 2; ++base) {
+                if (base < 0 || base > 255) {
+                    continue;
+                }
+                int error = 0;
+                unsigned long long indices = 0;
+                for (int i = 0; i < 16 && error < best_error; ++i) {
+                    int best_pixel_error = INT_MAX, best_index = 0;
+                    for (int index = 0; index < 8; ++index) {
+                        int e = clamp255(base + table[index] * multiplier)
+                                - rgba[i][3];
+                        if (e * e < best_pixel_error) {
+                            best_pixel_error = e * e;
+                            best_index = index;
+                        }
+                    }
+                    error += best_pixel_error;
+                    indices |= static_cast<unsigned long long>(best_index)
+                            << (45 - 3 * i);
+                }
+                if (error < best_error) {
+                    best_error = error;
+                    block[0] = base;
+                    block[1] = (multiplier << 4) | t;
+                    for (int i = 0; i < 6; ++i) {
+                        block[2 + i] = indices >> (40 - 8 * i);
+                    }
+                }
+            }
+        }
+    }
+}
+
+std::vector<unsigned char> EtcEncoder::encode(const RgbaImage& image,
+        bool alpha) {
+    int blocks_x = (image.width + 3) / 4;
+    int blocks_y = (image.height + 3) / 4;
+    size_t block_size = alpha ? 16 : 8;
+    std::vector<unsigned char> blocks(blocks_x * blocks_y * block_size);
+
+    unsigned char rgba[16][4];
+    for (int by = 0; by < blocks_y; ++by) {
+        for (int bx = 0; bx < blocks_x; ++bx) {
+            // edge blocks repeat the last row and column
+            for (int i = 0; i < 16; ++i) {
+                int x = bx * 4 + i / 4, y = by * 4 + i % 4;
+                x = x < image.width ? x : image.width - 1;
+                y = y < image.height ? y : image.height - 1;
+                memcpy(rgba[i], &image.pixels[(y * image.width + x) * 4], 4);
+            }
+            unsigned char* block = &blocks[(by * blocks_x + bx) * block_size];
+            if (alpha) {
+                encodeAlphaBlock(rgba, block);
+                block += 8;
+            }
+            encodeColorBlock(rgba, block);
+        }
+    }
+    return blocks;
+}
+
+}
@@ -0,0 +1,48 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * ETC2 RGB8 and RGBA8 (EAC alpha) block encoder for the texture cooker.
+ ***************************************************************************/
+
+#ifndef ETC_ENCODER_H_
+#define ETC_ENCODER_H_
+
+#include <vector>
+
+#include "mip_chain.h"
+
+namespace gvr {
+
+/*
+ * Searches the individual, differential and planar modes, which covers
+ * ETC1 plus the smooth gradients ETC1 bands on; the T and H modes are
+ * never chosen. Alpha, when asked for, is encoded as an EAC block ahead
+ * of each color block (GL_COMPRESSED_RGBA8_ETC2_EAC).
+ */
+class EtcEncoder {
+public:
+    static std::vector<unsigned char> encode(const RgbaImage& image,
+            bool alpha);
+
+private:
+    static void encodeColorBlock(const unsigned char rgba[16][4],
+            unsigned char* block);
+    static void encodeAlphaBlock(const unsigned char rgba[16][4],
+            unsigned char* block);
+};
+
+}
+#endif
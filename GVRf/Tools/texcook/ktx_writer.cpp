@@ -0,0 +1,71 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * KTX 1 output for the texture cooker.
+ ***************************************************************************/
+
+#include "ktx_writer.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+namespace gvr {
+
+static const unsigned char KTX1_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ',
+        '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+static GLenum baseFormat(GLenum internal_format) {
+    switch (internal_format) {
+    case GL_COMPRESSED_RGB8_ETC2:
+    case GL_COMPRESSED_SRGB8_ETC2:
+        return GL_RGB;
+    default:
+        return GL_RGBA;
+    }
+}
+
+bool writeKtx(const std::string& path, GLenum internal_format, int width,
+        int height, const std::vector<std::vector<unsigned char> >& levels) {
+    bool uncompressed = internal_format == GL_RGBA8;
+    uint32_t header[13] = { 0x04030201, // endianness
+            uncompressed ? GL_UNSIGNED_BYTE : 0u, // glType
+            1, // glTypeSize
+            uncompressed ? GL_RGBA : 0u, // glFormat
+            internal_format, baseFormat(internal_format), uint32_t(width),
+            uint32_t(height), 0, // pixelDepth
+            0, // numberOfArrayElements
+            1, // numberOfFaces
+            uint32_t(levels.size()), 0 // bytesOfKeyValueData
+            };
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == NULL) {
+        return false;
+    }
+    bool written = fwrite(KTX1_IDENTIFIER, sizeof(KTX1_IDENTIFIER), 1, file)
+            == 1 && fwrite(header, sizeof(header), 1, file) == 1;
+    static const unsigned char padding[3] = { 0, 0, 0 };
+    for (size_t i = 0; written && i < levels.size(); ++i) {
+        uint32_t size = levels[i].size();
+        written = fwrite(&size, sizeof(size), 1, file) == 1
+                && fwrite(levels[i].data(), size, 1, file) == 1
+                && (size % 4 == 0
+                        || fwrite(padding, 4 - size % 4, 1, file) == 1);
+    }
+    return fclose(file) == 0 && written;
+}
+
+}
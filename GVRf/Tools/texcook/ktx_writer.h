@@ -0,0 +1,39 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * KTX 1 output for the texture cooker.
+ ***************************************************************************/
+
+#ifndef KTX_WRITER_H_
+#define KTX_WRITER_H_
+
+#include <string>
+#include <vector>
+
+#include "GLES3/gl3.h"
+
+namespace gvr {
+
+/*
+ * Write one face of levels, largest first, as a KTX 1 file that KtxFile
+ * and the Java KTX loader both read. An uncompressed (GL_RGBA,
+ * GL_UNSIGNED_BYTE) file is written when internal_format is GL_RGBA8.
+ */
+bool writeKtx(const std::string& path, GLenum internal_format, int width,
+        int height, const std::vector<std::vector<unsigned char> >& levels);
+
+}
+#endif
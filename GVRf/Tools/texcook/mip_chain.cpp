@@ -0,0 +1,103 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Gamma-correct mip chain generation for the texture cooker.
+ ***************************************************************************/
+
+#include "mip_chain.h"
+
+#include <math.h>
+
+namespace gvr {
+
+static float srgbToLinear(float value) {
+    return value <= 0.04045f ?
+            value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float linearToSrgb(float value) {
+    return value <= 0.0031308f ?
+            value * 12.92f : 1.055f * powf(value, 1.0f / 2.4f) - 0.055f;
+}
+
+static unsigned char toByte(float value) {
+    if (value <= 0.0f) {
+        return 0;
+    }
+    if (value >= 1.0f) {
+        return 255;
+    }
+    return static_cast<unsigned char>(value * 255.0f + 0.5f);
+}
+
+static RgbaImage downsample(const RgbaImage& source, const float* to_linear,
+        bool linear) {
+    RgbaImage level;
+    level.width = source.width > 1 ? source.width / 2 : 1;
+    level.height = source.height > 1 ? source.height / 2 : 1;
+    level.pixels.resize(level.width * level.height * 4);
+
+    for (int y = 0; y < level.height; ++y) {
+        int y0 = y * source.height / level.height;
+        int y1 = (y + 1) * source.height / level.height;
+        for (int x = 0; x < level.width; ++x) {
+            int x0 = x * source.width / level.width;
+            int x1 = (x + 1) * source.width / level.width;
+
+            float color[3] = { 0.0f, 0.0f, 0.0f };
+            float unweighted[3] = { 0.0f, 0.0f, 0.0f };
+            float alpha = 0.0f;
+            int count = 0;
+            for (int sy = y0; sy < y1; ++sy) {
+                const unsigned char* texel = &source.pixels[(sy * source.width
+                        + x0) * 4];
+                for (int sx = x0; sx < x1; ++sx, texel += 4) {
+                    float a = texel[3] / 255.0f;
+                    for (int c = 0; c < 3; ++c) {
+                        float value = to_linear[texel[c]];
+                        color[c] += value * a;
+                        unweighted[c] += value;
+                    }
+                    alpha += a;
+                    ++count;
+                }
+            }
+
+            unsigned char* out = &level.pixels[(y * level.width + x) * 4];
+            for (int c = 0; c < 3; ++c) {
+                // a fully transparent area keeps its plain average
+                float value =
+                        alpha > 0.0f ? color[c] / alpha : unweighted[c] / count;
+                out[c] = toByte(linear ? value : linearToSrgb(value));
+            }
+            out[3] = toByte(alpha / count);
+        }
+    }
+    return level;
+}
+
+void buildMipChain(std::vector<RgbaImage>& levels, bool linear) {
+    float to_linear[256];
+    for (int i = 0; i < 256; ++i) {
+        to_linear[i] = linear ? i / 255.0f : srgbToLinear(i / 255.0f);
+    }
+    levels.resize(1);
+    while (levels.back().width > 1 || levels.back().height > 1) {
+        levels.push_back(downsample(levels.back(), to_linear, linear));
+    }
+}
+
+}
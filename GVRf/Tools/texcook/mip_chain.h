@@ -0,0 +1,43 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * Gamma-correct mip chain generation for the texture cooker.
+ ***************************************************************************/
+
+#ifndef MIP_CHAIN_H_
+#define MIP_CHAIN_H_
+
+#include <vector>
+
+namespace gvr {
+
+struct RgbaImage {
+    int width;
+    int height;
+    std::vector<unsigned char> pixels;
+};
+
+/*
+ * Build levels 1..n down to 1x1 from levels[0]. Colors are averaged in
+ * linear light unless linear is set (the data is not sRGB, as in normal
+ * maps), and weighted by alpha, so transparent texels do not darken their
+ * neighbours. Non-power-of-two sizes are halved, rounding down, with each
+ * texel averaging the source area it covers.
+ */
+void buildMipChain(std::vector<RgbaImage>& levels, bool linear);
+
+}
+#endif
@@ -0,0 +1,321 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/***************************************************************************
+ * gvrf-texcook: cooks PNG textures into mipmapped ETC2 or ASTC KTX files.
+ ***************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "objects/textures/etc_decoder.h"
+#include "objects/textures/ktx_file.h"
+#include "objects/textures/png_loader.h"
+
+#include "astc_encoder.h"
+#include "etc_encoder.h"
+#include "ktx_writer.h"
+#include "mip_chain.h"
+
+using namespace gvr;
+
+namespace {
+
+struct Options {
+    Options() :
+            output_dir(), astc(false), astc_block("6x6"), astc_quality(
+                    "medium"), srgb(false), linear(false), mipmaps(true), jobs(
+                    0) {
+    }
+
+    std::string output_dir;
+    bool astc;
+    std::string astc_block;
+    std::string astc_quality;
+    bool srgb;
+    bool linear;
+    bool mipmaps;
+    int jobs;
+};
+
+struct Result {
+    Result() :
+            cooked(false), rgba_bytes(0), ktx_bytes(0) {
+    }
+
+    bool cooked;
+    // what the runtime would hold as RGBA8, mip chain included
+    size_t rgba_bytes;
+    size_t ktx_bytes;
+};
+
+std::mutex output_mutex;
+
+void usage() {
+    fprintf(stderr,
+            "usage: gvrf-texcook [options] input.png...\n"
+                    "  -o DIR          write DIR/<name>.ktx, not <input>.ktx\n"
+                    "  -f etc2|astc    output format (default etc2)\n"
+                    "  -b WxH          ASTC block footprint (default 6x6)\n"
+                    "  -q PRESET       astcenc fast, medium, thorough or "
+                    "exhaustive (default medium)\n"
+                    "  --astcenc CMD   astcenc executable (default astcenc)\n"
+                    "  --srgb          tag the output as sRGB\n"
+                    "  --linear        data is not sRGB (normal maps): "
+                    "no gamma in mip filtering\n"
+                    "  --no-mips       level 0 only\n"
+                    "  -j N            files cooked in parallel (default: "
+                    "one per core)\n");
+}
+
+std::string outputPath(const Options& options, const std::string& input) {
+    std::string name = input;
+    size_t dot = name.rfind('.');
+    size_t slash = name.rfind('/');
+    if (dot != std::string::npos
+            && (slash == std::string::npos || dot > slash)) {
+        name.erase(dot);
+    }
+    if (!options.output_dir.empty()) {
+        slash = name.rfind('/');
+        name = options.output_dir + "/"
+                + (slash == std::string::npos ? name : name.substr(slash + 1));
+    }
+    return name + ".ktx";
+}
+
+bool readFile(const std::string& path, std::vector<unsigned char>& contents) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL) {
+        return false;
+    }
+    unsigned char buffer[65536];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        contents.insert(contents.end(), buffer, buffer + count);
+    }
+    fclose(file);
+    return true;
+}
+
+bool decodePng(const std::string& path, RgbaImage& image) {
+    std::vector<unsigned char> contents;
+    if (!readFile(path, contents)) {
+        return false;
+    }
+    // the engine's own decoder, so textures look as they did at runtime
+    PngLoader loader;
+    if (!loader.begin(contents.data(), contents.size())) {
+        return false;
+    }
+    image.width = loader.pOutImage.width;
+    image.height = loader.pOutImage.height;
+    image.pixels.resize(image.width * image.height * 4);
+    return loader.decode(image.pixels.data(), image.width * 4);
+}
+
+// peak signal to noise ratio of decoded against original, in dB
+double psnr(const RgbaImage& original, const unsigned char* decoded,
+        bool alpha) {
+    double squared = 0.0;
+    int channels = alpha ? 4 : 3;
+    for (size_t i = 0; i < original.pixels.size(); i += 4) {
+        for (int c = 0; c < channels; ++c) {
+            double e = double(decoded[i + c]) - original.pixels[i + c];
+            squared += e * e;
+        }
+    }
+    double mse = squared / (original.pixels.size() / 4 * channels);
+    return mse == 0.0 ? INFINITY : 10.0 * log10(255.0 * 255.0 / mse);
+}
+
+Result cook(const Options& options, const std::string& input) {
+    Result result;
+    std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+
+    std::vector<RgbaImage> levels(1);
+    if (!decodePng(input, levels[0])) {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        fprintf(stderr, "texcook: cannot decode %s\n", input.c_str());
+        return result;
+    }
+    bool alpha = false;
+    for (size_t i = 3; i < levels[0].pixels.size() && !alpha; i += 4) {
+        alpha = levels[0].pixels[i] != 255;
+    }
+    if (options.mipmaps) {
+        buildMipChain(levels, options.linear);
+    }
+
+    GLenum format;
+    if (options.astc) {
+        format = AstcEncoder::internalFormat(options.astc_block, options.srgb);
+    } else if (alpha) {
+        format = options.srgb ?
+                GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC :
+                GL_COMPRESSED_RGBA8_ETC2_EAC;
+    } else {
+        format = options.srgb ?
+                GL_COMPRESSED_SRGB8_ETC2 : GL_COMPRESSED_RGB8_ETC2;
+    }
+
+    std::vector<std::vector<unsigned char> > encoded;
+    for (size_t i = 0; i < levels.size(); ++i) {
+        result.rgba_bytes += levels[i].pixels.size();
+        encoded.push_back(
+                options.astc ?
+                        AstcEncoder::encode(levels[i], options.astc_block,
+                                options.srgb, options.astc_quality) :
+                        EtcEncoder::encode(levels[i], alpha));
+        if (encoded.back().empty()) {
+            return result;
+        }
+        result.ktx_bytes += encoded.back().size();
+    }
+
+    std::string output = outputPath(options, input);
+    if (!writeKtx(output, format, levels[0].width, levels[0].height,
+            encoded)) {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        fprintf(stderr, "texcook: cannot write %s\n", output.c_str());
+        return result;
+    }
+    // read back with the runtime's parser
+    KtxFile check;
+    if (!check.open(output.c_str())
+            || check.levels() != static_cast<int>(levels.size())) {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        fprintf(stderr, "texcook: %s does not read back\n", output.c_str());
+        return result;
+    }
+
+    char quality[32] = "n/a";
+    if (EtcDecoder::canDecode(format)) {
+        std::vector<unsigned char> decoded(levels[0].pixels.size());
+        EtcDecoder::decode(format, encoded[0].data(), encoded[0].size(),
+                levels[0].width, levels[0].height, decoded.data());
+        snprintf(quality, sizeof(quality), "%.2f dB",
+                psnr(levels[0], decoded.data(), alpha));
+    }
+    double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(output_mutex);
+    printf("%s: %dx%d, %zu levels, 0x%x, %zu -> %zu bytes (%.1fx), "
+            "PSNR %s, %.2f s\n", output.c_str(), levels[0].width,
+            levels[0].height, levels.size(), format, result.rgba_bytes,
+            result.ktx_bytes, double(result.rgba_bytes) / result.ktx_bytes,
+            quality, seconds);
+    result.cooked = true;
+    return result;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-o" && has_value) {
+            options.output_dir = argv[++i];
+        } else if (arg == "-f" && has_value) {
+            std::string format = argv[++i];
+            if (format != "etc2" && format != "astc") {
+                usage();
+                return 2;
+            }
+            options.astc = format == "astc";
+        } else if (arg == "-b" && has_value) {
+            options.astc_block = argv[++i];
+        } else if (arg == "-q" && has_value) {
+            options.astc_quality = argv[++i];
+        } else if (arg == "--astcenc" && has_value) {
+            AstcEncoder::setCommand(argv[++i]);
+        } else if (arg == "--srgb") {
+            options.srgb = true;
+        } else if (arg == "--linear") {
+            options.linear = true;
+        } else if (arg == "--no-mips") {
+            options.mipmaps = false;
+        } else if (arg == "-j" && has_value) {
+            options.jobs = atoi(argv[++i]);
+        } else if (arg.empty() || arg[0] == '-') {
+            usage();
+            return 2;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        usage();
+        return 2;
+    }
+    if (options.astc && AstcEncoder::internalFormat(options.astc_block,
+            false) == 0) {
+        fprintf(stderr, "texcook: %s is not an ASTC block footprint\n",
+                options.astc_block.c_str());
+        return 2;
+    }
+
+    int jobs = options.jobs > 0 ?
+            options.jobs : static_cast<int>(std::thread::hardware_concurrency());
+    jobs = jobs < 1 ? 1 : jobs;
+    jobs = jobs > static_cast<int>(inputs.size()) ?
+            static_cast<int>(inputs.size()) : jobs;
+
+    std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+    std::vector<Result> results(inputs.size());
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < jobs; ++i) {
+        workers.push_back(std::thread([&]() {
+            for (size_t n; (n = next++) < inputs.size();) {
+                results[n] = cook(options, inputs[n]);
+            }
+        }));
+    }
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+
+    size_t cooked = 0, rgba_bytes = 0, ktx_bytes = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (results[i].cooked) {
+            ++cooked;
+            rgba_bytes += results[i].rgba_bytes;
+            ktx_bytes += results[i].ktx_bytes;
+        }
+    }
+    double seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    printf("%zu of %zu cooked with %d jobs in %.2f s: %zu -> %zu bytes "
+            "(%.1fx smaller in GPU memory)\n", cooked, inputs.size(), jobs,
+            seconds, rgba_bytes, ktx_bytes,
+            ktx_bytes ? double(rgba_bytes) / ktx_bytes : 0.0);
+    return cooked == inputs.size() ? 0 : 1;
+}